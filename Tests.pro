@@ -1,4 +1,4 @@
-QT += testlib core
+QT += testlib core multimedia concurrent
 
 CONFIG += qt console warn_on depend_includepath testcase
 CONFIG -= app_bundle
@@ -11,12 +11,69 @@ SOURCES +=  \
     tests/tst_recentfilesmanager.cpp \
     tests/tst_testrecentfilesinteractor.cpp \
     tests/tst_imagevalidationrules.cpp \
+    tests/tst_boundedframequeue.cpp \
+    tests/tst_videooffsetfinder.cpp \
+    tests/tst_framecadenceanalyzer.cpp \
+    tests/tst_tearingdetector.cpp \
+    tests/tst_differenceregionindex.cpp \
+    tests/tst_rowdifferencemap.cpp \
+    tests/tst_differenceplane.cpp \
+    tests/tst_pixelkernels.cpp \
+    tests/tst_filterpipeline.cpp \
+    tests/tst_filterhistory.cpp \
+    tests/tst_compressedimage.cpp \
+    tests/tst_comparableimage.cpp \
+    tests/tst_summedareatable.cpp \
+    tests/tst_brushstatistics.cpp \
+    tests/tst_comparisonestimator.cpp \
+    tests/tst_tiledimagebuffer.cpp \
+    tests/tst_ssimcalculator.cpp \
+    tests/tst_temporalditheringstatistics.cpp \
+    tests/tst_framehasher.cpp \
+    tests/tst_framepairextractioninteractor.cpp \
+    tests/tst_internalimagefile.cpp \
 
 SOURCES += \
     business/recentfilesmanager.cpp \
     business/recentfilesinteractor.cpp \
     business/validation/imagevalidationrules.cpp \
-    domain/valueobjects/images.cpp
+    domain/valueobjects/images.cpp \
+    domain/valueobjects/compressedimage.cpp \
+    data/storage/internalimagefile.cpp \
+    domain/valueobjects/comparableimage.cpp \
+    domain/valueobjects/summedareatable.cpp \
+    domain/valueobjects/integralimage.cpp \
+    domain/valueobjects/brushstatistics.cpp \
+    domain/valueobjects/rowdifferencemap.cpp \
+    domain/valueobjects/rowindex.cpp \
+    domain/valueobjects/differenceplane.cpp \
+    domain/valueobjects/tiledimagebuffer.cpp \
+    domain/valueobjects/comparisonresultvariant.cpp \
+    domain/valueobjects/property.cpp \
+    domain/interfaces/business/imageprocessor.cpp \
+    domain/interfaces/business/icomparator.cpp \
+    domain/interfaces/business/ifilter.cpp \
+    domain/kernels/pixelkernels.cpp \
+    domain/kernels/pixelkernelsx86.cpp \
+    domain/kernels/pixelkernelsneon.cpp \
+    domain/utils/parallel.cpp \
+    business/videoanalysis/boundedframequeue.cpp \
+    business/videoanalysis/videooffsetfinder.cpp \
+    business/videoanalysis/videosignature.cpp \
+    business/videoanalysis/framecadenceanalyzer.cpp \
+    business/videoanalysis/framehasher.cpp \
+    business/videoanalysis/tearingdetector.cpp \
+    business/videoanalysis/framepairextractioninteractor.cpp \
+    business/videoanalysis/videoanalysisworkers.cpp \
+    business/videoanalysis/videoframereader.cpp \
+    business/videoanalysis/temporalditheringstatistics.cpp \
+    business/imageanalysis/differenceregionindex.cpp \
+    business/imageanalysis/comparisonestimator.cpp \
+    business/imageanalysis/comporators/helpers/ssimcalculator.cpp \
+    business/imageanalysis/filters/grayscalefilter.cpp \
+    business/imageanalysis/filters/rgbfilter.cpp \
+    business/imageanalysis/filters/filterpipeline.cpp \
+    business/imageanalysis/filterhistory.cpp
 
 HEADERS += \
     business/recentfilesmanager.h \
@@ -24,6 +81,63 @@ HEADERS += \
     tests/mocks/mockrecentfilesmanager.h \
     business/validation/imagevalidationrules.h \
     domain/valueobjects/images.h \
+    domain/valueobjects/compressedimage.h \
+    data/storage/internalimagefile.h \
+    domain/valueobjects/comparableimage.h \
+    domain/valueobjects/summedareatable.h \
+    domain/valueobjects/integralimage.h \
+    domain/valueobjects/brushstatistics.h \
+    domain/valueobjects/rowdifferencemap.h \
+    domain/valueobjects/rowindex.h \
+    domain/valueobjects/differenceplane.h \
+    domain/valueobjects/tiledimagebuffer.h \
+    domain/valueobjects/comparisonresultvariant.h \
+    domain/valueobjects/framepairextractionsettings.h \
+    domain/kernels/pixelkernels.h \
+    domain/kernels/scalarkernels.h \
+    domain/utils/parallel.h \
+    domain/valueobjects/property.h \
+    domain/interfaces/business/imageprocessor.h \
+    domain/interfaces/business/ifilter.h \
+    domain/interfaces/business/icomparator.h \
     tests/tst_imagevalidationrules.h \
     tests/tst_recentfilesmanager.h \
-    tests/tst_testrecentfilesinteractor.h
+    tests/tst_testrecentfilesinteractor.h \
+    tests/tst_boundedframequeue.h \
+    tests/tst_videooffsetfinder.h \
+    tests/tst_framecadenceanalyzer.h \
+    tests/tst_tearingdetector.h \
+    tests/tst_differenceregionindex.h \
+    tests/tst_rowdifferencemap.h \
+    tests/tst_differenceplane.h \
+    tests/tst_pixelkernels.h \
+    tests/tst_filterpipeline.h \
+    tests/tst_filterhistory.h \
+    tests/tst_compressedimage.h \
+    tests/tst_comparableimage.h \
+    tests/tst_summedareatable.h \
+    tests/tst_brushstatistics.h \
+    tests/tst_comparisonestimator.h \
+    tests/tst_tiledimagebuffer.h \
+    tests/tst_ssimcalculator.h \
+    tests/tst_temporalditheringstatistics.h \
+    tests/tst_framehasher.h \
+    tests/tst_framepairextractioninteractor.h \
+    tests/tst_internalimagefile.h \
+    business/videoanalysis/boundedframequeue.h \
+    business/videoanalysis/videooffsetfinder.h \
+    business/videoanalysis/videosignature.h \
+    business/videoanalysis/framecadenceanalyzer.h \
+    business/videoanalysis/framehasher.h \
+    business/videoanalysis/tearingdetector.h \
+    business/videoanalysis/framepairextractioninteractor.h \
+    business/videoanalysis/videoanalysisworkers.h \
+    business/videoanalysis/videoframereader.h \
+    business/videoanalysis/temporalditheringstatistics.h \
+    business/imageanalysis/differenceregionindex.h \
+    business/imageanalysis/comparisonestimator.h \
+    business/imageanalysis/comporators/helpers/ssimcalculator.h \
+    business/imageanalysis/filters/grayscalefilter.h \
+    business/imageanalysis/filters/rgbfilter.h \
+    business/imageanalysis/filters/filterpipeline.h \
+    business/imageanalysis/filterhistory.h
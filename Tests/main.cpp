@@ -1,6 +1,27 @@
 #include "tst_recentfilesmanager.h"
 #include "tst_testrecentfilesinteractor.h"
 #include "tst_imagevalidationrules.h"
+#include "tst_boundedframequeue.h"
+#include "tst_videooffsetfinder.h"
+#include "tst_framecadenceanalyzer.h"
+#include "tst_tearingdetector.h"
+#include "tst_differenceregionindex.h"
+#include "tst_rowdifferencemap.h"
+#include "tst_differenceplane.h"
+#include "tst_pixelkernels.h"
+#include "tst_filterpipeline.h"
+#include "tst_filterhistory.h"
+#include "tst_compressedimage.h"
+#include "tst_comparableimage.h"
+#include "tst_summedareatable.h"
+#include "tst_brushstatistics.h"
+#include "tst_comparisonestimator.h"
+#include "tst_tiledimagebuffer.h"
+#include "tst_ssimcalculator.h"
+#include "tst_temporalditheringstatistics.h"
+#include "tst_framehasher.h"
+#include "tst_framepairextractioninteractor.h"
+#include "tst_internalimagefile.h"
 
 
 int main(int argc, char *argv[]) {
@@ -23,5 +44,110 @@ int main(int argc, char *argv[]) {
         status |= QTest::qExec(&test, argc, argv);
     }
 
+    {
+        TestBoundedFrameQueue test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestVideoOffsetFinder test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestFrameCadenceAnalyzer test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestTearingDetector test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestDifferenceRegionIndex test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestRowDifferenceMap test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestDifferencePlane test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestPixelKernels test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestFilterPipeline test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestFilterHistory test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestCompressedImage test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestComparableImage test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestSummedAreaTable test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestBrushStatistics test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestComparisonEstimator test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestTiledImageBuffer test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestSsimCalculator test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestTemporalDitheringStatistics test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestFrameHasher test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestFramePairExtractionInteractor test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
+    {
+        TestInternalImageFile test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
     return status;
 }
@@ -0,0 +1,70 @@
+#include "tst_boundedframequeue.h"
+
+#include <QThread>
+#include <atomic>
+#include <business/videoanalysis/boundedframequeue.h>
+
+// Test: frames are returned in the order they were pushed
+void TestBoundedFrameQueue::testFramesKeepOrder() {
+    BoundedFrameQueue queue(3);
+    QVERIFY(queue.push({ 0, 0, QImage() }));
+    QVERIFY(queue.push({ 1, 40, QImage() }));
+
+    auto first = queue.pop();
+    auto second = queue.pop();
+    QVERIFY(first.has_value());
+    QVERIFY(second.has_value());
+    QCOMPARE(first->frameIndex, 0);
+    QCOMPARE(second->frameIndex, 1);
+    QCOMPARE(second->positionMs, qint64(40));
+}
+
+// Test: a closed queue is drained first and then reports the end of the stream
+void TestBoundedFrameQueue::testPopReturnsNothingAfterClose() {
+    BoundedFrameQueue queue(2);
+    QVERIFY(queue.push({ 0, 0, QImage() }));
+    queue.close();
+
+    QVERIFY(queue.pop().has_value());
+    QVERIFY(!queue.pop().has_value());
+}
+
+// Test: an aborted queue drops its frames and rejects new ones
+void TestBoundedFrameQueue::testPushFailsAfterAbort() {
+    BoundedFrameQueue queue(2);
+    QVERIFY(queue.push({ 0, 0, QImage() }));
+    queue.abort();
+
+    QVERIFY(!queue.push({ 1, 40, QImage() }));
+    QVERIFY(!queue.pop().has_value());
+}
+
+// Test: the producer cannot get ahead of the consumer by more than the capacity
+void TestBoundedFrameQueue::testProducerIsBlockedWhenQueueIsFull() {
+    BoundedFrameQueue queue(2);
+    std::atomic<int> pushedFrames(0);
+
+    QThread *producer = QThread::create([&]() {
+        for (int i = 0; i < 5; ++i) {
+            if (!queue.push({ i, 0, QImage() })) {
+                break;
+            }
+            ++pushedFrames;
+        }
+        queue.close();
+    });
+    producer->start();
+
+    QTest::qWait(100);
+    QCOMPARE(pushedFrames.load(), 2);
+
+    int poppedFrames = 0;
+    while (queue.pop()) {
+        ++poppedFrames;
+    }
+    producer->wait();
+    delete producer;
+
+    QCOMPARE(poppedFrames, 5);
+    QCOMPARE(pushedFrames.load(), 5);
+}
@@ -0,0 +1,17 @@
+#ifndef TST_BOUNDEDFRAMEQUEUE_H
+#define TST_BOUNDEDFRAMEQUEUE_H
+
+#include <QTest>
+
+class TestBoundedFrameQueue : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFramesKeepOrder();
+    void testPopReturnsNothingAfterClose();
+    void testPushFailsAfterAbort();
+    void testProducerIsBlockedWhenQueueIsFull();
+};
+
+
+#endif // TST_BOUNDEDFRAMEQUEUE_H
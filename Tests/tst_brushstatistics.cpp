@@ -0,0 +1,45 @@
+#include "tst_brushstatistics.h"
+
+#include <domain/valueobjects/brushstatistics.h>
+
+// Test: the mean, the deviation and the maximum difference of the channels under a 4x4 brush
+void TestBrushStatistics::testStatisticsUnderBrush() {
+    QImage image(32, 32, QImage::Format_RGB32);
+    image.fill(qRgb(100, 50, 10));
+    QImage otherImage = image.copy();
+    // A checkerboard of 90 and 110 in the red channel under the brush
+    for (int y = 8; y < 12; ++y) {
+        for (int x = 8; x < 12; ++x) {
+            image.setPixel(x, y, (x + y) % 2 == 0 ? qRgb(90, 50, 10) : qRgb(110, 50, 10));
+        }
+    }
+    otherImage.setPixel(9, 9, qRgb(100, 50, 30));
+
+    auto statistics = BrushStatistics::calculate(image, QPoint(10, 10), 4, otherImage);
+    QCOMPARE(statistics.getArea(), QRect(8, 8, 4, 4));
+    QCOMPARE(statistics.getChannelSums(0).getMean(), 100.0);
+    QCOMPARE(statistics.getChannelSums(0).getStandardDeviation(), 10.0);
+    QCOMPARE(statistics.getChannelSums(1).getStandardDeviation(), 0.0);
+    QCOMPARE(statistics.getMaxDifference(0), 10);
+    QCOMPARE(statistics.getMaxDifference(1), 0);
+    QCOMPARE(statistics.getMaxDifference(2), 20);
+
+    // Without the other image there are no differences
+    statistics = BrushStatistics::calculate(image, QPoint(10, 10), 4);
+    QCOMPARE(statistics.getMaxDifference(0), -1);
+}
+
+// Test: the brush is clipped to the image and its size is limited
+void TestBrushStatistics::testBrushIsClippedToImage() {
+    QImage image(100, 100, QImage::Format_RGB32);
+    image.fill(qRgb(1, 2, 3));
+
+    auto statistics = BrushStatistics::calculate(image, QPoint(0, 0), 9);
+    QCOMPARE(statistics.getArea(), QRect(0, 0, 5, 5));
+    QCOMPARE(statistics.getChannelSums(2).getMean(), 3.0);
+
+    statistics = BrushStatistics::calculate(image, QPoint(50, 50), 1000);
+    QCOMPARE(statistics.getArea().size(), QSize(BrushStatistics::mMaxBrushSize, BrushStatistics::mMaxBrushSize));
+
+    QVERIFY(BrushStatistics::calculate(image, QPoint(-20, -20), 9).isNull());
+}
@@ -0,0 +1,15 @@
+#ifndef TST_BRUSHSTATISTICS_H
+#define TST_BRUSHSTATISTICS_H
+
+#include <QTest>
+
+class TestBrushStatistics : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStatisticsUnderBrush();
+    void testBrushIsClippedToImage();
+};
+
+
+#endif // TST_BRUSHSTATISTICS_H
@@ -0,0 +1,48 @@
+#include "tst_comparableimage.h"
+
+#include <domain/valueobjects/comparableimage.h>
+
+namespace {
+
+QImage makeImage(int width, int height) {
+    QImage image(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixel(x, y, qRgb(x % 256, y % 256, (x * y) % 256));
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+// Test: the region is a view of the rows of the whole image with the same pixels as a copy
+void TestComparableImage::testRegionOfInterestIsNotCopied() {
+    QImage image = makeImage(64, 48);
+    QRect area { 10, 5, 20, 30 };
+    ComparableImage comparableImage { image, "first.png" };
+    comparableImage.setRegionOfInterest(area);
+
+    QImage region = comparableImage.getImage();
+    QCOMPARE(region.size(), area.size());
+    QCOMPARE(region.constScanLine(0), image.constScanLine(area.top()) + area.left() * 4);
+    QCOMPARE(region, image.copy(area));
+
+    // Modifying the view does not modify the whole image
+    region.setPixel(0, 0, qRgb(1, 2, 3));
+    QCOMPARE(image.pixel(area.topLeft()), qRgb(10, 5, 50));
+}
+
+// Test: the region is clipped to the image, an area outside of it is not a region
+void TestComparableImage::testRegionOfInterestIsClipped() {
+    ComparableImage comparableImage { makeImage(32, 32), "first.png" };
+    QCOMPARE(comparableImage.getRegionOfInterest(), QRect(0, 0, 32, 32));
+
+    comparableImage.setRegionOfInterest(QRect(20, 24, 40, 40));
+    QCOMPARE(comparableImage.getRegionOfInterest(), QRect(20, 24, 12, 8));
+    QCOMPARE(comparableImage.getImage().size(), QSize(12, 8));
+
+    comparableImage.setRegionOfInterest(QRect(40, 40, 8, 8));
+    QVERIFY(!comparableImage.hasRegionOfInterest());
+    QCOMPARE(comparableImage.getImage().size(), QSize(32, 32));
+}
@@ -0,0 +1,15 @@
+#ifndef TST_COMPARABLEIMAGE_H
+#define TST_COMPARABLEIMAGE_H
+
+#include <QTest>
+
+class TestComparableImage : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRegionOfInterestIsNotCopied();
+    void testRegionOfInterestIsClipped();
+};
+
+
+#endif // TST_COMPARABLEIMAGE_H
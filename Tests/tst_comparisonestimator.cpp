@@ -0,0 +1,71 @@
+#include "tst_comparisonestimator.h"
+
+#include <business/imageanalysis/comparisonestimator.h>
+#include <cmath>
+
+namespace {
+
+// The red and green channels of every pixel hold its coordinates
+QImage createCoordinatesImage(int width, int height, int blue) {
+    QImage image(width, height, QImage::Format_RGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixel(x, y, qRgb(x, y, blue));
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+// Test: the sample has one pixel of every block (including the partial ones at the edges),
+// taken at the same position in both images
+void TestComparisonEstimator::testStratifiedSampleTakesOnePixelOfEveryBlock() {
+    const int step = 4;
+    QImage first = createCoordinatesImage(30, 18, 0);
+    QImage second = createCoordinatesImage(30, 18, 255);
+
+    auto sample = ComparisonEstimator::makeStratifiedSample(first, second, step, 42);
+    QCOMPARE(sample.first.size(), QSize(8, 5));
+    QCOMPARE(sample.second.size(), QSize(8, 5));
+
+    for (int blockY = 0; blockY < sample.first.height(); ++blockY) {
+        for (int blockX = 0; blockX < sample.first.width(); ++blockX) {
+            QRgb firstPixel = sample.first.pixel(blockX, blockY);
+            QRgb secondPixel = sample.second.pixel(blockX, blockY);
+            QCOMPARE(qRed(firstPixel) / step, blockX);
+            QCOMPARE(qGreen(firstPixel) / step, blockY);
+            QVERIFY(qRed(firstPixel) < first.width());
+            QVERIFY(qGreen(firstPixel) < first.height());
+            QCOMPARE(qRed(secondPixel), qRed(firstPixel));
+            QCOMPARE(qGreen(secondPixel), qGreen(firstPixel));
+            QCOMPARE(qBlue(secondPixel), 255);
+        }
+    }
+
+    // The same seed gives the same sample
+    auto sameSample = ComparisonEstimator::makeStratifiedSample(first, second, step, 42);
+    QCOMPARE(sameSample.first, sample.first);
+}
+
+// Test: images of different sizes cannot be sampled
+void TestComparisonEstimator::testStratifiedSampleRequiresSameSize() {
+    QImage first = createCoordinatesImage(10, 10, 0);
+    QImage second = createCoordinatesImage(10, 11, 0);
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error,
+                             ComparisonEstimator::makeStratifiedSample(first, second, 2, 1));
+}
+
+// Test: the estimate is the mean of the samples with the 95% confidence interval of Student's t-distribution
+void TestComparisonEstimator::testMetricConfidenceInterval() {
+    auto estimate = ComparisonEstimator::estimateMetric("Metric", { 1.0, 2.0, 3.0, 4.0 });
+    QCOMPARE(estimate.name, QString("Metric"));
+    QCOMPARE(estimate.value, 2.5);
+    // s = sqrt(5 / 3), the standard error is s / 2, t(3) = 3.182
+    QVERIFY(qAbs(estimate.marginOfError - 3.182 * std::sqrt(5.0 / 3.0) / 2.0) < 1e-9);
+
+    // A single sample has no spread, so the margin of error is unknown
+    estimate = ComparisonEstimator::estimateMetric("Metric", { 7.0 });
+    QCOMPARE(estimate.value, 7.0);
+    QCOMPARE(estimate.marginOfError, -1.0);
+}
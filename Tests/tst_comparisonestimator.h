@@ -0,0 +1,16 @@
+#ifndef TST_COMPARISONESTIMATOR_H
+#define TST_COMPARISONESTIMATOR_H
+
+#include <QTest>
+
+class TestComparisonEstimator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStratifiedSampleTakesOnePixelOfEveryBlock();
+    void testStratifiedSampleRequiresSameSize();
+    void testMetricConfidenceInterval();
+};
+
+
+#endif // TST_COMPARISONESTIMATOR_H
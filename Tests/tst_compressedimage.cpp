@@ -0,0 +1,90 @@
+#include "tst_compressedimage.h"
+
+#include <domain/valueobjects/compressedimage.h>
+
+namespace {
+
+// Runs, repeated colors, small and large steps, so every kind of QOI chunk is used
+QImage makeArgbImage(int width, int height) {
+    QImage image(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            QRgb color;
+            if (x < width / 4) {
+                color = qRgba(10, 20, 30, 255);
+            } else if (x < width / 2) {
+                color = qRgba(x % 3 * 40, y % 5 * 20, 200, 255);
+            } else {
+                color = qRgba((x * 37 + y) % 256, (y * 91) % 256, (x * y) % 256, (x + y) % 256);
+            }
+            image.setPixel(x, y, color);
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+// Test: a 32-bit image with alpha is restored exactly, spread over several bands
+void TestCompressedImage::testArgbImageRoundtrip() {
+    QImage image = makeArgbImage(301, 257);
+
+    CompressedImage compressed = CompressedImage::compress(image);
+    QCOMPARE(compressed.size(), image.size());
+    QCOMPARE(compressed.format(), image.format());
+    QVERIFY(compressed.getCompressedSize() < compressed.getUncompressedSize());
+
+    QImage restored = compressed.decompress();
+    QCOMPARE(restored.format(), image.format());
+    QCOMPARE(restored, image);
+}
+
+// Test: an indexed image keeps its format and color table
+void TestCompressedImage::testIndexedImageRoundtrip() {
+    QImage image(130, 70, QImage::Format_Indexed8);
+    image.setColorTable({ qRgb(0, 0, 0), qRgb(255, 0, 0), qRgb(0, 255, 0) });
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.setPixel(x, y, (x / 10 + y) % 3);
+        }
+    }
+
+    QImage restored = CompressedImage::compress(image).decompress();
+    QCOMPARE(restored.format(), QImage::Format_Indexed8);
+    QCOMPARE(restored.colorTable(), image.colorTable());
+    QCOMPARE(restored, image);
+}
+
+// Test: the totals count the compressed data while at least one copy of it is alive
+void TestCompressedImage::testTotalSizesFollowLifetime() {
+    qint64 compressedBefore = CompressedImage::getTotalCompressedSize();
+    qint64 uncompressedBefore = CompressedImage::getTotalUncompressedSize();
+    {
+        CompressedImage compressed = CompressedImage::compress(makeArgbImage(64, 64));
+        CompressedImage copy = compressed;
+        QCOMPARE(CompressedImage::getTotalCompressedSize() - compressedBefore, compressed.getCompressedSize());
+        QCOMPARE(CompressedImage::getTotalUncompressedSize() - uncompressedBefore, compressed.getUncompressedSize());
+        QVERIFY(!copy.isNull());
+    }
+    QCOMPARE(CompressedImage::getTotalCompressedSize(), compressedBefore);
+    QCOMPARE(CompressedImage::getTotalUncompressedSize(), uncompressedBefore);
+    QVERIFY(CompressedImage::compress(QImage()).isNull());
+}
+
+// Test: the written data is read back as the same image, truncated data is rejected
+void TestCompressedImage::testSerializedImageRoundtrip() {
+    QImage image = makeArgbImage(200, 150);
+    QByteArray bytes;
+    {
+        QDataStream stream { &bytes, QIODevice::WriteOnly };
+        CompressedImage::compress(image).write(stream);
+    }
+
+    QDataStream stream { bytes };
+    CompressedImage compressed = CompressedImage::read(stream);
+    QCOMPARE(compressed.size(), image.size());
+    QCOMPARE(compressed.decompress(), image);
+
+    QDataStream truncatedStream { bytes.left(bytes.size() / 2) };
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, CompressedImage::read(truncatedStream));
+}
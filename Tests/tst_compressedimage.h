@@ -0,0 +1,17 @@
+#ifndef TST_COMPRESSEDIMAGE_H
+#define TST_COMPRESSEDIMAGE_H
+
+#include <QTest>
+
+class TestCompressedImage : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testArgbImageRoundtrip();
+    void testIndexedImageRoundtrip();
+    void testTotalSizesFollowLifetime();
+    void testSerializedImageRoundtrip();
+};
+
+
+#endif // TST_COMPRESSEDIMAGE_H
@@ -0,0 +1,87 @@
+#include "tst_differenceplane.h"
+
+#include <domain/valueobjects/differenceplane.h>
+
+namespace {
+
+QImage makeImage(int width, int height) {
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(qRgb(50, 60, 70));
+    return image;
+}
+
+} // namespace
+
+// Test: every pixel holds the maximum difference of its R, G and B channels
+void TestDifferencePlane::testMaxChannelDifference() {
+    QImage first = makeImage(7, 5);
+    QImage second = first.copy();
+    second.setPixel(2, 1, qRgb(55, 40, 72));
+    second.setPixel(6, 4, qRgb(50, 60, 255));
+
+    auto plane = DifferencePlane::build(first, second);
+    QCOMPARE(plane.size(), QSize(7, 5));
+    QCOMPARE(plane.constScanLine(1)[2], uchar(20));
+    QCOMPARE(plane.constScanLine(4)[6], uchar(185));
+    QCOMPARE(plane.constScanLine(0)[0], uchar(0));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, DifferencePlane::build(first, makeImage(7, 6)));
+}
+
+// Test: the rows that are identical according to the row map are not compared
+void TestDifferencePlane::testIdenticalRowsAreSkipped() {
+    QImage first = makeImage(7, 5);
+    QImage second = first.copy();
+    second.setPixel(3, 2, qRgb(0, 0, 0));
+    auto rowDifferences = RowDifferenceMap::build(first, second);
+
+    // The first image is changed after the map was built, so only the
+    // rows that the map reports as different can contain differences
+    first.setPixel(3, 0, qRgb(0, 0, 0));
+    auto plane = DifferencePlane::build(first, second, rowDifferences);
+    QCOMPARE(plane.constScanLine(0)[3], uchar(0));
+    QCOMPARE(plane.constScanLine(2)[3], uchar(70));
+}
+
+// Test: the histogram counts the pixels by difference and an area is mapped to a paletted image
+void TestDifferencePlane::testHistogramAndMap() {
+    QImage first = makeImage(4, 4);
+    QImage second = first.copy();
+    second.setPixel(1, 1, qRgb(60, 60, 70));
+    second.setPixel(2, 3, qRgb(60, 60, 70));
+
+    auto plane = DifferencePlane::build(first, second);
+    auto histogram = plane.getHistogram();
+    QCOMPARE(histogram[0], qint64(14));
+    QCOMPARE(histogram[10], qint64(2));
+
+    QList<QRgb> colorTable(256, qRgb(255, 0, 0));
+    colorTable[0] = qRgb(255, 255, 255);
+    QImage area = plane.map(colorTable, QRect(1, 1, 2, 3));
+    QCOMPARE(area.size(), QSize(2, 3));
+    QCOMPARE(area.format(), QImage::Format_Indexed8);
+    QCOMPARE(area.pixel(0, 0), qRgb(255, 0, 0));
+    QCOMPARE(area.pixel(1, 0), qRgb(255, 255, 255));
+    QCOMPARE(area.pixel(1, 2), qRgb(255, 0, 0));
+}
+
+// Test: the colors of transparent pixels are compared as they are, and so is the alpha channel
+void TestDifferencePlane::testAlphaChannelIsCompared() {
+    QImage first(3, 1, QImage::Format_ARGB32);
+    first.setPixel(0, 0, qRgba(200, 100, 50, 0));
+    first.setPixel(1, 0, qRgba(200, 100, 50, 128));
+    first.setPixel(2, 0, qRgba(200, 100, 50, 255));
+    QImage second = first.copy();
+    second.setPixel(0, 0, qRgba(10, 100, 50, 0));
+    second.setPixel(1, 0, qRgba(200, 100, 50, 28));
+
+    auto plane = DifferencePlane::build(first, second);
+    QCOMPARE(plane.constScanLine(0)[0], uchar(190));
+    QCOMPARE(plane.constScanLine(0)[1], uchar(100));
+    QCOMPARE(plane.constScanLine(0)[2], uchar(0));
+
+    // An opaque image is compared with a transparent one in a common format
+    QImage opaque = first.convertToFormat(QImage::Format_RGB32);
+    plane = DifferencePlane::build(opaque, first);
+    QCOMPARE(plane.constScanLine(0)[0], uchar(255));
+    QCOMPARE(plane.constScanLine(0)[2], uchar(0));
+}
@@ -0,0 +1,17 @@
+#ifndef TST_DIFFERENCEPLANE_H
+#define TST_DIFFERENCEPLANE_H
+
+#include <QTest>
+
+class TestDifferencePlane : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testMaxChannelDifference();
+    void testIdenticalRowsAreSkipped();
+    void testHistogramAndMap();
+    void testAlphaChannelIsCompared();
+};
+
+
+#endif // TST_DIFFERENCEPLANE_H
@@ -0,0 +1,85 @@
+#include "tst_differenceregionindex.h"
+
+#include <business/imageanalysis/differenceregionindex.h>
+
+namespace {
+
+QImage makeImage(int width, int height) {
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(qRgb(100, 100, 100));
+    return image;
+}
+
+} // namespace
+
+// Test: identical images do not differ anywhere
+void TestDifferenceRegionIndex::testIdenticalImagesHaveNoRegions() {
+    QImage image = makeImage(64, 32);
+    auto index = DifferenceRegionIndex::build(image, image.copy());
+    QVERIFY(index.isEmpty());
+    QCOMPARE(index.getDifferentPixelCount(), qint64(0));
+}
+
+// Test: diagonal neighbours are connected and the regions are sorted in reading order
+void TestDifferenceRegionIndex::testDiagonalPixelsFormOneRegion() {
+    QImage first = makeImage(100, 40);
+    QImage second = first.copy();
+    second.setPixel(10, 10, qRgb(110, 100, 100));
+    second.setPixel(11, 11, qRgb(100, 100, 103));
+    second.setPixel(50, 5, qRgb(100, 140, 100));
+
+    auto index = DifferenceRegionIndex::build(first, second);
+    QCOMPARE(index.size(), 2);
+    QCOMPARE(index.at(0).boundingRect, QRect(50, 5, 1, 1));
+    QCOMPARE(index.at(0).maxDifference, 40);
+    QCOMPARE(index.at(1).boundingRect, QRect(10, 10, 2, 2));
+    QCOMPARE(index.at(1).pixelCount, qint64(2));
+    QCOMPARE(index.at(1).maxDifference, 10);
+}
+
+// Test: a U-shaped region is labeled in different bands but merged into one
+void TestDifferenceRegionIndex::testRegionSpanningSeveralBands() {
+    QImage first = makeImage(30, 1000);
+    QImage second = first.copy();
+    for (int y = 0; y < second.height(); ++y) {
+        second.setPixel(3, y, qRgb(0, 0, 0));
+        second.setPixel(20, y, qRgb(0, 0, 0));
+    }
+    for (int x = 3; x <= 20; ++x) {
+        second.setPixel(x, 999, qRgb(0, 0, 0));
+    }
+
+    auto index = DifferenceRegionIndex::build(first, second);
+    QCOMPARE(index.size(), 1);
+    QCOMPARE(index.at(0).boundingRect, QRect(3, 0, 18, 1000));
+    QCOMPARE(index.at(0).pixelCount, qint64(2 * 1000 + 16));
+}
+
+// Test: only images of the same size can be compared
+void TestDifferenceRegionIndex::testDifferentSizesThrow() {
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error,
+                             DifferenceRegionIndex::build(makeImage(10, 10), makeImage(10, 11)));
+}
+
+// Test: a canceled build stops and returns an empty index
+void TestDifferenceRegionIndex::testCanceledBuildIsEmpty() {
+    QImage first = makeImage(64, 256);
+    QImage second = first.copy();
+    second.setPixel(3, 200, qRgb(0, 0, 0));
+
+    auto index = DifferenceRegionIndex::build(first, second, []() { return true; });
+    QVERIFY(index.isEmpty());
+    QCOMPARE(DifferenceRegionIndex::build(first, second, []() { return false; }).size(), 1);
+}
+
+// Test: Format_RGB32 and opaque Format_ARGB32 pixels are compared without a conversion
+void TestDifferenceRegionIndex::testRgb32ComparedWithArgb32() {
+    QImage first = makeImage(40, 30);
+    QImage second = first.convertToFormat(QImage::Format_ARGB32);
+    QVERIFY(DifferenceRegionIndex::build(first, second).isEmpty());
+
+    second.setPixel(7, 9, qRgb(100, 100, 90));
+    auto index = DifferenceRegionIndex::build(first, second);
+    QCOMPARE(index.size(), 1);
+    QCOMPARE(index.at(0).boundingRect, QRect(7, 9, 1, 1));
+}
@@ -0,0 +1,19 @@
+#ifndef TST_DIFFERENCEREGIONINDEX_H
+#define TST_DIFFERENCEREGIONINDEX_H
+
+#include <QTest>
+
+class TestDifferenceRegionIndex : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIdenticalImagesHaveNoRegions();
+    void testDiagonalPixelsFormOneRegion();
+    void testRegionSpanningSeveralBands();
+    void testDifferentSizesThrow();
+    void testCanceledBuildIsEmpty();
+    void testRgb32ComparedWithArgb32();
+};
+
+
+#endif // TST_DIFFERENCEREGIONINDEX_H
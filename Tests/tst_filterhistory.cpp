@@ -0,0 +1,107 @@
+#include "tst_filterhistory.h"
+
+#include <business/imageanalysis/filterhistory.h>
+#include <business/imageanalysis/filters/filterpipeline.h>
+#include <business/imageanalysis/filters/grayscalefilter.h>
+#include <business/imageanalysis/filters/rgbfilter.h>
+
+namespace {
+
+QImage makeImage(int width, int height, int seed) {
+    QImage image(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixel(x, y, qRgb((x * 7 + seed) % 256, (y * 13) % 256, (x + y + seed) % 256));
+        }
+    }
+    return image;
+}
+
+QImage applyFilters(const QList<AppliedFilter> &filters, const QImage &image) {
+    return FilterHistory::createPipeline(filters).apply(image);
+}
+
+} // namespace
+
+// Test: with a tiny budget only the current state is stored, the others are recomputed from the originals
+void TestFilterHistory::testEvictedStatesAreRecomputed() {
+    QImage first = makeImage(64, 48, 1);
+    QImage second = makeImage(64, 48, 2);
+    QList<AppliedFilter> redFilter = { { std::make_shared<RedChannelFilter>(), {} } };
+    QList<AppliedFilter> grayscaleFilter = { { std::make_shared<GrayscaleFilter>(), {} } };
+    QImage firstRed = applyFilters(redFilter, first);
+    QImage firstGray = applyFilters(grayscaleFilter, firstRed);
+
+    FilterHistory history { 1 };
+    history.reset(first, second);
+    history.push(redFilter, firstRed, applyFilters(redFilter, second));
+    history.push(grayscaleFilter, firstGray, applyFilters(grayscaleFilter, applyFilters(redFilter, second)));
+    QVERIFY(history.getMemoryUsage() <= 2 * firstGray.sizeInBytes());
+
+    auto images = history.undo();
+    QCOMPARE(images.firstImage, firstRed);
+    QCOMPARE(history.undo().firstImage, first);
+    QVERIFY(!history.canUndo());
+
+    history.redo();
+    images = history.redo();
+    QCOMPARE(images.firstImage, firstGray);
+    QCOMPARE(images.secondImage, applyFilters(grayscaleFilter, applyFilters(redFilter, second)));
+    QVERIFY(!history.canRedo());
+}
+
+// Test: the far states are compressed under the budget and restored exactly
+void TestFilterHistory::testCompressedStatesAreRestored() {
+    QImage image = makeImage(64, 64, 3);
+    QList<AppliedFilter> greenFilter = { { std::make_shared<GreenChannelFilter>(), {} } };
+    QList<AppliedFilter> grayscaleFilter = { { std::make_shared<GrayscaleFilter>(), {} } };
+    QImage greenImage = applyFilters(greenFilter, image);
+    QImage grayImage = applyFilters(grayscaleFilter, greenImage);
+    QImage blueImage = applyFilters({ { std::make_shared<BlueChannelFilter>(), {} } }, grayImage);
+
+    // The decoded states may take a half of the budget, i.e. only the current one
+    FilterHistory history { 3 * image.sizeInBytes() };
+    history.reset(image);
+    history.push(greenFilter, greenImage);
+    history.push(grayscaleFilter, grayImage);
+    history.push({ { std::make_shared<BlueChannelFilter>(), {} } }, blueImage);
+    QVERIFY(history.getMemoryUsage() <= history.getMemoryBudget());
+    QVERIFY(history.getMemoryUsage() < 3 * image.sizeInBytes());
+
+    QCOMPARE(history.moveTo(1).firstImage, greenImage);
+    QCOMPARE(history.moveTo(2).firstImage, grayImage);
+    QCOMPARE(history.moveTo(3).firstImage, blueImage);
+    QVERIFY(history.getMemoryUsage() <= history.getMemoryBudget());
+}
+
+// Test: a new step after an undo replaces the steps that could be redone
+void TestFilterHistory::testPushDropsRedoStates() {
+    QImage image = makeImage(16, 16, 4);
+    QList<AppliedFilter> redFilter = { { std::make_shared<RedChannelFilter>(), {} } };
+    QList<AppliedFilter> blueFilter = { { std::make_shared<BlueChannelFilter>(), {} } };
+
+    FilterHistory history;
+    history.reset(image);
+    history.push(redFilter, applyFilters(redFilter, image));
+    history.push(redFilter, applyFilters(redFilter, image));
+    history.undo();
+    history.push(blueFilter, applyFilters(blueFilter, applyFilters(redFilter, image)));
+    QCOMPARE(history.size(), 3);
+    QCOMPARE(history.getCurrentStep(), 2);
+    QVERIFY(!history.canRedo());
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, history.moveTo(3));
+}
+
+// Test: recomputing a state with the properties it was applied with does not change the filter itself
+void TestFilterHistory::testReplayDoesNotChangeFilters() {
+    QImage image = makeImage(32, 24, 3);
+    auto redFilter = std::make_shared<RedChannelFilter>();
+    Property grayscaleMode = Property::createAlternativesProperty("Color mode", "", { "Colored", "Grayscale" }, 1);
+    redFilter->setProperties({ grayscaleMode });
+    QImage grayscaleRed = redFilter->filter(image);
+
+    // The state was applied with the default (colored) mode
+    QImage coloredRed = applyFilters({ { redFilter, {} } }, image);
+    QVERIFY(coloredRed != grayscaleRed);
+    QCOMPARE(redFilter->filter(image), grayscaleRed);
+}
@@ -0,0 +1,17 @@
+#ifndef TST_FILTERHISTORY_H
+#define TST_FILTERHISTORY_H
+
+#include <QTest>
+
+class TestFilterHistory : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEvictedStatesAreRecomputed();
+    void testCompressedStatesAreRestored();
+    void testPushDropsRedoStates();
+    void testReplayDoesNotChangeFilters();
+};
+
+
+#endif // TST_FILTERHISTORY_H
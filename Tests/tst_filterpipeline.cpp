@@ -0,0 +1,90 @@
+#include "tst_filterpipeline.h"
+
+#include <business/imageanalysis/filters/filterpipeline.h>
+#include <business/imageanalysis/filters/grayscalefilter.h>
+#include <business/imageanalysis/filters/rgbfilter.h>
+
+namespace {
+
+// A filter that is not per-pixel, i.e. it can only be applied to a whole image
+class InvertFilter : public IFilter {
+public:
+    QString getShortName() const override { return "Invert"; }
+    QString getHotkey() const override { return ""; }
+    QString getDescription() const override { return ""; }
+    QString getFullName() const override { return "Invert"; }
+
+    QImage filter(const QImage &image) override {
+        QImage result = image.convertToFormat(QImage::Format_ARGB32);
+        result.invertPixels();
+        return result;
+    }
+
+    std::shared_ptr<IImageProcessor> clone() const override { return std::make_shared<InvertFilter>(*this); }
+};
+
+QImage makeImage(int width, int height) {
+    QImage image(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixel(x, y, qRgba(x * 37 % 256, y * 53 % 256, (x + y) * 11 % 256, 255));
+        }
+    }
+    return image;
+}
+
+void compareImages(const QImage &actual, const QImage &expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (int y = 0; y < expected.height(); ++y) {
+        for (int x = 0; x < expected.width(); ++x) {
+            QCOMPARE(actual.pixel(x, y), expected.pixel(x, y));
+        }
+    }
+}
+
+} // namespace
+
+// Test: a fused chain of per-pixel filters gives the same image as applying the filters one by one
+void TestFilterPipeline::testFusedFiltersMatchSequentialFilters() {
+    QImage image = makeImage(300, 7);
+    auto redFilter = std::make_shared<RedChannelFilter>();
+    auto grayscaleFilter = std::make_shared<GrayscaleFilter>();
+
+    QImage expected = grayscaleFilter->filter(redFilter->filter(image));
+    FilterPipeline pipeline { { redFilter, grayscaleFilter } };
+    QVERIFY(pipeline.isPerPixel());
+    compareImages(pipeline.apply(image), expected);
+
+    // The grayscale mode of a channel filter is fused as well
+    redFilter->setProperties({ Property::createAlternativesProperty("Color mode", "", { "Colored", "Grayscale" }, 1) });
+    expected = redFilter->filter(image);
+    compareImages(FilterPipeline { { redFilter } }.apply(image), expected);
+}
+
+// Test: a filter that is not per-pixel is applied to the whole image between the fused stages
+void TestFilterPipeline::testWholeImageFilterSplitsTheChain() {
+    QImage image = makeImage(40, 9);
+    auto greenFilter = std::make_shared<GreenChannelFilter>();
+    auto invertFilter = std::make_shared<InvertFilter>();
+    auto grayscaleFilter = std::make_shared<GrayscaleFilter>();
+
+    QImage expected = grayscaleFilter->filter(invertFilter->filter(greenFilter->filter(image)));
+    FilterPipeline pipeline { { greenFilter, invertFilter, grayscaleFilter } };
+    QVERIFY(!pipeline.isPerPixel());
+    compareImages(pipeline.apply(image), expected);
+    QVERIFY(FilterPipeline { {} }.isEmpty());
+}
+
+// Test: the rows of an RGB32 image that is not shared are filtered in its own buffer
+void TestFilterPipeline::testRgb32IsFilteredInPlace() {
+    QImage image = makeImage(64, 5).convertToFormat(QImage::Format_RGB32);
+    auto blueFilter = std::make_shared<BlueChannelFilter>();
+    auto grayscaleFilter = std::make_shared<GrayscaleFilter>();
+    QImage expected = grayscaleFilter->filter(blueFilter->filter(image));
+
+    const uchar *bits = image.constBits();
+    QImage result = FilterPipeline { { blueFilter, grayscaleFilter } }.apply(std::move(image));
+    QCOMPARE(result.format(), QImage::Format_RGB32);
+    QCOMPARE(result.constBits(), bits);
+    compareImages(result, expected);
+}
@@ -0,0 +1,16 @@
+#ifndef TST_FILTERPIPELINE_H
+#define TST_FILTERPIPELINE_H
+
+#include <QTest>
+
+class TestFilterPipeline : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFusedFiltersMatchSequentialFilters();
+    void testWholeImageFilterSplitsTheChain();
+    void testRgb32IsFilteredInPlace();
+};
+
+
+#endif // TST_FILTERPIPELINE_H
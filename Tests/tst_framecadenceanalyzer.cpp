@@ -0,0 +1,74 @@
+#include "tst_framecadenceanalyzer.h"
+
+#include <business/videoanalysis/framecadenceanalyzer.h>
+
+namespace {
+
+const double frameRate = 50.0;
+const qint64 frameIntervalUs = 20000;
+
+// A gradient that moves by one step per frame, like a slow pan
+FrameFingerprint makeFrame(int index, int contentStep) {
+    FrameFingerprint frame;
+    frame.positionMs = index * 20 + 10;
+    frame.startTime = index * frameIntervalUs;
+    frame.hash = static_cast<quint64>(contentStep) + 1;
+    for (int i = 0; i < 64; ++i) {
+        frame.thumbnail.push_back(static_cast<quint8>(i * 2 + contentStep));
+    }
+    return frame;
+}
+
+std::vector<FrameFingerprint> makeVideo(int length) {
+    std::vector<FrameFingerprint> frames;
+    for (int i = 0; i < length; ++i) {
+        frames.push_back(makeFrame(i, i));
+    }
+    return frames;
+}
+
+} // namespace
+
+// Test: a video with a steady cadence does not produce any events
+void TestFrameCadenceAnalyzer::testSmoothVideoHasNoEvents() {
+    auto events = FrameCadenceAnalyzer::analyze(makeVideo(40), frameRate);
+    QVERIFY(events.isEmpty());
+}
+
+// Test: a frame with the same content as the previous one is a duplicate
+void TestFrameCadenceAnalyzer::testDetectsDuplicatedFrame() {
+    auto frames = makeVideo(40);
+    frames[20] = makeFrame(20, 19);
+
+    auto events = FrameCadenceAnalyzer::analyze(frames, frameRate);
+    QVERIFY(!events.isEmpty());
+    QVERIFY(events.first().type == FrameCadenceEventType::DuplicatedFrame);
+    QCOMPARE(events.first().frameIndex, 20);
+}
+
+// Test: the content jumps over several frames
+void TestFrameCadenceAnalyzer::testDetectsDroppedFrames() {
+    auto frames = makeVideo(40);
+    for (int i = 20; i < 40; ++i) {
+        frames[i] = makeFrame(i, i + 3);
+    }
+
+    auto events = FrameCadenceAnalyzer::analyze(frames, frameRate);
+    QCOMPARE(events.size(), 1);
+    QVERIFY(events.first().type == FrameCadenceEventType::DroppedFrames);
+    QCOMPARE(events.first().frameIndex, 20);
+}
+
+// Test: a repeated timestamp is reported as a gap in the stream, not as a duplicate
+void TestFrameCadenceAnalyzer::testDetectsTimestampGap() {
+    auto frames = makeVideo(40);
+    frames[10] = frames[9];
+
+    auto events = FrameCadenceAnalyzer::analyze(frames, frameRate);
+    QVERIFY(!events.isEmpty());
+    QVERIFY(events.first().type == FrameCadenceEventType::TimestampIrregularity);
+    QCOMPARE(events.first().frameIndex, 10);
+    foreach (auto event, events) {
+        QVERIFY(event.type != FrameCadenceEventType::DuplicatedFrame);
+    }
+}
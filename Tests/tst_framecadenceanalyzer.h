@@ -0,0 +1,17 @@
+#ifndef TST_FRAMECADENCEANALYZER_H
+#define TST_FRAMECADENCEANALYZER_H
+
+#include <QTest>
+
+class TestFrameCadenceAnalyzer : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSmoothVideoHasNoEvents();
+    void testDetectsDuplicatedFrame();
+    void testDetectsDroppedFrames();
+    void testDetectsTimestampGap();
+};
+
+
+#endif // TST_FRAMECADENCEANALYZER_H
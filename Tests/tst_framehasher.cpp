@@ -0,0 +1,95 @@
+#include "tst_framehasher.h"
+
+#include <business/videoanalysis/framehasher.h>
+
+namespace {
+
+QImage makeImage(int width = 16, int height = 12) {
+    QImage image(width, height, QImage::Format_RGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixel(x, y, qRgb(x * 10, y * 10, 100));
+        }
+    }
+    return image;
+}
+
+DecodedVideoFrame makeFrame(const QImage &image) {
+    DecodedVideoFrame frame { 0, 0, image };
+    FrameHasher::hash(frame);
+    return frame;
+}
+
+} // namespace
+
+// Test: equal frames have equal hashes and no different row
+void TestFrameHasher::testIdenticalFrames() {
+    DecodedVideoFrame first = makeFrame(makeImage());
+    DecodedVideoFrame second = makeFrame(makeImage());
+
+    QCOMPARE(first.rowHashes.size(), size_t(12));
+    QVERIFY(first.rowHashes == second.rowHashes);
+    QCOMPARE(first.frameHash, second.frameHash);
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), -1);
+}
+
+// Test: the first row with a different pixel is reported
+void TestFrameHasher::testFindsFirstDifferentRow() {
+    QImage image = makeImage();
+    image.setPixel(3, 9, qRgb(0, 0, 0));
+    image.setPixel(15, 5, qRgb(0, 0, 0));
+    DecodedVideoFrame first = makeFrame(makeImage());
+    DecodedVideoFrame second = makeFrame(image);
+
+    QVERIFY(first.frameHash != second.frameHash);
+    QVERIFY(first.rowHashes[5] != second.rowHashes[5]);
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), 5);
+}
+
+// Test: equal hashes of rows with different pixels do not hide the difference
+void TestFrameHasher::testHashCollisionIsConfirmedByPixels() {
+    QImage image = makeImage();
+    image.setPixel(7, 7, qRgb(255, 255, 255));
+    DecodedVideoFrame first = makeFrame(makeImage());
+    DecodedVideoFrame second = makeFrame(image);
+
+    // Simulates a collision of all the row hashes
+    second.rowHashes = first.rowHashes;
+    second.frameHash = first.frameHash;
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), 7);
+}
+
+// Test: frames of different sizes differ in the first row
+void TestFrameHasher::testDifferentSizes() {
+    DecodedVideoFrame first = makeFrame(makeImage(16, 12));
+    DecodedVideoFrame second = makeFrame(makeImage(16, 10));
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), 0);
+}
+
+// Test: frames in different formats are compared by their pixels
+void TestFrameHasher::testDifferentFormats() {
+    DecodedVideoFrame first = makeFrame(makeImage());
+    DecodedVideoFrame second = makeFrame(makeImage().convertToFormat(QImage::Format_ARGB32));
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), -1);
+
+    QImage image = makeImage().convertToFormat(QImage::Format_ARGB32);
+    image.setPixel(0, 4, qRgb(0, 0, 0));
+    second = makeFrame(image);
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), 4);
+}
+
+// Test: the last pixel of a 1-bit row shares its byte with the padding, and is still compared
+void TestFrameHasher::testPartialLastByteIsCompared() {
+    QImage image(9, 4, QImage::Format_Mono);
+    image.setColorTable({ qRgb(0, 0, 0), qRgb(255, 255, 255) });
+    image.fill(0);
+    QImage changedImage = image.copy();
+    changedImage.setPixel(8, 2, 1);
+
+    DecodedVideoFrame first = makeFrame(image);
+    DecodedVideoFrame second = makeFrame(changedImage);
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), 2);
+
+    second.rowHashes = first.rowHashes;
+    QCOMPARE(FrameHasher::findFirstDifferentRow(first, second), 2);
+}
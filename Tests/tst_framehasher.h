@@ -0,0 +1,19 @@
+#ifndef TST_FRAMEHASHER_H
+#define TST_FRAMEHASHER_H
+
+#include <QTest>
+
+class TestFrameHasher : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIdenticalFrames();
+    void testFindsFirstDifferentRow();
+    void testHashCollisionIsConfirmedByPixels();
+    void testDifferentSizes();
+    void testDifferentFormats();
+    void testPartialLastByteIsCompared();
+};
+
+
+#endif // TST_FRAMEHASHER_H
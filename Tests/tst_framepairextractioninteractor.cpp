@@ -0,0 +1,48 @@
+#include "tst_framepairextractioninteractor.h"
+
+#include <business/videoanalysis/framepairextractioninteractor.h>
+
+// Test: "ss[.zzz]" is a number of seconds
+void TestFramePairExtractionInteractor::testParsesSeconds() {
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("12"), QList<qint64>({ 12000 }));
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("05.250"), QList<qint64>({ 5250 }));
+}
+
+// Test: "mm:ss[.zzz]"; the leading field may exceed 59
+void TestFramePairExtractionInteractor::testParsesMinutesAndSeconds() {
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("01:30"), QList<qint64>({ 90000 }));
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("2:05.5"), QList<qint64>({ 125500 }));
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("90:00"), QList<qint64>({ 5400000 }));
+}
+
+// Test: "hh:mm:ss[.zzz]"
+void TestFramePairExtractionInteractor::testParsesHoursMinutesAndSeconds() {
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("01:02:03"), QList<qint64>({ 3723000 }));
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("00:00:59.999"), QList<qint64>({ 59999 }));
+}
+
+// Test: commas, semicolons, spaces and new lines separate the timestamps in any combination
+void TestFramePairExtractionInteractor::testParsesMixedSeparators() {
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps("1, 2;3\n00:04 \t 5.5,\n"),
+             QList<qint64>({ 1000, 2000, 3000, 4000, 5500 }));
+    QCOMPARE(FramePairExtractionInteractor::parseTimestamps(" ,; \n"), QList<qint64>());
+}
+
+// Test: the minutes and seconds after the leading field must be below 60
+void TestFramePairExtractionInteractor::testRejectsFieldsOutOfRange() {
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, FramePairExtractionInteractor::parseTimestamps("01:60"));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, FramePairExtractionInteractor::parseTimestamps("00:75:00"));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, FramePairExtractionInteractor::parseTimestamps("1:00:60.5"));
+}
+
+// Test: at most three fields are allowed
+void TestFramePairExtractionInteractor::testRejectsFourFields() {
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, FramePairExtractionInteractor::parseTimestamps("1:02:03:04"));
+}
+
+// Test: negative values are not timestamps
+void TestFramePairExtractionInteractor::testRejectsNegativeValues() {
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, FramePairExtractionInteractor::parseTimestamps("-5"));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, FramePairExtractionInteractor::parseTimestamps("01:-05"));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, FramePairExtractionInteractor::parseTimestamps("10, -1"));
+}
@@ -0,0 +1,20 @@
+#ifndef TST_FRAMEPAIREXTRACTIONINTERACTOR_H
+#define TST_FRAMEPAIREXTRACTIONINTERACTOR_H
+
+#include <QTest>
+
+class TestFramePairExtractionInteractor : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testParsesSeconds();
+    void testParsesMinutesAndSeconds();
+    void testParsesHoursMinutesAndSeconds();
+    void testParsesMixedSeparators();
+    void testRejectsFieldsOutOfRange();
+    void testRejectsFourFields();
+    void testRejectsNegativeValues();
+};
+
+
+#endif // TST_FRAMEPAIREXTRACTIONINTERACTOR_H
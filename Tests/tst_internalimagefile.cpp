@@ -0,0 +1,130 @@
+#include "tst_internalimagefile.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QTemporaryDir>
+#include <data/storage/internalimagefile.h>
+
+namespace {
+
+const quint32 Magic = 0x54575058; // "TWPX"
+const quint32 Version = 1;
+
+QImage makeImage() {
+    QImage image(97, 61, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.setPixel(x, y, qRgba(x * 2, y * 4, (x + y) % 256, 255 - x));
+        }
+    }
+    return image;
+}
+
+QByteArray readFile(const QString &filePath) {
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void writeFile(const QString &filePath, const QByteArray &bytes) {
+    QFile file { filePath };
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(bytes);
+    }
+}
+
+// A valid file whose header is replaced by the given magic and version
+QByteArray makeFileWithHeader(const QString &filePath, quint32 magic, quint32 version) {
+    InternalImageFile::save(makeImage(), filePath);
+    QByteArray header;
+    {
+        QDataStream stream { &header, QIODevice::WriteOnly };
+        stream << magic << version;
+    }
+    return header + readFile(filePath).mid(header.size());
+}
+
+} // namespace
+
+// Test: a saved image is loaded back unchanged and is recognized by its header
+void TestInternalImageFile::testRoundtrip() {
+    QTemporaryDir directory;
+    QString filePath = directory.filePath("image.twpx");
+    QImage image = makeImage();
+
+    QVERIFY(InternalImageFile::save(image, filePath));
+    QVERIFY(InternalImageFile::isInternalImageFile(filePath));
+    QCOMPARE(InternalImageFile::load(filePath), image);
+
+    QString pngPath = directory.filePath("image.png");
+    QVERIFY(image.save(pngPath));
+    QVERIFY(!InternalImageFile::isInternalImageFile(pngPath));
+    QVERIFY(!InternalImageFile::save(QImage(), filePath));
+}
+
+// Test: a file with another magic number is neither recognized nor loaded
+void TestInternalImageFile::testBadMagicIsRejected() {
+    QTemporaryDir directory;
+    QString filePath = directory.filePath("image.twpx");
+    writeFile(filePath, makeFileWithHeader(filePath, Magic + 1, Version));
+
+    QVERIFY(!InternalImageFile::isInternalImageFile(filePath));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, InternalImageFile::load(filePath));
+}
+
+// Test: a file of another version is recognized but not loaded
+void TestInternalImageFile::testWrongVersionIsRejected() {
+    QTemporaryDir directory;
+    QString filePath = directory.filePath("image.twpx");
+    writeFile(filePath, makeFileWithHeader(filePath, Magic, Version + 1));
+
+    QVERIFY(InternalImageFile::isInternalImageFile(filePath));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, InternalImageFile::load(filePath));
+}
+
+// Test: a file cut off in the header or in the payload is not loaded
+void TestInternalImageFile::testTruncatedPayloadIsRejected() {
+    QTemporaryDir directory;
+    QString filePath = directory.filePath("image.twpx");
+    QVERIFY(InternalImageFile::save(makeImage(), filePath));
+    QByteArray bytes = readFile(filePath);
+
+    writeFile(filePath, bytes.left(bytes.size() / 2));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, InternalImageFile::load(filePath));
+
+    writeFile(filePath, bytes.left(6));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, InternalImageFile::load(filePath));
+}
+
+// Test: an invalid image description or an empty image in the payload is not loaded
+void TestInternalImageFile::testCorruptPayloadIsRejected() {
+    QTemporaryDir directory;
+    QString filePath = directory.filePath("image.twpx");
+    QVERIFY(InternalImageFile::save(makeImage(), filePath));
+    QByteArray bytes = readFile(filePath);
+
+    // The payload starts with the size of the image; a negative width is invalid
+    QByteArray corrupted = bytes;
+    corrupted.replace(8, 4, QByteArray(4, '\xFF'));
+    writeFile(filePath, corrupted);
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, InternalImageFile::load(filePath));
+
+    QByteArray emptyImage;
+    {
+        QDataStream stream { &emptyImage, QIODevice::WriteOnly };
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << Magic << Version << QSize() << qint32(QImage::Format_Invalid);
+    }
+    writeFile(filePath, emptyImage);
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, InternalImageFile::load(filePath));
+}
+
+// Test: a file that does not exist is not loaded
+void TestInternalImageFile::testMissingFileIsRejected() {
+    QTemporaryDir directory;
+    QString filePath = directory.filePath("missing.twpx");
+    QVERIFY(!InternalImageFile::isInternalImageFile(filePath));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, InternalImageFile::load(filePath));
+}
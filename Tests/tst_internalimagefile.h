@@ -0,0 +1,19 @@
+#ifndef TST_INTERNALIMAGEFILE_H
+#define TST_INTERNALIMAGEFILE_H
+
+#include <QTest>
+
+class TestInternalImageFile : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundtrip();
+    void testBadMagicIsRejected();
+    void testWrongVersionIsRejected();
+    void testTruncatedPayloadIsRejected();
+    void testCorruptPayloadIsRejected();
+    void testMissingFileIsRejected();
+};
+
+
+#endif // TST_INTERNALIMAGEFILE_H
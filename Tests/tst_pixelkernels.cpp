@@ -0,0 +1,138 @@
+#include "tst_pixelkernels.h"
+
+#include <QRandomGenerator>
+#include <vector>
+#include <domain/kernels/pixelkernels.h>
+
+namespace {
+
+// The length is not a multiple of any vector size, so the tails are tested too
+constexpr int mPixelCount = 4096 + 61;
+
+std::vector<QRgb> makePixels(quint32 seed) {
+    QRandomGenerator generator { seed };
+    std::vector<QRgb> pixels(mPixelCount);
+    for (auto &pixel : pixels) {
+        pixel = generator.generate();
+    }
+    return pixels;
+}
+
+struct KernelResults {
+    std::vector<uchar> maxChannelDifference;
+    std::vector<uchar> grayscale;
+    std::vector<uchar> luminance;
+    std::vector<uchar> channels[4];
+    quint64 sum = 0;
+    quint64 sumOfSquares = 0;
+    std::vector<quint64> histogram;
+};
+
+KernelResults runKernels(const std::vector<QRgb> &first, const std::vector<QRgb> &second) {
+    KernelResults results;
+    results.maxChannelDifference.resize(first.size());
+    PixelKernels::maxChannelDifference(first.data(), second.data(), results.maxChannelDifference.data(), mPixelCount);
+    results.grayscale.resize(first.size());
+    PixelKernels::grayscale(first.data(), results.grayscale.data(), mPixelCount);
+    results.luminance.resize(first.size());
+    PixelKernels::luminance(first.data(), results.luminance.data(), mPixelCount);
+    for (int channel = 0; channel < 4; ++channel) {
+        results.channels[channel].resize(first.size());
+        PixelKernels::extractChannel(first.data(), results.channels[channel].data(), mPixelCount, channel * 8);
+    }
+    // An odd offset checks unaligned loads
+    results.sum = PixelKernels::sum(results.luminance.data() + 1, mPixelCount - 1);
+    results.sumOfSquares = PixelKernels::sumOfSquares(results.luminance.data() + 1, mPixelCount - 1);
+    results.histogram.resize(256, 0);
+    PixelKernels::histogram(results.maxChannelDifference.data(), mPixelCount, results.histogram.data());
+    return results;
+}
+
+} // namespace
+
+// Test: every vectorized implementation returns exactly the same results as the scalar one
+void TestPixelKernels::testIsasMatchScalarImplementation() {
+    auto first = makePixels(1);
+    auto second = makePixels(2);
+    PixelKernels::setActiveIsa(KernelIsa::Scalar);
+    KernelResults expected = runKernels(first, second);
+
+    foreach (auto isa, PixelKernels::getSupportedIsas()) {
+        PixelKernels::setActiveIsa(isa);
+        KernelResults actual = runKernels(first, second);
+        QByteArray isaName = PixelKernels::getIsaName(isa).toUtf8();
+        QVERIFY2(actual.maxChannelDifference == expected.maxChannelDifference, isaName);
+        QVERIFY2(actual.grayscale == expected.grayscale, isaName);
+        QVERIFY2(actual.luminance == expected.luminance, isaName);
+        for (int channel = 0; channel < 4; ++channel) {
+            QVERIFY2(actual.channels[channel] == expected.channels[channel], isaName);
+        }
+        QCOMPARE(actual.sum, expected.sum);
+        QCOMPARE(actual.sumOfSquares, expected.sumOfSquares);
+        QVERIFY2(actual.histogram == expected.histogram, isaName);
+    }
+}
+
+// Test: the primitives match the formulas of Qt
+void TestPixelKernels::testKnownValues() {
+    std::vector<QRgb> first { qRgb(10, 200, 30), qRgba(255, 255, 255, 0) };
+    std::vector<QRgb> second { qRgb(20, 150, 35), qRgba(255, 255, 255, 255) };
+    uchar result[2];
+
+    PixelKernels::maxChannelDifference(first.data(), second.data(), result, 2);
+    QCOMPARE(result[0], uchar(50));
+    QCOMPARE(result[1], uchar(0)); // the alpha channel is ignored
+
+    PixelKernels::grayscale(first.data(), result, 1);
+    QCOMPARE(result[0], uchar(qGray(first[0])));
+
+    PixelKernels::luminance(first.data(), result, 1);
+    QCOMPARE(result[0], uchar(qRound(0.2126 * 10 + 0.7152 * 200 + 0.0722 * 30)));
+
+    uchar values[] = { 1, 2, 3, 255 };
+    QCOMPARE(PixelKernels::sum(values, 4), quint64(261));
+    QCOMPARE(PixelKernels::sumOfSquares(values, 4), quint64(1 + 4 + 9 + 255 * 255));
+}
+
+void TestPixelKernels::benchmarkKernels_data() {
+    QTest::addColumn<int>("isa");
+    foreach (auto isa, PixelKernels::getSupportedIsas()) {
+        QTest::newRow(PixelKernels::getIsaName(isa).toUtf8().constData()) << static_cast<int>(isa);
+    }
+}
+
+// The difference plane of a 4K pair of images and the statistics of the plane
+void TestPixelKernels::benchmarkKernels() {
+    QFETCH(int, isa);
+    PixelKernels::setActiveIsa(static_cast<KernelIsa>(isa));
+
+    const int width = 3840;
+    const int height = 2160;
+    QImage first { width, height, QImage::Format_ARGB32 };
+    first.fill(qRgb(90, 120, 150));
+    QImage second = first.copy();
+    for (int i = 0; i < width * height; i += 7) {
+        second.setPixel(i % width, i / width, qRgb(i % 255, 30, 60));
+    }
+    std::vector<uchar> plane(width);
+    std::vector<quint64> histogram(256, 0);
+    quint64 total = 0;
+
+    QBENCHMARK {
+        for (int y = 0; y < height; ++y) {
+            PixelKernels::maxChannelDifference(reinterpret_cast<const QRgb*>(first.constScanLine(y)),
+                                               reinterpret_cast<const QRgb*>(second.constScanLine(y)),
+                                               plane.data(),
+                                               width
+                                               );
+            PixelKernels::histogram(plane.data(), width, histogram.data());
+            total += PixelKernels::sum(plane.data(), width) + PixelKernels::sumOfSquares(plane.data(), width);
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void TestPixelKernels::cleanup() {
+    // The other tests use the best implementation
+    PixelKernels::setActiveIsa(PixelKernels::getSupportedIsas().last());
+}
@@ -0,0 +1,21 @@
+#ifndef TST_PIXELKERNELS_H
+#define TST_PIXELKERNELS_H
+
+#include <QTest>
+
+class TestPixelKernels : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIsasMatchScalarImplementation();
+    void testKnownValues();
+
+    // Reports the throughput of every ISA supported by this CPU, run with -iterations N
+    void benchmarkKernels_data();
+    void benchmarkKernels();
+
+    void cleanup();
+};
+
+
+#endif // TST_PIXELKERNELS_H
@@ -0,0 +1,98 @@
+#include "tst_rowdifferencemap.h"
+
+#include <domain/valueobjects/rowdifferencemap.h>
+
+namespace {
+
+QImage makeImage(int width, int height) {
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(qRgb(50, 60, 70));
+    return image;
+}
+
+} // namespace
+
+// Test: identical images are recognized even if they are stored in different formats
+void TestRowDifferenceMap::testIdenticalImages() {
+    QImage first = makeImage(33, 20);
+    QImage second = first.convertToFormat(QImage::Format_ARGB32);
+
+    auto map = RowDifferenceMap::build(first, second);
+    QVERIFY(map.isKnown());
+    QVERIFY(map.isIdentical());
+    QCOMPARE(map.getDifferentRowCount(), 0);
+    QVERIFY(!map.isRowDifferent(5));
+}
+
+// Test: consecutive differing rows are merged into ranges
+void TestRowDifferenceMap::testDifferentRowRanges() {
+    QImage first = makeImage(33, 20);
+    QImage second = first.copy();
+    second.setPixel(32, 3, qRgb(0, 0, 0));
+    second.setPixel(0, 4, qRgb(0, 0, 0));
+    second.setPixel(7, 10, qRgb(0, 0, 0));
+
+    auto map = RowDifferenceMap::build(first, second);
+    QVERIFY(!map.isIdentical());
+    QCOMPARE(map.getDifferentRowCount(), 3);
+    QCOMPARE(map.getDifferentRowRanges(), (QList<QPair<int, int>> { { 3, 4 }, { 10, 10 } }));
+    QVERIFY(map.isRowDifferent(10));
+    QVERIFY(!map.isRowDifferent(11));
+}
+
+// Test: without a map every row has to be compared
+void TestRowDifferenceMap::testDifferentSizesAreUnknown() {
+    auto map = RowDifferenceMap::build(makeImage(10, 10), makeImage(10, 11));
+    QVERIFY(!map.isKnown());
+    QVERIFY(!map.isIdentical());
+    QVERIFY(map.isRowDifferent(0));
+}
+
+// Test: the rows of a part of the images are renumbered from its top
+void TestRowDifferenceMap::testMid() {
+    QImage first = makeImage(33, 20);
+    QImage second = first.copy();
+    second.setPixel(0, 3, qRgb(0, 0, 0));
+    second.setPixel(0, 4, qRgb(0, 0, 0));
+    second.setPixel(0, 10, qRgb(0, 0, 0));
+
+    auto map = RowDifferenceMap::build(first, second).mid(4, 8);
+    QVERIFY(map.isKnown());
+    QCOMPARE(map.getHeight(), 8);
+    QCOMPARE(map.getDifferentRowCount(), 2);
+    QCOMPARE(map.getDifferentRowRanges(), (QList<QPair<int, int>> { { 0, 0 }, { 6, 6 } }));
+    QVERIFY(map.isRowDifferent(6));
+    QVERIFY(!map.isRowDifferent(7));
+
+    QVERIFY(RowDifferenceMap::build(first, first).mid(4, 8).isIdentical());
+    QVERIFY(!RowDifferenceMap().mid(4, 8).isKnown());
+}
+
+// Test: indexed images are compared by the colors, not by the indices
+void TestRowDifferenceMap::testIndexedImagesWithDifferentColors() {
+    QImage first(16, 6, QImage::Format_Indexed8);
+    first.setColorTable({ qRgb(0, 0, 0), qRgb(255, 255, 255) });
+    first.fill(0);
+    QImage second = first.copy();
+    second.setColorTable({ qRgb(0, 0, 0), qRgb(255, 0, 0) });
+    second.setPixel(5, 2, 1);
+
+    auto map = RowDifferenceMap::build(first, first.copy());
+    QVERIFY(map.isIdentical());
+
+    map = RowDifferenceMap::build(first, second);
+    QCOMPARE(map.getDifferentRowRanges(), (QList<QPair<int, int>> { { 2, 2 } }));
+
+    second.setColorTable({ qRgb(255, 0, 0), qRgb(255, 255, 255) });
+    second.fill(0);
+    map = RowDifferenceMap::build(first, second);
+    QCOMPARE(map.getDifferentRowCount(), 6);
+}
+
+// Test: a canceled build knows nothing about the images
+void TestRowDifferenceMap::testCanceledBuildIsUnknown() {
+    auto map = RowDifferenceMap::build(makeImage(10, 10), makeImage(10, 10), []() {
+        return true;
+    });
+    QVERIFY(!map.isKnown());
+}
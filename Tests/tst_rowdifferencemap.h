@@ -0,0 +1,19 @@
+#ifndef TST_ROWDIFFERENCEMAP_H
+#define TST_ROWDIFFERENCEMAP_H
+
+#include <QTest>
+
+class TestRowDifferenceMap : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIdenticalImages();
+    void testDifferentRowRanges();
+    void testDifferentSizesAreUnknown();
+    void testMid();
+    void testIndexedImagesWithDifferentColors();
+    void testCanceledBuildIsUnknown();
+};
+
+
+#endif // TST_ROWDIFFERENCEMAP_H
@@ -0,0 +1,199 @@
+#include "tst_ssimcalculator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <business/imageanalysis/comporators/helpers/ssimcalculator.h>
+
+namespace {
+
+SsimPlane createPlane(int width, int height, float value) {
+    SsimPlane plane;
+    plane.width = width;
+    plane.height = height;
+    plane.values.assign(static_cast<size_t>(width) * height, value);
+    return plane;
+}
+
+SsimPlane createRandomPlane(int width, int height, std::mt19937 &random) {
+    SsimPlane plane = createPlane(width, height, 0.0f);
+    for (auto &value : plane.values) {
+        value = static_cast<float>(random() % 256);
+    }
+    return plane;
+}
+
+// The SSIM of one pixel straight from the definition, in double precision
+double calculatePixelSsim(const SsimPlane &first, const SsimPlane &second, int px, int py) {
+    int radius = SsimCalculator::mWindowRadius;
+    double sigma = SsimCalculator::mWindowSigma;
+    std::vector<double> window;
+    double windowSum = 0.0;
+    for (int i = -radius; i <= radius; ++i) {
+        window.push_back(std::exp(-i * i / (2.0 * sigma * sigma)));
+        windowSum += window.back();
+    }
+
+    double mx = 0.0, my = 0.0, mxx = 0.0, myy = 0.0, mxy = 0.0;
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            int x = std::clamp(px + dx, 0, first.width - 1);
+            int y = std::clamp(py + dy, 0, first.height - 1);
+            double weight = window[dx + radius] * window[dy + radius] / (windowSum * windowSum);
+            double a = first.values[y * first.width + x];
+            double b = second.values[y * second.width + x];
+            mx += weight * a;
+            my += weight * b;
+            mxx += weight * a * a;
+            myy += weight * b * b;
+            mxy += weight * a * b;
+        }
+    }
+    double c1 = std::pow(SsimCalculator::mK1 * 255.0, 2);
+    double c2 = std::pow(SsimCalculator::mK2 * 255.0, 2);
+    double cs = (2.0 * (mxy - mx * my) + c2) / ((mxx - mx * mx) + (myy - my * my) + c2);
+    return (2.0 * mx * my + c1) / (mx * mx + my * my + c1) * cs;
+}
+
+QImage createNoisyImage(const QImage &image, int amplitude, std::mt19937 &random) {
+    QImage result = image.convertToFormat(QImage::Format_RGB32);
+    for (int y = 0; y < result.height(); ++y) {
+        auto line = reinterpret_cast<QRgb*>(result.scanLine(y));
+        for (int x = 0; x < result.width(); ++x) {
+            int noise = static_cast<int>(random() % (2 * amplitude + 1)) - amplitude;
+            line[x] = qRgb(std::clamp(qRed(line[x]) + noise, 0, 255),
+                           std::clamp(qGreen(line[x]) + noise, 0, 255),
+                           std::clamp(qBlue(line[x]) + noise, 0, 255)
+                           );
+        }
+    }
+    return result;
+}
+
+QImage createGradientImage(int width, int height) {
+    QImage image { width, height, QImage::Format_RGB32 };
+    for (int y = 0; y < height; ++y) {
+        auto line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            line[x] = qRgb((x * 7 + y) % 256, (y * 3) % 256, (x ^ y) % 256);
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+// Test: identical images have SSIM 1 and MS-SSIM 1 in every pixel and channel
+void TestSsimCalculator::testIdenticalImages() {
+    QImage image = createGradientImage(200, 150);
+    QList<SsimChannel> channels = { SsimChannel::Luminance, SsimChannel::Red, SsimChannel::Green, SsimChannel::Blue };
+    foreach (auto channel, channels) {
+        SsimPlane plane = SsimCalculator::extractPlane(image, channel);
+        QCOMPARE(plane.width, 200);
+        QCOMPARE(plane.height, 150);
+
+        SsimResult result = SsimCalculator::calculate(plane, plane, true);
+        QVERIFY(std::abs(result.ssim - 1.0) < 1e-6);
+        QVERIFY(std::abs(result.contrastStructure - 1.0) < 1e-6);
+        QCOMPARE(static_cast<int>(result.map.size()), 200 * 150);
+        foreach (auto value, result.map) {
+            QVERIFY(std::abs(value - 1.0f) < 1e-6f);
+        }
+        QVERIFY(std::abs(SsimCalculator::calculateMultiScale(plane, plane) - 1.0) < 1e-6);
+    }
+}
+
+// Test: a constant brightness shift changes only the luminance term of SSIM
+void TestSsimCalculator::testBrightnessShift() {
+    SsimPlane first = createPlane(64, 48, 100.0f);
+    SsimPlane second = createPlane(64, 48, 110.0f);
+    double c1 = std::pow(SsimCalculator::mK1 * 255.0, 2);
+    double expected = (2.0 * 100.0 * 110.0 + c1) / (100.0 * 100.0 + 110.0 * 110.0 + c1);
+
+    SsimResult result = SsimCalculator::calculate(first, second);
+    QVERIFY(std::abs(result.ssim - expected) < 1e-5);
+    QVERIFY(std::abs(result.contrastStructure - 1.0) < 1e-5);
+}
+
+// Test: the separable, banded filtering gives the SSIM map of the definition, including the edges
+void TestSsimCalculator::testMatchesBruteForce() {
+    std::mt19937 random(1);
+    QList<QSize> sizes = { { 1, 1 }, { 7, 5 }, { 37, 29 }, { 41, 300 } };
+    foreach (auto size, sizes) {
+        SsimPlane first = createRandomPlane(size.width(), size.height(), random);
+        SsimPlane second = first;
+        for (auto &value : second.values) {
+            value = std::clamp(value + static_cast<float>(random() % 61) - 30.0f, 0.0f, 255.0f);
+        }
+
+        SsimResult result = SsimCalculator::calculate(first, second, true);
+        double sum = 0.0;
+        for (int y = 0; y < size.height(); ++y) {
+            for (int x = 0; x < size.width(); ++x) {
+                double expected = calculatePixelSsim(first, second, x, y);
+                QVERIFY(std::abs(result.map[y * size.width() + x] - expected) < 1e-3);
+                sum += expected;
+            }
+        }
+        QVERIFY(std::abs(result.ssim - sum / (size.width() * size.height())) < 1e-4);
+    }
+}
+
+// Test: stronger noise lowers SSIM and MS-SSIM, and the order of the images does not matter
+void TestSsimCalculator::testDegradedImages() {
+    std::mt19937 random(2);
+    QImage image = createGradientImage(256, 192);
+    SsimPlane original = SsimCalculator::extractPlane(image, SsimChannel::Luminance);
+    SsimPlane weakNoise = SsimCalculator::extractPlane(createNoisyImage(image, 8, random), SsimChannel::Luminance);
+    SsimPlane strongNoise = SsimCalculator::extractPlane(createNoisyImage(image, 64, random), SsimChannel::Luminance);
+
+    double weakSsim = SsimCalculator::calculate(original, weakNoise).ssim;
+    double strongSsim = SsimCalculator::calculate(original, strongNoise).ssim;
+    QVERIFY(weakSsim < 1.0);
+    QVERIFY(strongSsim < weakSsim);
+    QVERIFY(std::abs(SsimCalculator::calculate(strongNoise, original).ssim - strongSsim) < 1e-6);
+
+    double weakMsSsim = SsimCalculator::calculateMultiScale(original, weakNoise);
+    double strongMsSsim = SsimCalculator::calculateMultiScale(original, strongNoise);
+    QVERIFY(weakMsSsim < 1.0);
+    QVERIFY(strongMsSsim < weakMsSsim);
+    QVERIFY(std::abs(SsimCalculator::calculateMultiScale(strongNoise, original) - strongMsSsim) < 1e-6);
+}
+
+// Test: the planes of different sizes are rejected
+void TestSsimCalculator::testDifferentSizes() {
+    SsimPlane first = createPlane(20, 20, 0.0f);
+    SsimPlane second = createPlane(20, 21, 0.0f);
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, SsimCalculator::calculate(first, second));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, SsimCalculator::calculateMultiScale(first, second));
+}
+
+// Test: the heatmap has the size of the images, SSIM 1 is white and low SSIM is red
+void TestSsimCalculator::testHeatmap() {
+    std::vector<float> map = { 1.0f, 0.0f, -0.5f, 0.25f, 1.0f, 1.0f };
+    QImage heatmap = SsimCalculator::createHeatmap(map, QSize(3, 2));
+    QCOMPARE(heatmap.format(), QImage::Format_Indexed8);
+    QCOMPARE(heatmap.size(), QSize(3, 2));
+    QCOMPARE(heatmap.pixel(0, 0), qRgb(255, 255, 255));
+    QCOMPARE(heatmap.pixel(1, 0), qRgb(255, 0, 0));
+    QCOMPARE(heatmap.pixel(2, 0), qRgb(255, 0, 0));
+    QCOMPARE(heatmap.pixel(0, 1), qRgb(255, 128, 0));
+
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, SsimCalculator::createHeatmap(map, QSize(2, 2)));
+}
+
+// The SSIM map and MS-SSIM of a 4K pair of images, run with -iterations N
+void TestSsimCalculator::benchmarkSsim() {
+    std::mt19937 random(3);
+    QImage image = createGradientImage(3840, 2160);
+    SsimPlane first = SsimCalculator::extractPlane(image, SsimChannel::Luminance);
+    SsimPlane second = SsimCalculator::extractPlane(createNoisyImage(image, 16, random), SsimChannel::Luminance);
+    double total = 0.0;
+
+    QBENCHMARK {
+        total += SsimCalculator::calculate(first, second, true).ssim;
+        total += SsimCalculator::calculateMultiScale(first, second);
+    }
+    QVERIFY(total > 0.0);
+}
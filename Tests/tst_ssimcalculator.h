@@ -0,0 +1,20 @@
+#ifndef TST_SSIMCALCULATOR_H
+#define TST_SSIMCALCULATOR_H
+
+#include <QTest>
+
+class TestSsimCalculator : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIdenticalImages();
+    void testBrightnessShift();
+    void testMatchesBruteForce();
+    void testDegradedImages();
+    void testDifferentSizes();
+    void testHeatmap();
+    void benchmarkSsim();
+};
+
+
+#endif // TST_SSIMCALCULATOR_H
@@ -0,0 +1,136 @@
+#include "tst_summedareatable.h"
+
+#include <random>
+#include <vector>
+#include <domain/valueobjects/integralimage.h>
+#include <domain/valueobjects/summedareatable.h>
+
+namespace {
+
+SummedAreaTable buildTable(const std::vector<uchar> &plane, int width, int height) {
+    return SummedAreaTable::build(width, height, [&plane, width](int y, uchar *values) {
+        std::copy(plane.begin() + y * width, plane.begin() + (y + 1) * width, values);
+    });
+}
+
+RegionSums calculateRegionSums(const std::vector<uchar> &plane, int width, const QRect &region) {
+    RegionSums sums;
+    for (int y = region.top(); y <= region.bottom(); ++y) {
+        for (int x = region.left(); x <= region.right(); ++x) {
+            uchar value = plane[y * width + x];
+            sums.sum += value;
+            sums.sumOfSquares += value * value;
+            ++sums.pixelCount;
+        }
+    }
+    return sums;
+}
+
+} // namespace
+
+// Test: the sums of random regions are exact, including the regions that cross the tiles
+void TestSummedAreaTable::testRegionSumsMatchBruteForce() {
+    std::mt19937 random(1);
+    QList<QSize> sizes = { { 1, 1 }, { 255, 257 }, { 256, 256 }, { 513, 300 }, { 3, 600 } };
+    foreach (auto size, sizes) {
+        int width = size.width();
+        int height = size.height();
+        std::vector<uchar> plane(width * height);
+        for (auto &value : plane) {
+            value = random() % 256;
+        }
+        SummedAreaTable table = buildTable(plane, width, height);
+        QCOMPARE(table.width(), width);
+        QCOMPARE(table.height(), height);
+
+        for (int i = 0; i < 100; ++i) {
+            int x1 = random() % width;
+            int x2 = random() % width;
+            int y1 = random() % height;
+            int y2 = random() % height;
+            QRect region = (i == 0) ? QRect(0, 0, width, height)
+                                    : QRect(QPoint(x1, y1), QPoint(x2, y2)).normalized();
+            RegionSums expected = calculateRegionSums(plane, width, region);
+            RegionSums actual = table.getRegionSums(region);
+            QCOMPARE(actual.pixelCount, expected.pixelCount);
+            QCOMPARE(actual.sum, expected.sum);
+            QCOMPARE(actual.sumOfSquares, expected.sumOfSquares);
+        }
+    }
+}
+
+// Test: the worst case for the 32-bit parts of the table is a plane of 255
+void TestSummedAreaTable::testSaturatedPlaneDoesNotOverflow() {
+    int width = 1000;
+    int height = 1000;
+    SummedAreaTable table = SummedAreaTable::build(width, height, [width](int, uchar *values) {
+        std::fill(values, values + width, 255);
+    });
+
+    RegionSums sums = table.getRegionSums(QRect(0, 0, width, height));
+    QCOMPARE(sums.sum, 255ull * width * height);
+    QCOMPARE(sums.sumOfSquares, 255ull * 255 * width * height);
+    QCOMPARE(sums.getStandardDeviation(), 0.0);
+
+    // The region is clipped to the plane
+    sums = table.getRegionSums(QRect(900, 900, 200, 200));
+    QCOMPARE(sums.pixelCount, qint64(100 * 100));
+}
+
+// Test: the channels of an integral image are the channels of the pixels
+void TestSummedAreaTable::testIntegralImageChannels() {
+    QImage image(300, 280, QImage::Format_RGB32);
+    image.fill(qRgb(10, 20, 30));
+    QRect region { 100, 50, 150, 200 };
+    for (int y = region.top(); y <= region.bottom(); ++y) {
+        for (int x = region.left(); x <= region.right(); ++x) {
+            image.setPixel(x, y, (x + y) % 2 == 0 ? qRgb(200, 100, 50) : qRgb(0, 0, 0));
+        }
+    }
+    IntegralImage integralImage = IntegralImage::build(image);
+    QVERIFY(!integralImage.isNull());
+    QCOMPARE(integralImage.size(), image.size());
+
+    QCOMPARE(integralImage.getRegionSums(StatisticsChannel::Red, region).getMean(), 100.0);
+    QCOMPARE(integralImage.getRegionSums(StatisticsChannel::Green, region).getMean(), 50.0);
+    QCOMPARE(integralImage.getRegionSums(StatisticsChannel::Blue, region).getMean(), 25.0);
+    QCOMPARE(integralImage.getRegionSums(StatisticsChannel::Blue, QRect(0, 0, 10, 10)).getMean(), 30.0);
+    QCOMPARE(integralImage.getRegionSums(StatisticsChannel::Brightness, QRect(0, 0, 10, 10)).getMean(),
+             static_cast<double>(qGray(10, 20, 30)));
+    QVERIFY(integralImage.getRegionSums(StatisticsChannel::Luminance, region).getStandardDeviation() > 50.0);
+}
+
+// Test: a table without the sums of squares has the same sums
+void TestSummedAreaTable::testSumsOnly() {
+    std::mt19937 random(2);
+    int width = 300;
+    int height = 520;
+    std::vector<uchar> plane(width * height);
+    for (auto &value : plane) {
+        value = random() % 256;
+    }
+    SummedAreaTable table = SummedAreaTable::build(width, height, [&plane, width](int y, uchar *values) {
+        std::copy(plane.begin() + y * width, plane.begin() + (y + 1) * width, values);
+    }, SummedAreaTable::Content::Sums);
+    QVERIFY(!table.hasSumsOfSquares());
+
+    QRect region { 17, 200, 270, 310 };
+    RegionSums sums = table.getRegionSums(region);
+    QCOMPARE(sums.sum, calculateRegionSums(plane, width, region).sum);
+    QCOMPARE(sums.sumOfSquares, 0ull);
+}
+
+// Test: a canceled build returns null tables
+void TestSummedAreaTable::testCanceledBuildIsNull() {
+    auto isCanceled = []() {
+        return true;
+    };
+    SummedAreaTable table = SummedAreaTable::build(10, 10, [](int, uchar *values) {
+        std::fill(values, values + 10, 1);
+    }, SummedAreaTable::Content::SumsAndSquares, isCanceled);
+    QVERIFY(table.isNull());
+
+    QImage image(10, 10, QImage::Format_RGB32);
+    image.fill(Qt::white);
+    QVERIFY(IntegralImage::build(image, isCanceled).isNull());
+}
@@ -0,0 +1,18 @@
+#ifndef TST_SUMMEDAREATABLE_H
+#define TST_SUMMEDAREATABLE_H
+
+#include <QTest>
+
+class TestSummedAreaTable : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRegionSumsMatchBruteForce();
+    void testSaturatedPlaneDoesNotOverflow();
+    void testIntegralImageChannels();
+    void testSumsOnly();
+    void testCanceledBuildIsNull();
+};
+
+
+#endif // TST_SUMMEDAREATABLE_H
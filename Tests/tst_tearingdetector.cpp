@@ -0,0 +1,57 @@
+#include "tst_tearingdetector.h"
+
+#include <cstring>
+#include <business/videoanalysis/tearingdetector.h>
+
+namespace {
+
+// A vertical stripes pattern that moves to the right by 'shift' pixels
+QImage makeFrame(int shift) {
+    QImage image(64, 100, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            int value = ((x + shift) / 4) % 2 == 0 ? 40 : 200;
+            image.setPixel(x, y, qRgb(value, value, value));
+        }
+    }
+    return image;
+}
+
+// The top of the frame comes from the 'top' image and the rest from the 'bottom' one
+QImage makeTornFrame(const QImage &top, const QImage &bottom, int tearRow) {
+    QImage image = bottom.copy();
+    for (int y = 0; y < tearRow; ++y) {
+        memcpy(image.scanLine(y), top.constScanLine(y), top.bytesPerLine());
+    }
+    return image;
+}
+
+} // namespace
+
+// Test: the top of the frame matches the previous frame and the bottom matches the next one
+void TestTearingDetector::testFindsTearLine() {
+    QImage previous = makeFrame(0);
+    QImage next = makeFrame(2);
+    QImage current = makeTornFrame(previous, next, 37);
+
+    auto tearLine = TearingDetector::findTearLine(RowIndex(previous), RowIndex(current), RowIndex(next));
+    QVERIFY(tearLine.has_value());
+    QCOMPARE(tearLine->row, 37);
+    QVERIFY(tearLine->confidence > 0.9);
+}
+
+// Test: regular motion does not look like tearing
+void TestTearingDetector::testMovingVideoIsNotTorn() {
+    auto tearLine = TearingDetector::findTearLine(RowIndex(makeFrame(0)),
+                                                  RowIndex(makeFrame(2)),
+                                                  RowIndex(makeFrame(4))
+                                                  );
+    QVERIFY(!tearLine.has_value());
+}
+
+// Test: identical frames cannot be torn
+void TestTearingDetector::testStaticVideoIsNotTorn() {
+    QImage frame = makeFrame(0);
+    auto tearLine = TearingDetector::findTearLine(RowIndex(frame), RowIndex(frame), RowIndex(frame));
+    QVERIFY(!tearLine.has_value());
+}
@@ -0,0 +1,16 @@
+#ifndef TST_TEARINGDETECTOR_H
+#define TST_TEARINGDETECTOR_H
+
+#include <QTest>
+
+class TestTearingDetector : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFindsTearLine();
+    void testMovingVideoIsNotTorn();
+    void testStaticVideoIsNotTorn();
+};
+
+
+#endif // TST_TEARINGDETECTOR_H
@@ -0,0 +1,71 @@
+#include "tst_temporalditheringstatistics.h"
+
+#include <business/videoanalysis/temporalditheringstatistics.h>
+
+namespace {
+
+QImage makeFrame(int luma, int width = 8, int height = 6) {
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(qRgb(luma, luma, luma));
+    return image;
+}
+
+// Every frame alternates between the two luminance levels
+TemporalDitheringSummary analyzeToggles(int firstLuma, int secondLuma, int frameCount) {
+    TemporalDitheringStatistics statistics;
+    for (int i = 0; i < frameCount; ++i) {
+        statistics.addFrame(makeFrame(i % 2 == 0 ? firstLuma : secondLuma));
+    }
+    return statistics.getSummary();
+}
+
+} // namespace
+
+// Test: identical frames have no changes and no dithering
+void TestTemporalDitheringStatistics::testStaticVideoHasNoChanges() {
+    TemporalDitheringSummary summary = analyzeToggles(120, 120, 10);
+    QCOMPARE(summary.width, 8);
+    QCOMPARE(summary.height, 6);
+    QCOMPARE(summary.analyzedFrames, 10);
+    QCOMPARE(summary.framesWithChanges, 0);
+    QCOMPARE(summary.changedPixels, qint64(0));
+    QCOMPARE(summary.ditheredPixels, qint64(0));
+}
+
+// Test: changes of one level are within the threshold and are not counted
+void TestTemporalDitheringStatistics::testOneLevelTogglesAreIgnored() {
+    TemporalDitheringSummary summary = analyzeToggles(120, 121, 10);
+    QCOMPARE(summary.framesWithChanges, 0);
+    QCOMPARE(summary.changedPixels, qint64(0));
+    QCOMPARE(summary.ditheredPixels, qint64(0));
+
+    summary = analyzeToggles(120, 119, 10);
+    QCOMPARE(summary.framesWithChanges, 0);
+    QCOMPARE(summary.changedPixels, qint64(0));
+}
+
+// Test: a pixel that flickers above the threshold but close to its mean is dithered
+void TestTemporalDitheringStatistics::testTogglesAboveThresholdAreDithering() {
+    TemporalDitheringSummary summary = analyzeToggles(120, 123, 10);
+    QCOMPARE(summary.framesWithChanges, 9);
+    QCOMPARE(summary.changedPixels, qint64(48));
+    QCOMPARE(summary.ditheredPixels, qint64(48));
+    QCOMPARE(summary.ditheredPixelsPercent, 100.0);
+    QCOMPARE(summary.averageChangeRate, 1.0);
+    QVERIFY(qAbs(summary.maxStandardDeviation - 1.5) < 0.01);
+}
+
+// Test: large changes are motion, not dithering
+void TestTemporalDitheringStatistics::testLargeTogglesAreNotDithering() {
+    TemporalDitheringSummary summary = analyzeToggles(20, 220, 10);
+    QCOMPARE(summary.framesWithChanges, 9);
+    QCOMPARE(summary.changedPixels, qint64(48));
+    QCOMPARE(summary.ditheredPixels, qint64(0));
+}
+
+// Test: all frames must have the same size
+void TestTemporalDitheringStatistics::testFrameSizeChangeThrows() {
+    TemporalDitheringStatistics statistics;
+    statistics.addFrame(makeFrame(120));
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, statistics.addFrame(makeFrame(120, 4, 4)));
+}
@@ -0,0 +1,18 @@
+#ifndef TST_TEMPORALDITHERINGSTATISTICS_H
+#define TST_TEMPORALDITHERINGSTATISTICS_H
+
+#include <QTest>
+
+class TestTemporalDitheringStatistics : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStaticVideoHasNoChanges();
+    void testOneLevelTogglesAreIgnored();
+    void testTogglesAboveThresholdAreDithering();
+    void testLargeTogglesAreNotDithering();
+    void testFrameSizeChangeThrows();
+};
+
+
+#endif // TST_TEMPORALDITHERINGSTATISTICS_H
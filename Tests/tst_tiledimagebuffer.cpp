@@ -0,0 +1,82 @@
+#include "tst_tiledimagebuffer.h"
+
+#include <QSet>
+#include <algorithm>
+#include <stdexcept>
+#include <domain/valueobjects/tiledimagebuffer.h>
+
+namespace {
+
+// The tile is filled with a gray level of its index, so the joined image shows where every tile went
+QImage createTile(const QRect &area, int index) {
+    QImage tile(area.size(), QImage::Format_RGB32);
+    tile.fill(qRgb(index, index, index));
+    return tile;
+}
+
+} // namespace
+
+// Test: the tiles cover the image, the tiles at the right and bottom edges are smaller
+void TestTiledImageBuffer::testTilesCoverImage() {
+    TiledImageBuffer buffer { QSize(100, 70), 32 };
+    QCOMPARE(buffer.getColumnCount(), 4);
+    QCOMPARE(buffer.getRowCount(), 3);
+    QCOMPARE(buffer.getTileCount(), 12);
+    QCOMPARE(buffer.getTileRect(0), QRect(0, 0, 32, 32));
+    QCOMPARE(buffer.getTileRect(3), QRect(96, 0, 4, 32));
+    QCOMPARE(buffer.getTileRect(11), QRect(96, 64, 4, 6));
+    QVERIFY(buffer.getTileRect(12).isNull());
+}
+
+// Test: the tiles in the visible area are taken first, the closest ones to its center first
+void TestTiledImageBuffer::testVisibleTilesAreRenderedFirst() {
+    TiledImageBuffer buffer { QSize(128, 128), 32 };
+    buffer.setVisibleArea(QRect(64, 64, 64, 64)); // the 2x2 tiles in the bottom right corner
+
+    QList<int> visibleTiles;
+    for (int i = 0; i < 4; ++i) {
+        visibleTiles.append(buffer.takeNextTile());
+    }
+    std::sort(visibleTiles.begin(), visibleTiles.end());
+    QCOMPARE(visibleTiles, QList<int>({ 10, 11, 14, 15 }));
+
+    // The remaining tiles are taken once, then there is nothing left
+    QSet<int> otherTiles;
+    for (int index = buffer.takeNextTile(); index >= 0; index = buffer.takeNextTile()) {
+        otherTiles.insert(index);
+    }
+    QCOMPARE(otherTiles.size(), 12);
+    QVERIFY(!otherTiles.contains(10));
+}
+
+// Test: the finished tiles are reported once, and the whole image is joined from them
+void TestTiledImageBuffer::testTilesAreJoined() {
+    TiledImageBuffer buffer { QSize(50, 40), 32 };
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, buffer.toImage());
+
+    for (int index = buffer.takeNextTile(); index >= 0; index = buffer.takeNextTile()) {
+        buffer.setTile(index, createTile(buffer.getTileRect(index), index));
+    }
+    QVERIFY(buffer.isComplete());
+    QCOMPARE(buffer.takeUpdatedAreas().size(), 4);
+    QVERIFY(buffer.takeUpdatedAreas().isEmpty());
+
+    QImage image = buffer.toImage();
+    QCOMPARE(image.size(), QSize(50, 40));
+    QCOMPARE(image.pixel(0, 0), qRgb(0, 0, 0));
+    QCOMPARE(image.pixel(49, 0), qRgb(1, 1, 1));
+    QCOMPARE(image.pixel(31, 39), qRgb(2, 2, 2));
+    QCOMPARE(image.pixel(32, 32), qRgb(3, 3, 3));
+}
+
+// Test: a canceled or failed buffer gives no more tiles and keeps the first error
+void TestTiledImageBuffer::testCanceledBufferHasNoTiles() {
+    TiledImageBuffer buffer { QSize(64, 64), 32 };
+    QVERIFY(buffer.takeNextTile() >= 0);
+    buffer.setError("first");
+    buffer.setError("second");
+    QVERIFY(buffer.isCanceled());
+    QCOMPARE(buffer.takeNextTile(), -1);
+    QCOMPARE(buffer.getError(), QString("first"));
+    QVERIFY(!buffer.isComplete());
+}
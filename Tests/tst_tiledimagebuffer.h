@@ -0,0 +1,17 @@
+#ifndef TST_TILEDIMAGEBUFFER_H
+#define TST_TILEDIMAGEBUFFER_H
+
+#include <QTest>
+
+class TestTiledImageBuffer : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testTilesCoverImage();
+    void testVisibleTilesAreRenderedFirst();
+    void testTilesAreJoined();
+    void testCanceledBufferHasNoTiles();
+};
+
+
+#endif // TST_TILEDIMAGEBUFFER_H
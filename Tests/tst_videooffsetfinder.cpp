@@ -0,0 +1,62 @@
+#include "tst_videooffsetfinder.h"
+
+#include <cmath>
+#include <business/videoanalysis/videooffsetfinder.h>
+
+namespace {
+
+// A deterministic pseudo-random signal that looks like the motion energy of a real video
+std::vector<float> makeSignal(int length) {
+    std::vector<float> signal;
+    quint32 state = 12345;
+    for (int i = 0; i < length; ++i) {
+        state = state * 1664525u + 1013904223u;
+        float noise = static_cast<float>(state >> 24) / 255.0f;
+        signal.push_back(10.0f * std::sin(i * 0.05f) + 5.0f * noise);
+    }
+    return signal;
+}
+
+// Returns the part of the signal starting at the frame 'from'
+std::vector<float> slice(const std::vector<float> &signal, int from, int length) {
+    return std::vector<float>(signal.begin() + from, signal.begin() + from + length);
+}
+
+} // namespace
+
+// Test: the second capture was started later, so its content is shifted backwards
+void TestVideoOffsetFinder::testFindsPositiveOffset() {
+    auto signal = makeSignal(1200);
+    auto first = slice(signal, 100, 1000);
+    auto second = slice(signal, 0, 1000);
+
+    VideoOffset offset = VideoOffsetFinder::findOffset(first, second, 500);
+    QCOMPARE(offset.offsetFrames, 100);
+    QVERIFY(offset.correlation > 0.99);
+}
+
+// Test: the first capture was started later
+void TestVideoOffsetFinder::testFindsNegativeOffset() {
+    auto signal = makeSignal(1200);
+    auto first = slice(signal, 0, 1000);
+    auto second = slice(signal, 37, 1000);
+
+    VideoOffset offset = VideoOffsetFinder::findOffset(first, second, 500);
+    QCOMPARE(offset.offsetFrames, -37);
+    QVERIFY(offset.correlation > 0.99);
+}
+
+// Test: identical signals are already in sync
+void TestVideoOffsetFinder::testIdenticalSignalsHaveNoOffset() {
+    auto signal = makeSignal(300);
+
+    VideoOffset offset = VideoOffsetFinder::findOffset(signal, signal, 150);
+    QCOMPARE(offset.offsetFrames, 0);
+    QVERIFY(std::abs(offset.correlation - 1.0) < 1e-6);
+}
+
+// Test: there is nothing to correlate in a couple of frames
+void TestVideoOffsetFinder::testThrowsForTooShortSignals() {
+    std::vector<float> signal = { 1.0f, 2.0f, 3.0f };
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, VideoOffsetFinder::findOffset(signal, signal, 1));
+}
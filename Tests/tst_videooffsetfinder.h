@@ -0,0 +1,17 @@
+#ifndef TST_VIDEOOFFSETFINDER_H
+#define TST_VIDEOOFFSETFINDER_H
+
+#include <QTest>
+
+class TestVideoOffsetFinder : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFindsPositiveOffset();
+    void testFindsNegativeOffset();
+    void testIdenticalSignalsHaveNoOffset();
+    void testThrowsForTooShortSignals();
+};
+
+
+#endif // TST_VIDEOOFFSETFINDER_H
@@ -1,4 +1,4 @@
-QT       += core gui multimedia multimediawidgets
+QT       += core gui multimedia multimediawidgets concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -10,28 +10,51 @@ CONFIG += c++17
 
 SOURCES += \
     business/getimagesfromvideosinteractor.cpp \
+    business/videoanalysis/boundedframequeue.cpp \
+    business/videoanalysis/firstdifferentframeinteractor.cpp \
+    business/videoanalysis/framecadenceanalyzer.cpp \
+    business/videoanalysis/framecadenceinteractor.cpp \
+    business/videoanalysis/framehasher.cpp \
+    business/videoanalysis/framepairextractioninteractor.cpp \
+    business/videoanalysis/framepairmetricscalculator.cpp \
+    business/videoanalysis/tearingdetector.cpp \
+    business/videoanalysis/tearinginteractor.cpp \
+    business/videoanalysis/temporalditheringinteractor.cpp \
+    business/videoanalysis/temporalditheringstatistics.cpp \
+    business/videoanalysis/videoanalysisworkers.cpp \
+    business/videoanalysis/videocomparisoninteractor.cpp \
+    business/videoanalysis/videoframereader.cpp \
+    business/videoanalysis/videooffsetfinder.cpp \
+    business/videoanalysis/videosignature.cpp \
+    business/videoanalysis/videosyncinteractor.cpp \
     business/imageanalysis/autoanalysissettingsinteractor.cpp \
     business/imageanalysis/comporators/coloreddifferenceinpixelvaluescomporator.cpp \
     business/imageanalysis/comporators/colorssaturationcomporator.cpp \
     business/imageanalysis/comporators/contrastcomporator.cpp \
     business/imageanalysis/comporators/customrangeddifferenceinpixelvaluescomparator.cpp \
+    business/imageanalysis/comporators/differingrowbandscomparator.cpp \
     business/imageanalysis/comporators/formatters/pixelsabsolutevalueformatter.cpp \
     business/imageanalysis/comporators/helpers/mathhelper.cpp \
     business/imageanalysis/comporators/helpers/pixelsasolutvaluehelper.cpp \
+    business/imageanalysis/comporators/helpers/ssimcalculator.cpp \
     business/imageanalysis/comporators/imageproximitytoorigincomparator.cpp \
     business/imageanalysis/comporators/linernonlinerdifferencecomparator.cpp \
     business/imageanalysis/comporators/monocoloreddifferenceinpixelvaluescomporator.cpp \
     business/imageanalysis/comporators/pixelsbrightnesscomparator.cpp \
     business/imageanalysis/comporators/sharpnesscomparator.cpp \
+    business/imageanalysis/comporators/ssimcomparator.cpp \
     business/imageanalysis/filters/grayscalefilter.cpp \
     business/imageanalysis/filters/rgbfilter.cpp \
+    business/imageanalysis/filters/filterpipeline.cpp \
+    business/imageanalysis/filterhistory.cpp \
+    business/imageanalysis/differenceregionindex.cpp \
+    business/imageanalysis/comparisonestimator.cpp \
     business/imageanalysis/imageprocessinginteractor.cpp \
     business/imageanalysis/imageprocessorsmanager.cpp \
     business/utils/imagesinfo.cpp \
     business/validation/imageextensionsinfoprovider.cpp \
     business/validation/imagevalidationrules.cpp \
     business/imagefilesinteractors.cpp \
-    business/otherappinstancesinteractor.cpp \
     business/plugins/imageprocessordeserializer.cpp \
     business/plugins/pluginsmanager.cpp \
     business/imageanalysis/runallcomparatorsinteractor.cpp \
@@ -42,15 +65,28 @@ SOURCES += \
     business/recentfilesinteractor.cpp \
     data/storage/filedialoghandler.cpp \
     data/storage/imagefileshandler.cpp \
+    data/storage/internalimagefile.cpp \
     data/repositories/pluginsrepository.cpp \
     domain/interfaces/business/icomparator.cpp \
     domain/interfaces/business/ifilter.cpp \
     domain/interfaces/business/imageprocessor.cpp \
+    domain/valueobjects/brushstatistics.cpp \
     domain/valueobjects/comparableimage.cpp \
+    domain/valueobjects/summedareatable.cpp \
+    domain/valueobjects/integralimage.cpp \
     domain/valueobjects/comparisonresultvariant.cpp \
+    domain/valueobjects/compressedimage.cpp \
     domain/valueobjects/images.cpp \
     domain/valueobjects/property.cpp \
     domain/valueobjects/recentfilesrecord.cpp \
+    domain/valueobjects/rowdifferencemap.cpp \
+    domain/valueobjects/rowindex.cpp \
+    domain/valueobjects/differenceplane.cpp \
+    domain/valueobjects/tiledimagebuffer.cpp \
+    domain/kernels/pixelkernels.cpp \
+    domain/kernels/pixelkernelsx86.cpp \
+    domain/kernels/pixelkernelsneon.cpp \
+    domain/utils/parallel.cpp \
     main.cpp \
     presentation/colorpickercontroller.cpp \
     presentation/dialogs/aboutdialog.cpp \
@@ -58,38 +94,69 @@ SOURCES += \
     presentation/dialogs/comparatorresultdialog.cpp \
     presentation/dialogs/externalimageviewerdialog.cpp \
     presentation/dialogs/formatters/helphtmlformatter.cpp \
+    presentation/dialogs/framecadencedialog.cpp \
+    presentation/dialogs/framepairextractiondialog.cpp \
     presentation/dialogs/getimagesfromvideosdialog.cpp \
     presentation/dialogs/helpdialog.cpp \
     presentation/dialogs/imageautoanalysissettingsdialog.cpp \
     presentation/dialogs/pluginssettingsdialog.cpp \
     presentation/dialogs/propertyeditordialog.cpp \
+    presentation/dialogs/regionstatisticspanel.cpp \
+    presentation/dialogs/videocomparisondialog.cpp \
     presentation/imageprocessorsmenucontroller.cpp \
     presentation/mainwindow.cpp \
     business/imageanalysis/comporators/formatters/htmlreportpresenter.cpp \
     presentation/views/externalgraphicsview.cpp \
     presentation/views/graphicspixmapitem.cpp \
+    presentation/views/tiledpreviewitem.cpp \
+    presentation/views/streamedimageitem.cpp \
     presentation/views/imageviewer.cpp \
     presentation/views/videodialogslider.cpp \
+    presentation/views/videometricschartwidget.cpp \
     presentation/views/videoplayerwidget.cpp \
     domain/valueobjects/autocomparisonreportentry.cpp
 
 HEADERS += \
     business/getimagesfromvideosinteractor.h \
+    business/videoanalysis/boundedframequeue.h \
+    business/videoanalysis/firstdifferentframeinteractor.h \
+    business/videoanalysis/framecadenceanalyzer.h \
+    business/videoanalysis/framecadenceinteractor.h \
+    business/videoanalysis/framehasher.h \
+    business/videoanalysis/framepairextractioninteractor.h \
+    business/videoanalysis/framepairmetricscalculator.h \
+    business/videoanalysis/tearingdetector.h \
+    business/videoanalysis/tearinginteractor.h \
+    business/videoanalysis/temporalditheringinteractor.h \
+    business/videoanalysis/temporalditheringstatistics.h \
+    business/videoanalysis/videoanalysisworkers.h \
+    business/videoanalysis/videocomparisoninteractor.h \
+    business/videoanalysis/videoframereader.h \
+    business/videoanalysis/videooffsetfinder.h \
+    business/videoanalysis/videosignature.h \
+    business/videoanalysis/videosyncinteractor.h \
     business/imageanalysis/autoanalysissettingsinteractor.h \
     business/imageanalysis/comporators/coloreddifferenceInpixelvaluescomporator.h \
     business/imageanalysis/comporators/colorssaturationcomporator.h \
     business/imageanalysis/comporators/contrastcomporator.h \
     business/imageanalysis/comporators/customrangeddifferenceinpixelvaluescomparator.h \
+    business/imageanalysis/comporators/differingrowbandscomparator.h \
     business/imageanalysis/comporators/formatters/pixelsabsolutevalueformatter.h \
     business/imageanalysis/comporators/helpers/mathhelper.h \
     business/imageanalysis/comporators/helpers/pixelsasolutvaluehelper.h \
+    business/imageanalysis/comporators/helpers/ssimcalculator.h \
     business/imageanalysis/comporators/imageproximitytoorigincomparator.h \
     business/imageanalysis/comporators/linernonlinerdifferencecomparator.h \
     business/imageanalysis/comporators/monocoloreddifferenceinpixelvaluescomporator.h \
     business/imageanalysis/comporators/pixelsbrightnesscomparator.h \
     business/imageanalysis/comporators/sharpnesscomparator.h \
+    business/imageanalysis/comporators/ssimcomparator.h \
     business/imageanalysis/filters/grayscalefilter.h \
     business/imageanalysis/filters/rgbfilter.h \
+    business/imageanalysis/filters/filterpipeline.h \
+    business/imageanalysis/filterhistory.h \
+    business/imageanalysis/differenceregionindex.h \
+    business/imageanalysis/comparisonestimator.h \
     business/imageanalysis/imageprocessinginteractor.h \
     business/imageanalysis/imageprocessorsmanager.h \
     business/validation/imageextensionsinfoprovider.h \
@@ -98,7 +165,6 @@ HEADERS += \
     business/validation/interfaces/iimageextensionsinfoprovider.h \
     business/validation/interfaces/iimagevalidationrules.h \
     business/imagefilesinteractors.h \
-    business/otherappinstancesinteractor.h \
     business/plugins/imageprocessordeserializer.h \
     business/plugins/pluginsmanager.h \
     business/imageanalysis/runallcomparatorsinteractor.h \
@@ -110,6 +176,7 @@ HEADERS += \
     business/utils/imagesinfo.h \
     data/storage/filedialoghandler.h \
     data/storage/imagefileshandler.h \
+    data/storage/internalimagefile.h \
     data/repositories/pluginsrepository.h \
     data/storage/stb_image.h \
     domain/interfaces/business/irecentfilesmanager.h \
@@ -122,12 +189,16 @@ HEADERS += \
     domain/interfaces/presentation/imageprocessinginteractorlistener.h \
     domain/interfaces/business/imageprocessor.h \
     domain/interfaces/presentation/ioncropimageslistener.h \
-    domain/interfaces/presentation/iotherappinstancesinteractorcallback.h \
     domain/interfaces/presentation/iprocessorpropertiesdialogcallback.h \
     domain/interfaces/presentation/iprogressdialog.h \
     domain/valueobjects/autocomparisonreportentry.h \
+    domain/valueobjects/brushstatistics.h \
     domain/valueobjects/comparableimage.h \
+    domain/valueobjects/summedareatable.h \
+    domain/valueobjects/integralimage.h \
     domain/valueobjects/comparisonresultvariant.h \
+    domain/valueobjects/compressedimage.h \
+    domain/valueobjects/framepairextractionsettings.h \
     domain/valueobjects/imagepixelcolor.h \
     domain/valueobjects/imageprocessorsinfo.h \
     domain/valueobjects/images.h \
@@ -137,26 +208,42 @@ HEADERS += \
     domain/valueobjects/property.h \
     domain/valueobjects/pyscriptinfo.h \
     domain/valueobjects/recentfilesrecord.h \
+    domain/valueobjects/rowdifferencemap.h \
+    domain/valueobjects/rowindex.h \
+    domain/valueobjects/differenceplane.h \
+    domain/valueobjects/tiledimagebuffer.h \
+    domain/valueobjects/viewrendermode.h \
+    domain/kernels/pixelkernels.h \
+    domain/kernels/scalarkernels.h \
+    domain/utils/parallel.h \
     domain/valueobjects/savefileinfo.h \
+    domain/valueobjects/videoframemetrics.h \
     presentation/colorpickercontroller.h \
     presentation/dialogs/aboutdialog.h \
     presentation/dialogs/colorpickerpanel.h \
     presentation/dialogs/comparatorresultdialog.h \
     presentation/dialogs/externalimageviewerdialog.h \
     presentation/dialogs/formatters/helphtmlformatter.h \
+    presentation/dialogs/framecadencedialog.h \
+    presentation/dialogs/framepairextractiondialog.h \
     presentation/dialogs/getimagesfromvideosdialog.h \
     presentation/dialogs/helpdialog.h \
     presentation/dialogs/imageautoanalysissettingsdialog.h \
     presentation/dialogs/pluginssettingsdialog.h \
     presentation/dialogs/propertyeditordialog.h \
+    presentation/dialogs/regionstatisticspanel.h \
+    presentation/dialogs/videocomparisondialog.h \
     presentation/imageprocessorsmenucontroller.h \
     presentation/mainwindow.h \
     business/imageanalysis/comporators/formatters/htmlreportpresenter.h \
     presentation/valueobjects/rgbwidgets.h \
     presentation/views/externalgraphicsview.h \
     presentation/views/graphicspixmapitem.h \
+    presentation/views/tiledpreviewitem.h \
+    presentation/views/streamedimageitem.h \
     presentation/views/imageviewer.h \
     presentation/views/videodialogslider.h \
+    presentation/views/videometricschartwidget.h \
     presentation/views/videoplayerwidget.h
 
 FORMS += \
@@ -0,0 +1,176 @@
+#include "comparisonestimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+
+
+namespace {
+
+// The two-sided 95% quantiles of Student's t-distribution for 1-10 degrees of freedom
+const double studentT95[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228 };
+
+} // namespace
+
+bool ComparisonEstimator::isEstimateUseful(const IComparatorPtr comparator,
+                                           const QSize &firstImageSize,
+                                           const QSize &secondImageSize
+                                           )
+{
+    if (comparator == nullptr || comparator->getEstimationMethod() == EstimationMethod::None) {
+        return false;
+    }
+    // The comparators report the images of different sizes themselves
+    return firstImageSize == secondImageSize &&
+           static_cast<qint64>(firstImageSize.width()) * firstImageSize.height() >= mMinPixelCount;
+}
+
+QString ComparisonEstimator::estimate(const IComparatorPtr comparator,
+                                      const ComparableImage &first,
+                                      const ComparableImage &second
+                                      )
+{
+    // The images are converted once for all the samples
+    QImage firstImage = first.getImage().convertToFormat(QImage::Format_ARGB32);
+    QImage secondImage = second.getImage().convertToFormat(QImage::Format_ARGB32);
+    int step = getStep(firstImage.size());
+
+    QList<ComparisonResultVariantPtr> results;
+    for (int i = 0; i < mSampleCount; ++i) {
+        auto sample = makeStratifiedSample(firstImage, secondImage, step, i + 1);
+        results.append(compareSample(comparator,
+                                     sample.first,
+                                     first.getImageName(),
+                                     sample.second,
+                                     second.getImageName()
+                                     ));
+    }
+    QString methodDescription = QString("%1 stratified samples of 1/%2 of the pixels")
+                                    .arg(mSampleCount)
+                                    .arg(step * step);
+
+    QList<MetricEstimate> metrics;
+    auto firstMetrics = results.first()->getMetrics();
+    for (int i = 0; i < firstMetrics.size(); ++i) {
+        QList<double> values;
+        foreach (auto result, results) {
+            auto resultMetrics = result->getMetrics();
+            if (i < resultMetrics.size()) {
+                values.append(resultMetrics[i].value);
+            }
+        }
+        metrics.append(estimateMetric(firstMetrics[i].name, values));
+    }
+    return formatResultToHtml(metrics, results.first()->getStringResult(), methodDescription);
+}
+
+QPair<QImage, QImage> ComparisonEstimator::makeStratifiedSample(const QImage &first,
+                                                                const QImage &second,
+                                                                int step,
+                                                                quint32 seed
+                                                                )
+{
+    if (first.size() != second.size()) {
+        throw std::runtime_error("Error: Images have different sizes. Comparison is not possible.");
+    }
+    step = std::max(1, step);
+    QImage firstPixels = first.convertToFormat(QImage::Format_ARGB32);
+    QImage secondPixels = second.convertToFormat(QImage::Format_ARGB32);
+    int width = first.width();
+    int height = first.height();
+    int sampleWidth = (width + step - 1) / step;
+    int sampleHeight = (height + step - 1) / step;
+
+    QImage firstSample(sampleWidth, sampleHeight, QImage::Format_ARGB32);
+    QImage secondSample(sampleWidth, sampleHeight, QImage::Format_ARGB32);
+    std::mt19937 random(seed);
+    for (int blockY = 0; blockY < sampleHeight; ++blockY) {
+        int blockHeight = std::min(step, height - blockY * step);
+        auto firstSampleLine = reinterpret_cast<QRgb*>(firstSample.scanLine(blockY));
+        auto secondSampleLine = reinterpret_cast<QRgb*>(secondSample.scanLine(blockY));
+        for (int blockX = 0; blockX < sampleWidth; ++blockX) {
+            int blockWidth = std::min(step, width - blockX * step);
+            int x = blockX * step + static_cast<int>(random() % blockWidth);
+            int y = blockY * step + static_cast<int>(random() % blockHeight);
+            firstSampleLine[blockX] = reinterpret_cast<const QRgb*>(firstPixels.constScanLine(y))[x];
+            secondSampleLine[blockX] = reinterpret_cast<const QRgb*>(secondPixels.constScanLine(y))[x];
+        }
+    }
+    return { firstSample, secondSample };
+}
+
+MetricEstimate ComparisonEstimator::estimateMetric(const QString &name, const QList<double> &values) {
+    MetricEstimate estimate;
+    estimate.name = name;
+    if (values.isEmpty()) {
+        return estimate;
+    }
+    double sum = 0.0;
+    foreach (auto value, values) {
+        sum += value;
+    }
+    estimate.value = sum / values.size();
+
+    int degreesOfFreedom = values.size() - 1;
+    if (degreesOfFreedom < 1 || degreesOfFreedom > static_cast<int>(std::size(studentT95))) {
+        return estimate; // the margin of error is unknown
+    }
+    double squaredDeviations = 0.0;
+    foreach (auto value, values) {
+        squaredDeviations += (value - estimate.value) * (value - estimate.value);
+    }
+    double standardError = std::sqrt(squaredDeviations / degreesOfFreedom / values.size());
+    estimate.marginOfError = studentT95[degreesOfFreedom - 1] * standardError;
+    return estimate;
+}
+
+int ComparisonEstimator::getStep(const QSize &imageSize) {
+    double pixelCount = static_cast<double>(imageSize.width()) * imageSize.height();
+    return std::max(2, static_cast<int>(std::ceil(std::sqrt(pixelCount / mSamplePixelCount))));
+}
+
+ComparisonResultVariantPtr ComparisonEstimator::compareSample(const IComparatorPtr comparator,
+                                                              const QImage &first,
+                                                              const QString &firstImageName,
+                                                              const QImage &second,
+                                                              const QString &secondImageName
+                                                              )
+{
+    ComparableImage firstSample { first, firstImageName };
+    ComparableImage secondSample { second, secondImageName };
+    RowDifferenceMap rowDifferences = RowDifferenceMap::build(first, second);
+    firstSample.setRowDifferences(rowDifferences);
+    secondSample.setRowDifferences(rowDifferences);
+
+    auto result = comparator->compare(firstSample, secondSample);
+    if (result.get() == nullptr || result->getType() != ComparisonResultVariantType::String) {
+        throw std::runtime_error("Error: The comparator returns an incorrect result.");
+    }
+    return result;
+}
+
+QString ComparisonEstimator::formatResultToHtml(const QList<MetricEstimate> &metrics,
+                                                const QString &sampleHtml,
+                                                const QString &methodDescription
+                                                )
+{
+    QString html;
+    html += QString("<p><b><font color=\"#c07000\">Estimate</font></b> from %1. "
+                    "The exact result is being calculated.</p>").arg(methodDescription);
+    if (!metrics.isEmpty()) {
+        html += "<table border=\"1\" cellspacing=\"0\" cellpadding=\"5\">";
+        html += "<tr><th>Metric</th><th>Estimate (95% confidence interval)</th></tr>";
+        foreach (auto metric, metrics) {
+            QString value = QString::number(metric.value, 'f', 3);
+            if (metric.marginOfError >= 0.0) {
+                value += QString(" ± %1").arg(metric.marginOfError, 0, 'f', 3);
+            }
+            html += QString("<tr><td>%1</td><td>%2</td></tr>").arg(metric.name, value);
+        }
+        html += "</table><br />";
+    }
+    html += sampleHtml;
+    return html;
+}
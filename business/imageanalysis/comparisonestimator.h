@@ -0,0 +1,76 @@
+#ifndef COMPARISONESTIMATOR_H
+#define COMPARISONESTIMATOR_H
+
+#include <QImage>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <domain/interfaces/business/icomparator.h>
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct MetricEstimate {
+    QString name;
+    double value = 0.0;           // The mean of the metric over the samples
+    double marginOfError = -1.0;  // The half-width of the 95% confidence interval, -1 if it is unknown
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// Estimates the string result of a comparator on large images quickly, so the
+// estimate is shown at once while the exact result is calculated in the background.
+//
+// For EstimationMethod::PixelSample the images are split into blocks of step x step
+// pixels and a pixel at a random position of every block is taken, at the same
+// position in both images. Such a stratified sample covers the whole image evenly.
+// The comparator is run on mSampleCount independent samples: the estimate of every
+// metric (see ComparisonMetric) is the mean over the samples, and its confidence
+// interval follows from their spread (Student's t-distribution).
+
+class ComparisonEstimator
+{
+public:
+    ComparisonEstimator() = delete;
+    ~ComparisonEstimator() = delete;
+
+    // Smaller images are compared exactly at once
+    static bool isEstimateUseful(const IComparatorPtr comparator,
+                                 const QSize &firstImageSize,
+                                 const QSize &secondImageSize
+                                 );
+
+    // Returns the HTML of the estimate. Throws std::runtime_error if the comparator fails.
+    static QString estimate(const IComparatorPtr comparator,
+                            const ComparableImage &first,
+                            const ComparableImage &second
+                            );
+
+    // The images must have the same size; the sample has one pixel of every block.
+    // Images of other formats than Format_ARGB32 are converted on every call.
+    static QPair<QImage, QImage> makeStratifiedSample(const QImage &first,
+                                                      const QImage &second,
+                                                      int step,
+                                                      quint32 seed
+                                                      );
+
+    static MetricEstimate estimateMetric(const QString &name, const QList<double> &values);
+
+    static constexpr qint64 mMinPixelCount = 8'000'000;
+    static constexpr qint64 mSamplePixelCount = 500'000;
+    static constexpr int mSampleCount = 4;
+
+private:
+    static int getStep(const QSize &imageSize);
+    static ComparisonResultVariantPtr compareSample(const IComparatorPtr comparator,
+                                                    const QImage &first,
+                                                    const QString &firstImageName,
+                                                    const QImage &second,
+                                                    const QString &secondImageName
+                                                    );
+    static QString formatResultToHtml(const QList<MetricEstimate> &metrics,
+                                      const QString &sampleHtml,
+                                      const QString &methodDescription
+                                      );
+};
+
+#endif // COMPARISONESTIMATOR_H
@@ -55,16 +55,32 @@ QString ColoredDifferenceInPixelValuesComporator::getDescription() const {
     }
 }
 
+bool ColoredDifferenceInPixelValuesComporator::isDifferenceBased() const {
+    return true;
+}
+
+bool ColoredDifferenceInPixelValuesComporator::isTileRenderingSupported() const {
+    return mExpectedResult == Result::Image;
+}
+
+QImage ColoredDifferenceInPixelValuesComporator::renderTile(const ComparableImage &first,
+                                                            const ComparableImage &second,
+                                                            const QRect &area
+                                                            ) const
+{
+    PixelsAbsolutValueHelper helper {};
+    return helper.generateDifferenceImage(PixelsAbsolutValueHelper::getDifferencePlane(first, second), area);
+}
+
 ComparisonResultVariantPtr ColoredDifferenceInPixelValuesComporator::compare(const ComparableImage &first,
                                                                              const ComparableImage &second
                                                                             )
 {
     PixelsAbsolutValueHelper helper {};
+    DifferencePlane differencePlane = PixelsAbsolutValueHelper::getDifferencePlane(first, second);
 
     if (mExpectedResult == Result::Text) {
-        QList<PixelDifferenceRange> ranges = helper.generateDifferenceStringResult(first.getImage(),
-                                                                                   second.getImage()
-                                                                                  );
+        QList<PixelDifferenceRange> ranges = helper.generateDifferenceStringResult(differencePlane);
 
         QString result = PixelsAbsolutValueFormatter::formatResultToHtml(ranges,
                                                                          getFullName()
@@ -72,9 +88,13 @@ ComparisonResultVariantPtr ColoredDifferenceInPixelValuesComporator::compare(con
         return std::make_shared<ComparisonResultVariant>(result);
 
     } else if (mExpectedResult == Result::Image){
-        QImage result = helper.generateDifferenceImage(first.getImage(), second.getImage());
+        QImage result = helper.generateDifferenceImage(differencePlane);
         return std::make_shared<ComparisonResultVariant>(result);
     }
 
     throw runtime_error("Bad Result type in PixelsAbsoluteValueComparator::compare.");
 }
+
+std::shared_ptr<IImageProcessor> ColoredDifferenceInPixelValuesComporator::clone() const {
+    return std::make_shared<ColoredDifferenceInPixelValuesComporator>(*this);
+}
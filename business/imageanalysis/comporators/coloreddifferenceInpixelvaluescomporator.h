@@ -23,6 +23,12 @@ public:
     QString getDescription() const override;
     QString getFullName() const override;
     ComparisonResultVariantPtr compare(const ComparableImage &first, const ComparableImage &second) override;
+    bool isDifferenceBased() const override;
+    bool isTileRenderingSupported() const override;
+    QImage renderTile(const ComparableImage &first,
+                      const ComparableImage &second,
+                      const QRect &area) const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     Result mExpectedResult;
@@ -48,6 +48,10 @@ QString ColorsSaturationComporator::getFullName() const {
     return "Comparison of image saturation";
 }
 
+EstimationMethod ColorsSaturationComporator::getEstimationMethod() const {
+    return EstimationMethod::PixelSample;
+}
+
 QString ColorsSaturationComporator::getHotkey() const {
     return "T";
 }
@@ -69,7 +73,12 @@ ComparisonResultVariantPtr ColorsSaturationComporator::compare(const ComparableI
                                 );
 
     QString html = ColorsSaturationComporator::formatResultToHtml(result);
-    return std::make_shared<ComparisonResultVariant>(html);
+    auto resultVariant = std::make_shared<ComparisonResultVariant>(html);
+    resultVariant->setMetrics({
+        { "Saturation of " + result.firstImageName, result.firstImageSaturation },
+        { "Saturation of " + result.secondImageName, result.secondImageSaturation }
+    });
+    return resultVariant;
 }
 
 QString ColorsSaturationComporator::formatResultToHtml(const ColorsSaturationComparisonResult& result) {
@@ -106,3 +115,7 @@ QString ColorsSaturationComporator::formatResultToHtml(const ColorsSaturationCom
 
     return html;
 }
+
+std::shared_ptr<IImageProcessor> ColorsSaturationComporator::clone() const {
+    return std::make_shared<ColorsSaturationComporator>(*this);
+}
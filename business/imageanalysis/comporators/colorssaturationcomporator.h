@@ -32,8 +32,10 @@ public:
     QString getHotkey() const override;
     QString getDescription() const override;
     QString getFullName() const override;
+    EstimationMethod getEstimationMethod() const override;
     ComparisonResultVariantPtr compare(const ComparableImage &first,
                                        const ComparableImage &second) override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     ColorsSaturationComparisonResult compareImages(const QImage &image1,
@@ -1,52 +1,59 @@
 #include <QFileInfo>
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include <business/imageanalysis/comporators/helpers/mathhelper.h>
+#include <domain/kernels/pixelkernels.h>
 
 #include "contrastcomporator.h"
 
 // Method to compare the contrast of two images
-ContrastComparisonResult ContrastComporator::compareImages(const QImage &image1,
-                                                           const QString &name1,
-                                                           const QImage &image2,
-                                                           const QString &name2
+ContrastComparisonResult ContrastComporator::compareImages(const ComparableImage &first,
+                                                           const ComparableImage &second
                                                            )
 {
     // Calculate contrast for both images
-    double contrast1 = calculateContrast(image1);
-    double contrast2 = calculateContrast(image2);
+    double contrast1 = calculateContrast(first);
+    double contrast2 = calculateContrast(second);
 
-    return { name1, name2, contrast1, contrast2 };
+    return { first.getImageName(), second.getImageName(), contrast1, contrast2 };
+}
+
+double ContrastComporator::calculateContrast(const ComparableImage &image) {
+    auto integralImage = image.getIntegralImage();
+    if (integralImage == nullptr || integralImage->isNull()) {
+        return calculateContrast(image.getImage());
+    }
+    return integralImage->getRegionSums(StatisticsChannel::Luminance,
+                                        image.getRegionOfInterest()
+                                        ).getStandardDeviation();
 }
 
 // Method to calculate the contrast of an image
 double ContrastComporator::calculateContrast(const QImage &image) {
-    double meanLuminance = 0.0;  // Average luminance
-    double variance = 0.0;       // Variance of luminance
-
     int width = image.width();
     int height = image.height();
-    int pixelCount = width * height;
-
-    // Calculate the average luminance of all pixels
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QColor color = image.pixelColor(x, y);
-            double luminance = 0.2126 * color.red() + 0.7152 * color.green() + 0.0722 * color.blue();
-            meanLuminance += luminance;
-        }
+    double pixelCount = static_cast<double>(width) * height;
+    if (pixelCount == 0) {
+        return 0.0;
     }
-    meanLuminance /= pixelCount;
 
-    // Calculate the variance of luminance
+    // The luminance (Rec. 709) of every pixel is rounded to an integer,
+    // so its sums are exact and are calculated in a single pass
+    QImage pixels = image.convertToFormat(QImage::Format_ARGB32);
+    std::vector<uchar> luminance(width);
+    quint64 luminanceSum = 0;
+    quint64 luminanceSquaresSum = 0;
     for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QColor color = image.pixelColor(x, y);
-            double luminance = 0.2126 * color.red() + 0.7152* color.green() + 0.0722 * color.blue();
-            variance += std::pow(luminance - meanLuminance, 2);
-        }
+        PixelKernels::luminance(reinterpret_cast<const QRgb*>(pixels.constScanLine(y)), luminance.data(), width);
+        luminanceSum += PixelKernels::sum(luminance.data(), width);
+        luminanceSquaresSum += PixelKernels::sumOfSquares(luminance.data(), width);
     }
-    variance /= pixelCount;
+
+    // Average luminance and variance of luminance
+    double meanLuminance = luminanceSum / pixelCount;
+    double variance = std::max(0.0, luminanceSquaresSum / pixelCount - meanLuminance * meanLuminance);
 
     // Return the standard deviation of luminance as the contrast value
     return std::sqrt(variance);
@@ -60,6 +67,10 @@ QString ContrastComporator::getFullName() const {
     return "Comparison of image contrast";
 }
 
+EstimationMethod ContrastComporator::getEstimationMethod() const {
+    return EstimationMethod::PixelSample;
+}
+
 QString ContrastComporator::getHotkey() const {
     return "K";
 }
@@ -76,13 +87,14 @@ std::shared_ptr<ComparisonResultVariant> ContrastComporator::compare(
                                                             const ComparableImage& second
                                                             )
 {
-    auto result = compareImages(first.getImage(),
-                                first.getImageName(),
-                                second.getImage(),
-                                second.getImageName()
-                                );
+    auto result = compareImages(first, second);
     QString html = ContrastComporator::formatResultToHtml(result);
-    return std::make_shared<ComparisonResultVariant>(html);
+    auto resultVariant = std::make_shared<ComparisonResultVariant>(html);
+    resultVariant->setMetrics({
+        { "Contrast of " + result.firstImageName, result.firstImageContrast },
+        { "Contrast of " + result.secondImageName, result.secondImageContrast }
+    });
+    return resultVariant;
 }
 
 QString ContrastComporator::formatResultToHtml(const ContrastComparisonResult& result) {
@@ -120,3 +132,7 @@ QString ContrastComporator::formatResultToHtml(const ContrastComparisonResult& r
 
     return html;
 }
+
+std::shared_ptr<IImageProcessor> ContrastComporator::clone() const {
+    return std::make_shared<ContrastComporator>(*this);
+}
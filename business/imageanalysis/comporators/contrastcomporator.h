@@ -35,15 +35,18 @@ public:
     std::shared_ptr<ComparisonResultVariant> compare(const ComparableImage& first,
                                                      const ComparableImage& second) override;
     QString getFullName() const override;
+    EstimationMethod getEstimationMethod() const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
+
+    // Standard deviation of the Rec. 709 luminance; also used by the video comparison.
+    static double calculateContrast(const QImage &image);
 
 private:
-    ContrastComparisonResult compareImages(const QImage &image1,
-                                           const QString &path1,
-                                           const QImage &image2,
-                                           const QString &path2
-                                           );
+    ContrastComparisonResult compareImages(const ComparableImage &first, const ComparableImage &second);
+
+    // From the summed-area tables of the image if they are set
+    static double calculateContrast(const ComparableImage &image);
     QString formatResultToHtml(const ContrastComparisonResult &result);
-    static double calculateContrast(const QImage &image);
 };
 
 
@@ -44,6 +44,51 @@ bool CustomRangedDifferenceInPixelValuesComparator::isPartOfAutoReportingToolbox
     return false;
 }
 
+bool CustomRangedDifferenceInPixelValuesComparator::isDifferenceBased() const {
+    return true;
+}
+
+bool CustomRangedDifferenceInPixelValuesComparator::isPreviewSupported() const {
+    return true;
+}
+
+QImage CustomRangedDifferenceInPixelValuesComparator::renderPreview(const DifferencePlane &differencePlane,
+                                                                    const QList<Property> &properties,
+                                                                    const QRect &area
+                                                                    ) const
+{
+    if (properties.size() != 2) {
+        return {};
+    }
+    // An invalid range (the start is greater than the end) results in a null image
+    PixelsAbsolutValueHelper helper {};
+    return helper.generateDifferenceImageByCustomRage(differencePlane,
+                                                      static_cast<int>(properties[0].getValue()),
+                                                      static_cast<int>(properties[1].getValue()),
+                                                      area
+                                                      );
+}
+
+bool CustomRangedDifferenceInPixelValuesComparator::isTileRenderingSupported() const {
+    return true;
+}
+
+QImage CustomRangedDifferenceInPixelValuesComparator::renderTile(const ComparableImage &first,
+                                                                 const ComparableImage &second,
+                                                                 const QRect &area
+                                                                 ) const
+{
+    if (mStartOfRange > mEndOfRange) {
+        throw std::runtime_error("The start of the range cannot be greater than its end.");
+    }
+    PixelsAbsolutValueHelper helper {};
+    return helper.generateDifferenceImageByCustomRage(PixelsAbsolutValueHelper::getDifferencePlane(first, second),
+                                                      mStartOfRange,
+                                                      mEndOfRange,
+                                                      area
+                                                      );
+}
+
 QString CustomRangedDifferenceInPixelValuesComparator::getShortName() const {
     return "Difference In Pixel Values v.4 (Image, Custom Range, Single Color)";
 }
@@ -78,10 +123,14 @@ ComparisonResultVariantPtr CustomRangedDifferenceInPixelValuesComparator::compar
 
     PixelsAbsolutValueHelper helper {};
 
-    QImage result = helper.generateDifferenceImageByCustomRage(first.getImage(),
-                                                               second.getImage(),
-                                                               mStartOfRange,
-                                                               mEndOfRange
-                                                               );
+    QImage result = helper.generateDifferenceImageByCustomRage(
+                                            PixelsAbsolutValueHelper::getDifferencePlane(first, second),
+                                            mStartOfRange,
+                                            mEndOfRange
+                                            );
     return std::make_shared<ComparisonResultVariant>(result);
 }
+
+std::shared_ptr<IImageProcessor> CustomRangedDifferenceInPixelValuesComparator::clone() const {
+    return std::make_shared<CustomRangedDifferenceInPixelValuesComparator>(*this);
+}
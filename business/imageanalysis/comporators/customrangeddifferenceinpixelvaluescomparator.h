@@ -21,6 +21,16 @@ public:
     void setProperties(QList<Property> properties) override;
     void reset() override;
     bool isPartOfAutoReportingToolbox() override;
+    bool isDifferenceBased() const override;
+    bool isPreviewSupported() const override;
+    QImage renderPreview(const DifferencePlane &differencePlane,
+                         const QList<Property> &properties,
+                         const QRect &area) const override;
+    bool isTileRenderingSupported() const override;
+    QImage renderTile(const ComparableImage &first,
+                      const ComparableImage &second,
+                      const QRect &area) const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     int mStartOfRange, mEndOfRange;
@@ -0,0 +1,138 @@
+#include "differingrowbandscomparator.h"
+
+#include <algorithm>
+#include <optional>
+#include <business/imageanalysis/comporators/helpers/mathhelper.h>
+#include <domain/valueobjects/rowindex.h>
+
+
+QList<DifferingRowBand> DifferingRowBandsComparator::findBands(const QImage &image1, const QImage &image2) {
+    QImage first = image1.convertToFormat(QImage::Format_RGB32);
+    QImage second = image2.convertToFormat(QImage::Format_RGB32);
+    RowIndex firstIndex { first };
+    RowIndex secondIndex { second };
+
+    auto differences = RowIndex::calculateRowDifferences(firstIndex, secondIndex);
+
+    QList<DifferingRowBand> bands;
+    std::optional<DifferingRowBand> band;
+    double bandDifferenceSum = 0.0;
+    for (int y = 0; y <= first.height(); ++y) {
+        bool isDifferent = y < first.height() && !RowIndex::isRowEqual(firstIndex, secondIndex, y);
+        if (isDifferent) {
+            int maxDifference = RowIndex::calculateMaxDifference(first.constScanLine(y),
+                                                                 second.constScanLine(y),
+                                                                 first.width() * 4
+                                                                 );
+            if (!band) {
+                band = DifferingRowBand { y, y, 0, 0.0 };
+                bandDifferenceSum = 0.0;
+            }
+            band->lastRow = y;
+            band->maxDifference = std::max(band->maxDifference, maxDifference);
+            bandDifferenceSum += differences[y];
+        } else if (band) {
+            band->meanDifference = bandDifferenceSum / (band->lastRow - band->firstRow + 1);
+            bands.append(band.value());
+            band = std::nullopt;
+        }
+    }
+    return bands;
+}
+
+QString DifferingRowBandsComparator::getShortName() const {
+    return "Differing Row Bands";
+}
+
+QString DifferingRowBandsComparator::getFullName() const {
+    return "Bands of rows in which the images differ";
+}
+
+QString DifferingRowBandsComparator::getHotkey() const {
+    return "W";
+}
+
+bool DifferingRowBandsComparator::isDifferenceBased() const {
+    return true;
+}
+
+QString DifferingRowBandsComparator::getDescription() const {
+    return QString("This algorithm finds the horizontal bands of rows in which two images differ. ")
+           + "Identical rows are recognized by their hashes, so only the differing rows are "
+           + "compared pixel by pixel. It is useful for captures with tearing or partial updates.";
+}
+
+std::shared_ptr<ComparisonResultVariant> DifferingRowBandsComparator::compare(const ComparableImage &first,
+                                                                              const ComparableImage &second
+                                                                              )
+{
+    QImage image1 = first.getImage();
+    QImage image2 = second.getImage();
+    if (image1.size() != image2.size()) {
+        throw std::runtime_error("Error: the images must have the same size.");
+    }
+    auto bands = findBands(image1, image2);
+    QString html = formatResultToHtml(bands, image1.height());
+    return std::make_shared<ComparisonResultVariant>(html);
+}
+
+QString DifferingRowBandsComparator::formatResultToHtml(const QList<DifferingRowBand> &bands, int height) {
+    int differingRows = 0;
+    foreach (auto band, bands) {
+        differingRows += band.lastRow - band.firstRow + 1;
+    }
+    double differingRowsPercent = height > 0 ? 100.0 * differingRows / height : 0.0;
+
+    QString html;
+    html += QString("<h2 style=\"line-height: 2;\">%1</h2>").arg(getFullName());
+    html += "<table border=\"1\" cellspacing=\"0\" cellpadding=\"5\">";
+    html += QString("<tr><td>Differing rows</td><td align=\"right\">%1 of %2 (%3)</td></tr>")
+                .arg(differingRows)
+                .arg(height)
+                .arg(MathHelper::formatPercentageValue(differingRowsPercent, 2));
+    html += QString("<tr><td>Bands of differing rows</td><td align=\"right\">%1</td></tr>")
+                .arg(bands.size());
+    html += "</table>";
+
+    if (bands.isEmpty()) {
+        html += "<br/><b>The images are identical.</b>";
+        return html;
+    }
+
+    // The largest bands are the most interesting ones; they are listed top to bottom
+    QList<DifferingRowBand> reportedBands = bands;
+    if (reportedBands.size() > mMaxReportedBands) {
+        std::sort(reportedBands.begin(), reportedBands.end(), [](const auto &a, const auto &b) {
+            return (a.lastRow - a.firstRow) > (b.lastRow - b.firstRow);
+        });
+        reportedBands = reportedBands.mid(0, mMaxReportedBands);
+        std::sort(reportedBands.begin(), reportedBands.end(), [](const auto &a, const auto &b) {
+            return a.firstRow < b.firstRow;
+        });
+    }
+
+    html += "<br/><table border=\"1\" cellspacing=\"0\" cellpadding=\"5\">";
+    html += "<tr><th>Rows</th><th>Height</th><th>Max difference</th><th>Mean luminance difference</th></tr>";
+    foreach (auto band, reportedBands) {
+        html += QString("<tr><td>%1 - %2</td><td align=\"right\">%3</td><td align=\"right\">%4</td>"
+                        "<td align=\"right\">%5</td></tr>")
+                    .arg(band.firstRow)
+                    .arg(band.lastRow)
+                    .arg(band.lastRow - band.firstRow + 1)
+                    .arg(band.maxDifference)
+                    .arg(band.meanDifference, 0, 'f', 2);
+    }
+    html += "</table>";
+    if (bands.size() > reportedBands.size()) {
+        html += QString("<br/>Only the %1 highest bands are listed.").arg(reportedBands.size());
+    }
+    html += "<br/><br/>";
+    html += QString("The max difference is the largest difference of the color channels in the band [0, 255]. ")
+            + "A single band that starts in the middle of the image and reaches its bottom "
+            + "usually means that the second image is torn.";
+    return html;
+}
+
+std::shared_ptr<IImageProcessor> DifferingRowBandsComparator::clone() const {
+    return std::make_shared<DifferingRowBandsComparator>(*this);
+}
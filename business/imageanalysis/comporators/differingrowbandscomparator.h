@@ -0,0 +1,49 @@
+#ifndef DIFFERINGROWBANDSCOMPARATOR_H
+#define DIFFERINGROWBANDSCOMPARATOR_H
+
+#include <domain/interfaces/business/icomparator.h>
+
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct DifferingRowBand {
+    int firstRow;
+    int lastRow;
+    int maxDifference;        // The max difference of the color channels in the band
+    double meanDifference;    // The mean luminance difference of the rows of the band
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// This class finds the horizontal bands of rows in which two images differ.
+// Most of the differing rows are recognized by their hashes and rows with equal
+// hashes are confirmed by their bytes (see RowIndex), so only the rows that
+// differ are compared pixel by pixel. This is useful for captures with
+// tearing or partial updates, where only a part of the frame differs.
+
+class DifferingRowBandsComparator : public IComparator
+{
+public:
+    DifferingRowBandsComparator() = default;
+    virtual ~DifferingRowBandsComparator() = default;
+
+    // IComparator interface
+
+    QString getShortName() const override;
+    QString getHotkey() const override;
+    QString getDescription() const override;
+    ComparisonResultVariantPtr compare(const ComparableImage &first,
+                                       const ComparableImage &second) override;
+    QString getFullName() const override;
+    bool isDifferenceBased() const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
+
+private:
+    // Only the largest bands are listed in the report
+    const int mMaxReportedBands = 100;
+
+    QList<DifferingRowBand> findBands(const QImage &image1, const QImage &image2);
+    QString formatResultToHtml(const QList<DifferingRowBand> &bands, int height);
+};
+
+#endif // DIFFERINGROWBANDSCOMPARATOR_H
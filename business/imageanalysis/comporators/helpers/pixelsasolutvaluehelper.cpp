@@ -1,14 +1,26 @@
 #include "pixelsasolutvaluehelper.h"
 
 
+DifferencePlane PixelsAbsolutValueHelper::getDifferencePlane(const ComparableImage &first,
+                                                             const ComparableImage &second
+                                                             )
+{
+    if (!first.getDifferencePlane().isNull()) {
+        return first.getDifferencePlane();
+    }
+    return DifferencePlane::build(first.getImage(), second.getImage(), first.getRowDifferences());
+}
+
 QList<PixelDifferenceRange> PixelsAbsolutValueHelper::generateDifferenceStringResult(const QImage &image1,
-                                                                                     const QImage &image2
+                                                                                     const QImage &image2,
+                                                                                     const RowDifferenceMap &rowDifferences
                                                                                     )
 {
-    // General image parameters
-    int width = image1.width();
-    int height = image1.height();
-    int totalPixels = width * height;
+    return generateDifferenceStringResult(DifferencePlane::build(image1, image2, rowDifferences));
+}
+
+QList<PixelDifferenceRange> PixelsAbsolutValueHelper::generateDifferenceStringResult(const DifferencePlane &differencePlane) {
+    int totalPixels = differencePlane.width() * differencePlane.height();
 
     // Define difference ranges
     QList<PixelDifferenceRange> ranges = {
@@ -21,18 +33,14 @@ QList<PixelDifferenceRange> PixelsAbsolutValueHelper::generateDifferenceStringRe
         PixelDifferenceRange(151, 200), PixelDifferenceRange(201, 255)
     };
 
-    // Loop through each pixel and calculate the differences
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QColor color1 = image1.pixelColor(x, y);
-            QColor color2 = image2.pixelColor(x, y);
-            int maxDiff = calculateDiff(color1, color2);
-            // Increment the count for the corresponding range
-            for (auto &range : ranges) {
-                if (maxDiff >= range.minDifference && maxDiff <= range.maxDifference) {
-                    range.pixelCount++; // Increment pixel count
-                    break;
-                }
+    // Every pixel with the same difference falls into the same range,
+    // so the ranges are filled from the histogram of the difference plane.
+    QList<qint64> histogram = differencePlane.getHistogram();
+    for (int difference = 0; difference < histogram.size(); ++difference) {
+        for (auto &range : ranges) {
+            if (difference >= range.minDifference && difference <= range.maxDifference) {
+                range.pixelCount += static_cast<int>(histogram[difference]);
+                break;
             }
         }
     }
@@ -85,6 +93,21 @@ std::map<int, QColor> PixelsAbsolutValueHelper::generateColorMap(const QList<Pix
     return colorMap;
 }
 
+// The color of every difference value [0, 255]; values outside of the ranges are white.
+// If the ranges overlap, the first one wins.
+QList<QRgb> PixelsAbsolutValueHelper::generateColorTable(const QList<PixelDifferenceRange> &ranges) {
+    std::map<int, QColor> colorMap = generateColorMap(ranges);
+    QList<QRgb> colorTable(256, QColor(Qt::white).rgba());
+    for (int i = ranges.size() - 1; i >= 0; --i) {
+        int minDifference = std::max(0, ranges[i].minDifference);
+        int maxDifference = std::min(255, ranges[i].maxDifference);
+        for (int difference = minDifference; difference <= maxDifference; ++difference) {
+            colorTable[difference] = colorMap[i].rgba();
+        }
+    }
+    return colorTable;
+}
+
 QString PixelsAbsolutValueHelper::getColorRangeDescription() {
     QString description =
         "<html>"
@@ -118,59 +141,67 @@ QString PixelsAbsolutValueHelper::getColorRangeDescription() {
 QImage PixelsAbsolutValueHelper::generateDifferenceImageByCustomRage(const QImage &image1,
                                                                      const QImage &image2,
                                                                      int startOfRange,
-                                                                     int endOfRange
+                                                                     int endOfRange,
+                                                                     const RowDifferenceMap &rowDifferences
                                                                      )
 {
     if (startOfRange > endOfRange) {
         return {};
     }
+    return generateDifferenceImageByCustomRage(DifferencePlane::build(image1, image2, rowDifferences),
+                                               startOfRange,
+                                               endOfRange
+                                               );
+}
 
-    int width = image1.width();
-    int height = image1.height();
+QImage PixelsAbsolutValueHelper::generateDifferenceImageByCustomRage(const DifferencePlane &differencePlane,
+                                                                     int startOfRange,
+                                                                     int endOfRange
+                                                                     )
+{
+    return generateDifferenceImageByCustomRage(differencePlane,
+                                               startOfRange,
+                                               endOfRange,
+                                               QRect(QPoint(0, 0), differencePlane.size())
+                                               );
+}
+
+QImage PixelsAbsolutValueHelper::generateDifferenceImageByCustomRage(const DifferencePlane &differencePlane,
+                                                                     int startOfRange,
+                                                                     int endOfRange,
+                                                                     const QRect &area
+                                                                     )
+{
+    if (startOfRange > endOfRange) {
+        return {};
+    }
 
     // Define difference ranges
     QList<PixelDifferenceRange> ranges = { PixelDifferenceRange(0, 0), // skip the white color
                                            PixelDifferenceRange(startOfRange, endOfRange)
                                          };
 
-    // Generate a color map for each range
-    std::map<int, QColor> colorMap = generateColorMap(ranges);
-
-    // Create the output image
-    QImage outputImage(width, height, QImage::Format_ARGB32);
-    outputImage.fill(Qt::white); // Start with a white background
-
-    // Loop through each pixel and calculate the differences
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QColor color1 = image1.pixelColor(x, y);
-            QColor color2 = image2.pixelColor(x, y);
-            int maxDiff = calculateDiff(color1, color2);
-
-            // Find the corresponding range for the difference and apply the color
-            for (int i = 0; i < ranges.size(); ++i) {
-                const auto& range = ranges[i];
-                if (maxDiff >= range.minDifference && maxDiff <= range.maxDifference) {
-                    // White background mode: draw only differing pixels
-                    outputImage.setPixelColor(x, y, colorMap[i]);
-                    break;
-                }
-            }
-        }
-    }
-
-    return outputImage;
-
+    // White background mode: draw only differing pixels
+    return differencePlane.map(generateColorTable(ranges), area);
 }
 
 // Function to generate the difference visualization image
 QImage PixelsAbsolutValueHelper::generateDifferenceImage(const QImage &image1,
-                                                         const QImage &image2
+                                                         const QImage &image2,
+                                                         const RowDifferenceMap &rowDifferences
                                                          )
 {
-    int width = image1.width();
-    int height = image1.height();
+    return generateDifferenceImage(DifferencePlane::build(image1, image2, rowDifferences));
+}
 
+QImage PixelsAbsolutValueHelper::generateDifferenceImage(const DifferencePlane &differencePlane) {
+    return generateDifferenceImage(differencePlane, QRect(QPoint(0, 0), differencePlane.size()));
+}
+
+QImage PixelsAbsolutValueHelper::generateDifferenceImage(const DifferencePlane &differencePlane,
+                                                         const QRect &area
+                                                         )
+{
     // Define difference ranges
     QList<PixelDifferenceRange> ranges = {
         PixelDifferenceRange(0, 0), PixelDifferenceRange(1, 1), PixelDifferenceRange(2, 2),
@@ -180,31 +211,6 @@ QImage PixelsAbsolutValueHelper::generateDifferenceImage(const QImage &image1,
         PixelDifferenceRange(51, 255)
     };
 
-    // Generate a color map for each range
-    std::map<int, QColor> colorMap = generateColorMap(ranges);
-
-    // Create the output image
-    QImage outputImage(width, height, QImage::Format_ARGB32);
-    outputImage.fill(Qt::white); // Start with a white background
-
-    // Loop through each pixel and calculate the differences
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QColor color1 = image1.pixelColor(x, y);
-            QColor color2 = image2.pixelColor(x, y);
-            int maxDiff = calculateDiff(color1, color2);
-
-            // Find the corresponding range for the difference and apply the color
-            for (int i = 0; i < ranges.size(); ++i) {
-                const auto& range = ranges[i];
-                if (maxDiff >= range.minDifference && maxDiff <= range.maxDifference) {
-                    // White background mode: draw only differing pixels
-                    outputImage.setPixelColor(x, y, colorMap[i]);
-                    break;
-                }
-            }
-        }
-    }
-
-    return outputImage;
+    // White background mode: the pixels of the first range stay white
+    return differencePlane.map(generateColorTable(ranges), area);
 }
@@ -3,7 +3,10 @@
 
 #include <map>
 #include <qimage.h>
+#include <domain/valueobjects/comparableimage.h>
+#include <domain/valueobjects/differenceplane.h>
 #include <domain/valueobjects/pixeldiffrencerange.h>
+#include <domain/valueobjects/rowdifferencemap.h>
 
 class PixelsAbsolutValueHelper
 {
@@ -11,17 +14,46 @@ public:
     PixelsAbsolutValueHelper() = default;
     ~PixelsAbsolutValueHelper() = default;
 
-    QList<PixelDifferenceRange> generateDifferenceStringResult(const QImage &image1, const QImage &image2);
-    QImage generateDifferenceImage(const QImage &image1, const QImage &image2);
+    // The difference plane set on the first image (see ImageProcessingInteractor),
+    // or a new one if the images are compared outside of the interactor.
+    static DifferencePlane getDifferencePlane(const ComparableImage &first, const ComparableImage &second);
+
+    // The rows that are identical according to rowDifferences are not compared pixel by pixel.
+    // The overloads taking a difference plane reuse it instead of comparing the images again.
+
+    QList<PixelDifferenceRange> generateDifferenceStringResult(const DifferencePlane &differencePlane);
+    QImage generateDifferenceImage(const DifferencePlane &differencePlane);
+    QImage generateDifferenceImage(const DifferencePlane &differencePlane, const QRect &area);
+    QImage generateDifferenceImageByCustomRage(const DifferencePlane &differencePlane,
+                                               int startOfRange,
+                                               int endOfRange);
+    // Only the given area of the plane is generated, e.g. the visible part of a preview
+    QImage generateDifferenceImageByCustomRage(const DifferencePlane &differencePlane,
+                                               int startOfRange,
+                                               int endOfRange,
+                                               const QRect &area);
+
+
+    QList<PixelDifferenceRange> generateDifferenceStringResult(const QImage &image1,
+                                                               const QImage &image2,
+                                                               const RowDifferenceMap &rowDifferences = {});
+    QImage generateDifferenceImage(const QImage &image1,
+                                   const QImage &image2,
+                                   const RowDifferenceMap &rowDifferences = {});
     static QString getColorRangeDescription();
     
     QImage generateDifferenceImageByCustomRage(const QImage &image1,
                                                const QImage &image2,
                                                int startOfRange,
-                                               int endOfRange);
+                                               int endOfRange,
+                                               const RowDifferenceMap &rowDifferences = {});
+
+    // The maximum absolute difference between the R, G and B channels of two colors.
+    static int calculateDiff(QColor color1, QColor color2);
+
 private:
-    int calculateDiff(QColor color1, QColor color2);
     std::map<int, QColor> generateColorMap(const QList<PixelDifferenceRange> &ranges);
+    QList<QRgb> generateColorTable(const QList<PixelDifferenceRange> &ranges);
 };
 
 #endif // PIXELSASOLUTVALUEHELPER_H
@@ -0,0 +1,287 @@
+#include "ssimcalculator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <domain/kernels/pixelkernels.h>
+#include <domain/utils/parallel.h>
+
+
+namespace {
+
+constexpr int windowSize = 2 * SsimCalculator::mWindowRadius + 1;
+
+// The filtered quantities: x, y, x * x, y * y and x * y
+constexpr int quantityCount = 5;
+
+std::vector<float> createGaussianWindow() {
+    std::vector<float> window(windowSize);
+    double sum = 0.0;
+    for (int i = 0; i < windowSize; ++i) {
+        double distance = i - SsimCalculator::mWindowRadius;
+        window[i] = static_cast<float>(std::exp(-distance * distance /
+                                                (2.0 * SsimCalculator::mWindowSigma * SsimCalculator::mWindowSigma)));
+        sum += window[i];
+    }
+    for (auto &weight : window) {
+        weight = static_cast<float>(weight / sum);
+    }
+    return window;
+}
+
+// The source row is extended by the radius of the window at both ends
+void filterRow(const float *source, const std::vector<float> &window, float *result, int width) {
+    std::fill(result, result + width, 0.0f);
+    for (int k = 0; k < windowSize; ++k) {
+        float weight = window[k];
+        const float *shifted = source + k;
+        for (int x = 0; x < width; ++x) {
+            result[x] += weight * shifted[x];
+        }
+    }
+}
+
+void extendRow(const float *row, float *result, int width) {
+    int radius = SsimCalculator::mWindowRadius;
+    std::fill(result, result + radius, row[0]);
+    std::copy(row, row + width, result + radius);
+    std::fill(result + radius + width, result + width + 2 * radius, row[width - 1]);
+}
+
+} // namespace
+
+const QList<double> SsimCalculator::mMsSsimWeights = { 0.0448, 0.2856, 0.3001, 0.2363, 0.1333 };
+
+SsimPlane SsimCalculator::extractPlane(const QImage &image, SsimChannel channel) {
+    SsimPlane plane;
+    if (image.isNull()) {
+        return plane;
+    }
+    QImage pixels = image.convertToFormat(QImage::Format_RGB32);
+    plane.width = pixels.width();
+    plane.height = pixels.height();
+    plane.values.resize(static_cast<size_t>(plane.width) * plane.height);
+
+    std::vector<uchar> row(plane.width);
+    for (int y = 0; y < plane.height; ++y) {
+        auto line = reinterpret_cast<const QRgb*>(pixels.constScanLine(y));
+        switch (channel) {
+        case SsimChannel::Luminance:
+            PixelKernels::luminance(line, row.data(), plane.width);
+            break;
+        case SsimChannel::Red:
+            PixelKernels::extractChannel(line, row.data(), plane.width, 16);
+            break;
+        case SsimChannel::Green:
+            PixelKernels::extractChannel(line, row.data(), plane.width, 8);
+            break;
+        case SsimChannel::Blue:
+            PixelKernels::extractChannel(line, row.data(), plane.width, 0);
+            break;
+        }
+        std::copy(row.begin(), row.end(), plane.values.begin() + static_cast<size_t>(y) * plane.width);
+    }
+    return plane;
+}
+
+SsimResult SsimCalculator::calculate(const SsimPlane &first, const SsimPlane &second, bool isMapNeeded) {
+    if (first.width != second.width || first.height != second.height) {
+        throw std::runtime_error("Error: the images must be the same size to calculate SSIM.");
+    }
+    int width = first.width;
+    int height = first.height;
+
+    SsimResult result;
+    if (width == 0 || height == 0) {
+        result.ssim = 1.0;
+        result.contrastStructure = 1.0;
+        return result;
+    }
+    if (isMapNeeded) {
+        result.map.resize(static_cast<size_t>(width) * height);
+    }
+
+    const float c1 = static_cast<float>((mK1 * 255.0) * (mK1 * 255.0));
+    const float c2 = static_cast<float>((mK2 * 255.0) * (mK2 * 255.0));
+    const std::vector<float> window = createGaussianWindow();
+    const float offset = 128.0f;
+
+    int bandCount = Parallel::getBandCount(height, mMinBandHeight);
+    int bandHeight = (height + bandCount - 1) / bandCount;
+    std::vector<double> ssimSums(bandCount, 0.0);
+    std::vector<double> csSums(bandCount, 0.0);
+
+    Parallel::run(bandCount, [&](int band) {
+        int top = band * bandHeight;
+        int bottom = std::min(height, top + bandHeight);
+        if (top >= bottom) {
+            return;
+        }
+        int extendedWidth = width + 2 * mWindowRadius;
+        std::vector<float> extended(quantityCount * extendedWidth);
+        float *x = extended.data();
+        float *y = x + extendedWidth;
+        float *xx = y + extendedWidth;
+        float *yy = xx + extendedWidth;
+        float *xy = yy + extendedWidth;
+
+        // The horizontally filtered rows of every quantity, the row r is in the slot
+        // (r - top + radius) % windowSize, so the ring never has to be shifted
+        std::vector<float> ring(static_cast<size_t>(quantityCount) * windowSize * width);
+        auto getRingRow = [&](int quantity, int slot) {
+            return ring.data() + (static_cast<size_t>(quantity) * windowSize + slot) * width;
+        };
+        std::vector<float> means(quantityCount * width);
+
+        double ssimSum = 0.0;
+        double csSum = 0.0;
+        for (int r = top - mWindowRadius; r < bottom + mWindowRadius; ++r) {
+            int sourceRow = std::clamp(r, 0, height - 1);
+            extendRow(first.values.data() + static_cast<size_t>(sourceRow) * width, x, width);
+            extendRow(second.values.data() + static_cast<size_t>(sourceRow) * width, y, width);
+            // The variances are differences of large sums, so the values are centered
+            // on zero to keep the float precision; only the means depend on the offset
+            for (int i = 0; i < extendedWidth; ++i) {
+                x[i] -= offset;
+                y[i] -= offset;
+                xx[i] = x[i] * x[i];
+                yy[i] = y[i] * y[i];
+                xy[i] = x[i] * y[i];
+            }
+            int slot = (r - top + mWindowRadius) % windowSize;
+            for (int quantity = 0; quantity < quantityCount; ++quantity) {
+                filterRow(extended.data() + quantity * extendedWidth, window, getRingRow(quantity, slot), width);
+            }
+
+            // The window of the output row ends at the row that was just filtered
+            int outputRow = r - mWindowRadius;
+            if (outputRow < top) {
+                continue;
+            }
+            std::fill(means.begin(), means.end(), 0.0f);
+            for (int quantity = 0; quantity < quantityCount; ++quantity) {
+                float *mean = means.data() + quantity * width;
+                for (int k = 0; k < windowSize; ++k) {
+                    float weight = window[k];
+                    const float *row = getRingRow(quantity, (outputRow + k - top) % windowSize);
+                    for (int i = 0; i < width; ++i) {
+                        mean[i] += weight * row[i];
+                    }
+                }
+            }
+
+            const float *meanX = means.data();
+            const float *meanY = meanX + width;
+            const float *meanXX = meanY + width;
+            const float *meanYY = meanXX + width;
+            const float *meanXY = meanYY + width;
+            float *map = isMapNeeded ? result.map.data() + static_cast<size_t>(outputRow) * width : nullptr;
+            float rowSsimSum = 0.0f;
+            float rowCsSum = 0.0f;
+            for (int i = 0; i < width; ++i) {
+                float varianceX = meanXX[i] - meanX[i] * meanX[i];
+                float varianceY = meanYY[i] - meanY[i] * meanY[i];
+                float covariance = meanXY[i] - meanX[i] * meanY[i];
+                float mx = meanX[i] + offset;
+                float my = meanY[i] + offset;
+                float cs = (2.0f * covariance + c2) / (varianceX + varianceY + c2);
+                float ssim = (2.0f * mx * my + c1) / (mx * mx + my * my + c1) * cs;
+                rowCsSum += cs;
+                rowSsimSum += ssim;
+                if (map != nullptr) {
+                    map[i] = ssim;
+                }
+            }
+            ssimSum += rowSsimSum;
+            csSum += rowCsSum;
+        }
+        ssimSums[band] = ssimSum;
+        csSums[band] = csSum;
+    });
+
+    double pixelCount = static_cast<double>(width) * height;
+    for (int band = 0; band < bandCount; ++band) {
+        result.ssim += ssimSums[band];
+        result.contrastStructure += csSums[band];
+    }
+    result.ssim /= pixelCount;
+    result.contrastStructure /= pixelCount;
+    return result;
+}
+
+double SsimCalculator::calculateMultiScale(const SsimPlane &first, const SsimPlane &second) {
+    if (first.width != second.width || first.height != second.height) {
+        throw std::runtime_error("Error: the images must be the same size to calculate MS-SSIM.");
+    }
+    int scaleCount = 0;
+    int minSide = std::min(first.width, first.height);
+    while (scaleCount < mMsSsimWeights.size() && (minSide >> scaleCount) >= windowSize) {
+        ++scaleCount;
+    }
+    if (scaleCount == 0) {
+        return calculate(first, second).ssim; // the images are smaller than the window
+    }
+
+    double weightSum = 0.0;
+    for (int i = 0; i < scaleCount; ++i) {
+        weightSum += mMsSsimWeights[i];
+    }
+
+    SsimPlane scaledFirst = first;
+    SsimPlane scaledSecond = second;
+    double result = 1.0;
+    for (int scale = 0; scale < scaleCount; ++scale) {
+        SsimResult ssim = calculate(scaledFirst, scaledSecond);
+        bool isLastScale = scale == scaleCount - 1;
+        // The luminance term is used only at the coarsest scale
+        double value = isLastScale ? ssim.ssim : ssim.contrastStructure;
+        result *= std::pow(std::max(0.0, value), mMsSsimWeights[scale] / weightSum);
+        if (!isLastScale) {
+            scaledFirst = downsample(scaledFirst);
+            scaledSecond = downsample(scaledSecond);
+        }
+    }
+    return result;
+}
+
+QImage SsimCalculator::createHeatmap(const std::vector<float> &map, const QSize &size) {
+    if (static_cast<qint64>(map.size()) != static_cast<qint64>(size.width()) * size.height()) {
+        throw std::runtime_error("Error: the SSIM map does not match the size of the image.");
+    }
+    QImage heatmap { size, QImage::Format_Indexed8 };
+
+    QList<QRgb> colors;
+    for (int i = 0; i < 256; ++i) {
+        if (i < 128) {
+            colors.append(qRgb(255, 2 * i, 0));
+        } else {
+            colors.append(qRgb(255, 255, std::min(255, 2 * (i - 128) + 1)));
+        }
+    }
+    heatmap.setColorTable(colors);
+
+    for (int y = 0; y < size.height(); ++y) {
+        uchar *line = heatmap.scanLine(y);
+        const float *values = map.data() + static_cast<size_t>(y) * size.width();
+        for (int x = 0; x < size.width(); ++x) {
+            line[x] = static_cast<uchar>(std::lround(std::clamp(values[x], 0.0f, 1.0f) * 255.0f));
+        }
+    }
+    return heatmap;
+}
+
+SsimPlane SsimCalculator::downsample(const SsimPlane &plane) {
+    SsimPlane result;
+    result.width = plane.width / 2;
+    result.height = plane.height / 2;
+    result.values.resize(static_cast<size_t>(result.width) * result.height);
+    for (int y = 0; y < result.height; ++y) {
+        const float *top = plane.values.data() + static_cast<size_t>(2 * y) * plane.width;
+        const float *bottom = top + plane.width;
+        float *line = result.values.data() + static_cast<size_t>(y) * result.width;
+        for (int x = 0; x < result.width; ++x) {
+            line[x] = (top[2 * x] + top[2 * x + 1] + bottom[2 * x] + bottom[2 * x + 1]) * 0.25f;
+        }
+    }
+    return result;
+}
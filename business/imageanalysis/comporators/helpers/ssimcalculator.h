@@ -0,0 +1,69 @@
+#ifndef SSIMCALCULATOR_H
+#define SSIMCALCULATOR_H
+
+#include <QImage>
+#include <QList>
+#include <vector>
+
+enum class SsimChannel { Luminance, Red, Green, Blue };
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// One channel of an image as floats [0, 255], row by row
+struct SsimPlane {
+    int width = 0;
+    int height = 0;
+    std::vector<float> values;
+};
+
+struct SsimResult {
+    double ssim = 0.0;              // The mean SSIM over the pixels [-1, 1]
+    double contrastStructure = 0.0; // The mean of the contrast and structure terms, used by MS-SSIM
+    std::vector<float> map;         // The SSIM of every pixel, if it was requested
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// The structural similarity index (Wang et al., 2004) and its multi-scale
+// variant (Wang, Simoncelli and Bovik, 2003) of two images.
+//
+// The local statistics are weighted by an 11x11 Gaussian window (sigma 1.5),
+// applied as two separable 1D passes; the edges are extended, so the SSIM map
+// has the size of the images. The rows are processed in parallel bands, and
+// every band keeps only the 11 horizontally filtered rows that the vertical
+// pass needs, so the memory does not grow with the height of the images.
+// The inner loops run over contiguous float rows, so the compiler vectorizes them.
+
+class SsimCalculator
+{
+public:
+    SsimCalculator() = delete;
+    ~SsimCalculator() = delete;
+
+    // The luminance is the Rec. 709 one (see PixelKernels::luminance)
+    static SsimPlane extractPlane(const QImage &image, SsimChannel channel);
+
+    // Throws std::runtime_error if the sizes of the planes differ
+    static SsimResult calculate(const SsimPlane &first, const SsimPlane &second, bool isMapNeeded = false);
+
+    // The scales are halved while they are not smaller than the window, up to
+    // mMsSsimWeights.size() scales; the weights of the used scales are normalized.
+    // Throws std::runtime_error if the sizes of the planes differ.
+    static double calculateMultiScale(const SsimPlane &first, const SsimPlane &second);
+
+    // SSIM 1 is white, 0 and below is red, the values between go through yellow.
+    // The result is a Format_Indexed8 image of the given size.
+    static QImage createHeatmap(const std::vector<float> &map, const QSize &size);
+
+    static constexpr int mWindowRadius = 5;
+    static constexpr double mWindowSigma = 1.5;
+    static constexpr double mK1 = 0.01;
+    static constexpr double mK2 = 0.03;
+    static constexpr int mMinBandHeight = 64;
+    static const QList<double> mMsSsimWeights;
+
+private:
+    static SsimPlane downsample(const SsimPlane &plane);
+};
+
+#endif // SSIMCALCULATOR_H
@@ -10,7 +10,8 @@ ImageProximityToOriginResult ImageProximityToOriginComparator::compareImages(con
                                                                              const QImage &image2,
                                                                              const QString &name1,
                                                                              const QString &name2,
-                                                                             const QImage &originalImage
+                                                                             const QImage &originalImage,
+                                                                             const RowDifferenceMap &rowDifferences
                                                                             )
 {
     // Ensure all images have the same size
@@ -19,8 +20,17 @@ ImageProximityToOriginResult ImageProximityToOriginComparator::compareImages(con
     }
 
     // Calculate the total difference for each image compared to the original
-    int totalDifference1 = calculateTotalDifference(image1, originalImage);
-    int totalDifference2 = calculateTotalDifference(image2, originalImage);
+    qint64 totalDifference1 = 0;
+    qint64 totalDifference2 = 0;
+    for (int y = 0; y < image1.height(); ++y) {
+        qint64 rowDifference1 = calculateRowDifference(image1, originalImage, y);
+        totalDifference1 += rowDifference1;
+        if (rowDifferences.isRowDifferent(y)) {
+            totalDifference2 += calculateRowDifference(image2, originalImage, y);
+        } else {
+            totalDifference2 += rowDifference1;
+        }
+    }
 
     QString strResult;
     if (totalDifference1 < totalDifference2) {
@@ -35,28 +45,26 @@ ImageProximityToOriginResult ImageProximityToOriginComparator::compareImages(con
 }
 
 
-qint64 ImageProximityToOriginComparator::calculateTotalDifference(const QImage &image,
-                                                                  const QImage &originalImage
-                                                                  )
+qint64 ImageProximityToOriginComparator::calculateRowDifference(const QImage &image,
+                                                                const QImage &originalImage,
+                                                                int y
+                                                                )
 {
     int width = image.width();
-    int height = image.height();
     qint64 totalDifference = 0;
 
-    // Loop through each pixel in the images
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QColor color1 = image.pixelColor(x, y);
-            QColor colorOriginal = originalImage.pixelColor(x, y);
+    // Loop through each pixel of the row
+    for (int x = 0; x < width; ++x) {
+        QColor color1 = image.pixelColor(x, y);
+        QColor colorOriginal = originalImage.pixelColor(x, y);
 
-            // Calculate the squared difference for each RGB component
-            int diffR = color1.red() - colorOriginal.red();
-            int diffG = color1.green() - colorOriginal.green();
-            int diffB = color1.blue() - colorOriginal.blue();
+        // Calculate the squared difference for each RGB component
+        int diffR = color1.red() - colorOriginal.red();
+        int diffG = color1.green() - colorOriginal.green();
+        int diffB = color1.blue() - colorOriginal.blue();
 
-            // Sum up the squared differences (Euclidean distance squared)
-            totalDifference += diffR * diffR + diffG * diffG + diffB * diffB;
-        }
+        // Sum up the squared differences (Euclidean distance squared)
+        totalDifference += diffR * diffR + diffG * diffG + diffB * diffB;
     }
     return totalDifference;
 }
@@ -136,7 +144,8 @@ std::shared_ptr<ComparisonResultVariant> ImageProximityToOriginComparator::compa
                                 second.getImage(),
                                 first.getImageName(),
                                 second.getImageName(),
-                                mOriginalImage
+                                mOriginalImage,
+                                first.getRowDifferences()
                                 );
 
     QString html = ImageProximityToOriginComparator::formatResultToHtml(result);
@@ -168,3 +177,7 @@ QString ImageProximityToOriginComparator::formatResultToHtml(const ImageProximit
 
     return html;
 }
+
+std::shared_ptr<IImageProcessor> ImageProximityToOriginComparator::clone() const {
+    return std::make_shared<ImageProximityToOriginComparator>(*this);
+}
@@ -54,6 +54,7 @@ public:
     void reset() override;
     QString getFullName() const override;
     bool isPartOfAutoReportingToolbox() override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     QString mPathToOriginalImage;
@@ -61,13 +62,16 @@ private:
 
     double calculateSharpness(const QImage &image);
 
-    qint64 calculateTotalDifference(const QImage &image, const QImage &originalImage);
+    qint64 calculateRowDifference(const QImage &image, const QImage &originalImage, int y);
 
+    // The rows in which the images are identical have the same
+    // difference from the original image, so it is calculated once.
     ImageProximityToOriginResult compareImages(const QImage &image1,
                                                const QImage &image2,
                                                const QString &name1,
                                                const QString &name2,
-                                               const QImage &originalImage
+                                               const QImage &originalImage,
+                                               const RowDifferenceMap &rowDifferences
                                                );
 
     QString formatResultToHtml(const ImageProximityToOriginResult &result);
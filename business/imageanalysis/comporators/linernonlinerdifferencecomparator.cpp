@@ -29,6 +29,10 @@ QString LinerNonLinerDifferenceComparator::getFullName() const {
     return getShortName();
 }
 
+EstimationMethod LinerNonLinerDifferenceComparator::getEstimationMethod() const {
+    return EstimationMethod::PixelSample;
+}
+
 LinerNonLinerComparisonResult LinerNonLinerDifferenceComparator::compareImages(const QImage &image1,
                                                                                 const QString &,
                                                                                 const QImage &image2,
@@ -144,6 +148,10 @@ ComparisonResultVariantPtr LinerNonLinerDifferenceComparator::compare(const Comp
 
     QString html = formatResultToHtml(result);
     ComparisonResultVariantPtr resultVariant = std::make_shared<ComparisonResultVariant>(html);
+    resultVariant->setMetrics({
+        { "Mean difference", result.meanDifference },
+        { "Standard deviation of the difference", result.stdDeviation }
+    });
     return resultVariant;
 }
 
@@ -173,3 +181,7 @@ void LinerNonLinerDifferenceComparator::setProperties(QList<Property> properties
 void LinerNonLinerDifferenceComparator::reset() {
     mThreshold = 5.0;
 }
+
+std::shared_ptr<IImageProcessor> LinerNonLinerDifferenceComparator::clone() const {
+    return std::make_shared<LinerNonLinerDifferenceComparator>(*this);
+}
@@ -35,6 +35,7 @@ public:
     QString getHotkey() const override;
     QString getDescription() const override;
     QString getFullName() const override;
+    EstimationMethod getEstimationMethod() const override;
     QList<Property> getDefaultProperties() const override;
     void setProperties(QList<Property>) override;
     void reset() override;
@@ -42,6 +43,7 @@ public:
     // IComparator interface
 
     ComparisonResultVariantPtr compare(const ComparableImage &first, const ComparableImage &second) override;
+std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     double mThreshold;
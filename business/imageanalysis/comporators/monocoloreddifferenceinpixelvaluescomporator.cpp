@@ -5,23 +5,27 @@
 
 #include "monocoloreddifferenceinpixelvaluescomporator.h"
 
+#include <business/imageanalysis/comporators/helpers/pixelsasolutvaluehelper.h>
+
 QImage MonoColoredDifferenceInPixelValuesComporator::compareImages(const QImage &image1,
-                                                                   const QImage &image2
-                                                                  )
+                                                                   const DifferencePlane &differencePlane,
+                                                                   const QRect &area
+                                                                  ) const
 {
-    // Create a resulting image (copy of the first image)
-    QImage resultImg = image1.copy();
+    // Create a resulting image (copy of the area of the first image)
+    QImage resultImg = image1.copy(area);
     QPainter painter(&resultImg);
 
     // Add a semi-transparent layer
     painter.setOpacity(0.6);
-    painter.drawImage(0, 0, image1);
+    painter.drawImage(QPoint(0, 0), image1, area);
     painter.setOpacity(1.0);
 
     // Compare pixels and highlight differences in red
-    for (int y = 0; y < image1.height(); ++y) {
-        for (int x = 0; x < image1.width(); ++x) {
-            if (image1.pixel(x, y) != image2.pixel(x, y)) {
+    for (int y = 0; y < resultImg.height(); ++y) {
+        const uchar *differenceLine = differencePlane.constScanLine(area.top() + y) + area.left();
+        for (int x = 0; x < resultImg.width(); ++x) {
+            if (differenceLine[x] != 0) {
                 resultImg.setPixelColor(x, y, QColor(255, 0, 0, 255)); // Red color
             }
         }
@@ -43,6 +47,22 @@ QString MonoColoredDifferenceInPixelValuesComporator::getHotkey() const {
     return "D";
 }
 
+bool MonoColoredDifferenceInPixelValuesComporator::isDifferenceBased() const {
+    return true;
+}
+
+bool MonoColoredDifferenceInPixelValuesComporator::isTileRenderingSupported() const {
+    return true;
+}
+
+QImage MonoColoredDifferenceInPixelValuesComporator::renderTile(const ComparableImage &first,
+                                                                const ComparableImage &second,
+                                                                const QRect &area
+                                                                ) const
+{
+    return compareImages(first.getImage(), PixelsAbsolutValueHelper::getDifferencePlane(first, second), area);
+}
+
 QString MonoColoredDifferenceInPixelValuesComporator::getDescription() const {
     return QString("Show the difference in pixel values as an image. "
                    "Pixels that differ are marked with red dots.");
@@ -52,8 +72,15 @@ ComparisonResultVariantPtr MonoColoredDifferenceInPixelValuesComporator::compare
                                                                              const ComparableImage &second
                                                                              )
 {
-    auto result = compareImages(first.getImage(), second.getImage());
+    auto result = compareImages(first.getImage(),
+                                PixelsAbsolutValueHelper::getDifferencePlane(first, second),
+                                first.getImage().rect()
+                                );
     std::shared_ptr<ComparisonResultVariant> resultVariant =
                                 std::make_shared<ComparisonResultVariant>(result);
     return resultVariant;
 }
+
+std::shared_ptr<IImageProcessor> MonoColoredDifferenceInPixelValuesComporator::clone() const {
+    return std::make_shared<MonoColoredDifferenceInPixelValuesComporator>(*this);
+}
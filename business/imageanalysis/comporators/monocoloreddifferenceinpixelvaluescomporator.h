@@ -23,9 +23,16 @@ public:
     ComparisonResultVariantPtr compare(const ComparableImage &first,
                                        const ComparableImage &second) override;
     QString getFullName() const override;
+    bool isDifferenceBased() const override;
+    bool isTileRenderingSupported() const override;
+    QImage renderTile(const ComparableImage &first,
+                      const ComparableImage &second,
+                      const QRect &area) const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
-    QImage compareImages(const QImage &image1, const QImage &image2);
+    // Only the given area of the first image is compared; the result has its size
+    QImage compareImages(const QImage &image1, const DifferencePlane &differencePlane, const QRect &area) const;
 };
 
 #endif // MONOCOLOREDDIFFERENCEINPIXELVALUESCOMPORATOR_H
@@ -4,7 +4,10 @@
 #include <QDebug>
 #include <qfileinfo.h>
 
+#include <algorithm>
+#include <vector>
 #include <business/imageanalysis/comporators/helpers/mathhelper.h>
+#include <domain/kernels/pixelkernels.h>
 
 #include "pixelsbrightnesscomparator.h"
 
@@ -12,7 +15,9 @@
 PixelsBrightnessComparisonResult PixelsBrightnessComparator::compareImages(const QImage &image1,
                                                                            const QString& name1,
                                                                            const QImage &image2,
-                                                                           const QString& name2
+                                                                           const QString& name2,
+                                                                           const RowDifferenceMap &rowDifferences,
+                                                                           const std::optional<QPair<qint64, qint64>> &totalBrightness
                                                                           )
 {
     int width = image1.width();
@@ -27,21 +32,36 @@ PixelsBrightnessComparisonResult PixelsBrightnessComparator::compareImages(const
     qint64 totalBrightness1 = 0;
     qint64 totalBrightness2 = 0;
 
-    // Iterate through each pixel and compare colors
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            QColor color1 = image1.pixelColor(x, y);
-            QColor color2 = image2.pixelColor(x, y);
+    QImage pixels1 = image1.convertToFormat(QImage::Format_ARGB32);
+    QImage pixels2 = image2.convertToFormat(QImage::Format_ARGB32);
+    std::vector<uchar> brightness1(width);
+    std::vector<uchar> brightness2(width);
 
-            int brightness1 = qGray(color1.rgb());
-            int brightness2 = qGray(color2.rgb());
+    // Iterate through each row and compare colors
+    for (int y = 0; y < height; ++y) {
+        if (totalBrightness && !rowDifferences.isRowDifferent(y)) {
+            sameColorCount += width;
+            continue;
+        }
+        auto line1 = reinterpret_cast<const QRgb*>(pixels1.constScanLine(y));
+        PixelKernels::grayscale(line1, brightness1.data(), width);
+        qint64 rowBrightness1 = PixelKernels::sum(brightness1.data(), width);
+        totalBrightness1 += rowBrightness1;
+
+        if (!rowDifferences.isRowDifferent(y)) {
+            totalBrightness2 += rowBrightness1;
+            sameColorCount += width;
+            continue;
+        }
 
-            totalBrightness1 += brightness1;
-            totalBrightness2 += brightness2;
+        auto line2 = reinterpret_cast<const QRgb*>(pixels2.constScanLine(y));
+        PixelKernels::grayscale(line2, brightness2.data(), width);
+        totalBrightness2 += PixelKernels::sum(brightness2.data(), width);
 
-            if (color1 == color2) {
+        for (int x = 0; x < width; ++x) {
+            if (line1[x] == line2[x]) {
                 ++sameColorCount;
-            } else if (brightness1 > brightness2) {
+            } else if (brightness1[x] > brightness2[x]) {
                 ++brighterCount;
             } else {
                 ++darkerCount;
@@ -66,8 +86,8 @@ PixelsBrightnessComparisonResult PixelsBrightnessComparator::compareImages(const
     result.darkerPercent = (static_cast<double>(darkerCount) / totalPixels) * 100;
 
     // Store total brightness values in the result
-    result.firstImageTotalBrightness = totalBrightness1;
-    result.secondImageTotalBrightness = totalBrightness2;
+    result.firstImageTotalBrightness = totalBrightness ? totalBrightness->first : totalBrightness1;
+    result.secondImageTotalBrightness = totalBrightness ? totalBrightness->second : totalBrightness2;
 
     return result;
 }
@@ -80,6 +100,10 @@ QString PixelsBrightnessComparator::getFullName() const {
     return "Comparison of image brightness";
 }
 
+EstimationMethod PixelsBrightnessComparator::getEstimationMethod() const {
+    return EstimationMethod::PixelSample;
+}
+
 QString PixelsBrightnessComparator::getHotkey() const {
     return "N";
 }
@@ -98,14 +122,41 @@ ComparisonResultVariantPtr PixelsBrightnessComparator::compare(const ComparableI
                                                                const ComparableImage &second
                                                               )
 {
+    // The total brightness of the region comes from the summed-area tables if they are set
+    std::optional<QPair<qint64, qint64>> totalBrightness;
+    auto firstIntegralImage = first.getIntegralImage();
+    auto secondIntegralImage = second.getIntegralImage();
+    if (firstIntegralImage != nullptr && !firstIntegralImage->isNull() &&
+        secondIntegralImage != nullptr && !secondIntegralImage->isNull())
+    {
+        auto firstSums = firstIntegralImage->getRegionSums(StatisticsChannel::Brightness,
+                                                           first.getRegionOfInterest()
+                                                           );
+        auto secondSums = secondIntegralImage->getRegionSums(StatisticsChannel::Brightness,
+                                                             second.getRegionOfInterest()
+                                                             );
+        totalBrightness = QPair<qint64, qint64>(firstSums.sum, secondSums.sum);
+    }
+
     auto result = compareImages(first.getImage(),
                                 first.getImageName(),
                                 second.getImage(),
-                                second.getImageName()
+                                second.getImageName(),
+                                first.getRowDifferences(),
+                                totalBrightness
                                 );
 
     QString html = PixelsBrightnessComparator::formatResultToHtml(result);
     ComparisonResultVariantPtr resultVariant = std::make_shared<ComparisonResultVariant>(html);
+    // The totals depend on the number of pixels, so the means are the metrics
+    double pixelCount = std::max(1, result.totalPixels);
+    resultVariant->setMetrics({
+        { "Pixels of the same color, %", result.sameColorPercent },
+        { "Brighter pixels, %", result.brighterPercent },
+        { "Darker pixels, %", result.darkerPercent },
+        { "Mean brightness of " + result.firstImageName, result.firstImageTotalBrightness / pixelCount },
+        { "Mean brightness of " + result.secondImageName, result.secondImageTotalBrightness / pixelCount }
+    });
     return resultVariant;
 }
 
@@ -199,3 +250,7 @@ QString PixelsBrightnessComparator::formatResultToHtml(const PixelsBrightnessCom
 
     return html;
 }
+
+std::shared_ptr<IImageProcessor> PixelsBrightnessComparator::clone() const {
+    return std::make_shared<PixelsBrightnessComparator>(*this);
+}
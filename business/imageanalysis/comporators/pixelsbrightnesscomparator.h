@@ -2,6 +2,8 @@
 #define PIXELSBRIGHTNESSCOMPARATOR_H
 
 #include <qstring.h>
+#include <QPair>
+#include <optional>
 
 #include <domain/interfaces/business/icomparator.h>
 
@@ -44,12 +46,19 @@ public:
     ComparisonResultVariantPtr compare(const ComparableImage &first,
                                        const ComparableImage &second) override;
     QString getFullName() const override;
+    EstimationMethod getEstimationMethod() const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
+    // Only the brightness of the first image is calculated for the rows
+    // in which the images are identical. If the total brightness of the images
+    // is known (e.g. from the summed-area tables), these rows are skipped.
     PixelsBrightnessComparisonResult compareImages(const QImage &image1,
                                                    const QString &name1,
                                                    const QImage &image2,
-                                                   const QString &name2
+                                                   const QString &name2,
+                                                   const RowDifferenceMap &rowDifferences,
+                                                   const std::optional<QPair<qint64, qint64>> &totalBrightness
                                                    );
 
     QString formatResultToHtml(const PixelsBrightnessComparisonResult &result);
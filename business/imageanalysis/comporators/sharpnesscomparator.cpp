@@ -77,7 +77,12 @@ std::shared_ptr<ComparisonResultVariant> SharpnessComparator::compare(const Comp
                                 );
 
     QString html = SharpnessComparator::formatResultToHtml(result);
-    return std::make_shared<ComparisonResultVariant>(html);
+    auto resultVariant = std::make_shared<ComparisonResultVariant>(html);
+    resultVariant->setMetrics({
+        { "Sharpness of " + result.firstImageName, result.firstImageSharpness },
+        { "Sharpness of " + result.secondImageName, result.secondImageSharpness }
+    });
+    return resultVariant;
 }
 
 QString SharpnessComparator::formatResultToHtml(const SharpnessComparisonResult &result) {
@@ -123,3 +128,7 @@ QString SharpnessComparator::formatResultToHtml(const SharpnessComparisonResult
 
     return html;
 }
+
+std::shared_ptr<IImageProcessor> SharpnessComparator::clone() const {
+    return std::make_shared<SharpnessComparator>(*this);
+}
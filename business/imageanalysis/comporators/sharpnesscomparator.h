@@ -33,6 +33,7 @@ public:
     ComparisonResultVariantPtr compare(const ComparableImage &first,
                                        const ComparableImage &second) override;
     QString getFullName() const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     double calculateSharpness(const QImage& image);
@@ -0,0 +1,184 @@
+#include "ssimcomparator.h"
+
+#include <QString>
+#include <algorithm>
+#include <stdexcept>
+
+
+SsimComparator::SsimComparator(Result result) {
+    mExpectedResult = result;
+    mChannelIndex = 0;
+}
+
+QString SsimComparator::getShortName() const {
+    if (mExpectedResult == Result::Text) {
+        return "SSIM / MS-SSIM (Text)";
+    } else {
+        return "SSIM (Image, Heatmap)";
+    }
+}
+
+QString SsimComparator::getFullName() const {
+    if (mExpectedResult == Result::Text) {
+        return "Structural similarity (SSIM / MS-SSIM)";
+    } else {
+        return "Structural similarity (SSIM heatmap)";
+    }
+}
+
+QString SsimComparator::getHotkey() const {
+    return (mExpectedResult == Result::Text ? "I" : "J");
+}
+
+QString SsimComparator::getDescription() const {
+    QString baseHelpTxt = QString("This algorithm compares the structural similarity (SSIM) of two images. ") +
+                          "The brightness, contrast and structure of the pixels are compared in a small " +
+                          "window around every pixel, so the result follows the perceived quality of the " +
+                          "images better than the difference in pixel values. The range of values is " +
+                          "[-1.0, 1.0], where 1.0 means that the images are identical.";
+
+    if (mExpectedResult == Result::Text) {
+        return baseHelpTxt + " It shows the mean SSIM and the multi-scale SSIM (MS-SSIM), "
+                             "which also compares downscaled copies of the images, in text form.";
+    } else {
+        return baseHelpTxt + " It shows the SSIM of every pixel as a heatmap: white pixels are "
+                             "identical, yellow ones are similar and red ones differ the most.";
+    }
+}
+
+QList<Property> SsimComparator::getDefaultProperties() const {
+    QString description = "The channel of the images that is compared. All channels means "
+                          "that the red, green and blue channels are compared separately.";
+    auto channelProperty = Property::createAlternativesProperty("Channel",
+                                                                description,
+                                                                mChannelNames,
+                                                                mChannelIndex
+                                                                );
+    return { channelProperty };
+}
+
+void SsimComparator::setProperties(QList<Property> properties) {
+    if (properties.size() != 1) {
+        QString error = "Got an error from %1: an incorrect number of properties.";
+        error = error.arg(getShortName());
+        throw std::runtime_error(error.toStdString());
+    }
+    mChannelIndex = std::clamp(static_cast<int>(properties[0].getValue()), 0, static_cast<int>(mChannelNames.size()) - 1);
+}
+
+void SsimComparator::reset() {
+    mChannelIndex = 0;
+}
+
+QList<SsimChannel> SsimComparator::getChannels() const {
+    switch (mChannelIndex) {
+    case 1:
+        return { SsimChannel::Red };
+    case 2:
+        return { SsimChannel::Green };
+    case 3:
+        return { SsimChannel::Blue };
+    case 4:
+        return { SsimChannel::Red, SsimChannel::Green, SsimChannel::Blue };
+    default:
+        return { SsimChannel::Luminance };
+    }
+}
+
+ComparisonResultVariantPtr SsimComparator::compare(const ComparableImage &first,
+                                                   const ComparableImage &second
+                                                   )
+{
+    QImage image1 = first.getImage();
+    QImage image2 = second.getImage();
+    if (image1.size() != image2.size()) {
+        throw std::runtime_error("Error: the images must be the same size to calculate SSIM.");
+    }
+
+    QList<SsimChannel> channels = getChannels();
+    bool isImageResult = mExpectedResult == Result::Image;
+
+    QStringList channelNames;
+    QList<double> ssim;
+    QList<double> msSsim;
+    std::vector<float> map;
+    foreach (auto channel, channels) {
+        SsimPlane plane1 = SsimCalculator::extractPlane(image1, channel);
+        SsimPlane plane2 = SsimCalculator::extractPlane(image2, channel);
+        SsimResult result = SsimCalculator::calculate(plane1, plane2, isImageResult);
+
+        channelNames.append(channels.size() == 1 ? mChannelNames[mChannelIndex]
+                                                 : mChannelNames[static_cast<int>(channel)]);
+        ssim.append(result.ssim);
+        if (isImageResult) {
+            // The heatmap of several channels shows their mean SSIM
+            if (map.empty()) {
+                map = std::move(result.map);
+            } else {
+                for (size_t i = 0; i < map.size(); ++i) {
+                    map[i] += result.map[i];
+                }
+            }
+        } else {
+            msSsim.append(SsimCalculator::calculateMultiScale(plane1, plane2));
+        }
+    }
+
+    if (isImageResult) {
+        if (channels.size() > 1) {
+            for (auto &value : map) {
+                value /= channels.size();
+            }
+        }
+        QImage heatmap = SsimCalculator::createHeatmap(map, image1.size());
+        return std::make_shared<ComparisonResultVariant>(heatmap);
+    }
+
+    if (channels.size() > 1) {
+        double ssimSum = 0.0;
+        double msSsimSum = 0.0;
+        for (int i = 0; i < channels.size(); ++i) {
+            ssimSum += ssim[i];
+            msSsimSum += msSsim[i];
+        }
+        channelNames.append("Mean");
+        ssim.append(ssimSum / channels.size());
+        msSsim.append(msSsimSum / channels.size());
+    }
+
+    QString html = formatResultToHtml(channelNames, ssim, msSsim);
+    auto resultVariant = std::make_shared<ComparisonResultVariant>(html);
+    QList<ComparisonMetric> metrics;
+    for (int i = 0; i < channelNames.size(); ++i) {
+        metrics.append({ "SSIM (" + channelNames[i] + ")", ssim[i] });
+        metrics.append({ "MS-SSIM (" + channelNames[i] + ")", msSsim[i] });
+    }
+    resultVariant->setMetrics(metrics);
+    return resultVariant;
+}
+
+QString SsimComparator::formatResultToHtml(const QStringList &channelNames,
+                                           const QList<double> &ssim,
+                                           const QList<double> &msSsim
+                                           )
+{
+    QString html;
+    html += QString("<h2 style=\"line-height: 2;\">%1</h2>").arg(getFullName());
+    html += "<table border=\"1\" cellspacing=\"0\" cellpadding=\"5\">";
+    html += "<tr><th>Channel</th><th>SSIM</th><th>MS-SSIM</th></tr>";
+    for (int i = 0; i < channelNames.size(); ++i) {
+        html += QString("<tr><td>%1</td><td>%2</td><td>%3</td></tr>")
+                    .arg(channelNames[i])
+                    .arg(ssim[i], 0, 'f', 4)
+                    .arg(msSsim[i], 0, 'f', 4);
+    }
+    html += "</table>";
+    html += "<br /><br />";
+    html += QString("The range of values is [-1.0, 1.0]. ")
+            + "Where 1.0 means that the images are identical, and lower values indicate a lower similarity.";
+    return html;
+}
+
+std::shared_ptr<IImageProcessor> SsimComparator::clone() const {
+    return std::make_shared<SsimComparator>(*this);
+}
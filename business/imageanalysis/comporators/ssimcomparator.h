@@ -0,0 +1,51 @@
+#ifndef SSIMCOMPARATOR_H
+#define SSIMCOMPARATOR_H
+
+#include <domain/valueobjects/property.h>
+#include <domain/interfaces/business/icomparator.h>
+#include <business/imageanalysis/comporators/helpers/ssimcalculator.h>
+
+
+// This class compares the structural similarity (SSIM) of two images: the local
+// means, variances and covariance of the pixels are compared in a Gaussian window
+// around every pixel (see SsimCalculator). Unlike the pixel differences, SSIM
+// follows the perceived quality, e.g. noise and blur lower it more than a small
+// change of the brightness. The text result also has the multi-scale SSIM.
+
+class SsimComparator : public IComparator
+{
+public:
+    enum class Result { Text, Image };
+
+public:
+    SsimComparator(SsimComparator::Result result);
+    virtual ~SsimComparator() = default;
+
+    // IComparator interface
+
+    QString getShortName() const override;
+    QString getHotkey() const override;
+    QString getDescription() const override;
+    QString getFullName() const override;
+    ComparisonResultVariantPtr compare(const ComparableImage &first,
+                                       const ComparableImage &second) override;
+    QList<Property> getDefaultProperties() const override;
+    void setProperties(QList<Property> properties) override;
+    void reset() override;
+    std::shared_ptr<IImageProcessor> clone() const override;
+
+private:
+    // The alternatives of the channel property, the last one is all the color channels
+    const QStringList mChannelNames = { "Luminance", "Red", "Green", "Blue", "All channels" };
+
+    Result mExpectedResult;
+    int mChannelIndex;
+
+    QList<SsimChannel> getChannels() const;
+    QString formatResultToHtml(const QStringList &channelNames,
+                               const QList<double> &ssim,
+                               const QList<double> &msSsim
+                               );
+};
+
+#endif // SSIMCOMPARATOR_H
@@ -0,0 +1,257 @@
+#include "differenceregionindex.h"
+
+#include <QHash>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <domain/utils/parallel.h>
+
+
+namespace {
+
+// The statistics of a region while its pixels are being collected
+struct RegionBounds {
+    int left = std::numeric_limits<int>::max();
+    int top = std::numeric_limits<int>::max();
+    int right = -1;
+    int bottom = -1;
+    qint64 pixelCount = 0;
+    int maxDifference = 0;
+
+    void add(int x, int y, int difference) {
+        left = std::min(left, x);
+        top = std::min(top, y);
+        right = std::max(right, x);
+        bottom = std::max(bottom, y);
+        ++pixelCount;
+        maxDifference = std::max(maxDifference, difference);
+    }
+
+    void add(const RegionBounds &other) {
+        left = std::min(left, other.left);
+        top = std::min(top, other.top);
+        right = std::max(right, other.right);
+        bottom = std::max(bottom, other.bottom);
+        pixelCount += other.pixelCount;
+        maxDifference = std::max(maxDifference, other.maxDifference);
+    }
+};
+
+// The labels are pixel indices, which do not fit into int for the largest images
+typedef qint64 Label;
+
+// The labels of the pixels that do not differ
+constexpr Label NoLabel = -1;
+
+// Does not modify the labels, so several threads can call it at the same time
+Label findRoot(const Label *labels, Label index) {
+    while (labels[index] != index) {
+        index = labels[index];
+    }
+    return index;
+}
+
+Label findRootAndCompress(Label *labels, Label index) {
+    Label root = findRoot(labels, index);
+    while (labels[index] != root) {
+        Label next = labels[index];
+        labels[index] = root;
+        index = next;
+    }
+    return root;
+}
+
+// The smaller index becomes the root, so the labels do not depend on the order of unions
+void unite(Label *labels, Label first, Label second) {
+    Label firstRoot = findRootAndCompress(labels, first);
+    Label secondRoot = findRootAndCompress(labels, second);
+    if (firstRoot < secondRoot) {
+        labels[secondRoot] = firstRoot;
+    } else if (secondRoot < firstRoot) {
+        labels[firstRoot] = secondRoot;
+    }
+}
+
+int maxChannelDifference(QRgb first, QRgb second) {
+    int difference = std::max(std::abs(qRed(first) - qRed(second)),
+                              std::abs(qGreen(first) - qGreen(second)));
+    difference = std::max(difference, std::abs(qBlue(first) - qBlue(second)));
+    return std::max(difference, std::abs(qAlpha(first) - qAlpha(second)));
+}
+
+// Format_RGB32 stores the pixels as 0xffRRGGBB, so it is compared with Format_ARGB32 without a copy
+QImage toArgb32(const QImage &image) {
+    if (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32) {
+        return image;
+    }
+    return image.convertToFormat(QImage::Format_ARGB32);
+}
+
+} // namespace
+
+DifferenceRegionIndex DifferenceRegionIndex::build(const QImage &first,
+                                                   const QImage &second,
+                                                   const std::function<bool()> &isCanceled
+                                                   )
+{
+    if (first.size() != second.size()) {
+        throw std::runtime_error("Error: the images have different sizes.");
+    }
+
+    DifferenceRegionIndex index;
+    if (first.isNull()) {
+        return index;
+    }
+
+    QImage firstImage = toArgb32(first);
+    QImage secondImage = toArgb32(second);
+    auto isBuildCanceled = [&isCanceled]() { return isCanceled && isCanceled(); };
+    const int width = firstImage.width();
+    const int height = firstImage.height();
+
+    int bandCount = Parallel::getBandCount(height, mMinBandHeight);
+    int bandHeight = (height + bandCount - 1) / bandCount;
+
+    // Only the rows that differ are initialized and read
+    std::vector<quint8> isRowDifferent(height, false);
+    std::unique_ptr<Label[]> labelsBuffer { new Label[static_cast<size_t>(width) * height] };
+    std::unique_ptr<quint8[]> differencesBuffer { new quint8[static_cast<size_t>(width) * height] };
+    Label *labels = labelsBuffer.get();
+    quint8 *differences = differencesBuffer.get();
+
+    // 1. Every band is labeled independently, so a union never leaves the band
+    Parallel::run(bandCount, [&](int band) {
+        int top = band * bandHeight;
+        int bottom = std::min(height, top + bandHeight);
+        for (int y = top; y < bottom && !isBuildCanceled(); ++y) {
+            auto firstLine = reinterpret_cast<const QRgb*>(firstImage.constScanLine(y));
+            auto secondLine = reinterpret_cast<const QRgb*>(secondImage.constScanLine(y));
+            if (memcmp(firstLine, secondLine, width * sizeof(QRgb)) == 0) {
+                continue;
+            }
+            isRowDifferent[y] = true;
+            qint64 row = static_cast<qint64>(y) * width;
+            std::fill(&labels[row], &labels[row] + width, NoLabel);
+            bool isAboveDifferent = y > top && isRowDifferent[y - 1];
+            for (int x = 0; x < width; ++x) {
+                if (firstLine[x] == secondLine[x]) {
+                    continue;
+                }
+                qint64 i = row + x;
+                labels[i] = i;
+                differences[i] = static_cast<quint8>(maxChannelDifference(firstLine[x], secondLine[x]));
+                if (x > 0 && labels[i - 1] != NoLabel) {
+                    unite(labels, i, i - 1);
+                }
+                if (isAboveDifferent) {
+                    qint64 above = i - width;
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (x + dx >= 0 && x + dx < width && labels[above + dx] != NoLabel) {
+                            unite(labels, i, above + dx);
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    if (isBuildCanceled()) {
+        return index;
+    }
+
+    // 2. Only the first row of a band can be connected with the previous band
+    for (int band = 1; band < bandCount; ++band) {
+        int y = band * bandHeight;
+        if (y >= height) {
+            break;
+        }
+        if (!isRowDifferent[y] || !isRowDifferent[y - 1]) {
+            continue;
+        }
+        for (int x = 0; x < width; ++x) {
+            qint64 i = static_cast<qint64>(y) * width + x;
+            if (labels[i] == NoLabel) {
+                continue;
+            }
+            qint64 above = i - width;
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (x + dx >= 0 && x + dx < width && labels[above + dx] != NoLabel) {
+                    unite(labels, i, above + dx);
+                }
+            }
+        }
+    }
+
+    // 3. The statistics are collected per band and merged afterwards; the labels
+    // are only read here, so the bands do not have to be synchronized.
+    std::vector<QHash<Label, RegionBounds>> bandRegions(bandCount);
+    Parallel::run(bandCount, [&](int band) {
+        int top = band * bandHeight;
+        int bottom = std::min(height, top + bandHeight);
+        auto &regions = bandRegions[band];
+        for (int y = top; y < bottom; ++y) {
+            if (!isRowDifferent[y]) {
+                continue;
+            }
+            qint64 row = static_cast<qint64>(y) * width;
+            for (int x = 0; x < width; ++x) {
+                if (labels[row + x] != NoLabel) {
+                    regions[findRoot(labels, row + x)].add(x, y, differences[row + x]);
+                }
+            }
+        }
+    });
+
+    if (isBuildCanceled()) {
+        return index;
+    }
+
+    QHash<Label, RegionBounds> regions;
+    foreach (auto &band, bandRegions) {
+        for (auto it = band.cbegin(); it != band.cend(); ++it) {
+            regions[it.key()].add(it.value());
+        }
+    }
+
+    foreach (auto &bounds, regions) {
+        DifferenceRegion region;
+        region.boundingRect = QRect(QPoint(bounds.left, bounds.top), QPoint(bounds.right, bounds.bottom));
+        region.pixelCount = bounds.pixelCount;
+        region.maxDifference = bounds.maxDifference;
+        index.mRegions.append(region);
+        index.mDifferentPixelCount += bounds.pixelCount;
+    }
+    std::sort(index.mRegions.begin(), index.mRegions.end(), [](const auto &a, const auto &b) {
+        const QRect &first = a.boundingRect;
+        const QRect &second = b.boundingRect;
+        return first.top() != second.top() ? first.top() < second.top() : first.left() < second.left();
+    });
+    return index;
+}
+
+bool DifferenceRegionIndex::isEmpty() const {
+    return mRegions.isEmpty();
+}
+
+int DifferenceRegionIndex::size() const {
+    return mRegions.size();
+}
+
+const DifferenceRegion& DifferenceRegionIndex::at(int index) const {
+    return mRegions.at(index);
+}
+
+const QList<DifferenceRegion>& DifferenceRegionIndex::getRegions() const {
+    return mRegions;
+}
+
+qint64 DifferenceRegionIndex::getDifferentPixelCount() const {
+    return mDifferentPixelCount;
+}
+
+qint64 DifferenceRegionIndex::getMemoryUsage() const {
+    return static_cast<qint64>(mRegions.size()) * sizeof(DifferenceRegion);
+}
@@ -0,0 +1,57 @@
+#ifndef DIFFERENCEREGIONINDEX_H
+#define DIFFERENCEREGIONINDEX_H
+
+#include <QImage>
+#include <QList>
+#include <QRect>
+#include <functional>
+#include <vector>
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct DifferenceRegion {
+    QRect boundingRect;     // In image coordinates
+    qint64 pixelCount = 0;  // The number of differing pixels in the region
+    int maxDifference = 0;  // The maximum absolute difference of a color channel [1, 255]
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// The regions of two images that differ, i.e. the connected components
+// (8-connectivity) of the mask of differing pixels, in reading order.
+//
+// The index is built in a single parallel pass: the images are split into
+// horizontal bands, every band is labeled by its own thread with a union-find
+// over pixel indices, the few labels that touch the band borders are merged,
+// and the region statistics are then accumulated per band again in parallel.
+// Identical rows are skipped with memcmp, so a pair with a handful of differing
+// pixels costs little more than a memory comparison.
+
+class DifferenceRegionIndex
+{
+public:
+    DifferenceRegionIndex() = default;
+    ~DifferenceRegionIndex() = default;
+
+    // Throws std::runtime_error if the sizes of the images differ. isCanceled is
+    // polled between the rows; a canceled build returns an empty index.
+    static DifferenceRegionIndex build(const QImage &first,
+                                       const QImage &second,
+                                       const std::function<bool()> &isCanceled = {}
+                                       );
+
+    bool isEmpty() const;
+    int size() const;
+    const DifferenceRegion& at(int index) const;
+    const QList<DifferenceRegion>& getRegions() const;
+    qint64 getDifferentPixelCount() const;
+    qint64 getMemoryUsage() const;
+
+private:
+    static constexpr int mMinBandHeight = 64;
+
+    QList<DifferenceRegion> mRegions;
+    qint64 mDifferentPixelCount = 0;
+};
+
+#endif // DIFFERENCEREGIONINDEX_H
@@ -0,0 +1,228 @@
+#include "filterhistory.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <business/imageanalysis/filters/filterpipeline.h>
+
+
+FilterHistory::FilterHistory(qint64 memoryBudget)
+    : mCurrentStep(0),
+    mMemoryBudget(memoryBudget)
+{
+}
+
+void FilterHistory::reset(const OriginalImagesProvider &getOriginalImages) {
+    mGetOriginalImages = getOriginalImages;
+    mStates.clear();
+    mStates.append(State()); // the original images are not stored
+    mCurrentStep = 0;
+}
+
+void FilterHistory::reset(const QImage &firstImage, const QImage &secondImage) {
+    reset([firstImage, secondImage]() {
+        return FilterHistoryImages { firstImage, secondImage };
+    });
+}
+
+void FilterHistory::push(const QList<AppliedFilter> &filters,
+                         const QImage &firstImage,
+                         const QImage &secondImage
+                         )
+{
+    if (mStates.isEmpty()) {
+        throw std::runtime_error("Error: The filter history has no original images.");
+    }
+    mStates.resize(mCurrentStep + 1);
+    State state;
+    state.filters = filters;
+    state.images = { firstImage, secondImage };
+    mStates.append(state);
+    mCurrentStep = mStates.size() - 1;
+    enforceMemoryBudget();
+}
+
+bool FilterHistory::canUndo() const {
+    return mCurrentStep > 0;
+}
+
+bool FilterHistory::canRedo() const {
+    return mCurrentStep + 1 < mStates.size();
+}
+
+int FilterHistory::getCurrentStep() const {
+    return mCurrentStep;
+}
+
+int FilterHistory::size() const {
+    return mStates.size();
+}
+
+FilterHistoryImages FilterHistory::undo() {
+    return moveTo(mCurrentStep - 1);
+}
+
+FilterHistoryImages FilterHistory::redo() {
+    return moveTo(mCurrentStep + 1);
+}
+
+FilterHistoryImages FilterHistory::moveTo(int step) {
+    if (step < 0 || step >= mStates.size()) {
+        throw std::runtime_error("Error: The requested step is out of the filter history.");
+    }
+    FilterHistoryImages images = getImages(step);
+    mCurrentStep = step;
+    enforceMemoryBudget();
+    return images;
+}
+
+void FilterHistory::setMemoryBudget(qint64 memoryBudget) {
+    mMemoryBudget = memoryBudget;
+    enforceMemoryBudget();
+}
+
+qint64 FilterHistory::getMemoryBudget() const {
+    return mMemoryBudget;
+}
+
+qint64 FilterHistory::getMemoryUsage() const {
+    qint64 usage = 0;
+    for (int i = 1; i < mStates.size(); ++i) {
+        usage += getDecodedSize(mStates[i]) + getCompressedSize(mStates[i]);
+    }
+    return usage;
+}
+
+qint64 FilterHistory::getDecodedMemoryUsage() const {
+    qint64 usage = 0;
+    for (int i = 1; i < mStates.size(); ++i) {
+        usage += getDecodedSize(mStates[i]);
+    }
+    return usage;
+}
+
+FilterPipeline FilterHistory::createPipeline(const QList<AppliedFilter> &filters) {
+    QList<IFilterPtr> pipelineFilters;
+    foreach (auto &appliedFilter, filters) {
+        auto filter = std::dynamic_pointer_cast<IFilter>(appliedFilter.filter->clone());
+        filter->reset();
+        if (!appliedFilter.properties.isEmpty()) {
+            filter->setProperties(appliedFilter.properties);
+        }
+        pipelineFilters.append(filter);
+    }
+    return FilterPipeline { pipelineFilters };
+}
+
+/* Storage of the states { */
+
+FilterHistoryImages FilterHistory::getImages(int step) {
+    if (step == 0) {
+        return mGetOriginalImages();
+    }
+    State &state = mStates[step];
+    if (isDecoded(state)) {
+        return state.images;
+    }
+    if (isCompressed(state)) {
+        decompressState(state);
+        return state.images;
+    }
+
+    // The state is evicted, so it is recomputed from the nearest stored one
+    int baseStep = step - 1;
+    while (baseStep > 0 && !isDecoded(mStates[baseStep]) && !isCompressed(mStates[baseStep])) {
+        --baseStep;
+    }
+    // The filters of all the replayed steps form one pipeline, so the consecutive
+    // per-pixel ones are applied in a single pass over the images
+    QList<AppliedFilter> filters;
+    for (int i = baseStep + 1; i <= step; ++i) {
+        filters.append(mStates[i].filters);
+    }
+    FilterPipeline pipeline = createPipeline(filters);
+    FilterHistoryImages images = getImages(baseStep);
+    images.firstImage = pipeline.apply(std::move(images.firstImage));
+    if (!images.secondImage.isNull()) {
+        images.secondImage = pipeline.apply(std::move(images.secondImage));
+    }
+    mStates[step].images = images;
+    return images;
+}
+
+void FilterHistory::enforceMemoryBudget() {
+    // The decoded states take at most a half of the budget, the farthest ones are compressed
+    qint64 decodedSize = 0;
+    for (int i = 1; i < mStates.size(); ++i) {
+        decodedSize += getDecodedSize(mStates[i]);
+    }
+    while (decodedSize > mMemoryBudget / 2) {
+        int step = findFarthestState(&FilterHistory::isDecoded);
+        if (step < 0) {
+            break;
+        }
+        decodedSize -= getDecodedSize(mStates[step]);
+        compressState(mStates[step]);
+    }
+
+    // The farthest states are evicted, they can be recomputed
+    auto isStored = [](const State &state) {
+        return isDecoded(state) || isCompressed(state);
+    };
+    qint64 usage = getMemoryUsage();
+    while (usage > mMemoryBudget) {
+        int step = findFarthestState(isStored);
+        if (step < 0) {
+            break;
+        }
+        usage -= getDecodedSize(mStates[step]) + getCompressedSize(mStates[step]);
+        mStates[step].images = {};
+        mStates[step].compressedFirstImage = {};
+        mStates[step].compressedSecondImage = {};
+    }
+}
+
+// The current state is never compressed or evicted, the original images are not stored
+int FilterHistory::findFarthestState(bool (*isSuitable)(const State&)) const {
+    int farthestStep = -1;
+    int farthestDistance = 0;
+    for (int i = 1; i < mStates.size(); ++i) {
+        int distance = std::abs(i - mCurrentStep);
+        if (distance > farthestDistance && isSuitable(mStates[i])) {
+            farthestStep = i;
+            farthestDistance = distance;
+        }
+    }
+    return farthestStep;
+}
+
+bool FilterHistory::isDecoded(const State &state) {
+    return !state.images.firstImage.isNull();
+}
+
+bool FilterHistory::isCompressed(const State &state) {
+    return !state.compressedFirstImage.isNull();
+}
+
+qint64 FilterHistory::getDecodedSize(const State &state) {
+    return state.images.firstImage.sizeInBytes() + state.images.secondImage.sizeInBytes();
+}
+
+qint64 FilterHistory::getCompressedSize(const State &state) {
+    return state.compressedFirstImage.getCompressedSize() + state.compressedSecondImage.getCompressedSize();
+}
+
+// The decoded images are dropped, the compressed ones are kept when the state is decoded again
+void FilterHistory::compressState(State &state) {
+    if (!isCompressed(state)) {
+        state.compressedFirstImage = CompressedImage::compress(state.images.firstImage);
+        state.compressedSecondImage = CompressedImage::compress(state.images.secondImage);
+    }
+    state.images = {};
+}
+
+void FilterHistory::decompressState(State &state) {
+    state.images.firstImage = state.compressedFirstImage.decompress();
+    state.images.secondImage = state.compressedSecondImage.decompress();
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
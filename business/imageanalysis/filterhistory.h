@@ -0,0 +1,102 @@
+#ifndef FILTERHISTORY_H
+#define FILTERHISTORY_H
+
+#include <QImage>
+#include <QList>
+#include <functional>
+#include <domain/interfaces/business/ifilter.h>
+#include <domain/valueobjects/compressedimage.h>
+
+class FilterPipeline;
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// A filter and the properties it was applied with (the default ones if the list
+// is empty), so the filter can be applied again in the same way.
+struct AppliedFilter {
+    IFilterPtr filter;
+    QList<Property> properties;
+};
+
+struct FilterHistoryImages {
+    QImage firstImage;
+    QImage secondImage;     // Null for a single image
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// The undo/redo history of the filters applied to the displayed images. The
+// state 0 is the original images; every next state is the result of a chain
+// of filters applied to the previous one.
+//
+// The original images are owned by the caller and requested when they are needed,
+// so the caller can keep them compressed. The other states are kept under a memory
+// budget. The states nearest to the current one stay decoded, so stepping between
+// them is instant. When the decoded states take more than a half of the budget, the
+// farthest ones are compressed in memory (see CompressedImage). When the budget is
+// exceeded anyway, the farthest states are evicted and recomputed on demand from
+// the nearest stored state.
+
+class FilterHistory
+{
+public:
+    typedef std::function<FilterHistoryImages()> OriginalImagesProvider;
+
+    explicit FilterHistory(qint64 memoryBudget = mDefaultMemoryBudget);
+
+    // Starts a new history with the original images as the state 0
+    void reset(const OriginalImagesProvider &getOriginalImages);
+    void reset(const QImage &firstImage, const QImage &secondImage = {});
+
+    // Adds the result of the filters after the current state.
+    // The states that could be redone are dropped.
+    void push(const QList<AppliedFilter> &filters, const QImage &firstImage, const QImage &secondImage = {});
+
+    bool canUndo() const;
+    bool canRedo() const;
+    int getCurrentStep() const;
+    int size() const;
+
+    // Moves to the state and returns its images. Throws std::runtime_error
+    // if the state is evicted and a filter fails while it is recomputed.
+    FilterHistoryImages undo();
+    FilterHistoryImages redo();
+    FilterHistoryImages moveTo(int step);
+
+    void setMemoryBudget(qint64 memoryBudget);
+    qint64 getMemoryBudget() const;
+    qint64 getMemoryUsage() const;
+    qint64 getDecodedMemoryUsage() const;
+
+    // Configures copies of the filters with the properties they were applied with;
+    // the filters themselves are not changed, e.g. when an evicted state is recomputed
+    static FilterPipeline createPipeline(const QList<AppliedFilter> &filters);
+
+    static constexpr qint64 mDefaultMemoryBudget = 1024ll * 1024 * 1024;
+
+private:
+    struct State {
+        QList<AppliedFilter> filters;   // How the state is made from the previous one
+        FilterHistoryImages images;     // Null if the state is not decoded
+        CompressedImage compressedFirstImage;
+        CompressedImage compressedSecondImage;
+    };
+
+    OriginalImagesProvider mGetOriginalImages;
+    QList<State> mStates;
+    int mCurrentStep;
+    qint64 mMemoryBudget;
+
+    FilterHistoryImages getImages(int step);
+    void enforceMemoryBudget();
+    int findFarthestState(bool (*isSuitable)(const State&)) const;
+
+    static bool isDecoded(const State &state);
+    static bool isCompressed(const State &state);
+    static qint64 getDecodedSize(const State &state);
+    static qint64 getCompressedSize(const State &state);
+    static void compressState(State &state);
+    static void decompressState(State &state);
+};
+
+#endif // FILTERHISTORY_H
@@ -0,0 +1,63 @@
+#include "filterpipeline.h"
+
+#include <stdexcept>
+
+
+FilterPipeline::FilterPipeline(const QList<IFilterPtr> &filters) {
+    foreach (auto filter, filters) {
+        if (filter == nullptr) {
+            continue;
+        }
+        bool canBeFused = filter->isPerPixel() &&
+                          !mStages.isEmpty() &&
+                          mStages.last().first()->isPerPixel();
+        if (canBeFused) {
+            mStages.last().append(filter);
+        } else {
+            mStages.append({ filter });
+        }
+    }
+}
+
+QImage FilterPipeline::apply(QImage image) const {
+    foreach (auto &stage, mStages) {
+        if (stage.first()->isPerPixel()) {
+            applyPerPixelStage(image, stage);
+        } else {
+            image = stage.first()->filter(image);
+        }
+        if (image.isNull()) {
+            throw std::runtime_error("Error: The filter returns an empty result.");
+        }
+    }
+    return image;
+}
+
+void FilterPipeline::applyPerPixelStage(QImage &image, const QList<IFilterPtr> &stage) {
+    // The filters keep opaque pixels opaque, so the rows of an RGB32 image (e.g. of an
+    // opaque QPixmap) are changed in place too, and the pixmap of the result is created
+    // without a conversion. The rvalue conversion reuses the buffer if it can.
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32) {
+        image = std::move(image).convertToFormat(QImage::Format_ARGB32);
+    }
+    int width = image.width();
+    for (int y = 0; y < image.height(); ++y) {
+        auto line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        foreach (auto &filter, stage) {
+            filter->filterRow(line, width);
+        }
+    }
+}
+
+bool FilterPipeline::isEmpty() const {
+    return mStages.isEmpty();
+}
+
+bool FilterPipeline::isPerPixel() const {
+    foreach (auto &stage, mStages) {
+        if (!stage.first()->isPerPixel()) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef FILTERPIPELINE_H
+#define FILTERPIPELINE_H
+
+#include <QImage>
+#include <QList>
+#include <domain/interfaces/business/ifilter.h>
+
+// A chain of filters applied to an image, e.g. the filters of several steps of
+// the filter history that are replayed at once (see FilterHistory). Consecutive
+// per-pixel filters (see IFilter::isPerPixel) are fused into one stage: every row
+// is passed through all the filters of the stage while it is still in the cache,
+// in place, so no intermediate image is allocated. An RGB32 or ARGB32 image is
+// changed in its own buffer, other formats are converted to Format_ARGB32 once.
+// Other filters are applied one by one with filter().
+
+class FilterPipeline
+{
+public:
+    explicit FilterPipeline(const QList<IFilterPtr> &filters);
+
+    // Throws std::runtime_error if a filter returns an empty result. A moved
+    // image that is not shared is filtered without a copy.
+    QImage apply(QImage image) const;
+
+    bool isEmpty() const;
+
+    // True if all the filters are per-pixel, i.e. the pipeline does not call
+    // filter() of any filter (plugin filters may be unsafe to run concurrently).
+    bool isPerPixel() const;
+
+private:
+    QList<QList<IFilterPtr>> mStages;
+
+    static void applyPerPixelStage(QImage &image, const QList<IFilterPtr> &stage);
+};
+
+#endif // FILTERPIPELINE_H
@@ -1,6 +1,8 @@
 #include "grayscalefilter.h"
 
 #include <QtCore/qdebug.h>
+#include <algorithm>
+#include <domain/kernels/pixelkernels.h>
 
 QString GrayscaleFilter::getShortName() const {
     return "Make Grayscale";
@@ -19,18 +21,31 @@ QString GrayscaleFilter::getDescription() const {
 }
 
 QImage GrayscaleFilter::filter(const QImage &image) {
-    QImage grayImage = image;
-
+    QImage grayImage = image.convertToFormat(QImage::Format_ARGB32);
     for (int y = 0; y < grayImage.height(); ++y) {
-        for (int x = 0; x < grayImage.width(); ++x) {
-            QColor color = grayImage.pixelColor(x, y);
+        filterRow(reinterpret_cast<QRgb*>(grayImage.scanLine(y)), grayImage.width());
+    }
+    return grayImage;
+}
 
-            // Calculate the grayscale value using luminosity method
-            int grayValue = qGray(color.red(), color.green(), color.blue());
+bool GrayscaleFilter::isPerPixel() const {
+    return true;
+}
 
-            grayImage.setPixelColor(x, y, QColor(grayValue, grayValue, grayValue));
+void GrayscaleFilter::filterRow(QRgb *pixels, int count) const {
+    // The gray values are calculated by chunks, so the buffer stays on the stack
+    constexpr int chunkSize = 256;
+    uchar grayValues[chunkSize];
+    for (int start = 0; start < count; start += chunkSize) {
+        int size = std::min(chunkSize, count - start);
+        // Calculate the grayscale values using luminosity method (see qGray)
+        PixelKernels::grayscale(pixels + start, grayValues, size);
+        for (int x = 0; x < size; ++x) {
+            pixels[start + x] = qRgb(grayValues[x], grayValues[x], grayValues[x]);
         }
     }
+}
 
-    return grayImage;
+std::shared_ptr<IImageProcessor> GrayscaleFilter::clone() const {
+    return std::make_shared<GrayscaleFilter>(*this);
 }
@@ -17,4 +17,7 @@ public:
     QString getDescription() const override;
     QImage filter(const QImage &image) override;
     QString getFullName() const override;
+    bool isPerPixel() const override;
+    void filterRow(QRgb *pixels, int count) const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 };
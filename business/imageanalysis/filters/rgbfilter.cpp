@@ -1,5 +1,8 @@
 #include "rgbfilter.h"
 
+#include <vector>
+#include <domain/kernels/pixelkernels.h>
+
 GenericRgbFilter::GenericRgbFilter(RgbChannel channel)
     : mChannel(channel),
       mIsOutputImageColored(true)
@@ -60,38 +63,63 @@ QImage GenericRgbFilter::extractChannel(const QImage &image,
                                         )
 {
 
+    int shift = getChannelShift(channel);
+    QImage pixels = image.convertToFormat(QImage::Format_ARGB32);
     QImage oneChannelImage { image.size(),
                             isImageColored ?
                                 QImage::Format_ARGB32
                                            : QImage::Format_Grayscale8
                            };
 
-    // Iterate over each pixel
+    std::vector<uchar> values(image.width());
+
+    // Iterate over each row
     for (int y = 0; y < image.height(); ++y) {
+        auto line = reinterpret_cast<const QRgb*>(pixels.constScanLine(y));
+        if (!isImageColored) {
+            PixelKernels::extractChannel(line, oneChannelImage.scanLine(y), image.width(), shift);
+            continue;
+        }
+        // The channel stays in its place, the other color channels are cleared
+        PixelKernels::extractChannel(line, values.data(), image.width(), shift);
+        auto resultLine = reinterpret_cast<QRgb*>(oneChannelImage.scanLine(y));
         for (int x = 0; x < image.width(); ++x) {
-            // Extract the original pixel
-            QRgb pixel = image.pixel(x, y);
-
-            if (channel == RgbChannel::R) {
-                int red = qRed(pixel);
-                QRgb newPixel = qRgba(red, 0, 0, qAlpha(pixel));
-                oneChannelImage.setPixel(x, y, newPixel);
-            } else if (channel == RgbChannel::G) {
-                int green = qGreen(pixel);
-                QRgb newPixel = qRgba(0, green, 0, qAlpha(pixel));
-                oneChannelImage.setPixel(x, y, newPixel);
-            } else if (channel == RgbChannel::B) {
-                int blue = qBlue(pixel);
-                QRgb newPixel = qRgba(0, 0, blue, qAlpha(pixel));
-                oneChannelImage.setPixel(x, y, newPixel);
-            } else {
-                throw std::runtime_error("Error: An incorrect RGB channel was requested.");
-            }
+            resultLine[x] = (line[x] & 0xFF000000) | (static_cast<QRgb>(values[x]) << shift);
         }
     }
     return oneChannelImage;
 }
 
+int GenericRgbFilter::getChannelShift(RgbChannel channel) {
+    if (channel == RgbChannel::R) {
+        return 16;
+    } else if (channel == RgbChannel::G) {
+        return 8;
+    } else if (channel == RgbChannel::B) {
+        return 0;
+    }
+    throw std::runtime_error("Error: An incorrect RGB channel was requested.");
+}
+
+bool GenericRgbFilter::isPerPixel() const {
+    return true;
+}
+
+// In a pipeline the grayscale mode keeps the four-byte pixels, the channel is copied to R, G and B
+void GenericRgbFilter::filterRow(QRgb *pixels, int count) const {
+    int shift = getChannelShift(mChannel);
+    if (mIsOutputImageColored) {
+        QRgb mask = 0xFF000000 | (0xFFu << shift);
+        for (int x = 0; x < count; ++x) {
+            pixels[x] &= mask;
+        }
+    } else {
+        for (int x = 0; x < count; ++x) {
+            pixels[x] = 0xFF000000 | (((pixels[x] >> shift) & 0xFF) * 0x010101u);
+        }
+    }
+}
+
 QList<Property> GenericRgbFilter::getDefaultProperties() const {
     QList<QString> alternatives = { "Colored", "Grayscale" };
     QString description = "Represents the choice between colored and grayscale image in an R/G/B mode.";
@@ -122,3 +150,7 @@ void GenericRgbFilter::setProperties(QList<Property> properties) {
 void GenericRgbFilter::reset() {
     mIsOutputImageColored = true;
 }
+
+std::shared_ptr<IImageProcessor> GenericRgbFilter::clone() const {
+    return std::make_shared<GenericRgbFilter>(*this);
+}
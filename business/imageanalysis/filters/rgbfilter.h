@@ -21,6 +21,9 @@ public:
     void setProperties(QList<Property> properties) override;
     void reset() override;
     QString getFullName() const override;
+    bool isPerPixel() const override;
+    void filterRow(QRgb *pixels, int count) const override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     RgbChannel mChannel;
@@ -30,6 +33,7 @@ private:
                                  bool isImageColored,
                                  RgbChannel channels
                                  );
+    static int getChannelShift(RgbChannel channel);
     };
 
 class RedChannelFilter : public GenericRgbFilter {
@@ -13,8 +13,18 @@
 #include <business/imageanalysis/comporators/sharpnesscomparator.h>
 #include <business/imageanalysis/comporators/customrangeddifferenceinpixelvaluescomparator.h>
 #include <business/imageanalysis/comporators/linernonlinerdifferencecomparator.h>
+#include <business/imageanalysis/comporators/differingrowbandscomparator.h>
+#include <business/imageanalysis/comporators/ssimcomparator.h>
 #include <business/imageanalysis/filters/grayscalefilter.h>
 #include <business/imageanalysis/filters/rgbfilter.h>
+#include <business/imageanalysis/filters/filterpipeline.h>
+#include <business/imageanalysis/comparisonestimator.h>
+#include <QSettings>
+#include <QThread>
+#include <QtConcurrent>
+#include <QFutureWatcher>
+#include <algorithm>
+#include <future>
 #include <data/storage/filedialoghandler.h>
 #include <domain/interfaces/presentation/imageprocessinginteractorlistener.h>
 #include <business/utils/imagesinfo.h>
@@ -30,8 +40,25 @@ ImageProcessingInteractor::ImageProcessingInteractor(
     : mPropertiesDialogCallback(propertiesDialogCallback),
     mProgressDialogCallback(progressDialogCallback),
     mOriginalImages(images),
-    mDisplayedImages(images)
+    mDisplayedImages(images),
+    mIsLiveComparisonOverlayEnabled(false)
 {
+    QSettings settings("com.WhisperingWind", "TwinPix");
+    qint64 budgetMb = settings.value("filterHistory/memoryBudgetMb",
+                                     FilterHistory::mDefaultMemoryBudget / (1024 * 1024)
+                                     ).toLongLong();
+    mFilterHistory.setMemoryBudget(budgetMb * 1024 * 1024);
+    // The original images are compressed while a filter is displayed,
+    // so the history decompresses them only when it needs them
+    mFilterHistory.reset([this]() {
+        FilterHistoryImages images;
+        images.firstImage = mOriginalImages->getFirstImage().toImage();
+        if (mOriginalImages->isPairOfImages()) {
+            images.secondImage = mOriginalImages->getSecondImage().toImage();
+        }
+        return images;
+    });
+    updateRowDifferences();
 }
 
 ImageProcessingInteractor::~ImageProcessingInteractor() {
@@ -40,6 +67,12 @@ ImageProcessingInteractor::~ImageProcessingInteractor() {
     mDisplayedImages = nullptr;
     mPropertiesDialogCallback = nullptr;
     mProgressDialogCallback = nullptr;
+    mExactComparisonResult.cancel();
+    mRowDifferences.cancel();
+    resetIntegralImages();
+    if (mDifferenceRegionIndex) {
+        mDifferenceRegionIndex->cancel();
+    }
     clearLastComparisonImage();
 }
 
@@ -60,7 +93,7 @@ void ImageProcessingInteractor::coreCallImageProcessor(const QVariant &callerDat
 
     QString processorName = callerData.toString();
 
-    auto processor = ImageProcessorsManager::instance()->findProcessorByShortName(processorName);
+    auto processor = getOwnProcessor(ImageProcessorsManager::instance()->findProcessorByShortName(processorName));
 
     if (processor == nullptr) {
         throw std::runtime_error("Error: Unable to find the requested image processor.");
@@ -68,50 +101,77 @@ void ImageProcessingInteractor::coreCallImageProcessor(const QVariant &callerDat
 
     processor->reset();
 
-    handleProcessorPropertiesIfNeed(processor);
+    QList<Property> properties = handleProcessorPropertiesIfNeed(processor);
 
     if (processor->getType() == ImageProcessorType::Comparator) {
         callComparator(dynamic_pointer_cast<IComparator>(processor), mDisplayedImages);
     } else if (processor->getType() == ImageProcessorType::Filter) {
-        callFilter(dynamic_pointer_cast<IFilter>(processor));
+        callFilters({ { dynamic_pointer_cast<IFilter>(processor), properties } });
     } else {
         throw std::runtime_error("Error: An unknown image processor type.");
     }
 }
 
+// The processors of ImageProcessorsManager are shared by all windows, so every window
+// resets, sets up and runs its own copies of them. A copy is made again when the
+// manager reloads its processors.
+IImageProcessorPtr ImageProcessingInteractor::getOwnProcessor(IImageProcessorPtr processor) {
+    if (processor == nullptr) {
+        return nullptr;
+    }
+    QString shortName = processor->getShortName();
+    auto it = mOwnProcessors.find(shortName);
+    if (it == mOwnProcessors.end() || it->prototype != processor) {
+        it = mOwnProcessors.insert(shortName, { processor, processor->clone() });
+    }
+    return it->processor;
+}
+
 void ImageProcessingInteractor::clearLastComparisonImage() {
+    cancelComparisonImageStream(); // it would be the last comparison result when it is finished
     mLastDisplayedComparisonResult.clear();
     notifyFastSwitchingToComparisonImageStatusChanged(false);
 }
 
-void ImageProcessingInteractor::setLastComparisonImage(const QPixmap &pixmap, const QString &description) {
-    mLastDisplayedComparisonResult.set(pixmap, description);
+void ImageProcessingInteractor::setLastComparisonImage(const QImage &image, const QString &description) {
+    mLastDisplayedComparisonResult.set(image, description);
     notifyFastSwitchingToComparisonImageStatusChanged(true);
 }
 
 void ImageProcessingInteractor::showLastComparisonImage() {
     if (mLastDisplayedComparisonResult.hasLastDisplayedComparisonResult()) {
-        notifyComparisonResultLoaded(mLastDisplayedComparisonResult.getImage(),
+        notifyComparisonResultLoaded(QPixmap::fromImage(mLastDisplayedComparisonResult.getImage()),
                                      mLastDisplayedComparisonResult.getDescription()
                                      );
     }
 }
 
+std::optional<QImage> ImageProcessingInteractor::getLastComparisonImage() const {
+    if (!mLastDisplayedComparisonResult.hasLastDisplayedComparisonResult()) {
+        return std::nullopt;
+    }
+    return mLastDisplayedComparisonResult.getImage();
+}
+
 // If the user holds down the Command (Ctrl) key along with the comparator hotkey and selects
 // a specific area while holding the left mouse button, the comparator will run only for
 // the selected area.
-void ImageProcessingInteractor::analyzeSelectedArea(ImageHolderPtr images, std::optional<int> key) {
-    if (!key) {
+void ImageProcessingInteractor::analyzeSelectedArea(ImageHolderPtr images,
+                                                    const QRect &area,
+                                                    std::optional<int> key
+                                                    )
+{
+    if (!key || area.isEmpty()) {
         return;
     }
     QChar hotkey{key.value()};
     auto processorsManager = ImageProcessorsManager::instance();
-    auto processor = processorsManager->findProcessorByHotkey(hotkey);
+    auto processor = getOwnProcessor(processorsManager->findProcessorByHotkey(hotkey));
     if (processor == nullptr || processor->getType() != ImageProcessorType::Comparator) {
         return;
     }
     try {
-        callComparator(dynamic_pointer_cast<IComparator>(processor), images);
+        callComparator(dynamic_pointer_cast<IComparator>(processor), images, area);
     } catch(std::runtime_error &e) {
         notifyImageProcessorFailed(e.what());
     } catch (std::exception &e) {
@@ -119,35 +179,348 @@ void ImageProcessingInteractor::analyzeSelectedArea(ImageHolderPtr images, std::
     }
 }
 
+QFuture<RowDifferenceMap> ImageProcessingInteractor::getRowDifferences() const {
+    return mRowDifferences;
+}
+
+RowDifferenceMap ImageProcessingInteractor::getReadyRowDifferences() const {
+    if (!mRowDifferences.isFinished() || mRowDifferences.resultCount() == 0) {
+        return {}; // every row is treated as different
+    }
+    return mRowDifferences.result();
+}
+
+void ImageProcessingInteractor::updateRowDifferences() {
+    mDifferencePlane = {}; // it is calculated again when it is needed
+    if (mDifferencePlaneBuild) {
+        mDifferencePlaneBuild->cancel();
+        mDifferencePlaneBuild.reset();
+    }
+    mRowDifferences.cancel();
+    resetIntegralImages();
+    if (mDisplayedImages == nullptr || mDisplayedImages->isSingleImage()) {
+        mRowDifferences = QtFuture::makeReadyValueFuture(RowDifferenceMap {});
+        return;
+    }
+    // QPixmap may only be used in the GUI thread
+    QImage firstImage = mDisplayedImages->getFirstImage().toImage();
+    QImage secondImage = mDisplayedImages->getSecondImage().toImage();
+    mRowDifferences = QtConcurrent::run([firstImage, secondImage](QPromise<RowDifferenceMap> &promise) {
+        try {
+            auto map = RowDifferenceMap::build(firstImage, secondImage, [&promise]() {
+                return promise.isCanceled();
+            });
+            promise.addResult(map);
+        } catch (...) {
+            promise.setException(std::current_exception());
+        }
+    });
+}
+
+const DifferencePlane& ImageProcessingInteractor::getDifferencePlane() {
+    bool isPairOfImages = (mDisplayedImages != nullptr && mDisplayedImages->isPairOfImages());
+    if (!mDifferencePlane.isNull() || !isPairOfImages) {
+        return mDifferencePlane;
+    }
+    // The build may have been started by the preview of the properties already
+    QFuture<DifferencePlane> plane = buildDifferencePlane();
+    plane.waitForFinished(); // rethrows the error of the build
+    if (plane.resultCount() > 0) {
+        mDifferencePlane = plane.result();
+    }
+    return mDifferencePlane;
+}
+
+// The plane of the displayed images is built once in the background and shared by the
+// preview of the properties and the comparison that follows it
+QFuture<DifferencePlane> ImageProcessingInteractor::buildDifferencePlane() {
+    if (!mDifferencePlane.isNull()) {
+        return QtFuture::makeReadyValueFuture(mDifferencePlane);
+    }
+    if (!mDifferencePlaneBuild) {
+        // QPixmap may only be used in the GUI thread
+        QImage firstImage = mDisplayedImages->getFirstImage().toImage();
+        QImage secondImage = mDisplayedImages->getSecondImage().toImage();
+        RowDifferenceMap rowDifferences = getReadyRowDifferences();
+        mDifferencePlaneBuild = QtConcurrent::run([firstImage, secondImage, rowDifferences](QPromise<DifferencePlane> &promise) {
+            try {
+                // The plane stays null for images of different sizes, the comparators report the error
+                DifferencePlane plane;
+                if (firstImage.size() == secondImage.size()) {
+                    plane = DifferencePlane::build(firstImage, secondImage, rowDifferences);
+                }
+                promise.addResult(plane);
+            } catch (...) {
+                promise.setException(std::current_exception());
+            }
+        });
+    }
+    return mDifferencePlaneBuild.value();
+}
+
+// Canceling does not wait for the build, the worker drops its result
+void ImageProcessingInteractor::resetIntegralImages() {
+    if (mIntegralImages) {
+        mIntegralImages->cancel();
+        mIntegralImages.reset();
+    }
+}
+
+QFuture<DisplayedIntegralImages> ImageProcessingInteractor::getIntegralImages() {
+    if (mDisplayedImages == nullptr) {
+        return QtFuture::makeReadyValueFuture(DisplayedIntegralImages {});
+    }
+    if (!mIntegralImages) {
+        // QPixmap may only be used in the GUI thread
+        QImage firstImage = mDisplayedImages->getFirstImage().toImage();
+        QImage secondImage;
+        if (mDisplayedImages->isPairOfImages()) {
+            secondImage = mDisplayedImages->getSecondImage().toImage();
+        }
+        mIntegralImages = QtConcurrent::run([firstImage, secondImage](QPromise<DisplayedIntegralImages> &promise) {
+            try {
+                auto isCanceled = [&promise]() {
+                    return promise.isCanceled();
+                };
+                DisplayedIntegralImages integralImages;
+                auto first = IntegralImage::build(firstImage, isCanceled);
+                integralImages.first = std::make_shared<const IntegralImage>(std::move(first));
+                if (!secondImage.isNull()) {
+                    auto second = IntegralImage::build(secondImage, isCanceled);
+                    integralImages.second = std::make_shared<const IntegralImage>(std::move(second));
+                }
+                promise.addResult(integralImages);
+            } catch (...) {
+                promise.setException(std::current_exception());
+            }
+        });
+    }
+    return mIntegralImages.value();
+}
+
+DisplayedIntegralImages ImageProcessingInteractor::getReadyIntegralImages() const {
+    if (!mIntegralImages || !mIntegralImages->isFinished() || mIntegralImages->resultCount() == 0) {
+        return {};
+    }
+    return mIntegralImages->result();
+}
+
+// The images of a selected area come in the order in which they are shown,
+// so the tables are matched by the pixmaps, not by the position
+std::shared_ptr<const IntegralImage> ImageProcessingInteractor::getIntegralImage(const QPixmap &image) const {
+    if (mDisplayedImages == nullptr) {
+        return nullptr;
+    }
+    DisplayedIntegralImages integralImages = getReadyIntegralImages();
+    std::shared_ptr<const IntegralImage> result;
+    if (image.cacheKey() == mDisplayedImages->getFirstImage().cacheKey()) {
+        result = integralImages.first;
+    } else if (mDisplayedImages->isPairOfImages() &&
+               image.cacheKey() == mDisplayedImages->getSecondImage().cacheKey())
+    {
+        result = integralImages.second;
+    }
+    return (result == nullptr || result->isNull()) ? nullptr : result;
+}
+
+QFuture<DifferenceRegionIndex> ImageProcessingInteractor::getDifferenceRegionIndex() {
+    if (mOriginalImages == nullptr || mOriginalImages->isSingleImage()) {
+        return QtFuture::makeReadyValueFuture(DifferenceRegionIndex {});
+    }
+    if (!mDifferenceRegionIndex) {
+        // QPixmap may only be used in the GUI thread
+        QImage firstImage = mOriginalImages->getFirstImage().toImage();
+        QImage secondImage = mOriginalImages->getSecondImage().toImage();
+        mDifferenceRegionIndex = QtConcurrent::run([firstImage, secondImage](QPromise<DifferenceRegionIndex> &promise) {
+            try {
+                auto index = DifferenceRegionIndex::build(firstImage, secondImage, [&promise]() {
+                    return promise.isCanceled();
+                });
+                promise.addResult(index);
+            } catch (...) {
+                promise.setException(std::current_exception());
+            }
+        });
+    }
+    return mDifferenceRegionIndex.value();
+}
+
+// The filters stay in the history, so they can be redone
 void ImageProcessingInteractor::restoreOriginalImages() {
     if (mOriginalImages == nullptr) {
         return;
     }
+    mFilterHistory.moveTo(0);
+    mOriginalImages->decompress();
     mDisplayedImages = mOriginalImages;
+    updateRowDifferences();
+    clearLastComparisonImage();
+    notifyFilteredResultLoaded(mDisplayedImages);
+    updateLiveComparisonOverlay();
+}
+
+void ImageProcessingInteractor::undoFilter() {
+    if (mDisplayedImages == nullptr || !mFilterHistory.canUndo()) {
+        return;
+    }
+    try {
+        showFilterHistoryStep(mFilterHistory.getCurrentStep() - 1);
+    } catch (std::runtime_error &e) {
+        notifyImageProcessorFailed(e.what());
+    }
+}
+
+void ImageProcessingInteractor::redoFilter() {
+    if (mDisplayedImages == nullptr || !mFilterHistory.canRedo()) {
+        return;
+    }
+    try {
+        showFilterHistoryStep(mFilterHistory.getCurrentStep() + 1);
+    } catch (std::runtime_error &e) {
+        notifyImageProcessorFailed(e.what());
+    }
+}
+
+bool ImageProcessingInteractor::canUndoFilter() const {
+    return mFilterHistory.canUndo();
+}
+
+bool ImageProcessingInteractor::canRedoFilter() const {
+    return mFilterHistory.canRedo();
+}
+
+void ImageProcessingInteractor::showFilterHistoryStep(int step) {
+    FilterHistoryImages images = mFilterHistory.moveTo(step);
+    if (step == 0) {
+        mOriginalImages->decompress();
+        mDisplayedImages = mOriginalImages;
+    } else if (mDisplayedImages->isSingleImage()) {
+        mDisplayedImages = std::make_shared<ImageHolder>(QPixmap::fromImage(images.firstImage),
+                                                         mDisplayedImages->getFirstImagePath()
+                                                         );
+    } else {
+        mDisplayedImages = std::make_shared<ImageHolder>(QPixmap::fromImage(images.firstImage),
+                                                         mDisplayedImages->getFirstImagePath(),
+                                                         QPixmap::fromImage(images.secondImage),
+                                                         mDisplayedImages->getSecondImagePath()
+                                                         );
+    }
+    updateRowDifferences();
     clearLastComparisonImage();
     notifyFilteredResultLoaded(mDisplayedImages);
+    updateLiveComparisonOverlay();
+    compressOriginalImagesIfHidden();
+}
+
+// The original images are neither displayed nor analyzed while a filter is applied
+void ImageProcessingInteractor::compressOriginalImagesIfHidden() {
+    if (mOriginalImages != nullptr && mDisplayedImages != mOriginalImages) {
+        mOriginalImages->compress();
+    }
+}
+
+qint64 ImageProcessingInteractor::getDecodedMemoryUsage() const {
+    qint64 usage = mFilterHistory.getDecodedMemoryUsage() + mDifferencePlane.getMemoryUsage();
+    if (mDisplayedImages != nullptr) {
+        usage += mDisplayedImages->getDecodedSize();
+    }
+    if (mOriginalImages != nullptr && mOriginalImages != mDisplayedImages) {
+        usage += mOriginalImages->getDecodedSize();
+    }
+    if (mDifferenceRegionIndex && mDifferenceRegionIndex->isFinished() &&
+        mDifferenceRegionIndex->resultCount() > 0)
+    {
+        usage += mDifferenceRegionIndex->result().getMemoryUsage();
+    }
+    DisplayedIntegralImages displayedIntegralImages = getReadyIntegralImages();
+    QList<std::shared_ptr<const IntegralImage>> integralImages = {
+        displayedIntegralImages.first,
+        displayedIntegralImages.second
+    };
+    foreach (auto integralImage, integralImages) {
+        if (integralImage != nullptr) {
+            usage += integralImage->getMemoryUsage();
+        }
+    }
+    return usage;
 }
 
 QList<ImageProcessorInfo> ImageProcessingInteractor::showImageProcessorsHelp() {
     return ImageProcessorsManager::instance()->getAllProcessorsInfo();
 }
 
-void ImageProcessingInteractor::handleProcessorPropertiesIfNeed(IImageProcessorPtr processor) {
+QList<Property> ImageProcessingInteractor::handleProcessorPropertiesIfNeed(IImageProcessorPtr processor) {
     auto properties = processor->getDefaultProperties();
     if (properties.empty()) {
-        return;
+        return {};
+    }
+
+    // The preview is rendered from the difference plane, so changing the
+    // properties only re-thresholds it instead of comparing the images again.
+    // The dialog opens at once; the preview is shown when the plane is built.
+    PropertiesChangedCallback onPropertiesChanged = nullptr;
+    QFutureWatcher<DifferencePlane> differencePlaneWatcher;
+    bool isDifferencePlaneReady = false;
+    std::optional<QList<Property>> previewProperties; // The last ones set in the dialog
+    auto comparator = dynamic_pointer_cast<IComparator>(processor);
+    bool isPairOfImages = (mDisplayedImages != nullptr && mDisplayedImages->isPairOfImages());
+    if (comparator != nullptr && comparator->isPreviewSupported() && isPairOfImages) {
+        auto renderPreview = [this, comparator](const QList<Property> &properties) {
+            DifferencePlane differencePlane = mDifferencePlane;
+            notifyComparisonPreviewChanged([comparator, differencePlane, properties](const QRect &area) {
+                return comparator->renderPreview(differencePlane, properties, area);
+            });
+        };
+        // The watcher and the dialog live until this function returns
+        QObject::connect(&differencePlaneWatcher, &QFutureWatcherBase::finished, [&, renderPreview]() {
+            try {
+                getDifferencePlane(); // the build is finished, so it takes its result
+            } catch (std::exception &e) {
+                notifyImageProcessorFailed(e.what());
+                return;
+            }
+            isDifferencePlaneReady = true;
+            if (previewProperties) {
+                renderPreview(previewProperties.value());
+            }
+        });
+        onPropertiesChanged = [&, renderPreview](const QList<Property> &properties) {
+            previewProperties = properties;
+            if (isDifferencePlaneReady) {
+                renderPreview(properties);
+            }
+        };
+        differencePlaneWatcher.setFuture(buildDifferencePlane());
     }
-    auto newProperties = mPropertiesDialogCallback->showImageProcessorPropertiesDialog(
+
+    QList<Property> newProperties;
+    try {
+        newProperties = mPropertiesDialogCallback->showImageProcessorPropertiesDialog(
                                                                     processor->getShortName(),
                                                                     processor->getDescription(),
-                                                                    properties
+                                                                    properties,
+                                                                    onPropertiesChanged
                                                                 );
+    } catch (...) {
+        if (onPropertiesChanged) {
+            notifyComparisonPreviewFinished(); // the dialog was canceled
+        }
+        throw;
+    }
+    if (onPropertiesChanged) {
+        notifyComparisonPreviewFinished();
+    }
     if (!newProperties.empty()) {
         processor->setProperties(newProperties);
     }
+    return newProperties;
 }
 
-void ImageProcessingInteractor::callComparator(IComparatorPtr comparator, ImageHolderPtr images) {
+void ImageProcessingInteractor::callComparator(IComparatorPtr comparator,
+                                               ImageHolderPtr images,
+                                               const std::optional<QRect> &area
+                                               )
+{
     if (images == nullptr || images->isSingleImage()) {
         return;
     }
@@ -163,6 +536,58 @@ void ImageProcessingInteractor::callComparator(IComparatorPtr comparator, ImageH
     ComparableImage comapableImage1 { firstImage, firstImageName };
     ComparableImage comapableImage2 { secondImage, secondImageName };
 
+    // A selected area is compared as a new pair of images; the comparators see
+    // only the area, but its pixels are not copied out of the whole images
+    RowDifferenceMap rowDifferences = getReadyRowDifferences();
+    if (area) {
+        comapableImage1.setRegionOfInterest(area.value());
+        comapableImage2.setRegionOfInterest(area.value());
+        if (!comapableImage1.hasRegionOfInterest() || !comapableImage2.hasRegionOfInterest()) {
+            return; // the area is outside of the images
+        }
+        rowDifferences = RowDifferenceMap::build(comapableImage1.getImage(), comapableImage2.getImage());
+    }
+    if (rowDifferences.isIdentical() && comparator->isDifferenceBased()) {
+        mProgressDialogCallback->onMessage("The images are identical.");
+        return;
+    }
+    comapableImage1.setRowDifferences(rowDifferences);
+    comapableImage2.setRowDifferences(rowDifferences);
+
+    // A result of a selected area is shown in a separate viewer, so it is not streamed
+    bool isSameSize = (comapableImage1.getImage().size() == comapableImage2.getImage().size());
+    bool isStreamed = !area && isSameSize && comparator->isTileRenderingSupported();
+    if (!area && comparator->isDifferenceBased()) {
+        // Every streamed tile compares only its own pixels, so the first tiles do not
+        // wait for the plane of the whole images; the plane is reused if it is ready
+        const DifferencePlane &differencePlane = isStreamed ? mDifferencePlane : getDifferencePlane();
+        comapableImage1.setDifferencePlane(differencePlane);
+        comapableImage2.setDifferencePlane(differencePlane);
+    }
+    comapableImage1.setIntegralImage(getIntegralImage(firstImage));
+    comapableImage2.setIntegralImage(getIntegralImage(secondImage));
+
+    if (isStreamed) {
+        mLiveComparisonOverlayComparator = comparator->getShortName();
+        updateLiveComparisonOverlay();
+        streamComparisonImage(comparator, comapableImage1, comapableImage2);
+        return;
+    }
+
+    if (ComparisonEstimator::isEstimateUseful(comparator,
+                                              comapableImage1.getRegionOfInterest().size(),
+                                              comapableImage2.getRegionOfInterest().size()
+                                              ))
+    {
+        callComparatorProgressively(comparator,
+                                    comapableImage1,
+                                    comapableImage2,
+                                    firstImagePath,
+                                    secondImagePath
+                                    );
+        return;
+    }
+
     auto result = comparator->compare(comapableImage1, comapableImage2);
 
     if (result.get() == nullptr) {
@@ -175,12 +600,12 @@ void ImageProcessingInteractor::callComparator(IComparatorPtr comparator, ImageH
         if (pixmap.isNull()) {
             throw std::runtime_error("Error: The comparator returns an empty result.");
         }
-        int originalWidth = mOriginalImages->getFirstImage().width();
-        int originalHeight = mOriginalImages->getSecondImage().height();
+        int originalWidth = mOriginalImages->getFirstImageSize().width();
+        int originalHeight = mOriginalImages->getSecondImageSize().height();
         int resultWidth = imageResult.width();
         int resultHeight = imageResult.height();
         if (originalWidth == resultWidth && originalHeight == resultHeight) {
-            setLastComparisonImage(pixmap, comparator->getShortName());
+            setLastComparisonImage(imageResult, comparator->getShortName());
             notifyComparisonResultLoaded(pixmap, comparator->getShortName());
         } else {
             notifyShowImageInExternalViewer(pixmap, comparator->getShortName());
@@ -199,39 +624,264 @@ void ImageProcessingInteractor::callComparator(IComparatorPtr comparator, ImageH
     }
 }
 
-QPixmap ImageProcessingInteractor::applyFilter(const QPixmap &pixmap, IFilterPtr filter) {
-    QImage image = pixmap.toImage();
-    if (image.isNull()) {
-        throw std::runtime_error("An error occurred during the loading of one of the images");
+// The estimate is shown at once, the exact result replaces it when it is ready.
+// The exact result is calculated by a copy of the comparator, so the window can
+// change and run the comparator again meanwhile.
+void ImageProcessingInteractor::callComparatorProgressively(IComparatorPtr comparator,
+                                                            const ComparableImage &first,
+                                                            const ComparableImage &second,
+                                                            const QString &firstImagePath,
+                                                            const QString &secondImagePath
+                                                            )
+{
+    QString estimateHtml = ComparisonEstimator::estimate(comparator, first, second);
+
+    // Neither a new result nor closing the window waits for the previous exact result:
+    // it is canceled, and it is skipped if it has not started yet. A comparator can not
+    // be interrupted, so a started one finishes unobserved, but only in the pool of the
+    // exact results: the background work of the windows in the global pool is not delayed.
+    mExactComparisonResult.cancel();
+    auto comparatorCopy = dynamic_pointer_cast<IComparator>(comparator->clone());
+    mExactComparisonResult = QtConcurrent::run(getExactComparisonPool(), [comparatorCopy, first, second](QPromise<QString> &promise) {
+        if (promise.isCanceled()) {
+            return;
+        }
+        try {
+            auto result = comparatorCopy->compare(first, second);
+            if (result.get() == nullptr || result->getType() != ComparisonResultVariantType::String) {
+                throw std::runtime_error("Error: The comparator returns nothing.");
+            }
+            QString stringResult = result->getStringResult();
+            if (stringResult.isEmpty()) {
+                throw std::runtime_error("Error: The comparator returns an empty result.");
+            }
+            promise.addResult(stringResult);
+        } catch (...) {
+            // The listener gets the exception of the comparator as it is
+            promise.setException(std::current_exception());
+        }
+    });
+
+    notifyComparisonResultEstimated(estimateHtml,
+                                    mExactComparisonResult,
+                                    comparator->getFullName(),
+                                    firstImagePath,
+                                    secondImagePath
+                                    );
+}
+
+QThreadPool* ImageProcessingInteractor::getExactComparisonPool() {
+    static QThreadPool pool;
+    static bool isInitialized = false;
+    if (!isInitialized) {
+        // Only the latest exact result of a window is shown, so a few threads are enough
+        pool.setMaxThreadCount(std::clamp(QThread::idealThreadCount() / 4, 1, 2));
+        isInitialized = true;
     }
-    QImage filteredImage = filter->filter(image);
-    if (filteredImage.isNull()) {
-        throw std::runtime_error("The filter returns an empty result.");
+    return &pool;
+}
+
+void ImageProcessingInteractor::streamComparisonImage(IComparatorPtr comparator,
+                                                      const ComparableImage &first,
+                                                      const ComparableImage &second
+                                                      )
+{
+    cancelComparisonImageStream();
+    // The renderers share a copy of the comparator: renderTile() does not change it,
+    // and the window may change its own comparator before the stream is finished
+    IComparatorPtr comparatorCopy = dynamic_pointer_cast<IComparator>(comparator->clone());
+    auto buffer = std::make_shared<TiledImageBuffer>(first.getImage().size());
+    int renderersCount = std::clamp(buffer->getTileCount(), 1, std::max(1, QThread::idealThreadCount()));
+    for (int i = 0; i < renderersCount; ++i) {
+        // The renderers do not use the interactor, so a canceled stream is left to them
+        // and its remaining tiles are skipped; the GUI thread never waits for them
+        mComparisonImageStreamRenderers.append(QtConcurrent::run([comparatorCopy, first, second, buffer](QPromise<void> &promise) {
+            try {
+                for (int index = buffer->takeNextTile(); index >= 0 && !promise.isCanceled(); index = buffer->takeNextTile()) {
+                    QRect area = buffer->getTileRect(index);
+                    QImage tile = renderComparisonTile(comparatorCopy, first, second, area);
+                    if (tile.size() != area.size()) {
+                        throw std::runtime_error("Error: The comparator returns an empty result.");
+                    }
+                    buffer->setTile(index, tile);
+                }
+            } catch (std::exception &e) {
+                buffer->setError(e.what());
+            } catch (...) {
+                buffer->setError("Error: The comparator failed with an unknown error.");
+            }
+        }));
+    }
+    mComparisonImageStream = buffer;
+    mComparisonImageStreamDescription = comparator->getShortName();
+    notifyComparisonImageStreamStarted(buffer);
+}
+
+void ImageProcessingInteractor::finishComparisonImageStream(const TiledImageBufferPtr &buffer) {
+    if (buffer == nullptr || buffer != mComparisonImageStream) {
+        return;
+    }
+    QString error = buffer->getError();
+    QString description = mComparisonImageStreamDescription;
+    cancelComparisonImageStream();
+    if (!error.isEmpty()) {
+        notifyImageProcessorFailed(error);
+        return;
+    }
+    try {
+        QImage image = buffer->toImage();
+        setLastComparisonImage(image, description);
+        notifyComparisonResultLoaded(QPixmap::fromImage(image), description);
+    } catch (std::runtime_error &e) {
+        notifyImageProcessorFailed(e.what());
+    }
+}
+
+// Does not wait for the tiles that are being rendered
+void ImageProcessingInteractor::cancelComparisonImageStream() {
+    if (mComparisonImageStream != nullptr) {
+        mComparisonImageStream->cancel();
+    }
+    foreach (auto renderer, mComparisonImageStreamRenderers) {
+        renderer.cancel();
+    }
+    mComparisonImageStreamRenderers.clear();
+    mComparisonImageStream = nullptr;
+    mComparisonImageStreamDescription.clear();
+}
+
+void ImageProcessingInteractor::setLiveComparisonOverlayEnabled(bool isEnabled) {
+    mIsLiveComparisonOverlayEnabled = isEnabled;
+    updateLiveComparisonOverlay();
+}
+
+void ImageProcessingInteractor::updateLiveComparisonOverlay() {
+    bool isPairOfImages = (mDisplayedImages != nullptr && mDisplayedImages->isPairOfImages());
+    if (!mIsLiveComparisonOverlayEnabled || !isPairOfImages) {
+        notifyLiveComparisonOverlayChanged(nullptr);
+        return;
+    }
+    if (mLiveComparisonOverlayComparator.isEmpty()) {
+        ColoredDifferenceInPixelValuesComporator defaultComparator { ColoredDifferenceInPixelValuesComporator::Result::Image };
+        mLiveComparisonOverlayComparator = defaultComparator.getShortName();
+    }
+    auto processor = getOwnProcessor(ImageProcessorsManager::instance()->findProcessorByShortName(mLiveComparisonOverlayComparator));
+    auto comparator = dynamic_pointer_cast<IComparator>(processor);
+    QImage firstImage = mDisplayedImages->getFirstImage().toImage();
+    QImage secondImage = mDisplayedImages->getSecondImage().toImage();
+    if (comparator == nullptr || !comparator->isTileRenderingSupported() || firstImage.size() != secondImage.size()) {
+        notifyLiveComparisonOverlayChanged(nullptr);
+        return;
+    }
+    // The difference plane is not calculated for the overlay, but it is reused if it is ready.
+    // The renderer keeps a copy of the comparator, so the next call of it does not change the overlay.
+    auto comparatorCopy = dynamic_pointer_cast<IComparator>(comparator->clone());
+    notifyLiveComparisonOverlayChanged(createTileRenderer(comparatorCopy, firstImage, secondImage, mDifferencePlane));
+}
+
+ComparisonPreviewRenderer ImageProcessingInteractor::createTileRenderer(IComparatorPtr comparator,
+                                                                        const QImage &firstImage,
+                                                                        const QImage &secondImage,
+                                                                        const DifferencePlane &differencePlane
+                                                                        )
+{
+    return [comparator, firstImage, secondImage, differencePlane](const QRect &area) -> QImage {
+        ComparableImage first { firstImage, QString() };
+        ComparableImage second { secondImage, QString() };
+        first.setDifferencePlane(differencePlane);
+        second.setDifferencePlane(differencePlane);
+        try {
+            return renderComparisonTile(comparator, first, second, area);
+        } catch (std::exception &) {
+            return {}; // e.g. invalid properties, there is nothing to show
+        }
+    };
+}
+
+// Without the difference plane of the whole images only the pixels of the area are compared
+QImage ImageProcessingInteractor::renderComparisonTile(IComparatorPtr comparator,
+                                                       const ComparableImage &first,
+                                                       const ComparableImage &second,
+                                                       const QRect &area
+                                                       )
+{
+    if (!first.getDifferencePlane().isNull()) {
+        return comparator->renderTile(first, second, area);
     }
-    auto filteredPixmap = QPixmap::fromImage(filteredImage);
+    ComparableImage firstArea = first;
+    ComparableImage secondArea = second;
+    firstArea.setRegionOfInterest(area);
+    secondArea.setRegionOfInterest(area);
+    RowDifferenceMap rowDifferences = first.getRowDifferences().mid(area.top(), area.height());
+    firstArea.setRowDifferences(rowDifferences);
+    secondArea.setRowDifferences(rowDifferences);
+    return comparator->renderTile(firstArea, secondArea, QRect(QPoint(0, 0), area.size()));
+}
+
+QPixmap ImageProcessingInteractor::applyFilter(const QPixmap &pixmap, IFilterPtr filter) {
+    QImage filteredImage = applyFilters(pixmap.toImage(), FilterPipeline { { filter } });
+    auto filteredPixmap = QPixmap::fromImage(std::move(filteredImage));
     if (filteredPixmap.isNull()) {
         throw std::runtime_error("The filter returns an empty result.");
     }
     return filteredPixmap;
 }
 
-void ImageProcessingInteractor::callFilter(IFilterPtr filter) {
-    if (mDisplayedImages == nullptr) {
+QImage ImageProcessingInteractor::applyFilters(QImage image, const FilterPipeline &pipeline) {
+    if (image.isNull()) {
+        throw std::runtime_error("An error occurred during the loading of one of the images");
+    }
+    return pipeline.apply(std::move(image));
+}
+
+void ImageProcessingInteractor::callFilters(const QList<AppliedFilter> &filters) {
+    FilterPipeline pipeline = FilterHistory::createPipeline(filters);
+    if (mDisplayedImages == nullptr || pipeline.isEmpty()) {
         return;
     }
+    // QPixmap may only be used in the GUI thread. The images share the buffers of the
+    // pixmaps, so the filters copy them only once, when the first row is changed.
+    QImage firstImage = mDisplayedImages->getFirstImage().toImage();
     if (mDisplayedImages->isSingleImage()) {
-        QPixmap firstPixmap = applyFilter(mDisplayedImages->getFirstImage(), filter);
-        mDisplayedImages = std::make_shared<ImageHolder>(firstPixmap, mDisplayedImages->getFirstImagePath());
+        QImage filteredImage = applyFilters(std::move(firstImage), pipeline);
+        mFilterHistory.push(filters, filteredImage);
+        mDisplayedImages = std::make_shared<ImageHolder>(QPixmap::fromImage(std::move(filteredImage)),
+                                                         mDisplayedImages->getFirstImagePath()
+                                                         );
     } else {
-        QPixmap firstPixmap = applyFilter(mDisplayedImages->getFirstImage(), filter);
-        QPixmap secondPixmap = applyFilter(mDisplayedImages->getSecondImage(), filter);
-        mDisplayedImages = std::make_shared<ImageHolder>(firstPixmap,
-                                                        mDisplayedImages->getFirstImagePath(),
-                                                        secondPixmap,
-                                                        mDisplayedImages->getSecondImagePath());
+        QImage secondImage = mDisplayedImages->getSecondImage().toImage();
+        QImage firstFilteredImage;
+        QImage secondFilteredImage;
+        if (pipeline.isPerPixel()) {
+            // The built-in filters are thread-safe, so the second image is
+            // filtered in the background while the first one is filtered here
+            auto secondResult = std::async(std::launch::async, [&pipeline, &secondImage]() {
+                return applyFilters(std::move(secondImage), pipeline);
+            });
+            try {
+                firstFilteredImage = applyFilters(std::move(firstImage), pipeline);
+            } catch (...) {
+                secondResult.wait();
+                throw;
+            }
+            secondFilteredImage = secondResult.get();
+        } else {
+            firstFilteredImage = applyFilters(std::move(firstImage), pipeline);
+            secondFilteredImage = applyFilters(std::move(secondImage), pipeline);
+        }
+        mFilterHistory.push(filters, firstFilteredImage, secondFilteredImage);
+        mDisplayedImages = std::make_shared<ImageHolder>(QPixmap::fromImage(std::move(firstFilteredImage)),
+                                                         mDisplayedImages->getFirstImagePath(),
+                                                         QPixmap::fromImage(std::move(secondFilteredImage)),
+                                                         mDisplayedImages->getSecondImagePath()
+                                                         );
     }
+    // The displayed pair is replaced once, whatever the length of the chain
+    updateRowDifferences();
     clearLastComparisonImage();
     notifyFilteredResultLoaded(mDisplayedImages);
+    updateLiveComparisonOverlay();
+    compressOriginalImagesIfHidden();
 }
 
 QList<ImageProcessorInfo> ImageProcessingInteractor::getImageProcessorsInfo() {
@@ -256,6 +906,9 @@ QList<ImageProcessorInfo> ImageProcessingInteractor::getImageProcessorsInfo() {
     auto imageProximityComparator = make_shared<ImageProximityToOriginComparator>();
     auto customRangedPixelsComparatorImg = make_shared<CustomRangedDifferenceInPixelValuesComparator>();
     auto linerNonLinerDifferenceComparator = make_shared<LinerNonLinerDifferenceComparator>();
+    auto differingRowBandsComparator = make_shared<DifferingRowBandsComparator>();
+    auto ssimComparatorTxt = make_shared<SsimComparator>(SsimComparator::Result::Text);
+    auto ssimComparatorImg = make_shared<SsimComparator>(SsimComparator::Result::Image);
 
     processorsManager->addProcessor(imageComparator);
     processorsManager->addProcessor(imageSaturationComporator);
@@ -267,6 +920,9 @@ QList<ImageProcessorInfo> ImageProcessingInteractor::getImageProcessorsInfo() {
     processorsManager->addProcessor(imageProximityComparator);
     processorsManager->addProcessor(customRangedPixelsComparatorImg);
     processorsManager->addProcessor(linerNonLinerDifferenceComparator);
+    processorsManager->addProcessor(differingRowBandsComparator);
+    processorsManager->addProcessor(ssimComparatorTxt);
+    processorsManager->addProcessor(ssimComparatorImg);
 
     // add filters
 
@@ -291,6 +947,31 @@ QList<ImageProcessorInfo> ImageProcessingInteractor::getImageProcessorsInfo() {
     return processorsManager->getAllProcessorsInfo();
 }
 
+// Loads the processors only if they have not been loaded yet
+QList<ImageProcessorInfo> ImageProcessingInteractor::getLoadedImageProcessorsInfo() {
+    auto imageProcessorsInfo = ImageProcessorsManager::instance()->getAllProcessorsInfo();
+    if (imageProcessorsInfo.isEmpty()) {
+        return getImageProcessorsInfo();
+    }
+    return imageProcessorsInfo;
+}
+
+IFilterPtr ImageProcessingInteractor::createRenderFilter(ViewRenderMode mode) {
+    switch (mode) {
+    case ViewRenderMode::Color:
+        return nullptr;
+    case ViewRenderMode::Red:
+        return std::make_shared<RedChannelFilter>();
+    case ViewRenderMode::Green:
+        return std::make_shared<GreenChannelFilter>();
+    case ViewRenderMode::Blue:
+        return std::make_shared<BlueChannelFilter>();
+    case ViewRenderMode::Grayscale:
+        return std::make_shared<GrayscaleFilter>();
+    }
+    return nullptr;
+}
+
 void ImageProcessingInteractor::runAllComparators() {
 
     ImagesInfo info { mDisplayedImages };
@@ -308,6 +989,11 @@ void ImageProcessingInteractor::runAllComparators() {
 
     ComparableImage firstComparableImage {image1, fullName1};
     ComparableImage secondComparableImage {image2, fullName2};
+    RowDifferenceMap rowDifferences = getReadyRowDifferences();
+    firstComparableImage.setRowDifferences(rowDifferences);
+    secondComparableImage.setRowDifferences(rowDifferences);
+    firstComparableImage.setDifferencePlane(getDifferencePlane());
+    secondComparableImage.setDifferencePlane(getDifferencePlane());
 
     RunAllComparatorsInteractor runAllComparatorsInteractor {
                                             mProgressDialogCallback,
@@ -365,6 +1051,29 @@ void ImageProcessingInteractor::notifyComparisonResultLoaded(const QString &html
     }
 }
 
+void ImageProcessingInteractor::notifyComparisonResultEstimated(const QString &estimateHtml,
+                                                                const QFuture<QString> &exactHtml,
+                                                                const QString &comporatorFullName,
+                                                                const QString &firstImagePath,
+                                                                const QString &secondImagePath
+                                                                )
+{
+    foreach (auto listener, mListeners) {
+        listener->onComparisonResultEstimated(estimateHtml,
+                                              exactHtml,
+                                              comporatorFullName,
+                                              firstImagePath,
+                                              secondImagePath
+                                              );
+    }
+}
+
+void ImageProcessingInteractor::notifyComparisonImageStreamStarted(const TiledImageBufferPtr &buffer) {
+    foreach (auto listener, mListeners) {
+        listener->onComparisonImageStreamStarted(buffer);
+    }
+}
+
 void ImageProcessingInteractor::notifyShowImageInExternalViewer(const QPixmap &image,
                                                                 const QString &description
                                                                 )
@@ -391,3 +1100,21 @@ void ImageProcessingInteractor::notifyFastSwitchingToComparisonImageStatusChange
         listener->onFastSwitchingToComparisonImageStatusChanged(isSwitchingAvailable);
     }
 }
+
+void ImageProcessingInteractor::notifyComparisonPreviewChanged(const ComparisonPreviewRenderer &renderer) {
+    foreach (auto listener, mListeners) {
+        listener->onComparisonPreviewChanged(renderer);
+    }
+}
+
+void ImageProcessingInteractor::notifyLiveComparisonOverlayChanged(const ComparisonPreviewRenderer &renderer) {
+    foreach (auto listener, mListeners) {
+        listener->onLiveComparisonOverlayChanged(renderer);
+    }
+}
+
+void ImageProcessingInteractor::notifyComparisonPreviewFinished() {
+    foreach (auto listener, mListeners) {
+        listener->onComparisonPreviewFinished();
+    }
+}
@@ -3,13 +3,20 @@
 
 #include <QtCore/qvariant.h>
 #include <qpixmap.h>
+#include <QFuture>
+#include <QHash>
+#include <QThreadPool>
 #include <domain/interfaces/presentation/imagefilesinteractorlistener.h>
 #include <domain/interfaces/business/icomparator.h>
 #include <domain/interfaces/business/ifilter.h>
 #include <domain/valueobjects/imageprocessorsinfo.h>
 #include <domain/valueobjects/lastdisplayedcomparisonresult.h>
 #include <domain/valueobjects/savefileinfo.h>
+#include <domain/valueobjects/integralimage.h>
+#include <domain/valueobjects/viewrendermode.h>
 #include <business/recentfilesmanager.h>
+#include <business/imageanalysis/differenceregionindex.h>
+#include <business/imageanalysis/filterhistory.h>
 #include <domain/interfaces/presentation/imageprocessinginteractorlistener.h>
 
 
@@ -17,11 +24,25 @@ class PluginsManager;
 class ImageProcessorsManager;
 class IProgressDialog;
 class IPropcessorPropertiesDialogCallback;
+class FilterPipeline;
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct DisplayedIntegralImages {
+    std::shared_ptr<const IntegralImage> first;
+    std::shared_ptr<const IntegralImage> second; // nullptr for a single image
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
 class ImageProcessingInteractor
 {
 public:
     static QList<ImageProcessorInfo> getImageProcessorsInfo();
+    static QList<ImageProcessorInfo> getLoadedImageProcessorsInfo();
+
+    // The per-pixel filter that shows the images in the mode, nullptr for Color
+    static IFilterPtr createRenderFilter(ViewRenderMode mode);
 
     ImageProcessingInteractor(const ImageHolderPtr images,
                               IPropcessorPropertiesDialogCallback *propertiesDialogCallback,
@@ -41,10 +62,71 @@ public:
 
     void showLastComparisonImage();
 
-    void analyzeSelectedArea(ImageHolderPtr, std::optional<int> key);
+    // The last displayed comparison result in the format the comparator produced,
+    // e.g. Format_Indexed8 for the difference images, or std::nullopt if there is none.
+    std::optional<QImage> getLastComparisonImage() const;
+
+    // Loads the streamed comparison image when all its tiles are rendered, or reports
+    // the error of the comparator (see IImageProcessingInteractorListener).
+    // A buffer that is no longer current, e.g. after a filter is applied, is ignored.
+    void finishComparisonImageStream(const TiledImageBufferPtr &buffer);
+
+    // The live comparison overlay shows the result of the last image comparator that
+    // supports tile rendering (v.2 Image by default) over the displayed images. It is
+    // rendered only for the visible tiles, so turning it on does not compare the
+    // whole images. It follows the filters and the comparators run by the user.
+    void setLiveComparisonOverlayEnabled(bool isEnabled);
+
+    // The area is analyzed in place as a region of interest of the images
+    void analyzeSelectedArea(ImageHolderPtr images, const QRect &area, std::optional<int> key);
 
     QPixmap applyFilter(const QPixmap &pixmap, IFilterPtr filter);
 
+    // Applies a chain of filters to the displayed images as a single FilterPipeline:
+    // consecutive per-pixel filters are fused into one pass, both images are filtered
+    // in parallel and the listeners are notified once with the filtered pair.
+    // The chain is a single step of the filter history.
+    void callFilters(const QList<AppliedFilter> &filters);
+
+    // Steps through the filter history. The memory budget of the history
+    // is read from the "filterHistory/memoryBudgetMb" setting.
+    void undoFilter();
+    void redoFilter();
+    bool canUndoFilter() const;
+    bool canRedoFilter() const;
+
+    // The memory taken by the decoded images (the displayed ones, the original ones
+    // and the steps of the filter history) and by the difference plane, the region
+    // index and the integral images that are built; the compressed images are
+    // counted by CompressedImage.
+    qint64 getDecodedMemoryUsage() const;
+
+    // The regions in which the original images differ. The index is built in the
+    // background on the first call, and the build is canceled when the interactor
+    // is destroyed. The future throws std::runtime_error if the sizes of the images differ.
+    QFuture<DifferenceRegionIndex> getDifferenceRegionIndex();
+
+    // The rows in which the displayed images differ. The map is built in the background
+    // when the displayed images change, and the previous build is canceled. Comparators
+    // use the map to skip identical rows if it is ready, otherwise every row is compared.
+    QFuture<RowDifferenceMap> getRowDifferences() const;
+
+    // The per-pixel difference of the displayed images. It is calculated on the
+    // first call and shared by all the difference comparators until a filter is applied.
+    // It is null if the images have different sizes.
+    const DifferencePlane& getDifferencePlane();
+
+    // The summed-area tables of the displayed images, for O(1) statistics of any region
+    // (the Region Statistics panel). They take about 24 bytes per pixel, so they are
+    // built in the background only on the first call after the displayed images change,
+    // and the build is canceled when they change again.
+    QFuture<DisplayedIntegralImages> getIntegralImages();
+
+    // The table of a displayed image if it is built already, otherwise nullptr; the call
+    // does not start the build. Comparators use the table if it is ready: building it
+    // for a single region would take longer than reading the pixels of the region.
+    std::shared_ptr<const IntegralImage> getIntegralImage(const QPixmap &image) const;
+
 private:
     IPropcessorPropertiesDialogCallback *mPropertiesDialogCallback;
     IProgressDialog *mProgressDialogCallback;
@@ -52,11 +134,63 @@ private:
     ImageHolderPtr mOriginalImages;
     ImageHolderPtr mDisplayedImages;
     LastDisplayedComparisonResult mLastDisplayedComparisonResult;
+    std::optional<QFuture<DifferenceRegionIndex>> mDifferenceRegionIndex; // Started on the first request
+    QFuture<RowDifferenceMap> mRowDifferences;
+    DifferencePlane mDifferencePlane;
+    std::optional<QFuture<DifferencePlane>> mDifferencePlaneBuild; // Started by the preview of the properties
+    std::optional<QFuture<DisplayedIntegralImages>> mIntegralImages; // Started on the first request
+    FilterHistory mFilterHistory;
+    QFuture<QString> mExactComparisonResult;
+    TiledImageBufferPtr mComparisonImageStream;
+    QString mComparisonImageStreamDescription;
+    QList<QFuture<void>> mComparisonImageStreamRenderers;
+    bool mIsLiveComparisonOverlayEnabled;
+    QString mLiveComparisonOverlayComparator; // The short name of the comparator
+
+    // The copies of the processors that this window runs, by short name
+    struct OwnProcessor {
+        IImageProcessorPtr prototype; // The processor in ImageProcessorsManager
+        IImageProcessorPtr processor;
+    };
+    QHash<QString, OwnProcessor> mOwnProcessors;
 
     void coreCallImageProcessor(const QVariant &callerData);
-    void callComparator(IComparatorPtr comparator, ImageHolderPtr images);
-    void callFilter(IFilterPtr filter);
-    void handleProcessorPropertiesIfNeed(IImageProcessorPtr processor);
+    IImageProcessorPtr getOwnProcessor(IImageProcessorPtr processor);
+    void callComparator(IComparatorPtr comparator,
+                        ImageHolderPtr images,
+                        const std::optional<QRect> &area = std::nullopt
+                        );
+    void callComparatorProgressively(IComparatorPtr comparator,
+                                     const ComparableImage &first,
+                                     const ComparableImage &second,
+                                     const QString &firstImagePath,
+                                     const QString &secondImagePath
+                                     );
+    void streamComparisonImage(IComparatorPtr comparator,
+                               const ComparableImage &first,
+                               const ComparableImage &second
+                               );
+    void cancelComparisonImageStream();
+    void updateLiveComparisonOverlay();
+    static ComparisonPreviewRenderer createTileRenderer(IComparatorPtr comparator,
+                                                        const QImage &firstImage,
+                                                        const QImage &secondImage,
+                                                        const DifferencePlane &differencePlane
+                                                        );
+    static QImage renderComparisonTile(IComparatorPtr comparator,
+                                       const ComparableImage &first,
+                                       const ComparableImage &second,
+                                       const QRect &area
+                                       );
+    static QImage applyFilters(QImage image, const FilterPipeline &pipeline);
+
+    // The pool of the exact comparison results, shared by all windows (see callComparatorProgressively)
+    static QThreadPool* getExactComparisonPool();
+    void showFilterHistoryStep(int step);
+    void compressOriginalImagesIfHidden();
+
+    // Returns the properties chosen by the user, it is empty if the processor has none
+    QList<Property> handleProcessorPropertiesIfNeed(IImageProcessorPtr processor);
 
     void notifyComparisonResultLoaded(const QPixmap &image, const QString &description);
 
@@ -65,11 +199,26 @@ private:
                                       const QString &firstImagePath,
                                       const QString &secondImagePath);
 
+    void notifyComparisonResultEstimated(const QString &estimateHtml,
+                                         const QFuture<QString> &exactHtml,
+                                         const QString &comporatorFullName,
+                                         const QString &firstImagePath,
+                                         const QString &secondImagePath);
+
+    void notifyComparisonImageStreamStarted(const TiledImageBufferPtr &buffer);
     void notifyFilteredResultLoaded(const ImageHolderPtr imageHolder);
     void notifyImageProcessorFailed(const QString &error);
     void notifyFastSwitchingToComparisonImageStatusChanged(bool isSwitchingAvailable);
+    void notifyComparisonPreviewChanged(const ComparisonPreviewRenderer &renderer);
+    void notifyComparisonPreviewFinished();
+    void notifyLiveComparisonOverlayChanged(const ComparisonPreviewRenderer &renderer);
+    void updateRowDifferences();
+    RowDifferenceMap getReadyRowDifferences() const;
+    QFuture<DifferencePlane> buildDifferencePlane();
+    void resetIntegralImages();
+    DisplayedIntegralImages getReadyIntegralImages() const;
     void clearLastComparisonImage();
-    void setLastComparisonImage(const QPixmap &pixmap, const QString &description);
+    void setLastComparisonImage(const QImage &image, const QString &description);
     void notifyShowImageInExternalViewer(const QPixmap &image, const QString &description);
 };
 
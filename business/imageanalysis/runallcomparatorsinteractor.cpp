@@ -51,8 +51,10 @@ QList<AutocomparisonReportEntry> RunAllComparatorsInteractor::executeAllComparat
             return {};
         }
         try {
-            comparator->reset();
-            auto result = comparator->compare(mFirstImage, mSecondImage);
+            // The comparators of the manager are shared by all windows, so a copy is run
+            auto comparatorCopy = std::dynamic_pointer_cast<IComparator>(comparator->clone());
+            comparatorCopy->reset();
+            auto result = comparatorCopy->compare(mFirstImage, mSecondImage);
             if (result != nullptr) {
                 auto proicessorInfo = manager->getProcessorInfoByProcessorShortName(comparator->getShortName());
                 entries.append({ result, proicessorInfo });
@@ -2,8 +2,11 @@
 
 #include "business/getimagesfromvideosinteractor.h"
 #include "recentfilesinteractor.h"
+#include <QtCore/qdir.h>
 #include <QtCore/qmimedata.h>
 #include <QtGui/qclipboard.h>
+#include <business/utils/imagesinfo.h>
+#include <business/validation/imagevalidationrulesfactory.h>
 #include <data/storage/imagefileshandler.h>
 
 ImageFilesInteractor::ImageFilesInteractor() {
@@ -176,6 +179,58 @@ void ImageFilesInteractor::openImageFromClipboard() {
     }
 }
 
+// Opens images that were created by the application itself, e.g. frames
+// extracted from videos; the files are removed when the images are closed.
+void ImageFilesInteractor::openTemporaryImages(const QString &firstImagePath,
+                                               const QString &secondImagePath
+                                               )
+{
+    try {
+        mImages = mImageFileHandler->openImages(firstImagePath, secondImagePath);
+        mImages->markTemporary();
+        notifyImagesOpened(mImages);
+    } catch(std::runtime_error &e) {
+        cleanup();
+        notifyImagesOpenFailed(e.what());
+        notifyImagesClosed();
+    }
+}
+
+void ImageFilesInteractor::openTemporaryImage(const QString &imagePath) {
+    try {
+        mImages = mImageFileHandler->openImage(imagePath);
+        mImages->markTemporary();
+        notifyImagesOpened(mImages);
+    } catch(std::runtime_error &e) {
+        cleanup();
+        notifyImagesOpenFailed(e.what());
+        notifyImagesClosed();
+    }
+}
+
+// A cropped area is opened in a new window of the same process, so nothing is
+// written to disk. The cropped images are named after the original ones and are
+// placed in the Temp folder, so they are saved there by default.
+void ImageFilesInteractor::openCroppedImages(const ImageHolderPtr croppedImages) {
+    ImagesInfo info { croppedImages };
+    QDir tempDir { QDir::tempPath() };
+    auto extensionsInfoProvider = ImageValidationRulesFactory::createImageExtensionsInfoProvider();
+    QString ext = extensionsInfoProvider->getDeafaultSaveExtension(true);
+    QString firstImagePath = tempDir.filePath(info.getFirstImageBaseName() + ext);
+    if (croppedImages->isSingleImage()) {
+        mImages = std::make_shared<ImageHolder>(croppedImages->getFirstImage(), firstImagePath);
+    } else {
+        QString secondImagePath = tempDir.filePath(info.getSecondImageBaseName() + ext);
+        mImages = std::make_shared<ImageHolder>(croppedImages->getFirstImage(),
+                                                firstImagePath,
+                                                croppedImages->getSecondImage(),
+                                                secondImagePath
+                                                );
+    }
+    mImages->markInMemory();
+    notifyImagesOpened(mImages);
+}
+
 void ImageFilesInteractor::saveImageAs(const SaveImageInfo &info) {
     std::optional<QString> path;
     try {
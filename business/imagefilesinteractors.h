@@ -25,6 +25,9 @@ public:
     void openImageViaOpenFilesDialog();
     void openImagesFromVideos();
     void openImageFromClipboard();
+    void openTemporaryImages(const QString &firstImagePath, const QString &secondImagePath);
+    void openTemporaryImage(const QString &imagePath);
+    void openCroppedImages(const ImageHolderPtr croppedImages);
     void saveImageAs(const SaveImageInfo &info);
     
     bool subscribe(IImageFilesInteractorListener *listener);
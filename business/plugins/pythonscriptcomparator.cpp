@@ -145,3 +145,7 @@ shared_ptr<ComparisonResultVariant> PythonScriptComparator::compare(const Compar
     throw runtime_error("Error! The script returned '" +
                         process.readAllStandardError() + "'");
 }
+
+std::shared_ptr<IImageProcessor> PythonScriptComparator::clone() const {
+    return std::make_shared<PythonScriptComparator>(*this);
+}
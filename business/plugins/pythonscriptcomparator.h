@@ -25,6 +25,7 @@ public:
     bool isPartOfAutoReportingToolbox() override;
     ComparisonResultVariantPtr compare(const ComparableImage &first,
                                        const ComparableImage &second) override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     const int mCharsInReportMax = 10000;
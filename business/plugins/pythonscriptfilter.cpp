@@ -123,3 +123,7 @@ const QImage& PythonScripFilter::prepareResult(const QImage &resultImage, const
         return resultImage;
     }
 }
+
+std::shared_ptr<IImageProcessor> PythonScripFilter::clone() const {
+    return std::make_shared<PythonScripFilter>(*this);
+}
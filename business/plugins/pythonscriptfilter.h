@@ -22,6 +22,7 @@ public:
     QList<Property> getDefaultProperties() const override;
     void setProperties(QList<Property> properties) override;
     QImage filter(const QImage &image) override;
+    std::shared_ptr<IImageProcessor> clone() const override;
 
 private:
     QString mShortName;
@@ -5,6 +5,7 @@
 ImageExtensionsInfoProvider::ImageExtensionsInfoProvider() {
     mExtensionsForOpen = { "png", "tga", "jpg", "jpeg", "bmp", "gif" };
     mExtensionForSave = "png";
+    mExtensionForTemporaryImages = "twpx"; // see InternalImageFile
 }
 
 QString ImageExtensionsInfoProvider::getDeafaultSaveExtension(bool includeDot) {
@@ -15,6 +16,15 @@ QString ImageExtensionsInfoProvider::getDeafaultSaveExtension(bool includeDot) {
     }
 }
 
+// The temporary images are only read by the application itself
+QString ImageExtensionsInfoProvider::getTemporaryImageExtension(bool includeDot) {
+    if (includeDot) {
+        return "." + mExtensionForTemporaryImages;
+    } else {
+        return mExtensionForTemporaryImages;
+    }
+}
+
 QString ImageExtensionsInfoProvider::createOpenFilter() {
     QStringList formattedExtensions;
     foreach (const QString &ext, mExtensionsForOpen) {
@@ -12,12 +12,14 @@ public:
     virtual ~ImageExtensionsInfoProvider() = default;
 
     QString getDeafaultSaveExtension(bool includeDot = false) override;
+    QString getTemporaryImageExtension(bool includeDot = false) override;
     QString createOpenFilter() override;
     QString createSaveFilter() override;
 
 private:
     QList<QString> mExtensionsForOpen;
     QString mExtensionForSave;
+    QString mExtensionForTemporaryImages;
 };
 
 #endif // IMAGEEXTENSIONSINFOPROVIDER_H
@@ -8,6 +8,7 @@ class IImageExtensionsInfoProvider
 {
 public:
     virtual QString getDeafaultSaveExtension(bool includeDot) = 0;
+    virtual QString getTemporaryImageExtension(bool includeDot) = 0;
     virtual QString createOpenFilter() = 0;
     virtual QString createSaveFilter() = 0;
 };
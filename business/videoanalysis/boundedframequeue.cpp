@@ -0,0 +1,51 @@
+#include "boundedframequeue.h"
+
+#include <QMutexLocker>
+
+
+BoundedFrameQueue::BoundedFrameQueue(int capacity)
+    : mCapacity(qMax(1, capacity)),
+    mIsClosed(false)
+{
+}
+
+bool BoundedFrameQueue::push(DecodedVideoFrame frame) {
+    QMutexLocker locker(&mMutex);
+    while (mFrames.size() >= mCapacity && !mIsClosed) {
+        mNotFull.wait(&mMutex);
+    }
+    if (mIsClosed) {
+        return false;
+    }
+    mFrames.enqueue(std::move(frame));
+    mNotEmpty.wakeOne();
+    return true;
+}
+
+std::optional<DecodedVideoFrame> BoundedFrameQueue::pop() {
+    QMutexLocker locker(&mMutex);
+    while (mFrames.isEmpty() && !mIsClosed) {
+        mNotEmpty.wait(&mMutex);
+    }
+    if (mFrames.isEmpty()) {
+        return std::nullopt;
+    }
+    DecodedVideoFrame frame = mFrames.dequeue();
+    mNotFull.wakeOne();
+    return frame;
+}
+
+void BoundedFrameQueue::close() {
+    QMutexLocker locker(&mMutex);
+    mIsClosed = true;
+    mNotEmpty.wakeAll();
+    mNotFull.wakeAll();
+}
+
+void BoundedFrameQueue::abort() {
+    QMutexLocker locker(&mMutex);
+    mIsClosed = true;
+    mFrames.clear();
+    mNotEmpty.wakeAll();
+    mNotFull.wakeAll();
+}
@@ -0,0 +1,53 @@
+#ifndef BOUNDEDFRAMEQUEUE_H
+#define BOUNDEDFRAMEQUEUE_H
+
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+#include <optional>
+#include <vector>
+
+
+struct DecodedVideoFrame {
+    int frameIndex = 0;
+    qint64 positionMs = 0;
+    QImage image;
+    std::vector<quint64> rowHashes; // Filled only by the decoders that hash the frames (see FrameHasher)
+    quint64 frameHash = 0;
+    qint64 startTime = -1; // Presentation timestamp in microseconds, -1 if unknown
+};
+
+// A blocking queue with a fixed capacity. It is safe to use from several
+// producers and consumers, although usually there is one of each.
+// The decoder thread blocks in push() while the queue is full, so the amount
+// of memory occupied by decoded frames does not depend on the clip length.
+
+class BoundedFrameQueue
+{
+public:
+    explicit BoundedFrameQueue(int capacity);
+    ~BoundedFrameQueue() = default;
+
+    // Returns false if the queue has been closed and the frame was dropped.
+    bool push(DecodedVideoFrame frame);
+
+    // Returns std::nullopt once the queue is closed and drained.
+    std::optional<DecodedVideoFrame> pop();
+
+    // Wakes up all waiting threads; no more frames will be accepted.
+    void close();
+
+    // Like close(), but also drops the frames that are still in the queue.
+    void abort();
+
+private:
+    const int mCapacity;
+    bool mIsClosed;
+    QQueue<DecodedVideoFrame> mFrames;
+    QMutex mMutex;
+    QWaitCondition mNotEmpty;
+    QWaitCondition mNotFull;
+};
+
+#endif // BOUNDEDFRAMEQUEUE_H
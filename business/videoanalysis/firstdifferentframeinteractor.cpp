@@ -0,0 +1,182 @@
+#include "firstdifferentframeinteractor.h"
+
+#include <QThread>
+#include <business/videoanalysis/boundedframequeue.h>
+#include <business/videoanalysis/framehasher.h>
+#include <business/videoanalysis/videoframereader.h>
+#include <data/storage/imagefileshandler.h>
+
+
+FirstDifferentFrameInteractor::FirstDifferentFrameInteractor(const QString &firstVideoPath,
+                                                             const QString &secondVideoPath,
+                                                             bool useCoarseSearch,
+                                                             QObject *parent
+                                                             )
+    : QObject(parent),
+    mFirstVideoPath(firstVideoPath),
+    mSecondVideoPath(secondVideoPath),
+    mUseCoarseSearch(useCoarseSearch),
+    mTotalFrames(0),
+    mFrameRate(0.0),
+    mProgress(0),
+    mFirstDifferentRow(-1)
+{
+}
+
+FirstDifferentFrameInteractor::~FirstDifferentFrameInteractor() {
+    mWorkers.cancel();
+    mWorkers.stopThreads();
+}
+
+void FirstDifferentFrameInteractor::start() {
+    VideoFrameReader firstReader { mFirstVideoPath };
+    VideoFrameReader secondReader { mSecondVideoPath };
+    firstReader.open();
+    secondReader.open();
+
+    // Both videos are sampled on the timeline of the first one
+    mFrameRate = firstReader.getFrameRate();
+    qint64 duration = qMin(firstReader.getDuration(), secondReader.getDuration());
+    mTotalFrames = static_cast<int>(duration * mFrameRate / 1000.0);
+    if (mTotalFrames <= 0) {
+        throw std::runtime_error("Error: the videos do not contain any frames to compare.");
+    }
+
+    mWorkers.reset();
+    mProgress = 0;
+    mFirstDifferentFrame = std::nullopt;
+    mFirstDifferentRow = -1;
+
+    QThread *searchThread = mWorkers.createThread([this]() {
+        search();
+    });
+    connect(searchThread,
+            &QThread::finished,
+            this,
+            &FirstDifferentFrameInteractor::onSearchThreadFinished
+            );
+    mWorkers.startThreads();
+}
+
+void FirstDifferentFrameInteractor::cancel() {
+    mWorkers.cancel();
+}
+
+int FirstDifferentFrameInteractor::getTotalFrames() const {
+    return mTotalFrames;
+}
+
+qint64 FirstDifferentFrameInteractor::getFramePosition(int frameIndex) const {
+    return VideoFrameReader::getFramePosition(frameIndex, mFrameRate);
+}
+
+std::optional<int> FirstDifferentFrameInteractor::getFirstDifferentFrame() const {
+    return mFirstDifferentFrame;
+}
+
+int FirstDifferentFrameInteractor::getFirstDifferentRow() const {
+    return mFirstDifferentRow;
+}
+
+QPair<QString, QString> FirstDifferentFrameInteractor::saveFramePairAsTemporary() {
+    if (!mFirstDifferentFrame) {
+        throw std::runtime_error("Error: the videos do not have different frames.");
+    }
+    ImageFilesHandler imageFilesHandler;
+    QString firstPath = imageFilesHandler.saveImageAsTemporary(mFirstImage);
+    QString secondPath = imageFilesHandler.saveImageAsTemporary(mSecondImage);
+    return { firstPath, secondPath };
+}
+
+/* Worker threads { */
+
+void FirstDifferentFrameInteractor::search() {
+    int lastFrame = mTotalFrames - 1;
+    if (!mUseCoarseSearch) {
+        mFirstDifferentFrame = scanFrames(0, lastFrame, 1);
+        return;
+    }
+
+    // The last frame is not always a multiple of the step, so it is checked separately
+    std::optional<int> sample = scanFrames(0, lastFrame, mCoarseStep);
+    if (!sample && lastFrame % mCoarseStep != 0 && !mWorkers.isCanceled()) {
+        sample = scanFrames(lastFrame, lastFrame, 1);
+    }
+    if (!sample || *sample == 0 || mWorkers.isCanceled()) {
+        mFirstDifferentFrame = sample;
+        return;
+    }
+
+    // The previous sample was identical, so only the frames after it are scanned
+    int fromFrame = ((*sample - 1) / mCoarseStep) * mCoarseStep + 1;
+    QImage firstImage = mFirstImage;
+    QImage secondImage = mSecondImage;
+    int differentRow = mFirstDifferentRow;
+    std::optional<int> frame = fromFrame < *sample ? scanFrames(fromFrame, *sample - 1, 1) : std::nullopt;
+    if (frame) {
+        mFirstDifferentFrame = frame;
+    } else {
+        mFirstDifferentFrame = sample;
+        mFirstImage = firstImage;
+        mSecondImage = secondImage;
+        mFirstDifferentRow = differentRow;
+    }
+}
+
+std::optional<int> FirstDifferentFrameInteractor::scanFrames(int fromFrame, int toFrame, int step) {
+    if (mWorkers.isCanceled()) {
+        return std::nullopt;
+    }
+    auto firstQueue = mWorkers.createQueue(mFrameQueueCapacity);
+    auto secondQueue = mWorkers.createQueue(mFrameQueueCapacity);
+    auto hashFrame = [](DecodedVideoFrame &frame) {
+        FrameHasher::hash(frame);
+    };
+
+    QThread *firstDecoderThread = mWorkers.createThread([this, fromFrame, toFrame, step, firstQueue, hashFrame]() {
+        mWorkers.decodeVideo(mFirstVideoPath, mFrameRate, fromFrame, toFrame, step, firstQueue, hashFrame);
+    });
+    QThread *secondDecoderThread = mWorkers.createThread([this, fromFrame, toFrame, step, secondQueue, hashFrame]() {
+        mWorkers.decodeVideo(mSecondVideoPath, mFrameRate, fromFrame, toFrame, step, secondQueue, hashFrame);
+    });
+    mWorkers.startThreads();
+
+    std::optional<int> result;
+    while (!mWorkers.isCanceled()) {
+        auto firstFrame = firstQueue->pop();
+        auto secondFrame = secondQueue->pop();
+        if (!firstFrame || !secondFrame) {
+            break;
+        }
+        int row = FrameHasher::findFirstDifferentRow(*firstFrame, *secondFrame);
+        if (row >= 0) {
+            result = firstFrame->frameIndex;
+            mFirstDifferentRow = row;
+            mFirstImage = firstFrame->image;
+            mSecondImage = secondFrame->image;
+            break;
+        }
+        if (firstFrame->frameIndex > mProgress) {
+            mProgress = firstFrame->frameIndex;
+            emit progressChanged(mProgress);
+        }
+    }
+
+    // The decoders may still be reading frames that are not needed anymore
+    firstQueue->abort();
+    secondQueue->abort();
+    firstDecoderThread->wait();
+    secondDecoderThread->wait();
+    return result;
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+void FirstDifferentFrameInteractor::onSearchThreadFinished() {
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit searchFailed(error);
+    } else if (!mWorkers.isCanceled()) {
+        emit searchFinished();
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef FIRSTDIFFERENTFRAMEINTERACTOR_H
+#define FIRSTDIFFERENTFRAMEINTERACTOR_H
+
+#include <QImage>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <optional>
+#include <business/videoanalysis/videoanalysisworkers.h>
+
+// Finds the first frame where two captures that should be pixel-identical diverge.
+// Both videos are decoded and hashed in their own worker threads (see FrameHasher),
+// and a search thread compares the hashes, confirms the equal ones with the pixels
+// and stops at the first mismatch.
+//
+// The coarse search first checks only every mCoarseStep-th frame and then scans
+// the frames between the last identical sample and the first different one. It
+// skips long identical spans, but assumes that the videos stay different once they
+// have diverged. QMediaPlayer does not expose the keyframes of a stream, so fixed
+// steps are used instead of keyframe positions.
+
+class FirstDifferentFrameInteractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    FirstDifferentFrameInteractor(const QString &firstVideoPath,
+                                  const QString &secondVideoPath,
+                                  bool useCoarseSearch,
+                                  QObject *parent = nullptr
+                                  );
+    ~FirstDifferentFrameInteractor();
+
+    // Reads the metadata of both videos and starts the search.
+    // Throws std::runtime_error if the videos cannot be opened.
+    void start();
+    void cancel();
+
+    int getTotalFrames() const;
+    qint64 getFramePosition(int frameIndex) const;
+
+    // Available after searchFinished() was emitted; std::nullopt if no difference was found.
+    std::optional<int> getFirstDifferentFrame() const;
+    int getFirstDifferentRow() const;
+
+    // Saves the first different frame pair in the Temp directory,
+    // so it can be opened in the main window. Throws std::runtime_error.
+    QPair<QString, QString> saveFramePairAsTemporary();
+
+signals:
+    void progressChanged(int checkedFrames);
+    void searchFinished();
+    void searchFailed(const QString &error);
+
+private slots:
+    void onSearchThreadFinished();
+
+private:
+    const int mCoarseStep = 64;
+    const int mFrameQueueCapacity = 3;
+
+    QString mFirstVideoPath;
+    QString mSecondVideoPath;
+    bool mUseCoarseSearch;
+    int mTotalFrames;
+    double mFrameRate;
+    int mProgress;
+    std::optional<int> mFirstDifferentFrame;
+    int mFirstDifferentRow;
+    QImage mFirstImage;
+    QImage mSecondImage;
+    VideoAnalysisWorkers mWorkers;
+
+    void search();
+    std::optional<int> scanFrames(int fromFrame, int toFrame, int step);
+};
+
+#endif // FIRSTDIFFERENTFRAMEINTERACTOR_H
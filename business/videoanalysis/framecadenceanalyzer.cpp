@@ -0,0 +1,92 @@
+#include "framecadenceanalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <business/videoanalysis/videosignature.h>
+
+
+QList<FrameCadenceEvent> FrameCadenceAnalyzer::analyze(const std::vector<FrameFingerprint> &frames,
+                                                       double frameRate
+                                                       )
+{
+    QList<FrameCadenceEvent> events;
+    if (frameRate <= 0.0) {
+        return events;
+    }
+    double expectedIntervalUs = 1000000.0 / frameRate;
+    std::deque<float> recentMotion;
+
+    for (size_t i = 1; i < frames.size(); ++i) {
+        const FrameFingerprint &previous = frames[i - 1];
+        const FrameFingerprint &current = frames[i];
+        int frameIndex = static_cast<int>(i);
+
+        // A repeated timestamp means that the stream has no frame for this moment
+        // and the decoder returned the previous one, so it is not a duplicate.
+        bool hasTimestamps = previous.startTime >= 0 && current.startTime >= 0;
+        if (hasTimestamps) {
+            qint64 intervalUs = current.startTime - previous.startTime;
+            if (std::abs(intervalUs - expectedIntervalUs) > expectedIntervalUs * mIntervalTolerance) {
+                QString description = intervalUs == 0
+                    ? QString("No frame in the stream, the previous frame is repeated")
+                    : QString("Frame interval is %1 ms instead of %2 ms")
+                          .arg(intervalUs / 1000.0, 0, 'f', 2)
+                          .arg(expectedIntervalUs / 1000.0, 0, 'f', 2);
+                events.append({ FrameCadenceEventType::TimestampIrregularity,
+                                frameIndex,
+                                current.positionMs,
+                                description
+                              });
+            }
+            if (intervalUs == 0) {
+                continue;
+            }
+        }
+
+        if (current.hash == previous.hash) {
+            events.append({ FrameCadenceEventType::DuplicatedFrame,
+                            frameIndex,
+                            current.positionMs,
+                            "The frame is identical to the previous one"
+                          });
+            continue;
+        }
+
+        float motion = VideoSignature::calculateMotion(previous.thumbnail, current.thumbnail);
+        if (static_cast<int>(recentMotion.size()) >= mMotionWindow / 2) {
+            std::vector<float> sorted(recentMotion.begin(), recentMotion.end());
+            std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+            float typicalMotion = sorted[sorted.size() / 2];
+            if (typicalMotion >= mMinTypicalMotion && motion > typicalMotion * mDroppedFrameFactor) {
+                int droppedFrames = std::max(1, static_cast<int>(std::lround(motion / typicalMotion)) - 1);
+                events.append({ FrameCadenceEventType::DroppedFrames,
+                                frameIndex,
+                                current.positionMs,
+                                QString("The content jumps %1x more than usual, about %2 frame(s) "
+                                        "may be missing (or it is a scene cut)")
+                                    .arg(motion / typicalMotion, 0, 'f', 1)
+                                    .arg(droppedFrames)
+                              });
+            }
+        }
+
+        recentMotion.push_back(motion);
+        if (static_cast<int>(recentMotion.size()) > mMotionWindow) {
+            recentMotion.pop_front();
+        }
+    }
+    return events;
+}
+
+QString FrameCadenceAnalyzer::getEventTypeName(FrameCadenceEventType type) {
+    switch (type) {
+    case FrameCadenceEventType::DuplicatedFrame:
+        return "Duplicated frame";
+    case FrameCadenceEventType::DroppedFrames:
+        return "Dropped frames";
+    case FrameCadenceEventType::TimestampIrregularity:
+        return "Timestamp irregularity";
+    }
+    return "";
+}
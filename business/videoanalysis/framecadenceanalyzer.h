@@ -0,0 +1,64 @@
+#ifndef FRAMECADENCEANALYZER_H
+#define FRAMECADENCEANALYZER_H
+
+#include <QList>
+#include <QString>
+#include <vector>
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct FrameFingerprint {
+    qint64 positionMs = 0;
+    qint64 startTime = -1;          // Presentation timestamp in microseconds, -1 if unknown
+    quint64 hash = 0;               // See FrameHasher
+    std::vector<quint8> thumbnail;  // A tiny luminance signature, see VideoSignature
+};
+
+enum class FrameCadenceEventType {
+    DuplicatedFrame,
+    DroppedFrames,
+    TimestampIrregularity
+};
+
+struct FrameCadenceEvent {
+    FrameCadenceEventType type;
+    int frameIndex = 0;
+    qint64 positionMs = 0;
+    QString description;
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// Looks for cadence problems of a captured video in the fingerprints of its frames:
+//  - a duplicated frame has the same content hash as the previous frame;
+//  - dropped frames show up as a jump of the signature: the difference from the
+//    previous frame is several times larger than the recent typical motion;
+//  - a timestamp irregularity is an interval between the presentation timestamps
+//    of two consecutive frames that does not match the frame rate.
+// A scene cut looks like a dropped frame too, so those events are only hints.
+
+class FrameCadenceAnalyzer
+{
+public:
+    FrameCadenceAnalyzer() = delete;
+    ~FrameCadenceAnalyzer() = delete;
+
+    static QList<FrameCadenceEvent> analyze(const std::vector<FrameFingerprint> &frames, double frameRate);
+
+    static QString getEventTypeName(FrameCadenceEventType type);
+
+private:
+    // The number of preceding moving frames used to estimate the typical motion
+    static constexpr int mMotionWindow = 15;
+
+    // A jump is reported when the motion exceeds the typical one this many times
+    static constexpr float mDroppedFrameFactor = 2.0f;
+
+    // Below this typical motion the content is considered static, so jumps are not reported
+    static constexpr float mMinTypicalMotion = 0.5f;
+
+    // The allowed deviation of a frame interval from 1 / frameRate
+    static constexpr double mIntervalTolerance = 0.25;
+};
+
+#endif // FRAMECADENCEANALYZER_H
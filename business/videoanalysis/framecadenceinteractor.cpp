@@ -0,0 +1,131 @@
+#include "framecadenceinteractor.h"
+
+#include <QThread>
+#include <business/videoanalysis/boundedframequeue.h>
+#include <business/videoanalysis/framehasher.h>
+#include <business/videoanalysis/videoframereader.h>
+#include <business/videoanalysis/videosignature.h>
+#include <data/storage/imagefileshandler.h>
+
+
+FrameCadenceInteractor::FrameCadenceInteractor(const QString &videoPath, QObject *parent)
+    : QObject(parent),
+    mVideoPath(videoPath),
+    mTotalFrames(0),
+    mFrameRate(0.0),
+    mWorkersCount(0),
+    mFinishedWorkers(0),
+    mProcessedFrames(0)
+{
+}
+
+FrameCadenceInteractor::~FrameCadenceInteractor() {
+    mWorkers.cancel();
+    mWorkers.stopThreads();
+}
+
+void FrameCadenceInteractor::start() {
+    VideoFrameReader reader { mVideoPath };
+    reader.open();
+    mFrameRate = reader.getFrameRate();
+    mTotalFrames = reader.getFrameCount();
+    if (mTotalFrames <= 1) {
+        throw std::runtime_error("Error: the video is too short to be analyzed.");
+    }
+
+    // Only the decoder thread reads the video, the rest of the cores hash the frames
+    mWorkersCount = qMax(1, QThread::idealThreadCount() - 1);
+
+    mWorkers.reset();
+    mFinishedWorkers = 0;
+    mProcessedFrames = 0;
+    mFingerprints.assign(mTotalFrames, FrameFingerprint());
+    mEvents.clear();
+    mQueue = mWorkers.createQueue(mWorkersCount * mFramesPerWorker);
+
+    mWorkers.createThread([this]() {
+        mWorkers.decodeVideo(mVideoPath, mFrameRate, 0, mTotalFrames - 1, 1, mQueue);
+    });
+    for (int i = 0; i < mWorkersCount; ++i) {
+        QThread *thread = mWorkers.createThread([this]() {
+            fingerprintFrames();
+        });
+        connect(thread, &QThread::finished, this, &FrameCadenceInteractor::onWorkerThreadFinished);
+    }
+
+    mWorkers.startThreads();
+}
+
+void FrameCadenceInteractor::cancel() {
+    mWorkers.cancel();
+}
+
+int FrameCadenceInteractor::getTotalFrames() const {
+    return mTotalFrames;
+}
+
+double FrameCadenceInteractor::getFrameRate() const {
+    return mFrameRate;
+}
+
+QString FrameCadenceInteractor::getVideoPath() const {
+    return mVideoPath;
+}
+
+QList<FrameCadenceEvent> FrameCadenceInteractor::getEvents() const {
+    return mEvents;
+}
+
+QPair<QString, QString> FrameCadenceInteractor::saveFramePairAsTemporary(int frameIndex) {
+    if (frameIndex <= 0 || frameIndex >= mTotalFrames) {
+        throw std::runtime_error("Error: incorrect frame number.");
+    }
+    VideoFrameReader reader { mVideoPath };
+    reader.open();
+    QImage previousFrame = reader.readFrameAt(VideoFrameReader::getFramePosition(frameIndex - 1, mFrameRate));
+    QImage currentFrame = reader.readFrameAt(VideoFrameReader::getFramePosition(frameIndex, mFrameRate));
+
+    ImageFilesHandler imageFilesHandler;
+    QString previousPath = imageFilesHandler.saveImageAsTemporary(previousFrame);
+    QString currentPath = imageFilesHandler.saveImageAsTemporary(currentFrame);
+    return { previousPath, currentPath };
+}
+
+/* Worker threads { */
+
+void FrameCadenceInteractor::fingerprintFrames() {
+    while (!mWorkers.isCanceled()) {
+        auto frame = mQueue->pop();
+        if (!frame) {
+            break;
+        }
+        // Every worker writes only the fingerprints of its own frames, so no locking is needed
+        FrameFingerprint &fingerprint = mFingerprints[frame->frameIndex];
+        fingerprint.positionMs = frame->positionMs;
+        fingerprint.startTime = frame->startTime;
+        fingerprint.hash = FrameHasher::hashFrame(FrameHasher::hashRows(frame->image));
+        fingerprint.thumbnail = VideoSignature::createThumbnail(frame->image, mThumbnailSize);
+        emit progressChanged(++mProcessedFrames);
+    }
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+void FrameCadenceInteractor::onWorkerThreadFinished() {
+    if (++mFinishedWorkers < mWorkersCount) {
+        return;
+    }
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit analysisFailed(error);
+        return;
+    }
+    if (mWorkers.isCanceled()) {
+        return;
+    }
+    // All the fingerprints are ready; the analysis itself is a quick linear pass
+    mEvents = FrameCadenceAnalyzer::analyze(mFingerprints, mFrameRate);
+    mFingerprints.clear();
+    mFingerprints.shrink_to_fit();
+    emit analysisFinished();
+}
@@ -0,0 +1,74 @@
+#ifndef FRAMECADENCEINTERACTOR_H
+#define FRAMECADENCEINTERACTOR_H
+
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <business/videoanalysis/framecadenceanalyzer.h>
+#include <business/videoanalysis/videoanalysisworkers.h>
+
+class BoundedFrameQueue;
+
+// Detects dropped and duplicated frames and timestamp irregularities of a captured
+// video. A decoder thread reads the frames and a pool of worker threads hashes them
+// and creates their luminance signatures; the decoder is the only sequential part
+// and it limits the speed, because it seeks to every frame (see VideoFrameReader).
+// Only the fingerprints of the frames are kept, and once all of them are ready,
+// they are analyzed by FrameCadenceAnalyzer.
+
+class FrameCadenceInteractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameCadenceInteractor(const QString &videoPath, QObject *parent = nullptr);
+    ~FrameCadenceInteractor();
+
+    // Reads the metadata of the video and starts the worker threads.
+    // Throws std::runtime_error if the video cannot be opened.
+    void start();
+    void cancel();
+
+    int getTotalFrames() const;
+    double getFrameRate() const;
+    QString getVideoPath() const;
+
+    // Available after analysisFinished() was emitted.
+    QList<FrameCadenceEvent> getEvents() const;
+
+    // Decodes the frame and the previous one and saves them in the Temp directory,
+    // so they can be opened in the main window. Throws std::runtime_error.
+    QPair<QString, QString> saveFramePairAsTemporary(int frameIndex);
+
+signals:
+    void progressChanged(int processedFrames);
+    void analysisFinished();
+    void analysisFailed(const QString &error);
+
+private slots:
+    void onWorkerThreadFinished();
+
+private:
+    // Frames waiting for a free worker; a few per worker are enough.
+    const int mFramesPerWorker = 2;
+    const int mThumbnailSize = 8;
+
+    QString mVideoPath;
+    int mTotalFrames;
+    double mFrameRate;
+    std::vector<FrameFingerprint> mFingerprints;
+    QList<FrameCadenceEvent> mEvents;
+    std::shared_ptr<BoundedFrameQueue> mQueue;
+    int mWorkersCount;
+    int mFinishedWorkers;
+    std::atomic<int> mProcessedFrames;
+    VideoAnalysisWorkers mWorkers;
+
+    void fingerprintFrames();
+};
+
+#endif // FRAMECADENCEINTERACTOR_H
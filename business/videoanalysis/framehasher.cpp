@@ -0,0 +1,52 @@
+#include "framehasher.h"
+
+#include <QHash>
+#include <cstring>
+#include <domain/valueobjects/rowindex.h>
+
+
+std::vector<quint64> FrameHasher::hashRows(const QImage &image) {
+    return RowIndex::hashRows(image);
+}
+
+quint64 FrameHasher::hashFrame(const std::vector<quint64> &rowHashes) {
+    return qHashBits(rowHashes.data(), rowHashes.size() * sizeof(quint64));
+}
+
+void FrameHasher::hash(DecodedVideoFrame &frame) {
+    frame.rowHashes = hashRows(frame.image);
+    frame.frameHash = hashFrame(frame.rowHashes);
+}
+
+int FrameHasher::findFirstDifferentRow(const DecodedVideoFrame &first, const DecodedVideoFrame &second) {
+    if (first.image.size() != second.image.size()) {
+        return 0;
+    }
+    if (first.image.format() != second.image.format()) {
+        // The hashes of different formats never match, the pixels are compared in a common one
+        return findFirstDifferentRow(first.image.convertToFormat(QImage::Format_ARGB32),
+                                     second.image.convertToFormat(QImage::Format_ARGB32)
+                                     );
+    }
+
+    // A different hash always means a different row; equal hashes are confirmed
+    // by the bytes of the row, so a hash collision can not hide a difference
+    size_t rowBytes = RowIndex::getRowBytes(first.image);
+    for (int y = 0; y < first.image.height(); ++y) {
+        if (first.rowHashes[y] != second.rowHashes[y] ||
+            memcmp(first.image.constScanLine(y), second.image.constScanLine(y), rowBytes) != 0) {
+            return y;
+        }
+    }
+    return -1;
+}
+
+int FrameHasher::findFirstDifferentRow(const QImage &first, const QImage &second) {
+    size_t rowBytes = RowIndex::getRowBytes(first);
+    for (int y = 0; y < first.height(); ++y) {
+        if (memcmp(first.constScanLine(y), second.constScanLine(y), rowBytes) != 0) {
+            return y;
+        }
+    }
+    return -1;
+}
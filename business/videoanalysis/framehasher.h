@@ -0,0 +1,36 @@
+#ifndef FRAMEHASHER_H
+#define FRAMEHASHER_H
+
+#include <QImage>
+#include <vector>
+#include <business/videoanalysis/boundedframequeue.h>
+
+// Fingerprints of decoded frames. Hashing is done by the decoder threads, so the
+// thread that looks for differences only compares a few numbers per frame pair.
+// The hash of every row is kept: it tells which row differs first, and rows with
+// equal hashes are compared byte by byte, so equal hashes never mean "identical"
+// on their own.
+
+class FrameHasher
+{
+public:
+    FrameHasher() = delete;
+    ~FrameHasher() = delete;
+
+    static std::vector<quint64> hashRows(const QImage &image);
+    static quint64 hashFrame(const std::vector<quint64> &rowHashes);
+
+    // Fills rowHashes and frameHash of the frame.
+    static void hash(DecodedVideoFrame &frame);
+
+    // Returns the number of the first row that differs, or -1 if the frames are
+    // identical. Rows with equal hashes are compared byte by byte before the frames
+    // are reported identical. Frames of different sizes differ in the row 0.
+    static int findFirstDifferentRow(const DecodedVideoFrame &first, const DecodedVideoFrame &second);
+
+private:
+    // Compares the rows of two images of the same size and format byte by byte.
+    static int findFirstDifferentRow(const QImage &first, const QImage &second);
+};
+
+#endif // FRAMEHASHER_H
@@ -0,0 +1,242 @@
+#include "framepairextractioninteractor.h"
+
+#include <QDir>
+#include <QImageWriter>
+#include <QRegularExpression>
+#include <QThread>
+#include <QTime>
+#include <algorithm>
+#include <business/videoanalysis/boundedframequeue.h>
+#include <business/videoanalysis/videoframereader.h>
+#include <business/videoanalysis/videosignature.h>
+
+
+FramePairExtractionInteractor::FramePairExtractionInteractor(const QString &firstVideoPath,
+                                                             const QString &secondVideoPath,
+                                                             const FramePairExtractionSettings &settings,
+                                                             QObject *parent
+                                                             )
+    : QObject(parent),
+    mFirstVideoPath(firstVideoPath),
+    mSecondVideoPath(secondVideoPath),
+    mSettings(settings),
+    mFrameRate(0.0),
+    mTotalFrames(0),
+    mFinishedReaders(0),
+    mExtractedPairs(0)
+{
+    int encoders = qMax(1, QThread::idealThreadCount() - 2);
+    mEncoderPool.setMaxThreadCount(encoders);
+    mEncoderSlots = std::make_unique<QSemaphore>(encoders * mPendingImagesPerEncoder);
+}
+
+FramePairExtractionInteractor::~FramePairExtractionInteractor() {
+    mWorkers.cancel();
+    mWorkers.stopThreads();
+    mEncoderPool.waitForDone();
+}
+
+void FramePairExtractionInteractor::start() {
+    VideoFrameReader firstReader { mFirstVideoPath };
+    VideoFrameReader secondReader { mSecondVideoPath };
+    firstReader.open();
+    secondReader.open();
+
+    // Both videos are sampled on the timeline of the first one
+    mFrameRate = firstReader.getFrameRate();
+    qint64 duration = qMin(firstReader.getDuration(), secondReader.getDuration());
+    mTotalFrames = static_cast<int>(duration * mFrameRate / 1000.0);
+    if (mTotalFrames <= 0) {
+        throw std::runtime_error("Error: the videos do not contain any frames to extract.");
+    }
+
+    mTargetFrames.clear();
+    if (mSettings.mode == FramePairExtractionMode::FixedInterval) {
+        if (mSettings.intervalMs <= 0) {
+            throw std::runtime_error("Error: the interval must be greater than zero.");
+        }
+        for (qint64 position = 0; position < duration; position += mSettings.intervalMs) {
+            mTargetFrames.append(static_cast<int>(position * mFrameRate / 1000.0));
+        }
+    } else if (mSettings.mode == FramePairExtractionMode::Timestamps) {
+        foreach (auto position, mSettings.timestampsMs) {
+            if (position >= 0 && position < duration) {
+                mTargetFrames.append(static_cast<int>(position * mFrameRate / 1000.0));
+            }
+        }
+        if (mTargetFrames.isEmpty()) {
+            throw std::runtime_error("Error: none of the timestamps is within the videos.");
+        }
+    }
+    // The videos are read in one forward pass, and an interval shorter than a frame
+    // or two timestamps within one frame would extract the same frame twice
+    std::sort(mTargetFrames.begin(), mTargetFrames.end());
+    mTargetFrames.erase(std::unique(mTargetFrames.begin(), mTargetFrames.end()), mTargetFrames.end());
+    if (mSettings.maxPairs > 0 && mTargetFrames.size() > mSettings.maxPairs) {
+        mTargetFrames = mTargetFrames.mid(0, mSettings.maxPairs);
+    }
+
+    QDir outputDirectory { mSettings.outputDirectory };
+    mFirstOutputDirectory = outputDirectory.filePath("first");
+    mSecondOutputDirectory = outputDirectory.filePath("second");
+    if (!QDir().mkpath(mFirstOutputDirectory) || !QDir().mkpath(mSecondOutputDirectory)) {
+        QString error = QString("Error: unable to create the directories in %1.").arg(mSettings.outputDirectory);
+        throw std::runtime_error(error.toStdString());
+    }
+
+    mWorkers.reset();
+    mFinishedReaders = 0;
+    mExtractedPairs = 0;
+    mTargetQueue = mWorkers.createQueue(mTargetQueueCapacity);
+
+    QThread *firstReaderThread = mWorkers.createThread([this]() {
+        readFirstVideo();
+    });
+    QThread *secondReaderThread = mWorkers.createThread([this]() {
+        readSecondVideo();
+    });
+    connect(firstReaderThread, &QThread::finished, this, &FramePairExtractionInteractor::onReaderThreadFinished);
+    connect(secondReaderThread, &QThread::finished, this, &FramePairExtractionInteractor::onReaderThreadFinished);
+
+    mWorkers.startThreads();
+}
+
+void FramePairExtractionInteractor::cancel() {
+    mWorkers.cancel();
+}
+
+int FramePairExtractionInteractor::getTotalSteps() const {
+    return mSettings.mode == FramePairExtractionMode::SceneChanges ? mTotalFrames : mTargetFrames.size();
+}
+
+int FramePairExtractionInteractor::getExtractedPairs() const {
+    return mExtractedPairs;
+}
+
+QString FramePairExtractionInteractor::getFirstOutputDirectory() const {
+    return mFirstOutputDirectory;
+}
+
+QString FramePairExtractionInteractor::getSecondOutputDirectory() const {
+    return mSecondOutputDirectory;
+}
+
+QList<qint64> FramePairExtractionInteractor::parseTimestamps(const QString &text) {
+    QList<qint64> timestamps;
+    auto tokens = text.split(QRegularExpression("[,;\\s]+"), Qt::SkipEmptyParts);
+    foreach (auto token, tokens) {
+        // "[hh:]mm:ss[.zzz]" is converted to seconds part by part
+        auto parts = token.split(':');
+        double seconds = 0.0;
+        bool isValid = parts.size() <= 3;
+        for (int i = 0; i < parts.size() && isValid; ++i) {
+            double value = parts[i].toDouble(&isValid);
+            isValid = isValid && value >= 0.0 && (i == 0 || value < 60.0);
+            seconds = seconds * 60.0 + value;
+        }
+        if (!isValid) {
+            QString error = QString("Error: incorrect timestamp \"%1\".").arg(token);
+            throw std::runtime_error(error.toStdString());
+        }
+        timestamps.append(static_cast<qint64>(seconds * 1000.0 + 0.5));
+    }
+    return timestamps;
+}
+
+/* Worker threads { */
+
+void FramePairExtractionInteractor::readFirstVideo() {
+    VideoFrameReader reader { mFirstVideoPath };
+    reader.open();
+    bool isSceneMode = mSettings.mode == FramePairExtractionMode::SceneChanges;
+    int steps = isSceneMode ? mTotalFrames : mTargetFrames.size();
+    std::vector<quint8> previousThumbnail;
+    int extractedFrames = 0;
+
+    for (int step = 0; step < steps && !mWorkers.isCanceled(); ++step) {
+        int frameIndex = isSceneMode ? step : mTargetFrames[step];
+        qint64 position = VideoFrameReader::getFramePosition(frameIndex, mFrameRate);
+        QImage image = reader.readFrameAt(position);
+
+        bool isSelected = true;
+        if (isSceneMode) {
+            // The first frame starts the first scene
+            auto thumbnail = VideoSignature::createThumbnail(image, 16);
+            isSelected = frameIndex == 0 ||
+                         VideoSignature::calculateMotion(previousThumbnail, thumbnail) >= mSettings.sceneChangeThreshold;
+            previousThumbnail = std::move(thumbnail);
+        }
+        if (isSelected) {
+            encodeImage(image, mFirstOutputDirectory, frameIndex);
+            if (!mTargetQueue->push({ frameIndex, position, QImage() })) {
+                break; // the extraction was canceled
+            }
+            if (mSettings.maxPairs > 0 && ++extractedFrames >= mSettings.maxPairs) {
+                break;
+            }
+        }
+        emit progressChanged(step + 1);
+    }
+    mTargetQueue->close();
+}
+
+void FramePairExtractionInteractor::readSecondVideo() {
+    VideoFrameReader reader { mSecondVideoPath };
+    reader.open();
+    while (!mWorkers.isCanceled()) {
+        auto target = mTargetQueue->pop();
+        if (!target) {
+            break;
+        }
+        encodeImage(reader.readFrameAt(target->positionMs), mSecondOutputDirectory, target->frameIndex);
+        ++mExtractedPairs;
+    }
+}
+
+void FramePairExtractionInteractor::encodeImage(const QImage &image, const QString &directory, int frameIndex) {
+    QString path = QDir(directory).filePath(getFileName(frameIndex));
+    QString format = mSettings.imageFormat;
+
+    // Waits while the encoders are busy, so decoded images do not pile up
+    mEncoderSlots->acquire();
+    mEncoderPool.start([this, image, path, format]() {
+        try {
+            QImageWriter writer { path, format.toLatin1() };
+            if (format == "png") {
+                writer.setQuality(mPngQuality);
+            }
+            if (!writer.write(image)) {
+                mWorkers.setError(QString("Error: unable to save %1: %2").arg(path, writer.errorString()));
+                mWorkers.cancel();
+            }
+        } catch (std::exception &e) {
+            mWorkers.setError(e.what());
+            mWorkers.cancel();
+        }
+        mEncoderSlots->release();
+    });
+}
+
+QString FramePairExtractionInteractor::getFileName(int frameIndex) const {
+    QTime time = QTime(0, 0).addMSecs(VideoFrameReader::getFramePosition(frameIndex, mFrameRate));
+    return QString("frame_%1_%2.%3")
+        .arg(frameIndex, 6, 10, QChar('0'))
+        .arg(time.toString("hh-mm-ss-zzz"), mSettings.imageFormat);
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+void FramePairExtractionInteractor::onReaderThreadFinished() {
+    if (++mFinishedReaders < 2) {
+        return;
+    }
+    // Only a few images can still be waiting for the encoders
+    mEncoderPool.waitForDone();
+
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit extractionFailed(error);
+    } else if (!mWorkers.isCanceled()) {
+        emit extractionFinished();
+    }
+}
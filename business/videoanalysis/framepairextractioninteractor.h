@@ -0,0 +1,93 @@
+#ifndef FRAMEPAIREXTRACTIONINTERACTOR_H
+#define FRAMEPAIREXTRACTIONINTERACTOR_H
+
+#include <QImage>
+#include <QObject>
+#include <QSemaphore>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <business/videoanalysis/videoanalysisworkers.h>
+#include <domain/valueobjects/framepairextractionsettings.h>
+
+class BoundedFrameQueue;
+
+// Extracts frame pairs from two videos into a directory pair (see
+// FramePairExtractionSettings). Each video is read by its own thread in one forward
+// pass: the reader of the first video selects the frames (at a fixed interval, at
+// scene changes or at the given timestamps) and passes their positions to the reader
+// of the second video. Only the selected frames are decoded, except in the scene
+// change mode, which has to look at every frame of the first video. Every decoded
+// frame costs a seek (see VideoFrameReader), so the scene change mode is slow.
+// The images are encoded on a thread pool; the number of images waiting for
+// encoding is limited, so memory usage does not grow with the number of pairs.
+
+class FramePairExtractionInteractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    FramePairExtractionInteractor(const QString &firstVideoPath,
+                                  const QString &secondVideoPath,
+                                  const FramePairExtractionSettings &settings,
+                                  QObject *parent = nullptr
+                                  );
+    ~FramePairExtractionInteractor();
+
+    // Reads the metadata of both videos, creates the output directories and starts
+    // the worker threads. Throws std::runtime_error on failure.
+    void start();
+    void cancel();
+
+    // The progress is measured in selected frames or, in the scene change mode,
+    // in frames of the first video.
+    int getTotalSteps() const;
+    int getExtractedPairs() const;
+    QString getFirstOutputDirectory() const;
+    QString getSecondOutputDirectory() const;
+
+    // Parses a list of timestamps separated by commas, spaces or new lines.
+    // A timestamp is either a number of seconds ("12.5") or "[hh:]mm:ss[.zzz]".
+    // Throws std::runtime_error if a timestamp is incorrect.
+    static QList<qint64> parseTimestamps(const QString &text);
+
+signals:
+    void progressChanged(int steps);
+    void extractionFinished();
+    void extractionFailed(const QString &error);
+
+private slots:
+    void onReaderThreadFinished();
+
+private:
+    const int mTargetQueueCapacity = 64;
+    const int mPendingImagesPerEncoder = 2;
+
+    // Qt maps the quality q of a PNG to the zlib level (100 - q) * 9 / 91, so 80 is
+    // the level 1: the fastest level that still compresses. The encoders are the
+    // bottleneck of the extraction and the files are only an intermediate result.
+    const int mPngQuality = 80;
+
+    QString mFirstVideoPath;
+    QString mSecondVideoPath;
+    FramePairExtractionSettings mSettings;
+    QString mFirstOutputDirectory;
+    QString mSecondOutputDirectory;
+    double mFrameRate;
+    int mTotalFrames;
+    QList<int> mTargetFrames; // Empty in the scene change mode
+    std::shared_ptr<BoundedFrameQueue> mTargetQueue;
+    int mFinishedReaders;
+    std::atomic<int> mExtractedPairs;
+    QThreadPool mEncoderPool;
+    std::unique_ptr<QSemaphore> mEncoderSlots;
+    VideoAnalysisWorkers mWorkers;
+
+    void readFirstVideo();
+    void readSecondVideo();
+    void encodeImage(const QImage &image, const QString &directory, int frameIndex);
+    QString getFileName(int frameIndex) const;
+};
+
+#endif // FRAMEPAIREXTRACTIONINTERACTOR_H
@@ -0,0 +1,77 @@
+#include "framepairmetricscalculator.h"
+
+#include <algorithm>
+#include <vector>
+#include <business/imageanalysis/comporators/contrastcomporator.h>
+#include <domain/kernels/pixelkernels.h>
+
+
+VideoFrameMetrics FramePairMetricsCalculator::calculate(int frameIndex,
+                                                        qint64 positionMs,
+                                                        const QImage &firstFrame,
+                                                        const QImage &secondFrame,
+                                                        const QList<VideoFrameComparator> &comparators
+                                                        )
+{
+    if (firstFrame.size() != secondFrame.size()) {
+        throw std::runtime_error("Error: the videos have different frame sizes.");
+    }
+
+    VideoFrameMetrics metrics;
+    metrics.frameIndex = frameIndex;
+    metrics.positionMs = positionMs;
+
+    QImage image1 = firstFrame.convertToFormat(QImage::Format_RGB32);
+    QImage image2 = secondFrame.convertToFormat(QImage::Format_RGB32);
+
+    int width = image1.width();
+    int height = image1.height();
+    qint64 totalPixels = static_cast<qint64>(width) * height;
+    if (totalPixels == 0) {
+        return metrics;
+    }
+
+    bool isDifferenceNeeded = comparators.contains(VideoFrameComparator::PixelDifference);
+    bool isBrightnessNeeded = comparators.contains(VideoFrameComparator::Brightness);
+
+    int maxDifference = 0;
+    qint64 differingPixels = 0;
+    quint64 totalBrightness1 = 0;
+    quint64 totalBrightness2 = 0;
+
+    // The kernels read the channels of the QRgb values directly, one row at a time
+    std::vector<uchar> row(width);
+    for (int y = 0; y < height && (isDifferenceNeeded || isBrightnessNeeded); ++y) {
+        const QRgb *line1 = reinterpret_cast<const QRgb*>(image1.constScanLine(y));
+        const QRgb *line2 = reinterpret_cast<const QRgb*>(image2.constScanLine(y));
+        if (isBrightnessNeeded) {
+            PixelKernels::grayscale(line1, row.data(), width);
+            totalBrightness1 += PixelKernels::sum(row.data(), width);
+            PixelKernels::grayscale(line2, row.data(), width);
+            totalBrightness2 += PixelKernels::sum(row.data(), width);
+        }
+        if (isDifferenceNeeded) {
+            PixelKernels::maxChannelDifference(line1, line2, row.data(), width);
+            for (int x = 0; x < width; ++x) {
+                if (row[x] > 0) {
+                    ++differingPixels;
+                    maxDifference = std::max(maxDifference, static_cast<int>(row[x]));
+                }
+            }
+        }
+    }
+
+    if (isDifferenceNeeded) {
+        metrics.maxDifference = maxDifference;
+        metrics.differingPixelsPercent = (static_cast<double>(differingPixels) / totalPixels) * 100.0;
+    }
+    if (isBrightnessNeeded) {
+        metrics.firstBrightness = static_cast<double>(totalBrightness1) / totalPixels;
+        metrics.secondBrightness = static_cast<double>(totalBrightness2) / totalPixels;
+    }
+    if (comparators.contains(VideoFrameComparator::Contrast)) {
+        metrics.firstContrast = ContrastComporator::calculateContrast(image1);
+        metrics.secondContrast = ContrastComporator::calculateContrast(image2);
+    }
+    return metrics;
+}
@@ -0,0 +1,28 @@
+#ifndef FRAMEPAIRMETRICSCALCULATOR_H
+#define FRAMEPAIRMETRICSCALCULATOR_H
+
+#include <QImage>
+#include <QList>
+#include <domain/valueobjects/videoframemetrics.h>
+
+// Calculates the per-frame metrics of the video comparison timeline. The pixel
+// kernels and the contrast calculation are shared with the image comparators, so
+// a frame pair opened in the main viewer gives the same numbers as the timeline.
+
+class FramePairMetricsCalculator
+{
+public:
+    FramePairMetricsCalculator() = delete;
+    ~FramePairMetricsCalculator() = delete;
+
+    // Calculates only the metrics of the given comparators. Both frames must
+    // have the same size; throws std::runtime_error otherwise.
+    static VideoFrameMetrics calculate(int frameIndex,
+                                       qint64 positionMs,
+                                       const QImage &firstFrame,
+                                       const QImage &secondFrame,
+                                       const QList<VideoFrameComparator> &comparators
+                                       );
+};
+
+#endif // FRAMEPAIRMETRICSCALCULATOR_H
@@ -0,0 +1,61 @@
+#include "tearingdetector.h"
+
+#include <algorithm>
+#include <limits>
+
+
+std::optional<TearLine> TearingDetector::findTearLine(const RowIndex &previous,
+                                                      const RowIndex &current,
+                                                      const RowIndex &next
+                                                      )
+{
+    if (previous.getSize() != current.getSize() || next.getSize() != current.getSize()) {
+        return std::nullopt;
+    }
+    int height = current.getHeight();
+    if (height < 3) {
+        return std::nullopt;
+    }
+
+    auto previousDifferences = RowIndex::calculateRowDifferences(current, previous);
+    auto nextDifferences = RowIndex::calculateRowDifferences(current, next);
+
+    double totalPrevious = 0.0;
+    double totalNext = 0.0;
+    for (int y = 0; y < height; ++y) {
+        totalPrevious += previousDifferences[y];
+        totalNext += nextDifferences[y];
+    }
+    double wholeFrameDifference = std::min(totalPrevious, totalNext);
+    if (wholeFrameDifference / height < mMinMotion) {
+        return std::nullopt;
+    }
+
+    // abovePrevious is the difference from the previous frame of the rows above y
+    int margin = std::max(1, static_cast<int>(height * mEdgeMargin));
+    double abovePrevious = 0.0;
+    double aboveNext = 0.0;
+    double bestDifference = std::numeric_limits<double>::max();
+    int bestRow = -1;
+    for (int y = 0; y < height - margin; ++y) {
+        if (y >= margin) {
+            double difference = abovePrevious + (totalNext - aboveNext);
+            if (difference < bestDifference) {
+                bestDifference = difference;
+                bestRow = y;
+            }
+        }
+        abovePrevious += previousDifferences[y];
+        aboveNext += nextDifferences[y];
+    }
+    if (bestRow < 0 || bestDifference > wholeFrameDifference * mMaxRemainingDifference) {
+        return std::nullopt;
+    }
+
+    TearLine tearLine;
+    tearLine.row = bestRow;
+    tearLine.confidence = 1.0 - bestDifference / wholeFrameDifference;
+    double neighboursEnergy = (previous.getRowEnergy()[bestRow] + next.getRowEnergy()[bestRow]) / 2.0;
+    tearLine.edgeEnergyRatio = current.getRowEnergy()[bestRow] / std::max(neighboursEnergy, 1.0);
+    return tearLine;
+}
@@ -0,0 +1,48 @@
+#ifndef TEARINGDETECTOR_H
+#define TEARINGDETECTOR_H
+
+#include <optional>
+#include <domain/valueobjects/rowindex.h>
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct TearLine {
+    int row = 0;                 // The first row that comes from the newer source frame
+    double confidence = 0.0;     // 1 - (the difference left after the split) / (the difference without it)
+    double edgeEnergyRatio = 0.0; // Inter-row energy at the row compared with the neighbouring frames
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// Locates a tear line in a frame using the previous and the next frame. In a torn
+// frame the rows above the line match the previous frame and the rows below it match
+// the next one, so the split row minimizes
+//     sum(diff(current, previous) above the row) + sum(diff(current, next) below it).
+// The frame is torn if this sum is much smaller than the difference of the whole
+// frame from the closest neighbour. Static content cannot tear visibly, so frames
+// that barely differ from their neighbours are skipped.
+
+class TearingDetector
+{
+public:
+    TearingDetector() = delete;
+    ~TearingDetector() = delete;
+
+    static std::optional<TearLine> findTearLine(const RowIndex &previous,
+                                                const RowIndex &current,
+                                                const RowIndex &next
+                                                );
+
+private:
+    // The mean per-row luminance difference from the closest neighbour
+    // below which the frame is considered static
+    static constexpr double mMinMotion = 1.0;
+
+    // The part of the difference that may remain after the split
+    static constexpr double mMaxRemainingDifference = 0.3;
+
+    // Splits closer than this part of the height to the edges are ignored
+    static constexpr double mEdgeMargin = 0.02;
+};
+
+#endif // TEARINGDETECTOR_H
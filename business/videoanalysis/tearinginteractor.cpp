@@ -0,0 +1,172 @@
+#include "tearinginteractor.h"
+
+#include <QFileInfo>
+#include <QLocale>
+#include <QThread>
+#include <QTime>
+#include <deque>
+#include <business/videoanalysis/boundedframequeue.h>
+#include <business/videoanalysis/videoframereader.h>
+#include <data/storage/imagefileshandler.h>
+
+
+TearingInteractor::TearingInteractor(const QString &videoPath, QObject *parent)
+    : QObject(parent),
+    mVideoPath(videoPath),
+    mTotalFrames(0),
+    mFrameRate(0.0)
+{
+}
+
+TearingInteractor::~TearingInteractor() {
+    mWorkers.cancel();
+    mWorkers.stopThreads();
+}
+
+void TearingInteractor::start() {
+    VideoFrameReader reader { mVideoPath };
+    reader.open();
+    mFrameRate = reader.getFrameRate();
+    mTotalFrames = reader.getFrameCount();
+    if (mTotalFrames < 3) {
+        throw std::runtime_error("Error: at least three frames are required to detect tearing.");
+    }
+
+    mWorkers.reset();
+    mTornFrames.clear();
+    mQueue = mWorkers.createQueue(mFrameQueueCapacity);
+
+    mWorkers.createThread([this]() {
+        mWorkers.decodeVideo(mVideoPath, mFrameRate, 0, mTotalFrames - 1, 1, mQueue);
+    });
+    QThread *analysisThread = mWorkers.createThread([this]() {
+        analyzeFrames();
+    });
+
+    connect(analysisThread,
+            &QThread::finished,
+            this,
+            &TearingInteractor::onAnalysisThreadFinished
+            );
+
+    mWorkers.startThreads();
+}
+
+void TearingInteractor::cancel() {
+    mWorkers.cancel();
+}
+
+int TearingInteractor::getTotalFrames() const {
+    return mTotalFrames;
+}
+
+QString TearingInteractor::getVideoPath() const {
+    return mVideoPath;
+}
+
+QList<TornFrame> TearingInteractor::getTornFrames() const {
+    return mTornFrames;
+}
+
+QString TearingInteractor::getSummaryHtml() const {
+    QLocale locale = QLocale::system();
+
+    QString html;
+    html += QString("<h2 style=\"line-height: 2;\">%1</h2>").arg("Screen tearing analysis");
+    html += "<table border=\"1\" cellspacing=\"0\" cellpadding=\"5\">";
+    html += QString("<tr><td>Video</td><td align=\"right\">%1</td></tr>")
+                .arg(QFileInfo(mVideoPath).fileName());
+    html += QString("<tr><td>Analyzed frames</td><td align=\"right\">%1</td></tr>")
+                .arg(locale.toString(mTotalFrames));
+    html += QString("<tr><td>Torn frames</td><td align=\"right\">%1</td></tr>")
+                .arg(locale.toString(mTornFrames.size()));
+    html += "</table>";
+    html += "<br/>";
+
+    if (mTornFrames.isEmpty()) {
+        html += "<b>No tearing was detected in the video.</b>";
+        return html;
+    }
+
+    html += "<b><font color=\"red\">Tearing was detected in the video.</font></b><br/><br/>";
+    html += "<table border=\"1\" cellspacing=\"0\" cellpadding=\"5\">";
+    html += "<tr><th>Frame</th><th>Time</th><th>Tear line (row)</th>"
+            "<th>Confidence</th><th>Edge energy ratio</th></tr>";
+    int count = qMin(mTornFrames.size(), mMaxReportedFrames);
+    for (int i = 0; i < count; ++i) {
+        const TornFrame &frame = mTornFrames[i];
+        QTime time = QTime(0, 0).addMSecs(frame.positionMs);
+        html += QString("<tr><td align=\"right\">%1</td><td>%2</td><td align=\"right\">%3</td>"
+                        "<td align=\"right\">%4</td><td align=\"right\">%5</td></tr>")
+                    .arg(frame.frameIndex)
+                    .arg(time.toString("hh:mm:ss.zzz"))
+                    .arg(frame.tearLine.row)
+                    .arg(frame.tearLine.confidence, 0, 'f', 2)
+                    .arg(frame.tearLine.edgeEnergyRatio, 0, 'f', 2);
+    }
+    html += "</table>";
+    if (mTornFrames.size() > count) {
+        html += QString("<br/>Only the first %1 torn frames are listed.").arg(count);
+    }
+    html += "<br/><br/>";
+    html += QString("A frame is considered torn if the rows above a line match the previous frame ")
+            + "and the rows below it match the next frame. The edge energy ratio shows how much "
+            + "sharper the transition at the tear line is than the same rows of the neighbouring "
+            + "frames. The most confident torn frame and the frame before it are opened in the "
+            + "main window.";
+    return html;
+}
+
+QPair<QString, QString> TearingInteractor::saveFramePairAsTemporary(int frameIndex) {
+    if (frameIndex <= 0 || frameIndex >= mTotalFrames) {
+        throw std::runtime_error("Error: incorrect frame number.");
+    }
+    VideoFrameReader reader { mVideoPath };
+    reader.open();
+    QImage previousFrame = reader.readFrameAt(VideoFrameReader::getFramePosition(frameIndex - 1, mFrameRate));
+    QImage currentFrame = reader.readFrameAt(VideoFrameReader::getFramePosition(frameIndex, mFrameRate));
+
+    ImageFilesHandler imageFilesHandler;
+    QString previousPath = imageFilesHandler.saveImageAsTemporary(previousFrame);
+    QString currentPath = imageFilesHandler.saveImageAsTemporary(currentFrame);
+    return { previousPath, currentPath };
+}
+
+/* Worker threads { */
+
+void TearingInteractor::analyzeFrames() {
+    // The window holds the previous, the current and the next frame
+    std::deque<RowIndex> window;
+    std::deque<DecodedVideoFrame> frames;
+    while (!mWorkers.isCanceled()) {
+        auto frame = mQueue->pop();
+        if (!frame) {
+            break;
+        }
+        window.emplace_back(frame->image);
+        frame->image = QImage(); // only the row index is needed
+        frames.push_back(std::move(*frame));
+        if (window.size() > 3) {
+            window.pop_front();
+            frames.pop_front();
+        }
+        if (window.size() == 3) {
+            auto tearLine = TearingDetector::findTearLine(window[0], window[1], window[2]);
+            if (tearLine) {
+                mTornFrames.append({ frames[1].frameIndex, frames[1].positionMs, tearLine.value() });
+            }
+        }
+        emit progressChanged(frames.back().frameIndex + 1);
+    }
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+void TearingInteractor::onAnalysisThreadFinished() {
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit analysisFailed(error);
+    } else if (!mWorkers.isCanceled()) {
+        emit analysisFinished();
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef TEARINGINTERACTOR_H
+#define TEARINGINTERACTOR_H
+
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <memory>
+#include <business/videoanalysis/tearingdetector.h>
+#include <business/videoanalysis/videoanalysisworkers.h>
+
+class BoundedFrameQueue;
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct TornFrame {
+    int frameIndex = 0;
+    qint64 positionMs = 0;
+    TearLine tearLine;
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// Detects screen tearing in a video. A decoder thread reads the frames and an
+// analysis thread builds the row index of every frame (see RowIndex) and looks
+// for a tear line in each frame using its neighbours (see TearingDetector).
+// Only the row indexes of three frames are kept at a time, so full clips can be
+// processed.
+
+class TearingInteractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TearingInteractor(const QString &videoPath, QObject *parent = nullptr);
+    ~TearingInteractor();
+
+    // Reads the metadata of the video and starts the worker threads.
+    // Throws std::runtime_error if the video cannot be opened.
+    void start();
+    void cancel();
+
+    int getTotalFrames() const;
+    QString getVideoPath() const;
+
+    // Available after analysisFinished() was emitted.
+    QList<TornFrame> getTornFrames() const;
+    QString getSummaryHtml() const;
+
+    // Decodes the frame and the previous one and saves them in the Temp directory,
+    // so they can be opened in the main window. Throws std::runtime_error.
+    QPair<QString, QString> saveFramePairAsTemporary(int frameIndex);
+
+signals:
+    void progressChanged(int analyzedFrames);
+    void analysisFinished();
+    void analysisFailed(const QString &error);
+
+private slots:
+    void onAnalysisThreadFinished();
+
+private:
+    const int mFrameQueueCapacity = 3;
+
+    // Only the first torn frames are listed in the report
+    const int mMaxReportedFrames = 200;
+
+    QString mVideoPath;
+    int mTotalFrames;
+    double mFrameRate;
+    QList<TornFrame> mTornFrames;
+    std::shared_ptr<BoundedFrameQueue> mQueue;
+    VideoAnalysisWorkers mWorkers;
+
+    void analyzeFrames();
+};
+
+#endif // TEARINGINTERACTOR_H
@@ -0,0 +1,135 @@
+#include "temporalditheringinteractor.h"
+
+#include <QFileInfo>
+#include <QLocale>
+#include <QThread>
+#include <business/imageanalysis/comporators/helpers/mathhelper.h>
+#include <business/videoanalysis/boundedframequeue.h>
+#include <business/videoanalysis/videoframereader.h>
+
+
+TemporalDitheringInteractor::TemporalDitheringInteractor(const QString &videoPath, QObject *parent)
+    : QObject(parent),
+    mVideoPath(videoPath),
+    mTotalFrames(0),
+    mFrameRate(0.0)
+{
+}
+
+TemporalDitheringInteractor::~TemporalDitheringInteractor() {
+    mWorkers.cancel();
+    mWorkers.stopThreads();
+}
+
+void TemporalDitheringInteractor::start() {
+    VideoFrameReader reader { mVideoPath };
+    reader.open();
+    mFrameRate = reader.getFrameRate();
+    mTotalFrames = reader.getFrameCount();
+    if (mTotalFrames < 2) {
+        throw std::runtime_error("Error: at least two frames are required to detect temporal dithering.");
+    }
+
+    mWorkers.reset();
+    mQueue = mWorkers.createQueue(mFrameQueueCapacity);
+
+    mWorkers.createThread([this]() {
+        mWorkers.decodeVideo(mVideoPath, mFrameRate, 0, mTotalFrames - 1, 1, mQueue);
+    });
+    QThread *analysisThread = mWorkers.createThread([this]() {
+        analyzeFrames();
+    });
+
+    connect(analysisThread,
+            &QThread::finished,
+            this,
+            &TemporalDitheringInteractor::onAnalysisThreadFinished
+            );
+
+    mWorkers.startThreads();
+}
+
+void TemporalDitheringInteractor::cancel() {
+    mWorkers.cancel();
+}
+
+int TemporalDitheringInteractor::getTotalFrames() const {
+    return mTotalFrames;
+}
+
+QString TemporalDitheringInteractor::getVideoPath() const {
+    return mVideoPath;
+}
+
+QImage TemporalDitheringInteractor::getHeatmap() const {
+    return mStatistics.createHeatmap();
+}
+
+QString TemporalDitheringInteractor::getSummaryHtml() const {
+    TemporalDitheringSummary summary = mStatistics.getSummary();
+    QLocale locale = QLocale::system();
+    qint64 totalPixels = static_cast<qint64>(summary.width) * summary.height;
+
+    QString html;
+    html += QString("<h2 style=\"line-height: 2;\">%1</h2>").arg("Temporal dithering analysis");
+    html += "<table border=\"1\" cellspacing=\"0\" cellpadding=\"5\">";
+    html += QString("<tr><td>Video</td><td align=\"right\">%1</td></tr>")
+                .arg(QFileInfo(mVideoPath).fileName());
+    html += QString("<tr><td>Frame size</td><td align=\"right\">%1 x %2</td></tr>")
+                .arg(summary.width)
+                .arg(summary.height);
+    html += QString("<tr><td>Analyzed frames</td><td align=\"right\">%1</td></tr>")
+                .arg(locale.toString(summary.analyzedFrames));
+    html += QString("<tr><td>Frames that differ from the previous frame</td><td align=\"right\">%1</td></tr>")
+                .arg(locale.toString(summary.framesWithChanges));
+    html += QString("<tr><td>Pixels that changed at least once</td><td align=\"right\">%1</td></tr>")
+                .arg(locale.toString(summary.changedPixels));
+    html += QString("<tr><td>Dithered pixels</td><td align=\"right\">%1 of %2 (%3)</td></tr>")
+                .arg(locale.toString(summary.ditheredPixels),
+                     locale.toString(totalPixels),
+                     MathHelper::formatPercentageValue(summary.ditheredPixelsPercent, 3));
+    html += QString("<tr><td>Average change rate per pixel</td><td align=\"right\">%1</td></tr>")
+                .arg(MathHelper::formatPercentageValue(summary.averageChangeRate * 100.0, 3));
+    html += QString("<tr><td>Max luminance standard deviation</td><td align=\"right\">%1</td></tr>")
+                .arg(summary.maxStandardDeviation, 0, 'f', 2);
+    html += "</table>";
+    html += "<br/>";
+
+    if (summary.framesWithChanges == 0) {
+        html += "<b>All frames in the video are identical.</b>";
+    } else if (summary.ditheredPixels > 0) {
+        html += "<b><font color=\"red\">Temporal dithering was detected in the video.</font></b>";
+    } else {
+        html += "<b>Differences between frames were detected, but they do not look like temporal dithering.</b>";
+    }
+    html += "<br/><br/>";
+    html += QString("A pixel is considered dithered if it changes in at least 10% of the frame ")
+            + "transitions while its luminance stays within a few levels of its average value. "
+            + "The heatmap opened in the main window shows how often each pixel changed: white pixels "
+            + "never changed, blue pixels changed rarely and red pixels changed in almost every frame.";
+    return html;
+}
+
+/* Worker threads { */
+
+void TemporalDitheringInteractor::analyzeFrames() {
+    while (!mWorkers.isCanceled()) {
+        auto frame = mQueue->pop();
+        if (!frame) {
+            break;
+        }
+        mStatistics.addFrame(frame->image);
+        emit progressChanged(mStatistics.getAnalyzedFrames());
+    }
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+void TemporalDitheringInteractor::onAnalysisThreadFinished() {
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit analysisFailed(error);
+    } else if (!mWorkers.isCanceled()) {
+        emit analysisFinished();
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef TEMPORALDITHERINGINTERACTOR_H
+#define TEMPORALDITHERINGINTERACTOR_H
+
+#include <QImage>
+#include <QObject>
+#include <QString>
+#include <memory>
+#include <business/videoanalysis/temporalditheringstatistics.h>
+#include <business/videoanalysis/videoanalysisworkers.h>
+
+class BoundedFrameQueue;
+
+// Detects temporal dithering in a single video. A decoder thread reads the
+// frames one by one and an analysis thread accumulates the per-pixel statistics
+// at the same time; the two threads are connected by a small bounded queue.
+// Replaces non-project-files/misc/analyze_temporal_dithering.py.
+
+class TemporalDitheringInteractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TemporalDitheringInteractor(const QString &videoPath, QObject *parent = nullptr);
+    ~TemporalDitheringInteractor();
+
+    // Reads the metadata of the video and starts the worker threads.
+    // Throws std::runtime_error if the video cannot be opened.
+    void start();
+    void cancel();
+
+    int getTotalFrames() const;
+    QString getVideoPath() const;
+
+    // Available after analysisFinished() was emitted.
+    QImage getHeatmap() const;
+    QString getSummaryHtml() const;
+
+signals:
+    void progressChanged(int analyzedFrames);
+    void analysisFinished();
+    void analysisFailed(const QString &error);
+
+private slots:
+    void onAnalysisThreadFinished();
+
+private:
+    const int mFrameQueueCapacity = 3;
+
+    QString mVideoPath;
+    int mTotalFrames;
+    double mFrameRate;
+    TemporalDitheringStatistics mStatistics;
+    std::shared_ptr<BoundedFrameQueue> mQueue;
+    VideoAnalysisWorkers mWorkers;
+
+    void analyzeFrames();
+};
+
+#endif // TEMPORALDITHERINGINTERACTOR_H
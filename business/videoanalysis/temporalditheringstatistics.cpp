@@ -0,0 +1,125 @@
+#include "temporalditheringstatistics.h"
+
+#include <QColor>
+#include <cmath>
+
+
+void TemporalDitheringStatistics::addFrame(const QImage &frame) {
+    QImage image = frame.convertToFormat(QImage::Format_RGB32);
+
+    if (mFrameCount == 0) {
+        mWidth = image.width();
+        mHeight = image.height();
+        size_t size = static_cast<size_t>(mWidth) * mHeight;
+        mPreviousLuma.assign(size, 0);
+        mChangeCount.assign(size, 0);
+        mMean.assign(size, 0.0f);
+        mM2.assign(size, 0.0f);
+    } else if (image.width() != mWidth || image.height() != mHeight) {
+        throw std::runtime_error("Error: the size of the video frames has changed.");
+    }
+
+    ++mFrameCount;
+    bool isFirstFrame = mFrameCount == 1;
+    bool hasChanges = false;
+    float frameCount = static_cast<float>(mFrameCount);
+
+    for (int y = 0; y < mHeight; ++y) {
+        const QRgb *line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        size_t offset = static_cast<size_t>(y) * mWidth;
+        quint8 *previousLuma = mPreviousLuma.data() + offset;
+        quint32 *changeCount = mChangeCount.data() + offset;
+        float *mean = mMean.data() + offset;
+        float *m2 = mM2.data() + offset;
+
+        for (int x = 0; x < mWidth; ++x) {
+            quint8 luma = static_cast<quint8>(qGray(line[x]));
+            if (!isFirstFrame && std::abs(luma - previousLuma[x]) > mChangeThreshold) {
+                ++changeCount[x];
+                hasChanges = true;
+            }
+            previousLuma[x] = luma;
+
+            float delta = luma - mean[x];
+            mean[x] += delta / frameCount;
+            m2[x] += delta * (luma - mean[x]);
+        }
+    }
+
+    if (hasChanges) {
+        ++mFramesWithChanges;
+    }
+}
+
+int TemporalDitheringStatistics::getAnalyzedFrames() const {
+    return mFrameCount;
+}
+
+double TemporalDitheringStatistics::getChangeRate(size_t index) const {
+    if (mFrameCount < 2) {
+        return 0.0;
+    }
+    return static_cast<double>(mChangeCount[index]) / (mFrameCount - 1);
+}
+
+double TemporalDitheringStatistics::getStandardDeviation(size_t index) const {
+    if (mFrameCount < 2) {
+        return 0.0;
+    }
+    return std::sqrt(mM2[index] / mFrameCount);
+}
+
+TemporalDitheringSummary TemporalDitheringStatistics::getSummary() const {
+    TemporalDitheringSummary summary;
+    summary.width = mWidth;
+    summary.height = mHeight;
+    summary.analyzedFrames = mFrameCount;
+    summary.framesWithChanges = mFramesWithChanges;
+
+    size_t size = mChangeCount.size();
+    if (size == 0) {
+        return summary;
+    }
+
+    double totalChangeRate = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+        if (mChangeCount[i] == 0) {
+            continue;
+        }
+        double changeRate = getChangeRate(i);
+        double standardDeviation = getStandardDeviation(i);
+        totalChangeRate += changeRate;
+        ++summary.changedPixels;
+        summary.maxStandardDeviation = std::max(summary.maxStandardDeviation, standardDeviation);
+        if (changeRate >= mDitheringChangeRate && standardDeviation <= mDitheringMaxStdDeviation) {
+            ++summary.ditheredPixels;
+        }
+    }
+    summary.ditheredPixelsPercent = (static_cast<double>(summary.ditheredPixels) / size) * 100.0;
+    summary.averageChangeRate = totalChangeRate / size;
+    return summary;
+}
+
+QImage TemporalDitheringStatistics::createHeatmap() const {
+    QImage heatmap(mWidth, mHeight, QImage::Format_RGB32);
+    heatmap.fill(Qt::white);
+
+    // Hue 240 (blue) for rare changes down to 0 (red) for changes in every frame
+    QList<QRgb> palette(241);
+    for (int hue = 0; hue <= 240; ++hue) {
+        palette[hue] = QColor::fromHsv(hue, 255, 255).rgb();
+    }
+
+    for (int y = 0; y < mHeight; ++y) {
+        QRgb *line = reinterpret_cast<QRgb*>(heatmap.scanLine(y));
+        size_t offset = static_cast<size_t>(y) * mWidth;
+        for (int x = 0; x < mWidth; ++x) {
+            if (mChangeCount[offset + x] == 0) {
+                continue;
+            }
+            double changeRate = getChangeRate(offset + x);
+            line[x] = palette[static_cast<int>((1.0 - changeRate) * 240.0)];
+        }
+    }
+    return heatmap;
+}
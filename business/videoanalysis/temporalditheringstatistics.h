@@ -0,0 +1,72 @@
+#ifndef TEMPORALDITHERINGSTATISTICS_H
+#define TEMPORALDITHERINGSTATISTICS_H
+
+#include <QImage>
+#include <vector>
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct TemporalDitheringSummary {
+    int width = 0;
+    int height = 0;
+    int analyzedFrames = 0;
+    int framesWithChanges = 0;         // Frames that differ from the previous frame
+    qint64 changedPixels = 0;          // Pixels that changed at least once
+    qint64 ditheredPixels = 0;         // Pixels that flicker with a small amplitude
+    double ditheredPixelsPercent = 0.0;
+    double averageChangeRate = 0.0;    // Average share of frame transitions with a change [0, 1]
+    double maxStandardDeviation = 0.0; // Max luminance standard deviation over all pixels
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// Accumulates per-pixel statistics of the luminance over a sequence of frames.
+// Every statistic is kept in its own planar buffer (one value per pixel), so a
+// 1080p video needs about 20 MB regardless of the number of frames.
+//
+// Temporal dithering makes a pixel alternate between neighbouring values from
+// frame to frame. Such a pixel changes often but its values stay close to the
+// mean, while motion in the video changes pixels rarely and by large amounts.
+// A pixel is counted as dithered if it changed in at least mDitheringChangeRate
+// of the frame transitions and its standard deviation does not exceed
+// mDitheringMaxStdDeviation.
+//
+// Like analyze_temporal_dithering.py, a transition counts as a change only if the
+// luminance differs by more than mChangeThreshold, so the rounding noise of the
+// decoder and of the grayscale conversion is ignored.
+
+class TemporalDitheringStatistics
+{
+public:
+    TemporalDitheringStatistics() = default;
+    ~TemporalDitheringStatistics() = default;
+
+    // All frames must have the same size; throws std::runtime_error otherwise.
+    void addFrame(const QImage &frame);
+
+    int getAnalyzedFrames() const;
+    TemporalDitheringSummary getSummary() const;
+
+    // White pixels never changed; the color of the other pixels goes from blue
+    // to red as the share of frame transitions in which the pixel changed grows.
+    QImage createHeatmap() const;
+
+private:
+    const int mChangeThreshold = 1;
+    const double mDitheringChangeRate = 0.1;
+    const double mDitheringMaxStdDeviation = 4.0;
+
+    int mWidth = 0;
+    int mHeight = 0;
+    int mFrameCount = 0;
+    int mFramesWithChanges = 0;
+    std::vector<quint8> mPreviousLuma;
+    std::vector<quint32> mChangeCount;
+    std::vector<float> mMean;   // Welford's running mean
+    std::vector<float> mM2;     // Welford's running sum of squared deviations
+
+    double getChangeRate(size_t index) const;
+    double getStandardDeviation(size_t index) const;
+};
+
+#endif // TEMPORALDITHERINGSTATISTICS_H
@@ -0,0 +1,124 @@
+#include "videoanalysisworkers.h"
+
+#include <QMutexLocker>
+#include <QThread>
+#include <business/videoanalysis/boundedframequeue.h>
+#include <business/videoanalysis/videoframereader.h>
+
+
+VideoAnalysisWorkers::VideoAnalysisWorkers()
+    : mIsCanceled(false)
+{
+}
+
+VideoAnalysisWorkers::~VideoAnalysisWorkers() {
+    cancel();
+    stopThreads();
+}
+
+void VideoAnalysisWorkers::reset() {
+    QMutexLocker locker(&mMutex);
+    mIsCanceled = false;
+    mError.clear();
+    mQueues.clear();
+}
+
+std::shared_ptr<BoundedFrameQueue> VideoAnalysisWorkers::createQueue(int capacity) {
+    auto queue = std::make_shared<BoundedFrameQueue>(capacity);
+    QMutexLocker locker(&mMutex);
+    if (mIsCanceled) {
+        queue->abort();
+    }
+    mQueues.append(queue);
+    return queue;
+}
+
+QThread* VideoAnalysisWorkers::createThread(std::function<void()> task) {
+    QThread *thread = QThread::create([this, task]() {
+        try {
+            task();
+        } catch (std::exception &e) {
+            setError(e.what());
+            cancel();
+        }
+    });
+    QMutexLocker locker(&mMutex);
+    mThreads.append(thread);
+    return thread;
+}
+
+void VideoAnalysisWorkers::startThreads() {
+    QMutexLocker locker(&mMutex);
+    foreach (auto thread, mThreads) {
+        if (!thread->isRunning() && !thread->isFinished()) {
+            thread->start();
+        }
+    }
+}
+
+void VideoAnalysisWorkers::stopThreads() {
+    // A running thread may still create new ones, so the list is taken until it stays empty
+    while (true) {
+        QList<QThread*> threads;
+        {
+            QMutexLocker locker(&mMutex);
+            threads.swap(mThreads);
+        }
+        if (threads.isEmpty()) {
+            break;
+        }
+        foreach (auto thread, threads) {
+            thread->wait();
+            delete thread;
+        }
+    }
+}
+
+void VideoAnalysisWorkers::cancel() {
+    QMutexLocker locker(&mMutex);
+    mIsCanceled = true;
+    foreach (auto queue, mQueues) {
+        queue->abort();
+    }
+}
+
+bool VideoAnalysisWorkers::isCanceled() const {
+    return mIsCanceled;
+}
+
+void VideoAnalysisWorkers::setError(const QString &error) {
+    QMutexLocker locker(&mMutex);
+    if (mError.isEmpty()) {
+        mError = error;
+    }
+}
+
+QString VideoAnalysisWorkers::getError() {
+    QMutexLocker locker(&mMutex);
+    return mError;
+}
+
+void VideoAnalysisWorkers::decodeVideo(const QString &videoPath,
+                                       double frameRate,
+                                       int fromFrame,
+                                       int toFrame,
+                                       int step,
+                                       const std::shared_ptr<BoundedFrameQueue> &queue,
+                                       const std::function<void(DecodedVideoFrame&)> &prepareFrame
+                                       )
+{
+    VideoFrameReader reader { videoPath };
+    reader.open();
+    for (int i = fromFrame; i <= toFrame && !mIsCanceled; i += step) {
+        qint64 position = VideoFrameReader::getFramePosition(i, frameRate);
+        DecodedVideoFrame frame { i, position, reader.readFrameAt(position) };
+        frame.startTime = reader.getLastFrameStartTime();
+        if (prepareFrame) {
+            prepareFrame(frame);
+        }
+        if (!queue->push(std::move(frame))) {
+            break; // the analysis was canceled
+        }
+    }
+    queue->close();
+}
@@ -0,0 +1,71 @@
+#ifndef VIDEOANALYSISWORKERS_H
+#define VIDEOANALYSISWORKERS_H
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class QThread;
+class BoundedFrameQueue;
+struct DecodedVideoFrame;
+
+// The worker threads of a video analysis. They share a cancellation flag and the
+// first error that occurred in any of them; an exception thrown by a thread is
+// stored as the error and cancels the others. The frame queues created here are
+// aborted on cancellation, so the threads blocked on them wake up.
+//
+// The interactors own an instance, connect to the finished() signals of the
+// threads they are interested in and read the error in their slots.
+
+class VideoAnalysisWorkers
+{
+public:
+    VideoAnalysisWorkers();
+    ~VideoAnalysisWorkers();
+
+    // Clears the cancellation flag, the error and the queues before a new run.
+    // The threads of the previous run must be stopped.
+    void reset();
+
+    std::shared_ptr<BoundedFrameQueue> createQueue(int capacity);
+
+    // The thread is started by startThreads(), so its signals can be connected first.
+    // May be called from a worker thread.
+    QThread* createThread(std::function<void()> task);
+    void startThreads();
+
+    // Waits for all the threads and deletes them.
+    void stopThreads();
+
+    void cancel();
+    bool isCanceled() const;
+
+    // Only the first error is kept, the rest are usually its consequences.
+    void setError(const QString &error);
+    QString getError();
+
+    // Reads the frames fromFrame..toFrame (every step-th one) on the timeline of the
+    // given frame rate and pushes them into the queue, then closes it. prepareFrame,
+    // if set, is called on the decoder thread before a frame is pushed.
+    // Throws std::runtime_error if the video cannot be read.
+    void decodeVideo(const QString &videoPath,
+                     double frameRate,
+                     int fromFrame,
+                     int toFrame,
+                     int step,
+                     const std::shared_ptr<BoundedFrameQueue> &queue,
+                     const std::function<void(DecodedVideoFrame&)> &prepareFrame = nullptr
+                     );
+
+private:
+    std::atomic<bool> mIsCanceled;
+    QMutex mMutex;
+    QString mError;
+    QList<QThread*> mThreads;
+    QList<std::shared_ptr<BoundedFrameQueue>> mQueues;
+};
+
+#endif // VIDEOANALYSISWORKERS_H
@@ -0,0 +1,142 @@
+#include "videocomparisoninteractor.h"
+
+#include <QThread>
+#include <business/videoanalysis/boundedframequeue.h>
+#include <business/videoanalysis/framepairmetricscalculator.h>
+#include <business/videoanalysis/videoframereader.h>
+#include <data/storage/imagefileshandler.h>
+
+
+VideoComparisonInteractor::VideoComparisonInteractor(const QString &firstVideoPath,
+                                                     const QString &secondVideoPath,
+                                                     QObject *parent
+                                                     )
+    : QObject(parent),
+    mFirstVideoPath(firstVideoPath),
+    mSecondVideoPath(secondVideoPath),
+    mTotalFrames(0),
+    mFrameRate(0.0),
+    mComparators({ VideoFrameComparator::PixelDifference,
+                   VideoFrameComparator::Brightness,
+                   VideoFrameComparator::Contrast })
+{
+}
+
+VideoComparisonInteractor::~VideoComparisonInteractor() {
+    mWorkers.cancel();
+    mWorkers.stopThreads();
+}
+
+void VideoComparisonInteractor::setComparators(const QList<VideoFrameComparator> &comparators) {
+    mComparators = comparators;
+}
+
+QList<VideoFrameComparator> VideoComparisonInteractor::getComparators() const {
+    return mComparators;
+}
+
+void VideoComparisonInteractor::start() {
+    if (mComparators.isEmpty()) {
+        throw std::runtime_error("Error: select at least one comparator.");
+    }
+    VideoFrameReader firstReader { mFirstVideoPath };
+    VideoFrameReader secondReader { mSecondVideoPath };
+    firstReader.open();
+    secondReader.open();
+
+    // Both videos are sampled on the timeline of the first one. If the second video
+    // has a different frame rate, the frame visible at the same moment is compared.
+    mFrameRate = firstReader.getFrameRate();
+    qint64 duration = qMin(firstReader.getDuration(), secondReader.getDuration());
+    mTotalFrames = static_cast<int>(duration * mFrameRate / 1000.0);
+    if (mTotalFrames <= 0) {
+        throw std::runtime_error("Error: the videos do not contain any frames to compare.");
+    }
+
+    mWorkers.reset();
+    mFirstQueue = mWorkers.createQueue(mFrameQueueCapacity);
+    mSecondQueue = mWorkers.createQueue(mFrameQueueCapacity);
+
+    mWorkers.createThread([this]() {
+        mWorkers.decodeVideo(mFirstVideoPath, mFrameRate, 0, mTotalFrames - 1, 1, mFirstQueue);
+    });
+    mWorkers.createThread([this]() {
+        mWorkers.decodeVideo(mSecondVideoPath, mFrameRate, 0, mTotalFrames - 1, 1, mSecondQueue);
+    });
+    QThread *comparisonThread = mWorkers.createThread([this]() {
+        compareFrames();
+    });
+
+    connect(comparisonThread,
+            &QThread::finished,
+            this,
+            &VideoComparisonInteractor::onComparisonThreadFinished
+            );
+
+    mWorkers.startThreads();
+}
+
+void VideoComparisonInteractor::cancel() {
+    mWorkers.cancel();
+}
+
+int VideoComparisonInteractor::getTotalFrames() const {
+    return mTotalFrames;
+}
+
+double VideoComparisonInteractor::getFrameRate() const {
+    return mFrameRate;
+}
+
+qint64 VideoComparisonInteractor::getFramePosition(int frameIndex) const {
+    return VideoFrameReader::getFramePosition(frameIndex, mFrameRate);
+}
+
+QPair<QString, QString> VideoComparisonInteractor::saveFramePairAsTemporary(int frameIndex) {
+    if (frameIndex < 0 || frameIndex >= mTotalFrames) {
+        throw std::runtime_error("Error: incorrect frame number.");
+    }
+    qint64 position = getFramePosition(frameIndex);
+
+    VideoFrameReader firstReader { mFirstVideoPath };
+    VideoFrameReader secondReader { mSecondVideoPath };
+    firstReader.open();
+    secondReader.open();
+    QImage firstFrame = firstReader.readFrameAt(position);
+    QImage secondFrame = secondReader.readFrameAt(position);
+
+    ImageFilesHandler imageFilesHandler;
+    QString firstPath = imageFilesHandler.saveImageAsTemporary(firstFrame);
+    QString secondPath = imageFilesHandler.saveImageAsTemporary(secondFrame);
+    return { firstPath, secondPath };
+}
+
+/* Worker threads { */
+
+void VideoComparisonInteractor::compareFrames() {
+    while (!mWorkers.isCanceled()) {
+        auto firstFrame = mFirstQueue->pop();
+        auto secondFrame = mSecondQueue->pop();
+        if (!firstFrame || !secondFrame) {
+            break;
+        }
+        auto metrics = FramePairMetricsCalculator::calculate(firstFrame->frameIndex,
+                                                             firstFrame->positionMs,
+                                                             firstFrame->image,
+                                                             secondFrame->image,
+                                                             mComparators
+                                                             );
+        emit frameMetricsCalculated(metrics);
+    }
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+void VideoComparisonInteractor::onComparisonThreadFinished() {
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit comparisonFailed(error);
+    } else if (!mWorkers.isCanceled()) {
+        emit comparisonFinished();
+    }
+}
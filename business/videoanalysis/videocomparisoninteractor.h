@@ -0,0 +1,76 @@
+#ifndef VIDEOCOMPARISONINTERACTOR_H
+#define VIDEOCOMPARISONINTERACTOR_H
+
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <memory>
+#include <business/videoanalysis/videoanalysisworkers.h>
+#include <domain/valueobjects/videoframemetrics.h>
+
+class BoundedFrameQueue;
+
+// Compares two videos frame by frame. Each video is decoded in its own worker
+// thread; the decoders step through the clips in lockstep and hand the frames
+// over to a third thread through small bounded queues. The third thread feeds
+// every frame pair through the selected comparators and reports the metrics via
+// signals, so the UI can draw the timeline while the comparison is still running.
+
+class VideoComparisonInteractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    VideoComparisonInteractor(const QString &firstVideoPath,
+                              const QString &secondVideoPath,
+                              QObject *parent = nullptr
+                              );
+    ~VideoComparisonInteractor();
+
+    // The comparators of the frame pairs, all of them by default. Only the
+    // metrics of the selected comparators are calculated.
+    void setComparators(const QList<VideoFrameComparator> &comparators);
+    QList<VideoFrameComparator> getComparators() const;
+
+    // Reads the metadata of both videos and starts the worker threads. Throws
+    // std::runtime_error if the videos cannot be opened or no comparator is selected.
+    void start();
+    void cancel();
+
+    int getTotalFrames() const;
+    double getFrameRate() const;
+    qint64 getFramePosition(int frameIndex) const;
+
+    // Decodes the given frame pair again and saves it in the Temp directory,
+    // so it can be opened in the main window. It opens its own readers, so it
+    // may be called from any thread. Throws std::runtime_error.
+    QPair<QString, QString> saveFramePairAsTemporary(int frameIndex);
+
+signals:
+    void frameMetricsCalculated(const VideoFrameMetrics &metrics);
+    void comparisonFinished();
+    void comparisonFailed(const QString &error);
+
+private slots:
+    void onComparisonThreadFinished();
+
+private:
+    // Three frames per queue let a decoder work on the next frame while the
+    // previous one waits and a pair is being compared; larger values only
+    // increase the memory footprint.
+    const int mFrameQueueCapacity = 3;
+
+    QString mFirstVideoPath;
+    QString mSecondVideoPath;
+    int mTotalFrames;
+    double mFrameRate;
+    QList<VideoFrameComparator> mComparators;
+    std::shared_ptr<BoundedFrameQueue> mFirstQueue;
+    std::shared_ptr<BoundedFrameQueue> mSecondQueue;
+    VideoAnalysisWorkers mWorkers;
+
+    void compareFrames();
+};
+
+#endif // VIDEOCOMPARISONINTERACTOR_H
@@ -0,0 +1,163 @@
+#include "videoframereader.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QMediaMetaData>
+#include <QMediaPlayer>
+#include <QTimer>
+#include <QUrl>
+#include <QVideoFrame>
+#include <QVideoSink>
+#include <functional>
+
+
+namespace {
+
+// Runs the event loop of the current thread until the condition is met or the
+// timeout expires. The loop sleeps while there are no events: the caller connects
+// the signals that may change the condition to QEventLoop::quit of the loop.
+bool waitUntil(QEventLoop &loop, const std::function<bool()> &condition, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    while (!condition()) {
+        qint64 remainingMs = timeoutMs - timer.elapsed();
+        if (remainingMs <= 0) {
+            return false;
+        }
+        timeout.start(static_cast<int>(remainingMs));
+        loop.exec();
+    }
+    return true;
+}
+
+}
+
+VideoFrameReader::VideoFrameReader(const QString &videoPath)
+    : mVideoPath(videoPath),
+    mMediaPlayer(nullptr),
+    mVideoSink(nullptr),
+    mDuration(0),
+    mFrameRate(mDefaultFrameRate),
+    mLastPosition(-1),
+    mLastFrameStartTime(-1)
+{
+}
+
+VideoFrameReader::~VideoFrameReader() {
+    if (mMediaPlayer != nullptr) {
+        mMediaPlayer->stop();
+        delete mMediaPlayer;
+        mMediaPlayer = nullptr;
+    }
+    if (mVideoSink != nullptr) {
+        delete mVideoSink;
+        mVideoSink = nullptr;
+    }
+}
+
+void VideoFrameReader::open() {
+    mMediaPlayer = new QMediaPlayer();
+    mVideoSink = new QVideoSink();
+    mMediaPlayer->setVideoSink(mVideoSink);
+
+    QEventLoop loop;
+    QObject::connect(mMediaPlayer, &QMediaPlayer::mediaStatusChanged, &loop, &QEventLoop::quit);
+    QObject::connect(mMediaPlayer, &QMediaPlayer::errorOccurred, &loop, &QEventLoop::quit);
+    mMediaPlayer->setSource(QUrl::fromLocalFile(mVideoPath));
+
+    bool isLoaded = waitUntil(loop, [this]() {
+        auto status = mMediaPlayer->mediaStatus();
+        return status == QMediaPlayer::LoadedMedia ||
+               status == QMediaPlayer::InvalidMedia ||
+               mMediaPlayer->error() != QMediaPlayer::NoError;
+    }, mTimeoutMs);
+
+    if (!isLoaded || mMediaPlayer->mediaStatus() != QMediaPlayer::LoadedMedia) {
+        QString error = QString("Error: unable to open the video %1.").arg(mVideoPath);
+        throw std::runtime_error(error.toStdString());
+    }
+
+    mDuration = mMediaPlayer->duration();
+    QVariant frameRate = mMediaPlayer->metaData().value(QMediaMetaData::VideoFrameRate);
+    if (frameRate.isValid() && frameRate.toDouble() > 0.0) {
+        mFrameRate = frameRate.toDouble();
+    }
+
+    // A paused player renders a frame after every seek, which is
+    // what makes frame-by-frame reading possible.
+    mMediaPlayer->pause();
+}
+
+QString VideoFrameReader::getVideoPath() const {
+    return mVideoPath;
+}
+
+qint64 VideoFrameReader::getDuration() const {
+    return mDuration;
+}
+
+double VideoFrameReader::getFrameRate() const {
+    return mFrameRate;
+}
+
+int VideoFrameReader::getFrameCount() const {
+    return static_cast<int>(mDuration * mFrameRate / 1000.0);
+}
+
+qint64 VideoFrameReader::getFramePosition(int frameIndex, double frameRate) {
+    if (frameRate <= 0.0) {
+        return 0;
+    }
+    return static_cast<qint64>((frameIndex + 0.5) * 1000.0 / frameRate);
+}
+
+QImage VideoFrameReader::readFrameAt(qint64 positionMs) {
+    if (mMediaPlayer == nullptr) {
+        throw std::runtime_error("Error: the video is not opened.");
+    }
+    if (positionMs == mLastPosition && !mLastFrame.isNull()) {
+        return mLastFrame;
+    }
+
+    QVideoFrame receivedFrame;
+    bool isReceived = false;
+    QEventLoop loop;
+    auto connection = QObject::connect(mVideoSink,
+                                       &QVideoSink::videoFrameChanged,
+                                       &loop,
+                                       [&](const QVideoFrame &frame) {
+                                           if (frame.isValid()) {
+                                               receivedFrame = frame;
+                                               isReceived = true;
+                                               loop.quit();
+                                           }
+                                       });
+
+    mMediaPlayer->setPosition(positionMs);
+    bool isReady = waitUntil(loop, [&isReceived]() { return isReceived; }, mTimeoutMs);
+    QObject::disconnect(connection);
+
+    if (!isReady) {
+        QString error = QString("Error: unable to decode the frame at %1 ms of the video %2.")
+                            .arg(positionMs)
+                            .arg(mVideoPath);
+        throw std::runtime_error(error.toStdString());
+    }
+
+    QImage image = receivedFrame.toImage();
+    if (image.isNull()) {
+        throw std::runtime_error("Error: failed to convert the video frame to an image.");
+    }
+
+    mLastPosition = positionMs;
+    mLastFrameStartTime = receivedFrame.startTime();
+    mLastFrame = image.convertToFormat(QImage::Format_RGB32);
+    return mLastFrame;
+}
+
+qint64 VideoFrameReader::getLastFrameStartTime() const {
+    return mLastFrameStartTime;
+}
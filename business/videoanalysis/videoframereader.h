@@ -0,0 +1,63 @@
+#ifndef VIDEOFRAMEREADER_H
+#define VIDEOFRAMEREADER_H
+
+#include <QImage>
+#include <QString>
+
+class QMediaPlayer;
+class QVideoSink;
+
+// Decodes individual frames of a video by seeking a paused QMediaPlayer and
+// waiting for the frame to arrive in a QVideoSink. The reader runs a local
+// event loop while waiting, so it can be used from any thread, but it must be
+// created, used and destroyed in the same thread.
+//
+// Every frame costs a seek, even when the frames are read one after another:
+// QMediaPlayer can not step a paused video, and a playing one drops frames to
+// keep up with the clock, which would look like dropped frames of the capture.
+// So the analyses of whole clips run at the speed of the seeks and are usually
+// slower than real time for 4K videos.
+
+class VideoFrameReader
+{
+public:
+    explicit VideoFrameReader(const QString &videoPath);
+    ~VideoFrameReader();
+
+    VideoFrameReader(const VideoFrameReader&) = delete;
+    VideoFrameReader& operator=(const VideoFrameReader&) = delete;
+
+    // Loads the media and reads its metadata. Throws std::runtime_error on failure.
+    void open();
+
+    QString getVideoPath() const;
+    qint64 getDuration() const;
+    double getFrameRate() const;
+    int getFrameCount() const;
+
+    // The middle of the frame interval is used to avoid landing on the previous
+    // frame because of rounding errors in the timestamps.
+    static qint64 getFramePosition(int frameIndex, double frameRate);
+
+    // Returns the frame displayed at the given position. Throws std::runtime_error
+    // if the frame could not be decoded in time.
+    QImage readFrameAt(qint64 positionMs);
+
+    // The presentation timestamp (in microseconds) of the frame returned by the
+    // last readFrameAt() call, or -1 if the stream does not provide it.
+    qint64 getLastFrameStartTime() const;
+
+private:
+    const int mTimeoutMs = 5000;
+    const double mDefaultFrameRate = 25.0;
+    QString mVideoPath;
+    QMediaPlayer *mMediaPlayer;
+    QVideoSink *mVideoSink;
+    qint64 mDuration;
+    double mFrameRate;
+    qint64 mLastPosition;
+    qint64 mLastFrameStartTime;
+    QImage mLastFrame;
+};
+
+#endif // VIDEOFRAMEREADER_H
@@ -0,0 +1,134 @@
+#include "videooffsetfinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+
+VideoOffset VideoOffsetFinder::findOffset(const std::vector<float> &first,
+                                          const std::vector<float> &second,
+                                          int maxOffsetFrames
+                                          )
+{
+    if (static_cast<int>(first.size()) < mMinOverlap || static_cast<int>(second.size()) < mMinOverlap) {
+        throw std::runtime_error("Error: the videos are too short to be synchronized.");
+    }
+
+    auto coarseFirst = downsample(first, mCoarseFactor);
+    auto coarseSecond = downsample(second, mCoarseFactor);
+    if (static_cast<int>(coarseFirst.size()) < mMinOverlap ||
+        static_cast<int>(coarseSecond.size()) < mMinOverlap)
+    {
+        return findBestOffset(first, second, -maxOffsetFrames, maxOffsetFrames);
+    }
+
+    // Averaging blurs the peak (and repetitive content can produce several similar
+    // peaks), so a few of the best coarse candidates are refined, not just one.
+    int coarseMaxOffset = maxOffsetFrames / mCoarseFactor + 1;
+    std::vector<std::pair<double, int>> candidates;
+    for (int offset = -coarseMaxOffset; offset <= coarseMaxOffset; ++offset) {
+        candidates.push_back({ correlate(coarseFirst, coarseSecond, offset), offset });
+    }
+    int candidatesCount = std::min(static_cast<int>(candidates.size()), mCoarseCandidates);
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + candidatesCount,
+                      candidates.end(),
+                      [](const auto &a, const auto &b) { return a.first > b.first; }
+                      );
+
+    VideoOffset best;
+    best.correlation = std::numeric_limits<double>::lowest();
+    for (int i = 0; i < candidatesCount; ++i) {
+        int center = candidates[i].second * mCoarseFactor;
+        VideoOffset refined = findBestOffset(first,
+                                             second,
+                                             std::max(-maxOffsetFrames, center - 2 * mCoarseFactor),
+                                             std::min(maxOffsetFrames, center + 2 * mCoarseFactor)
+                                             );
+        if (refined.correlation > best.correlation) {
+            best = refined;
+        }
+    }
+    return best;
+}
+
+double VideoOffsetFinder::correlate(const std::vector<float> &first,
+                                    const std::vector<float> &second,
+                                    int offset
+                                    )
+{
+    int begin = std::max(0, -offset);
+    int end = std::min(static_cast<int>(first.size()), static_cast<int>(second.size()) - offset);
+    int count = end - begin;
+    if (count < mMinOverlap) {
+        return std::numeric_limits<double>::lowest();
+    }
+
+    double sum1 = 0.0;
+    double sum2 = 0.0;
+    for (int i = begin; i < end; ++i) {
+        sum1 += first[i];
+        sum2 += second[i + offset];
+    }
+    double mean1 = sum1 / count;
+    double mean2 = sum2 / count;
+
+    double covariance = 0.0;
+    double variance1 = 0.0;
+    double variance2 = 0.0;
+    for (int i = begin; i < end; ++i) {
+        double d1 = first[i] - mean1;
+        double d2 = second[i + offset] - mean2;
+        covariance += d1 * d2;
+        variance1 += d1 * d1;
+        variance2 += d2 * d2;
+    }
+
+    double denominator = std::sqrt(variance1 * variance2);
+    if (denominator < std::numeric_limits<double>::epsilon()) {
+        return 0.0; // at least one of the signals is constant over the overlap
+    }
+    return covariance / denominator;
+}
+
+std::vector<float> VideoOffsetFinder::downsample(const std::vector<float> &signal, int factor) {
+    std::vector<float> result;
+    result.reserve(signal.size() / factor + 1);
+    for (size_t i = 0; i < signal.size(); i += factor) {
+        size_t end = std::min(signal.size(), i + factor);
+        float sum = 0.0f;
+        for (size_t j = i; j < end; ++j) {
+            sum += signal[j];
+        }
+        result.push_back(sum / (end - i));
+    }
+    return result;
+}
+
+VideoOffset VideoOffsetFinder::findBestOffset(const std::vector<float> &first,
+                                              const std::vector<float> &second,
+                                              int fromOffset,
+                                              int toOffset
+                                              )
+{
+    VideoOffset best;
+    best.correlation = std::numeric_limits<double>::lowest();
+    for (int offset = fromOffset; offset <= toOffset; ++offset) {
+        double correlation = correlate(first, second, offset);
+        // Prefer the smallest shift when several offsets correlate equally well
+        bool isBetter = correlation > best.correlation ||
+                        (correlation == best.correlation &&
+                         std::abs(offset) < std::abs(best.offsetFrames));
+        if (isBetter) {
+            best.offsetFrames = offset;
+            best.correlation = correlation;
+        }
+    }
+    if (best.correlation == std::numeric_limits<double>::lowest()) {
+        best.offsetFrames = 0;
+        best.correlation = 0.0;
+    }
+    return best;
+}
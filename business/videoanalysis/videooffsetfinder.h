@@ -0,0 +1,51 @@
+#ifndef VIDEOOFFSETFINDER_H
+#define VIDEOOFFSETFINDER_H
+
+#include <vector>
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct VideoOffset {
+    int offsetFrames = 0;    // Frame i of the first video matches frame i + offsetFrames of the second one
+    double correlation = 0.0; // Normalized cross-correlation at the offset [-1, 1]
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// Finds the time offset between two per-frame signals (see VideoSignature) by
+// maximizing their normalized cross-correlation over the overlapping frames.
+// The search is coarse-to-fine: the signals are first averaged in blocks of
+// mCoarseFactor frames and all offsets are tried on the short signals, then the
+// best coarse offsets are refined frame by frame at full resolution. This keeps
+// hour-long captures fast without a Fourier transform.
+
+class VideoOffsetFinder
+{
+public:
+    VideoOffsetFinder() = delete;
+    ~VideoOffsetFinder() = delete;
+
+    static VideoOffset findOffset(const std::vector<float> &first,
+                                  const std::vector<float> &second,
+                                  int maxOffsetFrames
+                                  );
+
+    static double correlate(const std::vector<float> &first,
+                            const std::vector<float> &second,
+                            int offset
+                            );
+
+private:
+    static constexpr int mCoarseFactor = 8;
+    static constexpr int mCoarseCandidates = 8;
+    static constexpr int mMinOverlap = 8;
+
+    static std::vector<float> downsample(const std::vector<float> &signal, int factor);
+    static VideoOffset findBestOffset(const std::vector<float> &first,
+                                      const std::vector<float> &second,
+                                      int fromOffset,
+                                      int toOffset
+                                      );
+};
+
+#endif // VIDEOOFFSETFINDER_H
@@ -0,0 +1,56 @@
+#include "videosignature.h"
+
+#include <cstdlib>
+
+
+void VideoSignature::addFrame(const QImage &frame) {
+    std::vector<quint8> pixels = createThumbnail(frame, mThumbnailSize);
+
+    long totalLuma = 0;
+    for (auto pixel : pixels) {
+        totalLuma += pixel;
+    }
+    float count = pixels.empty() ? 1.0f : static_cast<float>(pixels.size());
+    mMeanLuma.push_back(totalLuma / count);
+    mMotion.push_back(calculateMotion(mPreviousThumbnail, pixels));
+    mPreviousThumbnail = std::move(pixels);
+}
+
+std::vector<quint8> VideoSignature::createThumbnail(const QImage &frame, int size) {
+    // A fast downscale to an intermediate size keeps the smooth
+    // scaling cheap even for 4K frames.
+    QImage thumbnail = frame.scaled(size * 8, size * 8, Qt::IgnoreAspectRatio, Qt::FastTransformation)
+                            .convertToFormat(QImage::Format_Grayscale8)
+                            .scaled(size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    std::vector<quint8> pixels;
+    pixels.reserve(size * size);
+    for (int y = 0; y < thumbnail.height(); ++y) {
+        const uchar *line = thumbnail.constScanLine(y);
+        pixels.insert(pixels.end(), line, line + thumbnail.width());
+    }
+    return pixels;
+}
+
+float VideoSignature::calculateMotion(const std::vector<quint8> &first, const std::vector<quint8> &second) {
+    if (first.size() != second.size() || first.empty()) {
+        return 0.0f; // e.g. there is no previous frame
+    }
+    long totalDifference = 0;
+    for (size_t i = 0; i < first.size(); ++i) {
+        totalDifference += std::abs(first[i] - second[i]);
+    }
+    return totalDifference / static_cast<float>(first.size());
+}
+
+int VideoSignature::size() const {
+    return static_cast<int>(mMotion.size());
+}
+
+const std::vector<float>& VideoSignature::getMotion() const {
+    return mMotion;
+}
+
+const std::vector<float>& VideoSignature::getMeanLuma() const {
+    return mMeanLuma;
+}
@@ -0,0 +1,42 @@
+#ifndef VIDEOSIGNATURE_H
+#define VIDEOSIGNATURE_H
+
+#include <QImage>
+#include <vector>
+
+// A compact per-frame description of a video used to align two captures in
+// time. Each frame is reduced to a tiny luminance thumbnail; only the thumbnail
+// of the previous frame is kept, and two floats are stored per frame:
+//  - the average luminance of the frame;
+//  - the motion energy, i.e. the mean absolute difference between the thumbnails
+//    of the frame and of the previous frame.
+// The memory footprint is therefore proportional to the number of frames and
+// does not depend on the resolution of the video.
+
+class VideoSignature
+{
+public:
+    VideoSignature() = default;
+    ~VideoSignature() = default;
+
+    void addFrame(const QImage &frame);
+
+    // Returns the pixels of a size x size grayscale thumbnail of the frame.
+    static std::vector<quint8> createThumbnail(const QImage &frame, int size);
+
+    // The mean absolute difference between two thumbnails of the same size.
+    static float calculateMotion(const std::vector<quint8> &first, const std::vector<quint8> &second);
+
+    int size() const;
+    const std::vector<float>& getMotion() const;
+    const std::vector<float>& getMeanLuma() const;
+
+private:
+    static constexpr int mThumbnailSize = 16;
+
+    std::vector<quint8> mPreviousThumbnail;
+    std::vector<float> mMotion;
+    std::vector<float> mMeanLuma;
+};
+
+#endif // VIDEOSIGNATURE_H
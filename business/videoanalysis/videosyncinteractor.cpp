@@ -0,0 +1,134 @@
+#include "videosyncinteractor.h"
+
+#include <QThread>
+#include <algorithm>
+#include <business/videoanalysis/videoframereader.h>
+
+
+VideoSyncInteractor::VideoSyncInteractor(const QString &firstVideoPath,
+                                         const QString &secondVideoPath,
+                                         QObject *parent
+                                         )
+    : QObject(parent),
+    mFirstVideoPath(firstVideoPath),
+    mSecondVideoPath(secondVideoPath),
+    mFrameRate(0.0),
+    mFirstFrameCount(0),
+    mSecondFrameCount(0),
+    mFinishedDecoders(0),
+    mDecodedFrames(0)
+{
+}
+
+VideoSyncInteractor::~VideoSyncInteractor() {
+    mWorkers.cancel();
+    mWorkers.stopThreads();
+}
+
+void VideoSyncInteractor::start() {
+    VideoFrameReader firstReader { mFirstVideoPath };
+    VideoFrameReader secondReader { mSecondVideoPath };
+    firstReader.open();
+    secondReader.open();
+
+    // Both videos are sampled on the timeline of the first one,
+    // so the signatures are comparable even if the frame rates differ.
+    mFrameRate = firstReader.getFrameRate();
+    mFirstFrameCount = static_cast<int>(firstReader.getDuration() * mFrameRate / 1000.0);
+    mSecondFrameCount = static_cast<int>(secondReader.getDuration() * mFrameRate / 1000.0);
+
+    mWorkers.reset();
+    mFinishedDecoders = 0;
+    mDecodedFrames = 0;
+
+    QThread *firstDecoderThread = mWorkers.createThread([this]() {
+        decodeVideo(mFirstVideoPath, mFirstFrameCount, mFirstSignature);
+    });
+    QThread *secondDecoderThread = mWorkers.createThread([this]() {
+        decodeVideo(mSecondVideoPath, mSecondFrameCount, mSecondSignature);
+    });
+
+    connect(firstDecoderThread, &QThread::finished, this, &VideoSyncInteractor::onDecoderThreadFinished);
+    connect(secondDecoderThread, &QThread::finished, this, &VideoSyncInteractor::onDecoderThreadFinished);
+
+    mWorkers.startThreads();
+}
+
+void VideoSyncInteractor::cancel() {
+    mWorkers.cancel();
+}
+
+/* Worker threads { */
+
+void VideoSyncInteractor::decodeVideo(const QString &videoPath,
+                                      int frameCount,
+                                      VideoSignature &signature
+                                      )
+{
+    VideoFrameReader reader { videoPath };
+    reader.open();
+    int totalFrames = mFirstFrameCount + mSecondFrameCount;
+    int lastPercent = -1;
+    for (int i = 0; i < frameCount && !mWorkers.isCanceled(); ++i) {
+        qint64 position = VideoFrameReader::getFramePosition(i, mFrameRate);
+        signature.addFrame(reader.readFrameAt(position));
+
+        int percent = static_cast<int>(100.0 * ++mDecodedFrames / std::max(1, totalFrames));
+        if (percent != lastPercent) {
+            lastPercent = percent;
+            emit progressChanged(percent);
+        }
+    }
+}
+
+void VideoSyncInteractor::findOffset() {
+    // Motion energy is a good fingerprint of the content, but it is flat for
+    // static scenes; in that case the average brightness is correlated instead.
+    int maxOffset = std::min(mFirstSignature.size(), mSecondSignature.size()) / 2;
+    VideoOffset offset = VideoOffsetFinder::findOffset(mFirstSignature.getMotion(),
+                                                       mSecondSignature.getMotion(),
+                                                       maxOffset
+                                                       );
+    if (offset.correlation <= 0.0) {
+        offset = VideoOffsetFinder::findOffset(mFirstSignature.getMeanLuma(),
+                                               mSecondSignature.getMeanLuma(),
+                                               maxOffset
+                                               );
+    }
+    mOffset = offset;
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+void VideoSyncInteractor::onDecoderThreadFinished() {
+    if (++mFinishedDecoders < 2) {
+        return;
+    }
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit syncFailed(error);
+        return;
+    }
+    if (mWorkers.isCanceled()) {
+        return;
+    }
+    QThread *correlationThread = mWorkers.createThread([this]() {
+        findOffset();
+    });
+    connect(correlationThread, &QThread::finished, this, &VideoSyncInteractor::onCorrelationThreadFinished);
+    mWorkers.startThreads();
+}
+
+void VideoSyncInteractor::onCorrelationThreadFinished() {
+    QString error = mWorkers.getError();
+    if (!error.isEmpty()) {
+        emit syncFailed(error);
+        return;
+    }
+    if (mWorkers.isCanceled()) {
+        return;
+    }
+    // Frame i of the first video matches frame i + offsetFrames of the second one
+    qint64 offsetMs = static_cast<qint64>(mOffset.offsetFrames * 1000.0 / mFrameRate);
+    emit syncFinished(offsetMs, mOffset.correlation);
+}
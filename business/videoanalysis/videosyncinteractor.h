@@ -0,0 +1,61 @@
+#ifndef VIDEOSYNCINTERACTOR_H
+#define VIDEOSYNCINTERACTOR_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <business/videoanalysis/videoanalysisworkers.h>
+#include <business/videoanalysis/videooffsetfinder.h>
+#include <business/videoanalysis/videosignature.h>
+
+// Finds the time offset between two captures of the same content. Both videos
+// are read in a streaming pass on their own worker threads and reduced to
+// per-frame signatures (see VideoSignature); the offset is then found by
+// cross-correlating the signatures (see VideoOffsetFinder) on a third thread.
+
+class VideoSyncInteractor : public QObject
+{
+    Q_OBJECT
+
+public:
+    VideoSyncInteractor(const QString &firstVideoPath,
+                        const QString &secondVideoPath,
+                        QObject *parent = nullptr
+                        );
+    ~VideoSyncInteractor();
+
+    // Reads the metadata of both videos and starts the worker threads.
+    // Throws std::runtime_error if the videos cannot be opened.
+    void start();
+    void cancel();
+
+signals:
+    void progressChanged(int percent);
+
+    // A positive offset means that the content of the first video appears
+    // in the second video offsetMs milliseconds later.
+    void syncFinished(qint64 offsetMs, double correlation);
+    void syncFailed(const QString &error);
+
+private slots:
+    void onDecoderThreadFinished();
+    void onCorrelationThreadFinished();
+
+private:
+    QString mFirstVideoPath;
+    QString mSecondVideoPath;
+    double mFrameRate;
+    int mFirstFrameCount;
+    int mSecondFrameCount;
+    VideoSignature mFirstSignature;
+    VideoSignature mSecondSignature;
+    VideoOffset mOffset;
+    int mFinishedDecoders;
+    std::atomic<int> mDecodedFrames;
+    VideoAnalysisWorkers mWorkers;
+
+    void decodeVideo(const QString &videoPath, int frameCount, VideoSignature &signature);
+    void findOffset();
+};
+
+#endif // VIDEOSYNCINTERACTOR_H
@@ -108,10 +108,64 @@ std::optional<QString> FileDialogHandler::getUserOpenImagePath(const QString &ba
     return std::make_optional<QString>(firstPath);
 }
 
+std::optional<QString> FileDialogHandler::getUserOpenVideoPath(const QString &baseDir) {
+    QFileDialog dialog;
+    QString path;
+    dialog.setViewMode(QFileDialog::Detail);
+    dialog.setWindowTitle("Open Video");
+    dialog.setNameFilter(mVideoFilter);
+    dialog.setModal(true);
+    dialog.setFileMode(QFileDialog::ExistingFile);
+    dialog.setAcceptMode(QFileDialog::AcceptOpen);
+
+    if (baseDir.isEmpty()) {
+        dialog.setDirectory(QDir::homePath());
+    } else {
+        dialog.setDirectory(baseDir);
+    }
+
+    if (dialog.exec() == QDialog::Accepted) {
+        QStringList fileNames = dialog.selectedFiles();
+        if (fileNames.size() == 0) {
+            showWarningMessage("You have not selected any video file.");
+            return std::nullopt;
+        }
+        else if (fileNames.size() == 1) {
+            path = dialog.selectedFiles().constFirst();
+        }
+    } else {
+        return std::nullopt;
+    }
+    if (path.isEmpty() || !validateVideoFile(path)) {
+        return std::nullopt;
+    }
+
+    return std::make_optional<QString>(path);
+}
+
 OptionalStringPair FileDialogHandler::getUserOpenTwoImagePaths(const QString &baseDir) {
     return getUserOpenTwoFilePaths(baseDir, PathType::Image);
 }
 
+std::optional<QString> FileDialogHandler::getUserOutputDirectory(const QString &baseDir) {
+    QFileDialog dialog;
+    dialog.setWindowTitle("Select Output Directory");
+    dialog.setModal(true);
+    dialog.setFileMode(QFileDialog::Directory);
+    dialog.setOption(QFileDialog::ShowDirsOnly, true);
+
+    if (baseDir.isEmpty()) {
+        dialog.setDirectory(QDir::homePath());
+    } else {
+        dialog.setDirectory(baseDir);
+    }
+
+    if (dialog.exec() != QDialog::Accepted || dialog.selectedFiles().isEmpty()) {
+        return std::nullopt;
+    }
+    return dialog.selectedFiles().constFirst();
+}
+
 OptionalStringPair FileDialogHandler::getUserOpenTwoVideoPaths(const QString &baseDir) {
     return getUserOpenTwoFilePaths(baseDir, PathType::Video);
 }
@@ -17,6 +17,8 @@ public:
     OptionalStringPair getUserOpenTwoImagePaths(const QString &baseDir);
     std::optional<QString> getUserOpenImagePath(const QString &baseDir);
     OptionalStringPair getUserOpenTwoVideoPaths(const QString &baseDir);
+    std::optional<QString> getUserOpenVideoPath(const QString &baseDir);
+    std::optional<QString> getUserOutputDirectory(const QString &baseDir);
 
 private:
     enum class PathType { Image, Report, Video };
@@ -10,6 +10,7 @@
 #include <domain/valueobjects/images.h>
 #include <business/utils/imagesinfo.h>
 #include <business/validation/imagevalidationrulesfactory.h>
+#include <data/storage/internalimagefile.h>
 #include <data/storage/stb_image.h>
 
 // The user can drag and drop one or two images into the application window.
@@ -75,6 +76,9 @@ ImageHolderPtr ImageFilesHandler::openImage(const QString &imagePath) {
 }
 
 QPixmap ImageFilesHandler::coreOpenImage(const QString &imagePath) {
+    if (InternalImageFile::isInternalImageFile(imagePath)) {
+        return QPixmap::fromImage(InternalImageFile::load(imagePath));
+    }
     int width, height, channels;
     unsigned char* data = stbi_load(imagePath.toStdString().c_str(),
                                     &width,
@@ -110,12 +114,16 @@ void ImageFilesHandler::validateImages(ImageHolderPtr images) {
 }
 
 QString ImageFilesHandler::saveImageAsTemporary(const QPixmap &image) {
+    return saveImageAsTemporary(image.toImage());
+}
+
+QString ImageFilesHandler::saveImageAsTemporary(const QImage &image) {
     auto extentionValidator = ImageValidationRulesFactory::createImageExtensionsInfoProvider();
-    QString ext = extentionValidator->getDeafaultSaveExtension(true);
+    QString ext = extentionValidator->getTemporaryImageExtension(true);
     QString uniqueName = QUuid::createUuid().toString(QUuid::WithoutBraces) + ext;
     QString tempDir = QDir::tempPath();
     QString filePath = QDir(tempDir).filePath(uniqueName);
-    if (image.save(filePath)) {
+    if (InternalImageFile::save(image, filePath)) {
         return filePath;
     }
     throw std::runtime_error("Unable to save the image in the Temp directory.");
@@ -183,7 +191,7 @@ std::optional<QString> ImageFilesHandler::saveImageAs(const SaveImageInfo &saveI
     }
     isSaved = saveImageInfo.mImage.save(savePath.value());
     if (!isSaved) {
-        throw std::runtime_error("QPixmap::save(QString) returns false."); // for qDebug()
+        throw std::runtime_error("QImage::save(QString) returns false."); // for qDebug()
     }
     return fullPath;
 }
@@ -29,8 +29,13 @@ public:
                                        );
     // }
 
+    // The image is saved in the internal format (see InternalImageFile),
+    // the file can be opened only by the application itself
     QString saveImageAsTemporary(const QPixmap &image);
 
+    // The same, but it does not use a pixmap, so it is safe outside the GUI thread
+    QString saveImageAsTemporary(const QImage &image);
+
 private:
     QPixmap coreOpenImage(const QString &imagePath);
     bool validateFile(const QString &filePath);
@@ -0,0 +1,58 @@
+#include "internalimagefile.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <stdexcept>
+#include <domain/valueobjects/compressedimage.h>
+
+
+bool InternalImageFile::save(const QImage &image, const QString &filePath) {
+    if (image.isNull()) {
+        return false;
+    }
+    QSaveFile file { filePath };
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream stream { &file };
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << mMagic << mVersion;
+    CompressedImage::compress(image).write(stream);
+    if (stream.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+QImage InternalImageFile::load(const QString &filePath) {
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(QString("Unable to open " + filePath + ".").toStdString());
+    }
+    QDataStream stream { &file };
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic;
+    quint32 version;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != mMagic || version != mVersion) {
+        throw std::runtime_error(QString("Unable to open " + filePath + ". The file is corrupted.").toStdString());
+    }
+    QImage image = CompressedImage::read(stream).decompress();
+    if (image.isNull()) {
+        throw std::runtime_error(QString("Unable to open " + filePath + ". The file is corrupted.").toStdString());
+    }
+    return image;
+}
+
+bool InternalImageFile::isInternalImageFile(const QString &filePath) {
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream stream { &file };
+    quint32 magic = 0;
+    stream >> magic;
+    return stream.status() == QDataStream::Ok && magic == mMagic;
+}
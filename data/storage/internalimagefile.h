@@ -0,0 +1,35 @@
+#ifndef INTERNALIMAGEFILE_H
+#define INTERNALIMAGEFILE_H
+
+#include <QImage>
+#include <QString>
+
+// The format of the temporary image files that the application writes only to read
+// them back itself: an image from the clipboard, a cropped area opened in a new
+// instance, frames extracted from videos. PNG spends most of the time in zlib both
+// when such a file is written and when it is read again, so the pixels are stored
+// as a CompressedImage instead (the QOI way for 32-bit images, coded in parallel).
+//
+// The file is a header (magic, version) followed by the serialized CompressedImage.
+// User-facing saves and reports stay in PNG.
+
+class InternalImageFile
+{
+public:
+    InternalImageFile() = delete;
+    ~InternalImageFile() = delete;
+
+    static bool save(const QImage &image, const QString &filePath);
+
+    // Throws std::runtime_error if the file cannot be read or is corrupted
+    static QImage load(const QString &filePath);
+
+    // Checks the header, not the extension
+    static bool isInternalImageFile(const QString &filePath);
+
+private:
+    static constexpr quint32 mMagic = 0x54575058; // "TWPX"
+    static constexpr quint32 mVersion = 1;
+};
+
+#endif // INTERNALIMAGEFILE_H
@@ -15,6 +15,30 @@ bool IComparator::isPartOfAutoReportingToolbox() {
     return true;
 }
 
+bool IComparator::isDifferenceBased() const {
+    return false;
+}
+
+EstimationMethod IComparator::getEstimationMethod() const {
+    return EstimationMethod::None;
+}
+
+bool IComparator::isPreviewSupported() const {
+    return false;
+}
+
+QImage IComparator::renderPreview(const DifferencePlane &, const QList<Property> &, const QRect &) const {
+    return {};
+}
+
+bool IComparator::isTileRenderingSupported() const {
+    return false;
+}
+
+QImage IComparator::renderTile(const ComparableImage &, const ComparableImage &, const QRect &) const {
+    return {};
+}
+
 bool IComparator::isEnabled() {
     return m_isEnabled;
 }
@@ -7,6 +7,15 @@
 #include <domain/valueobjects/comparisonresultvariant.h>
 #include <domain/interfaces/business/imageprocessor.h>
 
+// How a quick estimate of a string result is calculated for large images
+// before the exact result is ready (see ComparisonEstimator). The results that
+// depend on the neighbors of the pixels, e.g. the sharpness, change with the
+// scale of the image, so they are not estimated.
+enum class EstimationMethod {
+    None,        // Only the exact result is calculated
+    PixelSample  // The result is a statistic of independent pixels, so a stratified sample of them is compared
+};
+
 /*
  * A base class for all comparators' interfaces in the app
  */
@@ -29,6 +38,36 @@ public:
     // the 'properties' mechanism in any way.
     virtual bool isPartOfAutoReportingToolbox();
 
+    // A difference-based comparator only shows how the images differ, so it has
+    // nothing to show for identical images. For such a comparator identical images
+    // are reported immediately instead of calling compare().
+    virtual bool isDifferenceBased() const;
+
+    // A comparator with a string result can be estimated quickly on a part of
+    // the pixels of large images. The result should have metrics then
+    // (see ComparisonMetric), so the estimate has confidence intervals.
+    virtual EstimationMethod getEstimationMethod() const;
+
+    // A comparator that can render its result from the difference plane of the
+    // images (see DifferencePlane) can show a live preview while the user edits
+    // its properties. renderPreview() must be fast: it is called for every visible
+    // tile of the preview after each change, so it renders only the given area. The
+    // tiles are rendered on several threads at once, so it must not change the comparator.
+    virtual bool isPreviewSupported() const;
+    virtual QImage renderPreview(const DifferencePlane &differencePlane,
+                                 const QList<Property> &properties,
+                                 const QRect &area) const;
+
+    // A comparator with an image result of the size of the images that can render
+    // any area of it on its own is streamed: the tiles of the result are rendered in
+    // parallel and shown as soon as they are ready, the visible ones first
+    // (see TiledImageBuffer). renderTile() is called from several threads at once,
+    // so it must not change the comparator; the result has the size of the area.
+    virtual bool isTileRenderingSupported() const;
+    virtual QImage renderTile(const ComparableImage &first,
+                              const ComparableImage &second,
+                              const QRect &area) const;
+
     bool isEnabled();
 
     void setEnabled(bool isEnabled);
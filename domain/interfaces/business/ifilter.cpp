@@ -1,5 +1,7 @@
 #include "ifilter.h"
 
+#include <stdexcept>
+
 QList<Property> IFilter::getDefaultProperties() const {
     return {};
 }
@@ -7,6 +9,14 @@ QList<Property> IFilter::getDefaultProperties() const {
 void IFilter::setProperties(QList<Property>) {
 }
 
+bool IFilter::isPerPixel() const {
+    return false;
+}
+
+void IFilter::filterRow(QRgb *, int) const {
+    throw std::runtime_error("Error: The filter cannot be applied to a row of pixels.");
+}
+
 ImageProcessorType IFilter::getType() const {
     return ImageProcessorType::Filter;
 }
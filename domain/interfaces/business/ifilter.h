@@ -14,6 +14,14 @@ class IFilter : public IImageProcessor {
 public:
     virtual QImage filter(const QImage &image) = 0;
 
+    // A per-pixel filter changes every pixel independently of the others, so it
+    // can change a row of a Format_ARGB32 or Format_RGB32 image in place; it must
+    // keep opaque pixels opaque. Consecutive per-pixel
+    // filters are applied in a single pass over the image (see FilterPipeline).
+    // filterRow() may be called from several threads at the same time.
+    virtual bool isPerPixel() const;
+    virtual void filterRow(QRgb *pixels, int count) const;
+
     virtual QList<Property> getDefaultProperties() const override;
 
     virtual void setProperties(QList<Property>) override;;
@@ -30,6 +30,11 @@ public:
     virtual QString getFullName() const = 0;
 
     virtual void reset();
+
+    // A copy with the same properties. The processors registered in ImageProcessorsManager
+    // are shared by all windows, so a window changes and runs its own copies, and a copy
+    // that runs in another thread is not changed while it runs.
+    virtual std::shared_ptr<IImageProcessor> clone() const = 0;
 };
 
 typedef std::shared_ptr<IImageProcessor> IImageProcessorPtr;
@@ -85,6 +90,12 @@ Compare the proximity of two images to an original image
 
 Fit In View                                                                                             F
 
+Bands of rows in which the images differ (Comparator)                                                   W
+
+Structural similarity, SSIM / MS-SSIM (Text) (Comparator)                                               I
+
+Structural similarity, SSIM heatmap (Image) (Comparator)                                                J
+
 
 */
 
@@ -2,7 +2,14 @@
 #define IMAGEPROCESSINGINTERACTORLISTENER_H
 
 #include <qpixmap.h>
+#include <QFuture>
+#include <functional>
 #include "domain/valueobjects/images.h"
+#include <domain/valueobjects/tiledimagebuffer.h>
+
+// Renders the given area (in image coordinates) of a comparison preview.
+// The result has the size of the area; a null image means there is nothing to show.
+typedef std::function<QImage(const QRect &area)> ComparisonPreviewRenderer;
 
 class IImageProcessingInteractorListener {
 public:
@@ -13,6 +20,28 @@ public:
                                           const QString &firstImagePath,
                                           const QString &secondImagePath) = 0;
 
+    /*
+     * For large images a comparator with a string result is estimated first
+     * (see ComparisonEstimator). The estimate is shown at once and is replaced
+     * by the exact result when the future is ready; the future rethrows the
+     * exception of the comparator if it fails. The future is canceled if the
+     * result is no longer needed, e.g. when the window is closed.
+     */
+    virtual void onComparisonResultEstimated(const QString &estimateHtml,
+                                             const QFuture<QString> &exactHtml,
+                                             const QString &comparatorFullName,
+                                             const QString &firstImagePath,
+                                             const QString &secondImagePath) = 0;
+
+    /*
+     * A comparator that supports tile rendering (see IComparator::isTileRenderingSupported)
+     * fills the buffer in the background. The finished tiles are shown at once; the
+     * listener reports the finished (or failed) buffer back through
+     * ImageProcessingInteractor::finishComparisonImageStream(), and the whole image
+     * is loaded then as a usual comparison result.
+     */
+    virtual void onComparisonImageStreamStarted(const TiledImageBufferPtr &buffer) = 0;
+
     virtual void onFilteredResultLoaded(const ImageHolderPtr imageHolder) = 0;
     virtual void onShowImageInExternalViewer(const QPixmap &image, const QString &description) = 0;
     virtual void onImageProcessorFailed(const QString &error) = 0;
@@ -27,6 +56,23 @@ public:
      *
      */
     virtual void onFastSwitchingToComparisonImageStatusChanged(bool isSwitchingAvailable) = 0;
+
+    /*
+     * While the user edits the properties of a comparator that supports
+     * a preview (see IComparator::isPreviewSupported), the result is shown
+     * over the images and is updated on every change of the properties.
+     * The preview is rendered lazily, only for the visible area.
+     */
+    virtual void onComparisonPreviewChanged(const ComparisonPreviewRenderer &renderer) = 0;
+    virtual void onComparisonPreviewFinished() = 0;
+
+    /*
+     * The live comparison overlay shows the result of an image comparator over
+     * the images while the user browses them (see ImageProcessingInteractor::
+     * setLiveComparisonOverlayEnabled). It is rendered lazily like the preview;
+     * a null renderer hides it.
+     */
+    virtual void onLiveComparisonOverlayChanged(const ComparisonPreviewRenderer &renderer) = 0;
 };
 
 #endif // IMAGEPROCESSINGINTERACTORLISTENER_H
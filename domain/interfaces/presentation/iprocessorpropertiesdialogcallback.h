@@ -1,13 +1,19 @@
 #ifndef IPROCESSORPROPERTIESDIALOGCALLBACK_H
 #define IPROCESSORPROPERTIESDIALOGCALLBACK_H
 
+#include <functional>
 #include <domain/valueobjects/property.h>
 
+// Called with the current values every time the user changes a property
+typedef std::function<void(const QList<Property> &properties)> PropertiesChangedCallback;
+
 class IPropcessorPropertiesDialogCallback {
 public:
     virtual QList<Property> showImageProcessorPropertiesDialog(const QString &processorName,
                                                                const QString &processorDescription,
-                                                               const QList<Property> &defaultProperties) = 0;
+                                                               const QList<Property> &defaultProperties,
+                                                               const PropertiesChangedCallback &onPropertiesChanged = nullptr
+                                                               ) = 0;
 };
 
 #endif // IPROCESSORPROPERTIESDIALOGCALLBACK_H
@@ -0,0 +1,275 @@
+#include "pixelkernels.h"
+#include "scalarkernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace {
+
+std::atomic<const PixelKernelTable*> activeKernelTable { nullptr };
+std::atomic<KernelIsa> activeIsa { KernelIsa::Scalar };
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+// The CPU must support the instructions and the OS must save the wide registers
+bool isCpuFeatureSupported(int leaf, int registerIndex, int bit, unsigned long long osMask) {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < leaf) {
+        return false;
+    }
+    __cpuidex(info, leaf, 0);
+    if ((info[registerIndex] & (1 << bit)) == 0) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool hasXsave = (info[2] & (1 << 27)) != 0;
+    return osMask == 0 || (hasXsave && (_xgetbv(0) & osMask) == osMask);
+}
+
+bool isAvx2Supported() {
+    return isCpuFeatureSupported(7, 1, 5, 0x6);
+}
+
+bool isAvx512Supported() {
+    return isCpuFeatureSupported(7, 1, 16, 0xE6) && isCpuFeatureSupported(7, 1, 30, 0xE6);
+}
+
+#elif defined(__x86_64__) || defined(__i386__)
+
+bool isAvx2Supported() {
+    return __builtin_cpu_supports("avx2");
+}
+
+bool isAvx512Supported() {
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+}
+
+#else
+
+bool isAvx2Supported() {
+    return false;
+}
+
+bool isAvx512Supported() {
+    return false;
+}
+
+#endif
+
+} // namespace
+
+/* Dispatch { */
+
+void PixelKernels::maxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count) {
+    getActiveKernelTable().maxChannelDifference(first, second, result, count);
+}
+
+void PixelKernels::grayscale(const QRgb *pixels, uchar *result, int count) {
+    getActiveKernelTable().grayscale(pixels, result, count);
+}
+
+void PixelKernels::luminance(const QRgb *pixels, uchar *result, int count) {
+    getActiveKernelTable().luminance(pixels, result, count);
+}
+
+void PixelKernels::extractChannel(const QRgb *pixels, uchar *result, int count, int shift) {
+    if (shift != 0 && shift != 8 && shift != 16 && shift != 24) {
+        throw std::runtime_error("Error: An incorrect channel was requested.");
+    }
+    getActiveKernelTable().extractChannel(pixels, result, count, shift);
+}
+
+quint64 PixelKernels::sum(const uchar *values, int count) {
+    return getActiveKernelTable().sum(values, count);
+}
+
+quint64 PixelKernels::sumOfSquares(const uchar *values, int count) {
+    return getActiveKernelTable().sumOfSquares(values, count);
+}
+
+void PixelKernels::histogram(const uchar *values, int count, quint64 *bins) {
+    getActiveKernelTable().histogram(values, count, bins);
+}
+
+QList<KernelIsa> PixelKernels::getSupportedIsas() {
+    QList<KernelIsa> isas { KernelIsa::Scalar };
+    if (getSse2KernelTable() != nullptr) {
+        isas.append(KernelIsa::Sse2);
+    }
+    if (getAvx2KernelTable() != nullptr && isAvx2Supported()) {
+        isas.append(KernelIsa::Avx2);
+    }
+    if (getAvx512KernelTable() != nullptr && isAvx512Supported()) {
+        isas.append(KernelIsa::Avx512);
+    }
+    if (getNeonKernelTable() != nullptr) {
+        isas.append(KernelIsa::Neon);
+    }
+    return isas;
+}
+
+KernelIsa PixelKernels::getActiveIsa() {
+    getActiveKernelTable(); // the best ISA is detected on the first call
+    return activeIsa;
+}
+
+QString PixelKernels::getIsaName(KernelIsa isa) {
+    switch (isa) {
+    case KernelIsa::Scalar:
+        return "Scalar";
+    case KernelIsa::Sse2:
+        return "SSE2";
+    case KernelIsa::Avx2:
+        return "AVX2";
+    case KernelIsa::Avx512:
+        return "AVX-512";
+    case KernelIsa::Neon:
+        return "NEON";
+    }
+    return "Unknown";
+}
+
+void PixelKernels::setActiveIsa(KernelIsa isa) {
+    if (!getSupportedIsas().contains(isa)) {
+        QString error = QString("Error: %1 is not supported by this CPU.").arg(getIsaName(isa));
+        throw std::runtime_error(error.toStdString());
+    }
+    activeIsa = isa;
+    activeKernelTable = getKernelTable(isa);
+}
+
+const PixelKernelTable* PixelKernels::getKernelTable(KernelIsa isa) {
+    switch (isa) {
+    case KernelIsa::Scalar:
+        return getScalarKernelTable();
+    case KernelIsa::Sse2:
+        return getSse2KernelTable();
+    case KernelIsa::Avx2:
+        return getAvx2KernelTable();
+    case KernelIsa::Avx512:
+        return getAvx512KernelTable();
+    case KernelIsa::Neon:
+        return getNeonKernelTable();
+    }
+    return nullptr;
+}
+
+const PixelKernelTable& PixelKernels::getActiveKernelTable() {
+    const PixelKernelTable *table = activeKernelTable.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        // Several threads may detect the ISA at the same time, they select the same one
+        KernelIsa isa = detectBestIsa();
+        activeIsa = isa;
+        table = getKernelTable(isa);
+        activeKernelTable.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+KernelIsa PixelKernels::detectBestIsa() {
+    // The environment variable allows to compare the implementations in the app
+    QString forcedIsa = qEnvironmentVariable("TWINPIX_KERNEL_ISA");
+    auto isas = getSupportedIsas();
+    foreach (auto isa, isas) {
+        if (getIsaName(isa).compare(forcedIsa, Qt::CaseInsensitive) == 0) {
+            return isa;
+        }
+    }
+    return isas.last();
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+/* Scalar reference implementation { */
+
+void ScalarKernels::maxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count) {
+    for (int i = 0; i < count; ++i) {
+        int differenceRed = std::abs(qRed(first[i]) - qRed(second[i]));
+        int differenceGreen = std::abs(qGreen(first[i]) - qGreen(second[i]));
+        int differenceBlue = std::abs(qBlue(first[i]) - qBlue(second[i]));
+        result[i] = static_cast<uchar>(std::max({ differenceRed, differenceGreen, differenceBlue }));
+    }
+}
+
+void ScalarKernels::grayscale(const QRgb *pixels, uchar *result, int count) {
+    for (int i = 0; i < count; ++i) {
+        result[i] = static_cast<uchar>(qGray(pixels[i]));
+    }
+}
+
+void ScalarKernels::luminance(const QRgb *pixels, uchar *result, int count) {
+    for (int i = 0; i < count; ++i) {
+        int value = qRed(pixels[i]) * mLuminanceRed +
+                    qGreen(pixels[i]) * mLuminanceGreen +
+                    qBlue(pixels[i]) * mLuminanceBlue;
+        result[i] = static_cast<uchar>((value + (1 << (mLuminanceShift - 1))) >> mLuminanceShift);
+    }
+}
+
+void ScalarKernels::extractChannel(const QRgb *pixels, uchar *result, int count, int shift) {
+    for (int i = 0; i < count; ++i) {
+        result[i] = static_cast<uchar>(pixels[i] >> shift);
+    }
+}
+
+quint64 ScalarKernels::sum(const uchar *values, int count) {
+    quint64 result = 0;
+    for (int i = 0; i < count; ++i) {
+        result += values[i];
+    }
+    return result;
+}
+
+quint64 ScalarKernels::sumOfSquares(const uchar *values, int count) {
+    quint64 result = 0;
+    for (int i = 0; i < count; ++i) {
+        result += static_cast<quint32>(values[i]) * values[i];
+    }
+    return result;
+}
+
+void ScalarKernels::histogram(const uchar *values, int count, quint64 *bins) {
+    // Several banks of counters avoid stalls when neighbouring values are equal,
+    // which is the usual case for images. Vector instructions do not help here.
+    quint32 banks[4][256] = {};
+    int i = 0;
+    while (i < count) {
+        // The 32-bit counters are merged before they can overflow
+        int end = (count - i > (1 << 30)) ? i + (1 << 30) : count;
+        for (; i + 4 <= end; i += 4) {
+            ++banks[0][values[i]];
+            ++banks[1][values[i + 1]];
+            ++banks[2][values[i + 2]];
+            ++banks[3][values[i + 3]];
+        }
+        for (; i < end; ++i) {
+            ++banks[0][values[i]];
+        }
+        for (int value = 0; value < 256; ++value) {
+            bins[value] += static_cast<quint64>(banks[0][value]) + banks[1][value] + banks[2][value] + banks[3][value];
+            banks[0][value] = banks[1][value] = banks[2][value] = banks[3][value] = 0;
+        }
+    }
+}
+
+const PixelKernelTable* getScalarKernelTable() {
+    static const PixelKernelTable table {
+        ScalarKernels::maxChannelDifference,
+        ScalarKernels::grayscale,
+        ScalarKernels::luminance,
+        ScalarKernels::extractChannel,
+        ScalarKernels::sum,
+        ScalarKernels::sumOfSquares,
+        ScalarKernels::histogram
+    };
+    return &table;
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
@@ -0,0 +1,82 @@
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+#include <QRgb>
+
+// The low-level pixel primitives used by comparators and filters. Every
+// primitive has a scalar reference implementation and vectorized ones for
+// SSE2, AVX2 and AVX-512 (x86-64) and NEON (ARM64). The best implementation
+// supported by the CPU is selected at runtime on the first call, so the app
+// is still built with the default compiler flags.
+//
+// The pixels are QRgb values (Format_RGB32 / Format_ARGB32 scanlines);
+// the alpha channel is ignored unless it is extracted explicitly.
+
+enum class KernelIsa { Scalar, Sse2, Avx2, Avx512, Neon };
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// One implementation of all the primitives. The primitives that do not
+// benefit from vector instructions (e.g. histogram) share the scalar code.
+struct PixelKernelTable {
+    void (*maxChannelDifference)(const QRgb *first, const QRgb *second, uchar *result, int count);
+    void (*grayscale)(const QRgb *pixels, uchar *result, int count);
+    void (*luminance)(const QRgb *pixels, uchar *result, int count);
+    void (*extractChannel)(const QRgb *pixels, uchar *result, int count, int shift);
+    quint64 (*sum)(const uchar *values, int count);
+    quint64 (*sumOfSquares)(const uchar *values, int count);
+    void (*histogram)(const uchar *values, int count, quint64 *bins);
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+class PixelKernels
+{
+public:
+    PixelKernels() = delete;
+    ~PixelKernels() = delete;
+
+    // The maximum absolute difference of the R, G and B channels of every pair of pixels
+    static void maxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count);
+
+    // The same value as qGray(): (11 * R + 16 * G + 5 * B) / 32
+    static void grayscale(const QRgb *pixels, uchar *result, int count);
+
+    // The relative luminance (Rec. 709): 0.2126 * R + 0.7152 * G + 0.0722 * B, rounded
+    static void luminance(const QRgb *pixels, uchar *result, int count);
+
+    // One channel of every pixel: the shift is 16 for red, 8 for green, 0 for blue and 24 for alpha
+    static void extractChannel(const QRgb *pixels, uchar *result, int count, int shift);
+
+    static quint64 sum(const uchar *values, int count);
+    static quint64 sumOfSquares(const uchar *values, int count);
+
+    // Adds the number of occurrences of every value to the 256 bins
+    static void histogram(const uchar *values, int count, quint64 *bins);
+
+    // The ISAs supported by this CPU (and this build), the scalar one is always the first
+    static QList<KernelIsa> getSupportedIsas();
+    static KernelIsa getActiveIsa();
+    static QString getIsaName(KernelIsa isa);
+
+    // Selects the implementation of the given ISA instead of the best one, e.g. to
+    // compare the implementations. Throws std::runtime_error if the ISA is not supported.
+    static void setActiveIsa(KernelIsa isa);
+
+private:
+    static const PixelKernelTable* getKernelTable(KernelIsa isa);
+    static const PixelKernelTable& getActiveKernelTable();
+    static KernelIsa detectBestIsa();
+};
+
+// The implementations of the ISAs; they return nullptr if the ISA is not built for this architecture
+const PixelKernelTable* getScalarKernelTable();
+const PixelKernelTable* getSse2KernelTable();
+const PixelKernelTable* getAvx2KernelTable();
+const PixelKernelTable* getAvx512KernelTable();
+const PixelKernelTable* getNeonKernelTable();
+
+#endif // PIXELKERNELS_H
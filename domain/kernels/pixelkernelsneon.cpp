@@ -0,0 +1,125 @@
+#include "pixelkernels.h"
+#include "scalarkernels.h"
+
+// The NEON implementation of the pixel primitives. NEON is a part of every
+// ARM64 CPU (e.g. Apple Silicon), so it does not need a runtime check.
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+namespace {
+
+// The 32-bit sums of squares are moved to 64-bit counters after this
+// number of iterations, before they can overflow
+constexpr int mSquaresFlushInterval = 4096;
+
+// A QRgb is stored as B, G, R, A bytes in memory, vld4q_u8 splits 16 pixels into these planes
+
+void neonMaxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t a = vld4q_u8(reinterpret_cast<const uint8_t*>(first + i));
+        uint8x16x4_t b = vld4q_u8(reinterpret_cast<const uint8_t*>(second + i));
+        uint8x16_t maximum = vmaxq_u8(vabdq_u8(a.val[0], b.val[0]), vabdq_u8(a.val[1], b.val[1]));
+        maximum = vmaxq_u8(maximum, vabdq_u8(a.val[2], b.val[2]));
+        vst1q_u8(result + i, maximum);
+    }
+    ScalarKernels::maxChannelDifference(first + i, second + i, result + i, count - i);
+}
+
+void neonGrayscale(const QRgb *pixels, uchar *result, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t channels = vld4_u8(reinterpret_cast<const uint8_t*>(pixels + i));
+        uint16x8_t value = vmull_u8(channels.val[2], vdup_n_u8(11));
+        value = vmlal_u8(value, channels.val[1], vdup_n_u8(16));
+        value = vmlal_u8(value, channels.val[0], vdup_n_u8(5));
+        vst1_u8(result + i, vshrn_n_u16(value, 5));
+    }
+    ScalarKernels::grayscale(pixels + i, result + i, count - i);
+}
+
+void neonLuminance(const QRgb *pixels, uchar *result, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t channels = vld4_u8(reinterpret_cast<const uint8_t*>(pixels + i));
+        uint16x8_t red = vmovl_u8(channels.val[2]);
+        uint16x8_t green = vmovl_u8(channels.val[1]);
+        uint16x8_t blue = vmovl_u8(channels.val[0]);
+
+        uint32x4_t low = vmull_n_u16(vget_low_u16(red), ScalarKernels::mLuminanceRed);
+        low = vmlal_n_u16(low, vget_low_u16(green), ScalarKernels::mLuminanceGreen);
+        low = vmlal_n_u16(low, vget_low_u16(blue), ScalarKernels::mLuminanceBlue);
+        uint32x4_t high = vmull_n_u16(vget_high_u16(red), ScalarKernels::mLuminanceRed);
+        high = vmlal_n_u16(high, vget_high_u16(green), ScalarKernels::mLuminanceGreen);
+        high = vmlal_n_u16(high, vget_high_u16(blue), ScalarKernels::mLuminanceBlue);
+
+        uint16x8_t value = vcombine_u16(vrshrn_n_u32(low, ScalarKernels::mLuminanceShift),
+                                        vrshrn_n_u32(high, ScalarKernels::mLuminanceShift));
+        vst1_u8(result + i, vmovn_u16(value));
+    }
+    ScalarKernels::luminance(pixels + i, result + i, count - i);
+}
+
+void neonExtractChannel(const QRgb *pixels, uchar *result, int count, int shift) {
+    int channel = shift / 8;
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t channels = vld4q_u8(reinterpret_cast<const uint8_t*>(pixels + i));
+        vst1q_u8(result + i, channels.val[channel]);
+    }
+    ScalarKernels::extractChannel(pixels + i, result + i, count - i, shift);
+}
+
+quint64 neonSum(const uchar *values, int count) {
+    uint64x2_t total = vdupq_n_u64(0);
+    int i = 0;
+    while (i + 16 <= count) {
+        // 16-bit lanes hold the sums of up to 128 iterations
+        uint16x8_t sums = vdupq_n_u16(0);
+        for (int iteration = 0; iteration < 128 && i + 16 <= count; ++iteration, i += 16) {
+            sums = vpadalq_u8(sums, vld1q_u8(values + i));
+        }
+        total = vpadalq_u32(total, vpaddlq_u16(sums));
+    }
+    return vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1) + ScalarKernels::sum(values + i, count - i);
+}
+
+quint64 neonSumOfSquares(const uchar *values, int count) {
+    uint64x2_t total = vdupq_n_u64(0);
+    int i = 0;
+    while (i + 16 <= count) {
+        uint32x4_t squares = vdupq_n_u32(0);
+        for (int iteration = 0; iteration < mSquaresFlushInterval && i + 16 <= count; ++iteration, i += 16) {
+            uint8x16_t vector = vld1q_u8(values + i);
+            squares = vpadalq_u16(squares, vmull_u8(vget_low_u8(vector), vget_low_u8(vector)));
+            squares = vpadalq_u16(squares, vmull_u8(vget_high_u8(vector), vget_high_u8(vector)));
+        }
+        total = vpadalq_u32(total, squares);
+    }
+    return vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1) + ScalarKernels::sumOfSquares(values + i, count - i);
+}
+
+} // namespace
+
+const PixelKernelTable* getNeonKernelTable() {
+    static const PixelKernelTable table {
+        neonMaxChannelDifference,
+        neonGrayscale,
+        neonLuminance,
+        neonExtractChannel,
+        neonSum,
+        neonSumOfSquares,
+        ScalarKernels::histogram
+    };
+    return &table;
+}
+
+#else
+
+const PixelKernelTable* getNeonKernelTable() {
+    return nullptr;
+}
+
+#endif
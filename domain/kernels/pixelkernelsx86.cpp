@@ -0,0 +1,458 @@
+#include "pixelkernels.h"
+#include "scalarkernels.h"
+
+// The SSE2, AVX2 and AVX-512 implementations of the pixel primitives. The file is
+// built with the default compiler flags: the AVX2 and AVX-512 functions are compiled
+// for their ISA with the target attribute and are only called if the CPU supports it.
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define KERNEL_TARGET(isa)
+#endif
+
+namespace {
+
+// The 32-bit sums of squares are moved to 64-bit counters after this
+// number of iterations, before they can overflow
+constexpr int mSquaresFlushInterval = 4096;
+
+/* SSE2 { */
+
+// Packs the low bytes of the 32-bit lanes of four vectors (values 0..255) into one vector
+inline __m128i packLowBytes(__m128i a, __m128i b, __m128i c, __m128i d) {
+    return _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+}
+
+inline __m128i maxChannelDifferenceSse2(__m128i first, __m128i second) {
+    const __m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+    const __m128i lowByteMask = _mm_set1_epi32(0xFF);
+    __m128i difference = _mm_or_si128(_mm_subs_epu8(first, second), _mm_subs_epu8(second, first));
+    difference = _mm_and_si128(difference, colorMask);
+    __m128i result = _mm_max_epu8(difference, _mm_srli_epi32(difference, 8));
+    result = _mm_max_epu8(result, _mm_srli_epi32(difference, 16));
+    return _mm_and_si128(result, lowByteMask);
+}
+
+// The weighted sum of the channels of four pixels in the 32-bit lanes. The multiplications
+// are done by _mm_madd_epi16: the high halves of the lanes are zero, so every lane gets
+// the exact 32-bit product of the channel and the coefficient.
+inline __m128i weightChannelsSse2(__m128i pixels, int redWeight, int greenWeight, int blueWeight) {
+    const __m128i lowByteMask = _mm_set1_epi32(0xFF);
+    __m128i blue = _mm_and_si128(pixels, lowByteMask);
+    __m128i green = _mm_and_si128(_mm_srli_epi32(pixels, 8), lowByteMask);
+    __m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 16), lowByteMask);
+    __m128i result = _mm_madd_epi16(red, _mm_set1_epi32(redWeight));
+    result = _mm_add_epi32(result, _mm_madd_epi16(green, _mm_set1_epi32(greenWeight)));
+    return _mm_add_epi32(result, _mm_madd_epi16(blue, _mm_set1_epi32(blueWeight)));
+}
+
+inline __m128i grayscaleSse2(__m128i pixels) {
+    return _mm_srli_epi32(weightChannelsSse2(pixels, 11, 16, 5), 5);
+}
+
+inline __m128i luminanceSse2(__m128i pixels) {
+    __m128i value = weightChannelsSse2(pixels,
+                                       ScalarKernels::mLuminanceRed,
+                                       ScalarKernels::mLuminanceGreen,
+                                       ScalarKernels::mLuminanceBlue
+                                       );
+    value = _mm_add_epi32(value, _mm_set1_epi32(1 << (ScalarKernels::mLuminanceShift - 1)));
+    return _mm_srli_epi32(value, ScalarKernels::mLuminanceShift);
+}
+
+void sse2MaxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + j * 4));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i + j * 4));
+            lanes[j] = maxChannelDifferenceSse2(a, b);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i),
+                         packLowBytes(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    ScalarKernels::maxChannelDifference(first + i, second + i, result + i, count - i);
+}
+
+void sse2Grayscale(const QRgb *pixels, uchar *result, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            lanes[j] = grayscaleSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i + j * 4)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i),
+                         packLowBytes(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    ScalarKernels::grayscale(pixels + i, result + i, count - i);
+}
+
+void sse2Luminance(const QRgb *pixels, uchar *result, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            lanes[j] = luminanceSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i + j * 4)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i),
+                         packLowBytes(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    ScalarKernels::luminance(pixels + i, result + i, count - i);
+}
+
+void sse2ExtractChannel(const QRgb *pixels, uchar *result, int count, int shift) {
+    const __m128i lowByteMask = _mm_set1_epi32(0xFF);
+    const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            __m128i pixelsVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i + j * 4));
+            lanes[j] = _mm_and_si128(_mm_srl_epi32(pixelsVector, shiftCount), lowByteMask);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i),
+                         packLowBytes(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    ScalarKernels::extractChannel(pixels + i, result + i, count - i, shift);
+}
+
+quint64 sse2Sum(const uchar *values, int count) {
+    __m128i total = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        total = _mm_add_epi64(total, _mm_sad_epu8(vector, _mm_setzero_si128()));
+    }
+    quint64 lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), total);
+    return lanes[0] + lanes[1] + ScalarKernels::sum(values + i, count - i);
+}
+
+quint64 sse2SumOfSquares(const uchar *values, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i total = zero;
+    int i = 0;
+    while (i + 16 <= count) {
+        __m128i squares = zero; // 32-bit lanes
+        for (int iteration = 0; iteration < mSquaresFlushInterval && i + 16 <= count; ++iteration, i += 16) {
+            __m128i vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+            __m128i low = _mm_unpacklo_epi8(vector, zero);
+            __m128i high = _mm_unpackhi_epi8(vector, zero);
+            squares = _mm_add_epi32(squares, _mm_madd_epi16(low, low));
+            squares = _mm_add_epi32(squares, _mm_madd_epi16(high, high));
+        }
+        total = _mm_add_epi64(total, _mm_unpacklo_epi32(squares, zero));
+        total = _mm_add_epi64(total, _mm_unpackhi_epi32(squares, zero));
+    }
+    quint64 lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), total);
+    return lanes[0] + lanes[1] + ScalarKernels::sumOfSquares(values + i, count - i);
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+/* AVX2 { */
+
+// The packing instructions work within the 128-bit halves, the permutation restores the order
+KERNEL_TARGET("avx2")
+inline __m256i packLowBytesAvx2(__m256i a, __m256i b, __m256i c, __m256i d) {
+    __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+    return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+KERNEL_TARGET("avx2")
+inline __m256i weightChannelsAvx2(__m256i pixels, int redWeight, int greenWeight, int blueWeight) {
+    const __m256i lowByteMask = _mm256_set1_epi32(0xFF);
+    __m256i blue = _mm256_and_si256(pixels, lowByteMask);
+    __m256i green = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), lowByteMask);
+    __m256i red = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), lowByteMask);
+    __m256i result = _mm256_madd_epi16(red, _mm256_set1_epi32(redWeight));
+    result = _mm256_add_epi32(result, _mm256_madd_epi16(green, _mm256_set1_epi32(greenWeight)));
+    return _mm256_add_epi32(result, _mm256_madd_epi16(blue, _mm256_set1_epi32(blueWeight)));
+}
+
+KERNEL_TARGET("avx2")
+void avx2MaxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count) {
+    const __m256i colorMask = _mm256_set1_epi32(0x00FFFFFF);
+    const __m256i lowByteMask = _mm256_set1_epi32(0xFF);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i + j * 8));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i + j * 8));
+            __m256i difference = _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+            difference = _mm256_and_si256(difference, colorMask);
+            __m256i maximum = _mm256_max_epu8(difference, _mm256_srli_epi32(difference, 8));
+            maximum = _mm256_max_epu8(maximum, _mm256_srli_epi32(difference, 16));
+            lanes[j] = _mm256_and_si256(maximum, lowByteMask);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i),
+                            packLowBytesAvx2(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    sse2MaxChannelDifference(first + i, second + i, result + i, count - i);
+}
+
+KERNEL_TARGET("avx2")
+void avx2Grayscale(const QRgb *pixels, uchar *result, int count) {
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            __m256i pixelsVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i + j * 8));
+            lanes[j] = _mm256_srli_epi32(weightChannelsAvx2(pixelsVector, 11, 16, 5), 5);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i),
+                            packLowBytesAvx2(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    sse2Grayscale(pixels + i, result + i, count - i);
+}
+
+KERNEL_TARGET("avx2")
+void avx2Luminance(const QRgb *pixels, uchar *result, int count) {
+    const __m256i rounding = _mm256_set1_epi32(1 << (ScalarKernels::mLuminanceShift - 1));
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            __m256i pixelsVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i + j * 8));
+            __m256i value = weightChannelsAvx2(pixelsVector,
+                                               ScalarKernels::mLuminanceRed,
+                                               ScalarKernels::mLuminanceGreen,
+                                               ScalarKernels::mLuminanceBlue
+                                               );
+            lanes[j] = _mm256_srli_epi32(_mm256_add_epi32(value, rounding), ScalarKernels::mLuminanceShift);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i),
+                            packLowBytesAvx2(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    sse2Luminance(pixels + i, result + i, count - i);
+}
+
+KERNEL_TARGET("avx2")
+void avx2ExtractChannel(const QRgb *pixels, uchar *result, int count, int shift) {
+    const __m256i lowByteMask = _mm256_set1_epi32(0xFF);
+    const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i lanes[4];
+        for (int j = 0; j < 4; ++j) {
+            __m256i pixelsVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i + j * 8));
+            lanes[j] = _mm256_and_si256(_mm256_srl_epi32(pixelsVector, shiftCount), lowByteMask);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i),
+                            packLowBytesAvx2(lanes[0], lanes[1], lanes[2], lanes[3]));
+    }
+    sse2ExtractChannel(pixels + i, result + i, count - i, shift);
+}
+
+KERNEL_TARGET("avx2")
+quint64 avx2Sum(const uchar *values, int count) {
+    __m256i total = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(vector, _mm256_setzero_si256()));
+    }
+    quint64 lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sse2Sum(values + i, count - i);
+}
+
+KERNEL_TARGET("avx2")
+quint64 avx2SumOfSquares(const uchar *values, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i total = zero;
+    int i = 0;
+    while (i + 32 <= count) {
+        __m256i squares = zero; // 32-bit lanes
+        for (int iteration = 0; iteration < mSquaresFlushInterval && i + 32 <= count; ++iteration, i += 32) {
+            __m256i vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            __m256i low = _mm256_unpacklo_epi8(vector, zero);
+            __m256i high = _mm256_unpackhi_epi8(vector, zero);
+            squares = _mm256_add_epi32(squares, _mm256_madd_epi16(low, low));
+            squares = _mm256_add_epi32(squares, _mm256_madd_epi16(high, high));
+        }
+        total = _mm256_add_epi64(total, _mm256_unpacklo_epi32(squares, zero));
+        total = _mm256_add_epi64(total, _mm256_unpackhi_epi32(squares, zero));
+    }
+    quint64 lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sse2SumOfSquares(values + i, count - i);
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+/* AVX-512 (F + BW) { */
+
+// The AVX-512 intrinsics of GCC use deliberately undefined registers,
+// which produces false warnings when they are used with the target attribute
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+KERNEL_TARGET("avx512f,avx512bw")
+inline __m512i weightChannelsAvx512(__m512i pixels, int redWeight, int greenWeight, int blueWeight) {
+    const __m512i lowByteMask = _mm512_set1_epi32(0xFF);
+    __m512i blue = _mm512_and_si512(pixels, lowByteMask);
+    __m512i green = _mm512_and_si512(_mm512_srli_epi32(pixels, 8), lowByteMask);
+    __m512i red = _mm512_and_si512(_mm512_srli_epi32(pixels, 16), lowByteMask);
+    __m512i result = _mm512_madd_epi16(red, _mm512_set1_epi32(redWeight));
+    result = _mm512_add_epi32(result, _mm512_madd_epi16(green, _mm512_set1_epi32(greenWeight)));
+    return _mm512_add_epi32(result, _mm512_madd_epi16(blue, _mm512_set1_epi32(blueWeight)));
+}
+
+// AVX-512 narrows the 32-bit lanes to bytes in order, so no packing and permutation is needed
+
+KERNEL_TARGET("avx512f,avx512bw")
+void avx512MaxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count) {
+    const __m512i colorMask = _mm512_set1_epi32(0x00FFFFFF);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i a = _mm512_loadu_si512(first + i);
+        __m512i b = _mm512_loadu_si512(second + i);
+        __m512i difference = _mm512_or_si512(_mm512_subs_epu8(a, b), _mm512_subs_epu8(b, a));
+        difference = _mm512_and_si512(difference, colorMask);
+        __m512i maximum = _mm512_max_epu8(difference, _mm512_srli_epi32(difference, 8));
+        maximum = _mm512_max_epu8(maximum, _mm512_srli_epi32(difference, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm512_cvtepi32_epi8(maximum));
+    }
+    sse2MaxChannelDifference(first + i, second + i, result + i, count - i);
+}
+
+KERNEL_TARGET("avx512f,avx512bw")
+void avx512Grayscale(const QRgb *pixels, uchar *result, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i value = weightChannelsAvx512(_mm512_loadu_si512(pixels + i), 11, 16, 5);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i),
+                         _mm512_cvtepi32_epi8(_mm512_srli_epi32(value, 5)));
+    }
+    sse2Grayscale(pixels + i, result + i, count - i);
+}
+
+KERNEL_TARGET("avx512f,avx512bw")
+void avx512Luminance(const QRgb *pixels, uchar *result, int count) {
+    const __m512i rounding = _mm512_set1_epi32(1 << (ScalarKernels::mLuminanceShift - 1));
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i value = weightChannelsAvx512(_mm512_loadu_si512(pixels + i),
+                                             ScalarKernels::mLuminanceRed,
+                                             ScalarKernels::mLuminanceGreen,
+                                             ScalarKernels::mLuminanceBlue
+                                             );
+        value = _mm512_srli_epi32(_mm512_add_epi32(value, rounding), ScalarKernels::mLuminanceShift);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm512_cvtepi32_epi8(value));
+    }
+    sse2Luminance(pixels + i, result + i, count - i);
+}
+
+KERNEL_TARGET("avx512f,avx512bw")
+void avx512ExtractChannel(const QRgb *pixels, uchar *result, int count, int shift) {
+    const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i value = _mm512_srl_epi32(_mm512_loadu_si512(pixels + i), shiftCount);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm512_cvtepi32_epi8(value));
+    }
+    sse2ExtractChannel(pixels + i, result + i, count - i, shift);
+}
+
+KERNEL_TARGET("avx512f,avx512bw")
+quint64 avx512Sum(const uchar *values, int count) {
+    __m512i total = _mm512_setzero_si512();
+    int i = 0;
+    for (; i + 64 <= count; i += 64) {
+        __m512i vector = _mm512_loadu_si512(values + i);
+        total = _mm512_add_epi64(total, _mm512_sad_epu8(vector, _mm512_setzero_si512()));
+    }
+    return static_cast<quint64>(_mm512_reduce_add_epi64(total)) + sse2Sum(values + i, count - i);
+}
+
+KERNEL_TARGET("avx512f,avx512bw")
+quint64 avx512SumOfSquares(const uchar *values, int count) {
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i total = zero;
+    int i = 0;
+    while (i + 32 <= count) {
+        __m512i squares = zero; // 32-bit lanes
+        for (int iteration = 0; iteration < mSquaresFlushInterval && i + 32 <= count; ++iteration, i += 32) {
+            __m512i vector = _mm512_cvtepu8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+            squares = _mm512_add_epi32(squares, _mm512_madd_epi16(vector, vector));
+        }
+        total = _mm512_add_epi64(total, _mm512_unpacklo_epi32(squares, zero));
+        total = _mm512_add_epi64(total, _mm512_unpackhi_epi32(squares, zero));
+    }
+    return static_cast<quint64>(_mm512_reduce_add_epi64(total)) + sse2SumOfSquares(values + i, count - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+} // namespace
+
+const PixelKernelTable* getSse2KernelTable() {
+    static const PixelKernelTable table {
+        sse2MaxChannelDifference,
+        sse2Grayscale,
+        sse2Luminance,
+        sse2ExtractChannel,
+        sse2Sum,
+        sse2SumOfSquares,
+        ScalarKernels::histogram
+    };
+    return &table;
+}
+
+const PixelKernelTable* getAvx2KernelTable() {
+    static const PixelKernelTable table {
+        avx2MaxChannelDifference,
+        avx2Grayscale,
+        avx2Luminance,
+        avx2ExtractChannel,
+        avx2Sum,
+        avx2SumOfSquares,
+        ScalarKernels::histogram
+    };
+    return &table;
+}
+
+const PixelKernelTable* getAvx512KernelTable() {
+    static const PixelKernelTable table {
+        avx512MaxChannelDifference,
+        avx512Grayscale,
+        avx512Luminance,
+        avx512ExtractChannel,
+        avx512Sum,
+        avx512SumOfSquares,
+        ScalarKernels::histogram
+    };
+    return &table;
+}
+
+#else
+
+const PixelKernelTable* getSse2KernelTable() {
+    return nullptr;
+}
+
+const PixelKernelTable* getAvx2KernelTable() {
+    return nullptr;
+}
+
+const PixelKernelTable* getAvx512KernelTable() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef SCALARKERNELS_H
+#define SCALARKERNELS_H
+
+#include <QtGlobal>
+#include <QRgb>
+
+// The scalar reference implementations of the pixel primitives (see PixelKernels).
+// The vectorized implementations use them for the tails of the rows
+// which are shorter than a vector.
+
+namespace ScalarKernels {
+
+// Rec. 709 coefficients in Q15, their sum is exactly 1.0
+constexpr int mLuminanceRed = 6967;
+constexpr int mLuminanceGreen = 23436;
+constexpr int mLuminanceBlue = 2365;
+constexpr int mLuminanceShift = 15;
+
+void maxChannelDifference(const QRgb *first, const QRgb *second, uchar *result, int count);
+void grayscale(const QRgb *pixels, uchar *result, int count);
+void luminance(const QRgb *pixels, uchar *result, int count);
+void extractChannel(const QRgb *pixels, uchar *result, int count, int shift);
+quint64 sum(const uchar *values, int count);
+quint64 sumOfSquares(const uchar *values, int count);
+void histogram(const uchar *values, int count, quint64 *bins);
+
+} // namespace ScalarKernels
+
+#endif // SCALARKERNELS_H
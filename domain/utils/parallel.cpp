@@ -0,0 +1,41 @@
+#include "parallel.h"
+
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+#include <exception>
+
+
+void Parallel::run(int count, const std::function<void(int)> &task) {
+    QMutex errorMutex;
+    std::exception_ptr error;
+    // The first exception is kept as is rather than wrapped by QtConcurrent
+    auto guardedTask = [&task, &errorMutex, &error](int index) {
+        try {
+            task(index);
+        } catch (...) {
+            QMutexLocker locker(&errorMutex);
+            if (error == nullptr) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    // The tasks run on the global thread pool and on the calling thread, which also
+    // takes tasks while it waits, so nested calls (e.g. from a pool thread) share
+    // the pool instead of creating threads of their own and cannot starve it
+    QList<int> indexes;
+    for (int i = 0; i < count; ++i) {
+        indexes.append(i);
+    }
+    QtConcurrent::blockingMap(indexes, guardedTask);
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+int Parallel::getBandCount(int height, int minBandHeight) {
+    return std::clamp(height / std::max(1, minBandHeight), 1, std::max(1, QThread::idealThreadCount()));
+}
@@ -0,0 +1,24 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+// The parallel loop shared by the builders of the images and the indexes that
+// process their rows in independent bands (e.g. CompressedImage, IntegralImage).
+
+class Parallel
+{
+public:
+    Parallel() = delete;
+    ~Parallel() = delete;
+
+    // Calls task(0) .. task(count - 1) on the global QThreadPool and the calling thread,
+    // and returns when all of them are finished.
+    // If a task throws, the first exception is rethrown after all of them are finished.
+    static void run(int count, const std::function<void(int)> &task);
+
+    // The number of bands of at least minBandHeight rows, at most one per CPU core
+    static int getBandCount(int height, int minBandHeight);
+};
+
+#endif // PARALLEL_H
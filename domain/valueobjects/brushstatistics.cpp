@@ -0,0 +1,72 @@
+#include "brushstatistics.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <domain/kernels/pixelkernels.h>
+
+
+BrushStatistics BrushStatistics::calculate(const QImage &image,
+                                           const QPoint &center,
+                                           int brushSize,
+                                           const QImage &otherImage
+                                           )
+{
+    BrushStatistics statistics;
+    brushSize = std::clamp(brushSize, 1, mMaxBrushSize);
+    QRect brush { center.x() - brushSize / 2, center.y() - brushSize / 2, brushSize, brushSize };
+    statistics.mArea = brush.intersected(image.rect());
+    if (statistics.mArea.isEmpty()) {
+        return {};
+    }
+
+    // Only the pixels under the brush are converted
+    QImage pixels = image.copy(statistics.mArea).convertToFormat(QImage::Format_RGB32);
+    bool hasOtherImage = !otherImage.isNull() && otherImage.rect().contains(statistics.mArea);
+    QImage otherPixels;
+    if (hasOtherImage) {
+        otherPixels = otherImage.copy(statistics.mArea).convertToFormat(QImage::Format_RGB32);
+    }
+
+    int width = pixels.width();
+    std::vector<uchar> values(width);
+    std::vector<uchar> otherValues(width);
+    for (int channel = 0; channel < 3; ++channel) {
+        int shift = 16 - 8 * channel;
+        RegionSums &sums = statistics.mChannelSums[channel];
+        int maxDifference = 0;
+        for (int y = 0; y < pixels.height(); ++y) {
+            auto line = reinterpret_cast<const QRgb*>(pixels.constScanLine(y));
+            PixelKernels::extractChannel(line, values.data(), width, shift);
+            sums.sum += PixelKernels::sum(values.data(), width);
+            sums.sumOfSquares += PixelKernels::sumOfSquares(values.data(), width);
+
+            if (hasOtherImage) {
+                auto otherLine = reinterpret_cast<const QRgb*>(otherPixels.constScanLine(y));
+                PixelKernels::extractChannel(otherLine, otherValues.data(), width, shift);
+                for (int x = 0; x < width; ++x) {
+                    maxDifference = std::max(maxDifference, std::abs(values[x] - otherValues[x]));
+                }
+            }
+        }
+        sums.pixelCount = static_cast<qint64>(width) * pixels.height();
+        statistics.mMaxDifferences[channel] = hasOtherImage ? maxDifference : -1;
+    }
+    return statistics;
+}
+
+bool BrushStatistics::isNull() const {
+    return mArea.isEmpty();
+}
+
+QRect BrushStatistics::getArea() const {
+    return mArea;
+}
+
+const RegionSums& BrushStatistics::getChannelSums(int channel) const {
+    return mChannelSums[channel];
+}
+
+int BrushStatistics::getMaxDifference(int channel) const {
+    return mMaxDifferences[channel];
+}
@@ -0,0 +1,49 @@
+#ifndef BRUSHSTATISTICS_H
+#define BRUSHSTATISTICS_H
+
+#include <QImage>
+#include <QRect>
+#include <array>
+#include <domain/valueobjects/summedareatable.h>
+
+// The statistics of the R, G and B channels of the pixels under the brush of
+// the color picker: a square of brushSize x brushSize centered at the cursor.
+// A single pixel says little about a noisy capture, the mean and the standard
+// deviation over the brush say more.
+//
+// The brush is at most mMaxBrushSize x mMaxBrushSize, so the pixels are reduced
+// directly with the vectorized PixelKernels; the cost does not depend on the size
+// of the image and stays far below the rate of the mouse events.
+
+class BrushStatistics
+{
+public:
+    BrushStatistics() = default;
+    ~BrushStatistics() = default;
+
+    // The brush is clipped to the image. If the other image is given, the maximum
+    // differences of the channels from it under the same brush are calculated too.
+    static BrushStatistics calculate(const QImage &image,
+                                     const QPoint &center,
+                                     int brushSize,
+                                     const QImage &otherImage = QImage()
+                                     );
+
+    bool isNull() const;
+    QRect getArea() const;
+
+    // The channel is 0 for red, 1 for green and 2 for blue
+    const RegionSums& getChannelSums(int channel) const;
+
+    // The maximum absolute difference from the other image, it is -1 if there is no other image
+    int getMaxDifference(int channel) const;
+
+    static constexpr int mMaxBrushSize = 64;
+
+private:
+    QRect mArea;
+    std::array<RegionSums, 3> mChannelSums;
+    std::array<int, 3> mMaxDifferences = { -1, -1, -1 };
+};
+
+#endif // BRUSHSTATISTICS_H
@@ -21,7 +21,35 @@ ComparableImage::ComparableImage(const QPixmap &image, const QString &imageName)
 }
 
 QImage ComparableImage::getImage() const {
-    return mImage;
+    if (!hasRegionOfInterest() || mRegionOfInterest == mImage.rect()) {
+        return mImage;
+    }
+    if (mImage.depth() != 32) {
+        return mImage.copy(mRegionOfInterest); // rows of other depths may be unaligned
+    }
+    // The view keeps a shallow copy of the whole image, so the pixels stay
+    // alive as long as the view and its copies do
+    const uchar *firstPixel = mImage.constScanLine(mRegionOfInterest.top()) + mRegionOfInterest.left() * 4;
+    return QImage(firstPixel,
+                  mRegionOfInterest.width(),
+                  mRegionOfInterest.height(),
+                  mImage.bytesPerLine(),
+                  mImage.format(),
+                  [](void *image) { delete static_cast<QImage*>(image); },
+                  new QImage(mImage)
+                  );
+}
+
+void ComparableImage::setRegionOfInterest(const QRect &regionOfInterest) {
+    mRegionOfInterest = regionOfInterest.intersected(mImage.rect());
+}
+
+QRect ComparableImage::getRegionOfInterest() const {
+    return hasRegionOfInterest() ? mRegionOfInterest : mImage.rect();
+}
+
+bool ComparableImage::hasRegionOfInterest() const {
+    return !mRegionOfInterest.isNull();
 }
 
 QString ComparableImage::getPath() const {
@@ -31,3 +59,27 @@ QString ComparableImage::getPath() const {
 QString ComparableImage::getImageName() const {
     return mImageName;
 }
+
+void ComparableImage::setRowDifferences(const RowDifferenceMap &rowDifferences) {
+    mRowDifferences = rowDifferences;
+}
+
+const RowDifferenceMap& ComparableImage::getRowDifferences() const {
+    return mRowDifferences;
+}
+
+void ComparableImage::setDifferencePlane(const DifferencePlane &differencePlane) {
+    mDifferencePlane = differencePlane;
+}
+
+const DifferencePlane& ComparableImage::getDifferencePlane() const {
+    return mDifferencePlane;
+}
+
+void ComparableImage::setIntegralImage(const std::shared_ptr<const IntegralImage> &integralImage) {
+    mIntegralImage = integralImage;
+}
+
+std::shared_ptr<const IntegralImage> ComparableImage::getIntegralImage() const {
+    return mIntegralImage;
+}
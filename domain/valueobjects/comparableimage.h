@@ -2,6 +2,10 @@
 #define COMPARABLEIMAGE_H
 
 #include <qimage.h>
+#include <memory>
+#include <domain/valueobjects/differenceplane.h>
+#include <domain/valueobjects/integralimage.h>
+#include <domain/valueobjects/rowdifferencemap.h>
 
 class ComparableImage {
 public:
@@ -10,14 +14,42 @@ public:
 
     ComparableImage(const QPixmap &image, const QString &imageName);
 
+    // Returns the region of interest if it is set, otherwise the whole image.
+    // The region is not copied: the returned image is a read-only view of the
+    // rows of the whole image (it is copied only if it is modified).
     QImage getImage() const;
 
+    // Limits the analysis to an area of the image (e.g. an area selected by
+    // the user); the area is clipped to the image.
+    void setRegionOfInterest(const QRect &regionOfInterest);
+    QRect getRegionOfInterest() const;
+    bool hasRegionOfInterest() const;
+
     QString getImageName() const;
     QString getPath() const;
 
+    // The rows in which the images of a compared pair differ. It is the same
+    // for both images of the pair; unless it is set, every row is treated as different.
+    void setRowDifferences(const RowDifferenceMap &rowDifferences);
+    const RowDifferenceMap& getRowDifferences() const;
+
+    // The per-pixel difference of the compared pair, calculated once for
+    // all the difference comparators. It is null unless it is set.
+    void setDifferencePlane(const DifferencePlane &differencePlane);
+    const DifferencePlane& getDifferencePlane() const;
+
+    // The summed-area tables of the whole image, so the statistics of the region
+    // of interest are calculated in O(1). It is nullptr unless it is set.
+    void setIntegralImage(const std::shared_ptr<const IntegralImage> &integralImage);
+    std::shared_ptr<const IntegralImage> getIntegralImage() const;
+
 private:
     QImage mImage;
     QString mImageName;
+    QRect mRegionOfInterest;
+    RowDifferenceMap mRowDifferences;
+    DifferencePlane mDifferencePlane;
+    std::shared_ptr<const IntegralImage> mIntegralImage;
 };
 
 #endif // COMPARABLEIMAGE_H
@@ -33,3 +33,11 @@ QString ComparisonResultVariant::getStringResult() {
 ComparisonResultVariantType ComparisonResultVariant::getType() {
     return mType;
 }
+
+void ComparisonResultVariant::setMetrics(const QList<ComparisonMetric> &metrics) {
+    mMetrics = metrics;
+}
+
+QList<ComparisonMetric> ComparisonResultVariant::getMetrics() const {
+    return mMetrics;
+}
@@ -5,6 +5,17 @@
 
 enum class ComparisonResultVariantType { None, Image, String };
 
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// A scalar value of a string result, e.g. the contrast of one of the images.
+// The metrics of the estimated results are shown with confidence intervals.
+struct ComparisonMetric {
+    QString name;
+    double value;
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
 class ComparisonResultVariant
 {
 public:
@@ -17,12 +28,16 @@ public:
 
     ComparisonResultVariantType getType();
 
+    void setMetrics(const QList<ComparisonMetric> &metrics);
+    QList<ComparisonMetric> getMetrics() const;
+
     friend class TestComparisonResultVariant;
 
 private:
     ComparisonResultVariantType mType { ComparisonResultVariantType::None };
     QImage mImage;
     QString mString;
+    QList<ComparisonMetric> mMetrics;
 };
 
 typedef std::shared_ptr<ComparisonResultVariant> ComparisonResultVariantPtr;
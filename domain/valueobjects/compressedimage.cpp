@@ -0,0 +1,314 @@
+#include "compressedimage.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <domain/utils/parallel.h>
+
+
+std::atomic<qint64> CompressedImage::mTotalCompressedSize { 0 };
+std::atomic<qint64> CompressedImage::mTotalUncompressedSize { 0 };
+
+namespace {
+
+// The operations of the QOI format, see https://qoiformat.org
+constexpr uchar opIndex = 0x00;     // 00xxxxxx - the index of a recently seen color
+constexpr uchar opDiff = 0x40;      // 01rrggbb - a small difference from the previous pixel
+constexpr uchar opLuma = 0x80;      // 10gggggg rrrrbbbb - a difference relative to green
+constexpr uchar opRun = 0xC0;       // 11xxxxxx - the previous pixel repeated 1..62 times
+constexpr uchar opRgb = 0xFE;
+constexpr uchar opRgba = 0xFF;
+constexpr uchar opMask = 0xC0;
+constexpr int maxRun = 62;
+
+inline int getColorHash(QRgb pixel) {
+    return (qRed(pixel) * 3 + qGreen(pixel) * 5 + qBlue(pixel) * 7 + qAlpha(pixel) * 11) % 64;
+}
+
+} // namespace
+
+CompressedImage::Data::~Data() {
+    mTotalCompressedSize -= compressedSize;
+    mTotalUncompressedSize -= uncompressedSize;
+}
+
+CompressedImage CompressedImage::compress(const QImage &image) {
+    CompressedImage compressedImage;
+    if (image.isNull()) {
+        return compressedImage;
+    }
+    auto data = std::make_shared<Data>();
+    data->size = image.size();
+    data->format = image.format();
+    data->colorTable = image.colorTable();
+
+    int height = image.height();
+    int bandCount = Parallel::getBandCount(height, mMinBandHeight);
+    data->bandHeight = (height + bandCount - 1) / bandCount;
+    data->bands.resize(bandCount);
+    Parallel::run(bandCount, [&](int band) {
+        int top = band * data->bandHeight;
+        int bottom = std::min(height, top + data->bandHeight);
+        data->bands[band] = encodeBand(image, top, bottom);
+    });
+
+    foreach (auto &band, data->bands) {
+        data->compressedSize += band.size();
+    }
+    data->uncompressedSize = image.sizeInBytes();
+    mTotalCompressedSize += data->compressedSize;
+    mTotalUncompressedSize += data->uncompressedSize;
+    compressedImage.mData = data;
+    return compressedImage;
+}
+
+QImage CompressedImage::decompress() const {
+    if (isNull()) {
+        return {};
+    }
+    QImage image { mData->size, mData->format };
+    if (image.isNull()) {
+        throw std::runtime_error("Error: Not enough memory to decompress an image.");
+    }
+    image.setColorTable(mData->colorTable);
+    int height = image.height();
+    int bandCount = mData->bands.size();
+    std::atomic<bool> isCorrupted { false };
+    Parallel::run(bandCount, [&](int band) {
+        int top = band * mData->bandHeight;
+        int bottom = std::min(height, top + mData->bandHeight);
+        try {
+            decodeBand(mData->bands[band], image, top, bottom);
+        } catch (std::runtime_error &) {
+            isCorrupted = true; // every thread writes the same value
+        }
+    });
+    if (isCorrupted) {
+        throw std::runtime_error("Error: A compressed image is corrupted.");
+    }
+    return image;
+}
+
+QByteArray CompressedImage::encodeBand(const QImage &image, int top, int bottom) {
+    if (image.depth() != 32) {
+        qsizetype size = static_cast<qsizetype>(bottom - top) * image.bytesPerLine();
+        QByteArray rows = QByteArray::fromRawData(reinterpret_cast<const char*>(image.constScanLine(top)), size);
+        return qCompress(rows, 1);
+    }
+
+    int width = image.width();
+    QByteArray band(static_cast<qsizetype>(width) * (bottom - top) * 5, Qt::Uninitialized);
+    auto out = reinterpret_cast<uchar*>(band.data());
+    qsizetype position = 0;
+    QRgb index[64] = {};
+    QRgb previous = qRgba(0, 0, 0, 255);
+    int run = 0;
+
+    for (int y = top; y < bottom; ++y) {
+        auto line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < width; ++x) {
+            QRgb pixel = line[x];
+            if (pixel == previous) {
+                if (++run == maxRun) {
+                    out[position++] = opRun | (run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                out[position++] = opRun | (run - 1);
+                run = 0;
+            }
+            int hash = getColorHash(pixel);
+            if (index[hash] == pixel) {
+                out[position++] = opIndex | hash;
+            } else {
+                index[hash] = pixel;
+                if (qAlpha(pixel) == qAlpha(previous)) {
+                    int dr = static_cast<qint8>(qRed(pixel) - qRed(previous));
+                    int dg = static_cast<qint8>(qGreen(pixel) - qGreen(previous));
+                    int db = static_cast<qint8>(qBlue(pixel) - qBlue(previous));
+                    int drg = dr - dg;
+                    int dbg = db - dg;
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        out[position++] = opDiff | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+                    } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                        out[position++] = opLuma | (dg + 32);
+                        out[position++] = ((drg + 8) << 4) | (dbg + 8);
+                    } else {
+                        out[position++] = opRgb;
+                        out[position++] = qRed(pixel);
+                        out[position++] = qGreen(pixel);
+                        out[position++] = qBlue(pixel);
+                    }
+                } else {
+                    out[position++] = opRgba;
+                    out[position++] = qRed(pixel);
+                    out[position++] = qGreen(pixel);
+                    out[position++] = qBlue(pixel);
+                    out[position++] = qAlpha(pixel);
+                }
+            }
+            previous = pixel;
+        }
+    }
+    if (run > 0) {
+        out[position++] = opRun | (run - 1);
+    }
+    band.resize(position);
+    band.squeeze();
+    return band;
+}
+
+void CompressedImage::decodeBand(const QByteArray &band, QImage &image, int top, int bottom) {
+    if (image.depth() != 32) {
+        QByteArray rows = qUncompress(band);
+        qsizetype size = static_cast<qsizetype>(bottom - top) * image.bytesPerLine();
+        if (rows.size() != size) {
+            throw std::runtime_error("Error: A compressed image is corrupted.");
+        }
+        std::memcpy(image.scanLine(top), rows.constData(), size);
+        return;
+    }
+
+    int width = image.width();
+    auto in = reinterpret_cast<const uchar*>(band.constData());
+    qsizetype size = band.size();
+    qsizetype position = 0;
+    QRgb index[64] = {};
+    QRgb pixel = qRgba(0, 0, 0, 255);
+    int run = 0;
+
+    auto readByte = [&]() -> uchar {
+        if (position >= size) {
+            throw std::runtime_error("Error: A compressed image is corrupted.");
+        }
+        return in[position++];
+    };
+
+    for (int y = top; y < bottom; ++y) {
+        auto line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            if (run > 0) {
+                --run;
+                line[x] = pixel;
+                continue;
+            }
+            uchar op = readByte();
+            if (op == opRgb) {
+                int red = readByte();
+                int green = readByte();
+                int blue = readByte();
+                pixel = qRgba(red, green, blue, qAlpha(pixel));
+            } else if (op == opRgba) {
+                int red = readByte();
+                int green = readByte();
+                int blue = readByte();
+                int alpha = readByte();
+                pixel = qRgba(red, green, blue, alpha);
+            } else if ((op & opMask) == opIndex) {
+                pixel = index[op];
+            } else if ((op & opMask) == opDiff) {
+                pixel = qRgba((qRed(pixel) + ((op >> 4) & 0x03) - 2) & 0xFF,
+                              (qGreen(pixel) + ((op >> 2) & 0x03) - 2) & 0xFF,
+                              (qBlue(pixel) + (op & 0x03) - 2) & 0xFF,
+                              qAlpha(pixel)
+                              );
+            } else if ((op & opMask) == opLuma) {
+                uchar next = readByte();
+                int dg = (op & 0x3F) - 32;
+                pixel = qRgba((qRed(pixel) + dg + ((next >> 4) & 0x0F) - 8) & 0xFF,
+                              (qGreen(pixel) + dg) & 0xFF,
+                              (qBlue(pixel) + dg + (next & 0x0F) - 8) & 0xFF,
+                              qAlpha(pixel)
+                              );
+            } else {
+                run = op & 0x3F; // the current pixel is the first one of the run
+            }
+            index[getColorHash(pixel)] = pixel;
+            line[x] = pixel;
+        }
+    }
+}
+
+bool CompressedImage::isNull() const {
+    return mData == nullptr;
+}
+
+QSize CompressedImage::size() const {
+    return isNull() ? QSize() : mData->size;
+}
+
+QImage::Format CompressedImage::format() const {
+    return isNull() ? QImage::Format_Invalid : mData->format;
+}
+
+qint64 CompressedImage::getCompressedSize() const {
+    return isNull() ? 0 : mData->compressedSize;
+}
+
+qint64 CompressedImage::getUncompressedSize() const {
+    return isNull() ? 0 : mData->uncompressedSize;
+}
+
+qint64 CompressedImage::getTotalCompressedSize() {
+    return mTotalCompressedSize;
+}
+
+qint64 CompressedImage::getTotalUncompressedSize() {
+    return mTotalUncompressedSize;
+}
+
+void CompressedImage::write(QDataStream &stream) const {
+    if (isNull()) {
+        stream << QSize() << static_cast<qint32>(QImage::Format_Invalid);
+        return;
+    }
+    stream << mData->size
+           << static_cast<qint32>(mData->format)
+           << mData->colorTable
+           << static_cast<qint32>(mData->bandHeight)
+           << mData->uncompressedSize
+           << mData->bands;
+}
+
+CompressedImage CompressedImage::read(QDataStream &stream) {
+    QSize size;
+    qint32 format;
+    stream >> size >> format;
+    CompressedImage compressedImage;
+    if (stream.status() == QDataStream::Ok && size.isEmpty() && format == QImage::Format_Invalid) {
+        return compressedImage;
+    }
+
+    QList<QRgb> colorTable;
+    qint32 bandHeight;
+    qint64 uncompressedSize;
+    QList<QByteArray> bands;
+    stream >> colorTable >> bandHeight >> uncompressedSize >> bands;
+    bool isValid = stream.status() == QDataStream::Ok &&
+                   !size.isEmpty() &&
+                   format > QImage::Format_Invalid &&
+                   format < QImage::NImageFormats &&
+                   bandHeight > 0 &&
+                   uncompressedSize > 0 &&
+                   bands.size() == (size.height() + bandHeight - 1) / bandHeight;
+    if (!isValid) {
+        throw std::runtime_error("Error: A compressed image is corrupted.");
+    }
+
+    auto data = std::make_shared<Data>();
+    data->size = size;
+    data->format = static_cast<QImage::Format>(format);
+    data->colorTable = colorTable;
+    data->bandHeight = bandHeight;
+    data->bands = bands;
+    foreach (auto &band, data->bands) {
+        data->compressedSize += band.size();
+    }
+    data->uncompressedSize = uncompressedSize;
+    mTotalCompressedSize += data->compressedSize;
+    mTotalUncompressedSize += data->uncompressedSize;
+    compressedImage.mData = data;
+    return compressedImage;
+}
@@ -0,0 +1,72 @@
+#ifndef COMPRESSEDIMAGE_H
+#define COMPRESSEDIMAGE_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QImage>
+#include <QList>
+#include <atomic>
+#include <memory>
+
+// An image compressed in memory with a fast lossless codec, for images that are
+// kept but not displayed or analyzed (e.g. the original images while filters are
+// applied, the steps of the filter history, the last comparison result).
+//
+// The image is split into horizontal bands that are compressed and decompressed
+// in parallel. 32-bit images are encoded in the QOI way: every pixel is stored as
+// a run, a reference to a recently seen color, or a small difference from the
+// previous pixel, so it costs a few operations per pixel. Images of other depths
+// are compressed with zlib at the fastest level. The format and the color table
+// are kept, so decompress() returns exactly the compressed image.
+//
+// The compressed data is implicitly shared, so copies are cheap. The sizes of all
+// the compressed images that are alive are summed up for the memory statistics.
+
+class CompressedImage
+{
+public:
+    CompressedImage() = default;
+    ~CompressedImage() = default;
+
+    static CompressedImage compress(const QImage &image);
+    QImage decompress() const;
+
+    bool isNull() const;
+    QSize size() const;
+    QImage::Format format() const;
+    qint64 getCompressedSize() const;
+    qint64 getUncompressedSize() const;
+
+    // Of all the compressed images that are alive
+    static qint64 getTotalCompressedSize();
+    static qint64 getTotalUncompressedSize();
+
+    // Stores the compressed data as is, e.g. in the temporary files of the application.
+    // read() throws std::runtime_error if the data is malformed.
+    void write(QDataStream &stream) const;
+    static CompressedImage read(QDataStream &stream);
+
+private:
+    struct Data {
+        ~Data();
+
+        QSize size;
+        QImage::Format format = QImage::Format_Invalid;
+        QList<QRgb> colorTable;
+        int bandHeight = 0;
+        QList<QByteArray> bands;
+        qint64 compressedSize = 0;
+        qint64 uncompressedSize = 0;
+    };
+
+    static constexpr int mMinBandHeight = 64;
+    static std::atomic<qint64> mTotalCompressedSize;
+    static std::atomic<qint64> mTotalUncompressedSize;
+
+    std::shared_ptr<const Data> mData;
+
+    static QByteArray encodeBand(const QImage &image, int top, int bottom);
+    static void decodeBand(const QByteArray &band, QImage &image, int top, int bottom);
+};
+
+#endif // COMPRESSEDIMAGE_H
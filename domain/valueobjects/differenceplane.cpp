@@ -0,0 +1,108 @@
+#include "differenceplane.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <domain/kernels/pixelkernels.h>
+
+
+DifferencePlane DifferencePlane::build(const QImage &first,
+                                       const QImage &second,
+                                       const RowDifferenceMap &rowDifferences
+                                       )
+{
+    if (first.size() != second.size()) {
+        throw std::runtime_error("Error: the images have different sizes.");
+    }
+    DifferencePlane plane;
+    if (first.isNull()) {
+        return plane;
+    }
+
+    // Format_RGB32 would premultiply the colors by alpha and drop the alpha channel
+    bool hasAlpha = first.hasAlphaChannel() || second.hasAlphaChannel();
+    QImage::Format format = hasAlpha ? QImage::Format_ARGB32 : QImage::Format_RGB32;
+    QImage firstImage = first.convertToFormat(format);
+    QImage secondImage = second.convertToFormat(format);
+    const int width = firstImage.width();
+
+    plane.mPlane = QImage(firstImage.size(), QImage::Format_Grayscale8);
+    for (int y = 0; y < firstImage.height(); ++y) {
+        uchar *planeLine = plane.mPlane.scanLine(y);
+        if (!rowDifferences.isRowDifferent(y)) {
+            memset(planeLine, 0, width);
+            continue;
+        }
+        const QRgb *firstLine = reinterpret_cast<const QRgb*>(firstImage.constScanLine(y));
+        const QRgb *secondLine = reinterpret_cast<const QRgb*>(secondImage.constScanLine(y));
+        PixelKernels::maxChannelDifference(firstLine, secondLine, planeLine, width);
+
+        // The kernel compares only the colors
+        if (hasAlpha) {
+            for (int x = 0; x < width; ++x) {
+                int alphaDifference = std::abs(qAlpha(firstLine[x]) - qAlpha(secondLine[x]));
+                planeLine[x] = static_cast<uchar>(std::max<int>(planeLine[x], alphaDifference));
+            }
+        }
+    }
+    return plane;
+}
+
+bool DifferencePlane::isNull() const {
+    return mPlane.isNull();
+}
+
+QSize DifferencePlane::size() const {
+    return mPlane.size();
+}
+
+qint64 DifferencePlane::getMemoryUsage() const {
+    return mPlane.sizeInBytes();
+}
+
+int DifferencePlane::width() const {
+    return mPlane.width();
+}
+
+int DifferencePlane::height() const {
+    return mPlane.height();
+}
+
+const uchar* DifferencePlane::constScanLine(int y) const {
+    return mPlane.constScanLine(y);
+}
+
+QList<qint64> DifferencePlane::getHistogram() const {
+    QList<quint64> bins(256, 0);
+    for (int y = 0; y < mPlane.height(); ++y) {
+        PixelKernels::histogram(mPlane.constScanLine(y), mPlane.width(), bins.data());
+    }
+    QList<qint64> histogram;
+    histogram.reserve(bins.size());
+    foreach (auto count, bins) {
+        histogram.append(static_cast<qint64>(count));
+    }
+    return histogram;
+}
+
+QImage DifferencePlane::map(const QList<QRgb> &colorTable, const QRect &area) const {
+    if (colorTable.size() != 256) {
+        throw std::runtime_error("Error: the color table must contain 256 colors.");
+    }
+    QRect boundedArea = area.intersected(mPlane.rect());
+    if (boundedArea.isEmpty()) {
+        return {};
+    }
+    QImage result(boundedArea.size(), QImage::Format_Indexed8);
+    result.setColorTable(colorTable);
+    for (int y = 0; y < boundedArea.height(); ++y) {
+        const uchar *planeLine = mPlane.constScanLine(boundedArea.top() + y) + boundedArea.left();
+        memcpy(result.scanLine(y), planeLine, boundedArea.width());
+    }
+    return result;
+}
+
+QImage DifferencePlane::map(const QList<QRgb> &colorTable) const {
+    return map(colorTable, mPlane.rect());
+}
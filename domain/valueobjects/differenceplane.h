@@ -0,0 +1,53 @@
+#ifndef DIFFERENCEPLANE_H
+#define DIFFERENCEPLANE_H
+
+#include <QImage>
+#include <QList>
+#include <domain/valueobjects/rowdifferencemap.h>
+
+// The maximum absolute difference of the R, G, B and alpha channels of every
+// pixel of two images, stored as an 8-bit plane. Images with an alpha channel
+// are compared in Format_ARGB32, so the colors of transparent pixels are not
+// premultiplied away and a change of the transparency alone is a difference. The difference comparators
+// (v.1, v.2, v.4) only need this value per pixel, so the plane is calculated
+// once per pair of images and every result is derived from it with a lookup
+// table, e.g. re-thresholding it for another range costs one pass over bytes.
+//
+// The plane is an implicitly shared QImage, so copies are cheap.
+
+class DifferencePlane
+{
+public:
+    DifferencePlane() = default;
+    ~DifferencePlane() = default;
+
+    // Rows that are identical according to rowDifferences are zero without
+    // being compared. Throws std::runtime_error if the sizes of the images differ.
+    static DifferencePlane build(const QImage &first,
+                                 const QImage &second,
+                                 const RowDifferenceMap &rowDifferences = {}
+                                 );
+
+    bool isNull() const;
+    QSize size() const;
+    int width() const;
+    int height() const;
+    qint64 getMemoryUsage() const;
+    const uchar* constScanLine(int y) const;
+
+    // The number of pixels with every difference value [0, 255]
+    QList<qint64> getHistogram() const;
+
+    // Maps every difference value to a color through a table of 256 colors.
+    // Only the given area of the plane is mapped; the result has its size.
+    // The result is a Format_Indexed8 image: the difference values are its color
+    // indexes, so it takes one byte per pixel and its colors can be changed later
+    // with QImage::setColorTable() without mapping the plane again.
+    QImage map(const QList<QRgb> &colorTable, const QRect &area) const;
+    QImage map(const QList<QRgb> &colorTable) const;
+
+private:
+    QImage mPlane;
+};
+
+#endif // DIFFERENCEPLANE_H
@@ -0,0 +1,27 @@
+#ifndef FRAMEPAIREXTRACTIONSETTINGS_H
+#define FRAMEPAIREXTRACTIONSETTINGS_H
+
+#include <QList>
+#include <QString>
+
+enum class FramePairExtractionMode {
+    FixedInterval,
+    SceneChanges,
+    Timestamps
+};
+
+// Describes which frame pairs are extracted from two videos and where they are saved.
+// The frames of the first video are saved in outputDirectory/first and the frames of
+// the second one in outputDirectory/second; a pair has the same file name in both.
+
+struct FramePairExtractionSettings {
+    FramePairExtractionMode mode = FramePairExtractionMode::FixedInterval;
+    qint64 intervalMs = 1000;
+    double sceneChangeThreshold = 20.0;  // Mean luminance difference of thumbnails [0, 255]
+    QList<qint64> timestampsMs;
+    int maxPairs = 100;
+    QString imageFormat = "png";         // "png", "bmp" or "ppm"
+    QString outputDirectory;
+};
+
+#endif // FRAMEPAIREXTRACTIONSETTINGS_H
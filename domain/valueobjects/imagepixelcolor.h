@@ -2,6 +2,8 @@
 #define IMAGEPIXELCOLOR_H
 
 #include <qstring.h>
+#include <cmath>
+#include <domain/valueobjects/brushstatistics.h>
 
 
 class ImagePixelColor {
@@ -18,6 +20,15 @@ public:
           mG(g),
           mB(b) {}
 
+    // The color is the mean color under the brush of the color picker,
+    // the values are -1 if the brush is outside of the image
+    ImagePixelColor(const QString &imageName, const BrushStatistics &statistics)
+        : mImageName(imageName),
+          mR(getMean(statistics, 0)),
+          mG(getMean(statistics, 1)),
+          mB(getMean(statistics, 2)),
+          mStatistics(statistics) {}
+
     QString getImageName() const {
         return mImageName;
     }
@@ -34,14 +45,27 @@ public:
         return mB;
     }
 
+    // It is null for a color that is not picked with a brush
+    const BrushStatistics& getStatistics() const {
+        return mStatistics;
+    }
+
     ImagePixelColor& operator=(const ImagePixelColor&) = default;
     ImagePixelColor& operator=(ImagePixelColor&&) = default;
 
 private:
+    static int getMean(const BrushStatistics &statistics, int channel) {
+        if (statistics.isNull()) {
+            return -1;
+        }
+        return static_cast<int>(std::lround(statistics.getChannelSums(channel).getMean()));
+    }
+
     QString mImageName;
     int mR;
     int mG;
     int mB;
+    BrushStatistics mStatistics;
 };
 
 #endif // IMAGEPIXELCOLOR_H
@@ -8,6 +8,7 @@ int ImageHolder::mGeneration = 0;
 
 ImageHolder::ImageHolder(const QPixmap &image, const QString &imagePath)
     : mIsTemporary(false),
+    mIsInMemory(false),
     mFirstImage(image),
     mFirstImagePath(imagePath)
 {
@@ -23,6 +24,7 @@ ImageHolder::ImageHolder(const QPixmap &firstImage,
                          const QString &secondImagePath
                          )
     : mIsTemporary(false),
+    mIsInMemory(false),
     mFirstImage(firstImage),
     mFirstImagePath(firstImagePath),
     mSecondImage(secondImage),
@@ -57,18 +59,37 @@ bool ImageHolder::isMarkedTemporary() const {
     return mIsTemporary;
 }
 
+void ImageHolder::markInMemory() {
+    mIsInMemory = true;
+}
+
+bool ImageHolder::isMarkedInMemory() const {
+    return mIsInMemory;
+}
+
 bool ImageHolder::isSingleImage() const {
-    return mSecondImage.isNull();
+    return mSecondImage.isNull() && mCompressedSecondImage.isNull();
 }
 
 bool ImageHolder::isPairOfImages() const {
-    return !mFirstImage.isNull() && !mSecondImage.isNull();
+    bool hasFirstImage = !mFirstImage.isNull() || !mCompressedFirstImage.isNull();
+    return hasFirstImage && !isSingleImage();
 }
 
 QPixmap ImageHolder::getFirstImage() const {
+    if (mFirstImage.isNull() && !mCompressedFirstImage.isNull()) {
+        if (mCachedFirstImage.isNull()) {
+            mCachedFirstImage = QPixmap::fromImage(mCompressedFirstImage.decompress());
+        }
+        return mCachedFirstImage;
+    }
     return mFirstImage;
 }
 
+QSize ImageHolder::getFirstImageSize() const {
+    return mFirstImage.isNull() ? mCompressedFirstImage.size() : mFirstImage.size();
+}
+
 QString ImageHolder::getFirstImagePath() const {
     return mFirstImagePath;
 }
@@ -77,12 +98,64 @@ QPixmap ImageHolder::getSecondImage() const {
     if (isSingleImage()) {
         throw std::runtime_error("ImageHolder contains the single image");
     }
+    if (mSecondImage.isNull()) {
+        if (mCachedSecondImage.isNull()) {
+            mCachedSecondImage = QPixmap::fromImage(mCompressedSecondImage.decompress());
+        }
+        return mCachedSecondImage;
+    }
     return mSecondImage;
 }
 
+QSize ImageHolder::getSecondImageSize() const {
+    if (isSingleImage()) {
+        throw std::runtime_error("ImageHolder contains the single image");
+    }
+    return mSecondImage.isNull() ? mCompressedSecondImage.size() : mSecondImage.size();
+}
+
 QString ImageHolder::getSecondImagePath() const {
     if (isSingleImage()) {
         throw std::runtime_error("ImageHolder contains the single image");
     }
     return mSecondImagePath;
 }
+
+void ImageHolder::compress() {
+    mCachedFirstImage = {};
+    mCachedSecondImage = {};
+    if (!mFirstImage.isNull()) {
+        mCompressedFirstImage = CompressedImage::compress(mFirstImage.toImage());
+        mFirstImage = {};
+    }
+    if (!mSecondImage.isNull()) {
+        mCompressedSecondImage = CompressedImage::compress(mSecondImage.toImage());
+        mSecondImage = {};
+    }
+}
+
+void ImageHolder::decompress() {
+    if (mFirstImage.isNull() && !mCompressedFirstImage.isNull()) {
+        mFirstImage = getFirstImage();
+        mCompressedFirstImage = {};
+        mCachedFirstImage = {};
+    }
+    if (mSecondImage.isNull() && !mCompressedSecondImage.isNull()) {
+        mSecondImage = getSecondImage();
+        mCompressedSecondImage = {};
+        mCachedSecondImage = {};
+    }
+}
+
+bool ImageHolder::isCompressed() const {
+    return mFirstImage.isNull() && !mCompressedFirstImage.isNull();
+}
+
+qint64 ImageHolder::getDecodedSize() const {
+    qint64 size = 0;
+    QList<const QPixmap*> images = { &mFirstImage, &mSecondImage, &mCachedFirstImage, &mCachedSecondImage };
+    foreach (auto image, images) {
+        size += static_cast<qint64>(image->width()) * image->height() * image->depth() / 8;
+    }
+    return size;
+}
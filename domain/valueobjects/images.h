@@ -2,6 +2,7 @@
 #define IMAGES_H
 
 #include <qpixmap.h>
+#include <domain/valueobjects/compressedimage.h>
 
 struct ImageHolder {
 
@@ -14,30 +15,57 @@ struct ImageHolder {
 
     ~ImageHolder();
 
-    // When the user selects an area of the image with the mouse while holding
-    // down Command, a new instance of the application opens with cropped images.
-    // These images are saved in the Temp folder and will be deleted upon closing
-    // the application unless the user saves them.
+    // The images that the application saved in the Temp folder itself (e.g. an image
+    // from the clipboard or frames extracted from videos). The files will be deleted
+    // upon closing the images unless the user saves them.
     void markTemporary();
     bool isMarkedTemporary() const;
 
+    // The images exist only in memory (e.g. a cropped area opened in a new window),
+    // their paths just name them and tell where they are saved by default.
+    void markInMemory();
+    bool isMarkedInMemory() const;
+
     bool isSingleImage() const;
     bool isPairOfImages() const;
 
+    // If the images are compressed, the first call decodes a copy that is cached
+    // next to the compressed image (e.g. to recompute a filter from the original
+    // images) until compress() is called again; decompress() them before they are
+    // displayed again
     QPixmap getFirstImage() const;
     QString getFirstImagePath() const;
+    QSize getFirstImageSize() const;
 
     QPixmap getSecondImage() const;
     QString getSecondImagePath() const;
+    QSize getSecondImageSize() const;
+
+    // Compresses the images while they are not displayed or analyzed, e.g. the
+    // original images while filters are applied (see CompressedImage), and
+    // decompresses them. Only one copy of an image is kept: the decoded image
+    // or the compressed one.
+    void compress();
+    void decompress();
+    bool isCompressed() const;
+
+    // The memory taken by the decoded images, including the cached copies; the
+    // compressed ones are counted by CompressedImage
+    qint64 getDecodedSize() const;
 
 private:
     bool mIsTemporary;
+    bool mIsInMemory;
 
     QPixmap mFirstImage;
     QString mFirstImagePath;
+    CompressedImage mCompressedFirstImage;
+    mutable QPixmap mCachedFirstImage;
 
     QPixmap mSecondImage;
     QString mSecondImagePath;
+    CompressedImage mCompressedSecondImage;
+    mutable QPixmap mCachedSecondImage;
 
 #ifdef QT_DEBUG
     static int mGeneration;
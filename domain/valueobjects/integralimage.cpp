@@ -0,0 +1,78 @@
+#include "integralimage.h"
+
+#include <domain/kernels/pixelkernels.h>
+#include <domain/utils/parallel.h>
+
+
+namespace {
+
+constexpr int channelCount = 5;
+
+} // namespace
+
+IntegralImage IntegralImage::build(const QImage &image, const std::function<bool()> &isCanceled) {
+    IntegralImage integralImage;
+    if (image.isNull()) {
+        return integralImage;
+    }
+    QImage pixels = image.convertToFormat(QImage::Format_RGB32);
+    int width = pixels.width();
+    integralImage.mSize = pixels.size();
+    integralImage.mTables.resize(channelCount);
+
+    Parallel::run(channelCount, [&](int channel) {
+        SummedAreaTable::RowProvider getRow;
+        switch (static_cast<StatisticsChannel>(channel)) {
+        case StatisticsChannel::Red:
+        case StatisticsChannel::Green:
+        case StatisticsChannel::Blue: {
+            int shift = 16 - 8 * channel;
+            getRow = [&pixels, width, shift](int y, uchar *values) {
+                PixelKernels::extractChannel(reinterpret_cast<const QRgb*>(pixels.constScanLine(y)), values, width, shift);
+            };
+            break;
+        }
+        case StatisticsChannel::Luminance:
+            getRow = [&pixels, width](int y, uchar *values) {
+                PixelKernels::luminance(reinterpret_cast<const QRgb*>(pixels.constScanLine(y)), values, width);
+            };
+            break;
+        case StatisticsChannel::Brightness:
+            getRow = [&pixels, width](int y, uchar *values) {
+                PixelKernels::grayscale(reinterpret_cast<const QRgb*>(pixels.constScanLine(y)), values, width);
+            };
+            break;
+        }
+        auto content = (static_cast<StatisticsChannel>(channel) == StatisticsChannel::Luminance)
+                           ? SummedAreaTable::Content::SumsAndSquares
+                           : SummedAreaTable::Content::Sums;
+        integralImage.mTables[channel] = SummedAreaTable::build(width, pixels.height(), getRow, content, isCanceled);
+    });
+    if (isCanceled && isCanceled()) {
+        return {};
+    }
+    return integralImage;
+}
+
+bool IntegralImage::isNull() const {
+    return mTables.empty();
+}
+
+QSize IntegralImage::size() const {
+    return mSize;
+}
+
+qint64 IntegralImage::getMemoryUsage() const {
+    qint64 usage = 0;
+    for (const auto &table : mTables) {
+        usage += table.getMemoryUsage();
+    }
+    return usage;
+}
+
+RegionSums IntegralImage::getRegionSums(StatisticsChannel channel, const QRect &region) const {
+    if (isNull()) {
+        return {};
+    }
+    return mTables[static_cast<int>(channel)].getRegionSums(region);
+}
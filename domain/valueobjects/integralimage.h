@@ -0,0 +1,48 @@
+#ifndef INTEGRALIMAGE_H
+#define INTEGRALIMAGE_H
+
+#include <QImage>
+#include <QRect>
+#include <functional>
+#include <vector>
+#include <domain/valueobjects/summedareatable.h>
+
+enum class StatisticsChannel {
+    Red,
+    Green,
+    Blue,
+    Luminance,  // Rec. 709, as in the Contrast comparator
+    Brightness  // qGray(), as in the Brightness comparator
+};
+
+// The summed-area tables of the channels of an image (see SummedAreaTable), so the
+// mean, the variance and the contrast of any region are answered in O(1), e.g. for
+// a live statistics panel that follows the mouse selection.
+//
+// The tables of the channels are built in parallel. Only the luminance, whose
+// standard deviation is the contrast, keeps the sums of squares, so the tables
+// take about 24 bytes per pixel (see SummedAreaTable).
+
+class IntegralImage
+{
+public:
+    IntegralImage() = default;
+    ~IntegralImage() = default;
+
+    // isCanceled is polled between the rows; a canceled build returns a null integral image
+    static IntegralImage build(const QImage &image, const std::function<bool()> &isCanceled = {});
+
+    bool isNull() const;
+    QSize size() const;
+    qint64 getMemoryUsage() const;
+
+    // The region is clipped to the image. The sum of squares is zero for
+    // every channel but the luminance.
+    RegionSums getRegionSums(StatisticsChannel channel, const QRect &region) const;
+
+private:
+    QSize mSize;
+    std::vector<SummedAreaTable> mTables; // In the order of StatisticsChannel
+};
+
+#endif // INTEGRALIMAGE_H
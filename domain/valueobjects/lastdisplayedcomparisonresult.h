@@ -1,33 +1,85 @@
 #ifndef LASTDISPLAYEDCOMPARISONRESULT_H
 #define LASTDISPLAYEDCOMPARISONRESULT_H
 
-#include <qpixmap.h>
+#include <qimage.h>
+#include <QFuture>
+#include <QMutex>
+#include <QtConcurrent>
+#include <memory>
+#include <domain/valueobjects/compressedimage.h>
 
+// The result is kept compressed (see CompressedImage): it is displayed by the
+// viewer when it is set, and only decompressed when it is shown again. Difference
+// visualizations are Format_Indexed8 and mostly uniform, so they take a small
+// fraction of the memory of a pixmap while they are waiting to be shown.
+//
+// The result is compressed in the background, so setting it does not hold up the
+// GUI thread. The decoded image is released once the compressed copy is ready;
+// until then it is returned as is.
 
 struct LastDisplayedComparisonResult {
 public:
-    void set(const QPixmap &image, const QString &description) {
-        this->mImage = image;
+    ~LastDisplayedComparisonResult() {
+        // The compression task owns the state it writes to, so it is not waited for
+        mCompression.cancel();
+    }
+
+    void set(const QImage &image, const QString &description) {
+        mCompression.cancel();
+        if (image.isNull()) {
+            clear();
+            return;
+        }
+        auto state = std::make_shared<State>();
+        state->image = image;
+        this->mState = state;
         this->mDescription = description;
+        mCompression = QtConcurrent::run([state](QPromise<void> &promise) {
+            if (promise.isCanceled()) {
+                return;
+            }
+            QImage image;
+            {
+                QMutexLocker locker(&state->mutex);
+                image = state->image;
+            }
+            try {
+                CompressedImage compressedImage = CompressedImage::compress(image);
+                QMutexLocker locker(&state->mutex);
+                state->compressedImage = compressedImage;
+                state->image = {};
+            } catch (...) {
+                // The decoded image is kept
+            }
+        });
     }
 
     void clear() {
-        mImage = std::nullopt;
+        mCompression.cancel();
+        mState = nullptr;
         mDescription = "";
     }
 
-    bool hasLastDisplayedComparisonResult() {
-        return (mImage != std::nullopt);
+    bool hasLastDisplayedComparisonResult() const {
+        return mState != nullptr;
     }
 
-    QPixmap getImage() const {
-        if (!mImage.has_value()) {
+    QImage getImage() const {
+        CompressedImage compressedImage;
+        if (mState != nullptr) {
+            QMutexLocker locker(&mState->mutex);
+            if (!mState->image.isNull()) {
+                return mState->image;
+            }
+            compressedImage = mState->compressedImage;
+        }
+        if (compressedImage.isNull()) {
             throw std::runtime_error("The application is in an inconsistent state. "
                                      "Please report the following information to the "
-                                     "app developer: an empty QPixmap was requested in "
+                                     "app developer: an empty QImage was requested in "
                                      "the function LastDisplayedComparisonResult::getImage.");
         }
-        return mImage.value();
+        return compressedImage.decompress();
     }
 
     QString getDescription() const {
@@ -35,7 +87,15 @@ public:
     }
 
 private:
-    std::optional<QPixmap> mImage;
+    // Shared with the compression task, which may outlive the result
+    struct State {
+        QMutex mutex;
+        QImage image;
+        CompressedImage compressedImage;
+    };
+
+    std::shared_ptr<State> mState;
+    QFuture<void> mCompression;
     QString mDescription;
 };
 
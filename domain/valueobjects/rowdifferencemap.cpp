@@ -0,0 +1,96 @@
+#include "rowdifferencemap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <domain/valueobjects/rowindex.h>
+
+
+RowDifferenceMap RowDifferenceMap::build(const QImage &first,
+                                         const QImage &second,
+                                         const std::function<bool()> &isCanceled
+                                         )
+{
+    RowDifferenceMap map;
+    if (first.isNull() || second.isNull() || first.size() != second.size()) {
+        return map;
+    }
+
+    // Different formats have to be compared pixel by pixel in a common one, and so do
+    // indexed images with different color tables: equal indices may mean different colors
+    QImage firstImage = first;
+    QImage secondImage = second;
+    bool isIndexed = first.colorCount() > 0 || second.colorCount() > 0;
+    if (first.format() != second.format() || (isIndexed && first.colorTable() != second.colorTable())) {
+        firstImage = first.convertToFormat(QImage::Format_ARGB32);
+        secondImage = second.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    // The padding at the end of a scanline is not a part of the image
+    const size_t rowBytes = RowIndex::getRowBytes(firstImage);
+    const int height = firstImage.height();
+
+    map.mIsKnown = true;
+    map.mDifferentRows = QBitArray(height, false);
+    for (int y = 0; y < height; ++y) {
+        if (isCanceled && isCanceled()) {
+            return {};
+        }
+        if (memcmp(firstImage.constScanLine(y), secondImage.constScanLine(y), rowBytes) == 0) {
+            continue;
+        }
+        map.mDifferentRows.setBit(y);
+        ++map.mDifferentRowCount;
+        if (!map.mDifferentRowRanges.isEmpty() && map.mDifferentRowRanges.last().second == y - 1) {
+            map.mDifferentRowRanges.last().second = y;
+        } else {
+            map.mDifferentRowRanges.append({ y, y });
+        }
+    }
+    return map;
+}
+
+bool RowDifferenceMap::isKnown() const {
+    return mIsKnown;
+}
+
+bool RowDifferenceMap::isIdentical() const {
+    return mIsKnown && mDifferentRowCount == 0;
+}
+
+bool RowDifferenceMap::isRowDifferent(int y) const {
+    return !mIsKnown || mDifferentRows.testBit(y);
+}
+
+int RowDifferenceMap::getDifferentRowCount() const {
+    return mDifferentRowCount;
+}
+
+int RowDifferenceMap::getHeight() const {
+    return mDifferentRows.size();
+}
+
+const QList<QPair<int, int>>& RowDifferenceMap::getDifferentRowRanges() const {
+    return mDifferentRowRanges;
+}
+
+RowDifferenceMap RowDifferenceMap::mid(int top, int height) const {
+    RowDifferenceMap map;
+    if (!mIsKnown) {
+        return map;
+    }
+    top = std::clamp(top, 0, getHeight());
+    height = std::clamp(height, 0, getHeight() - top);
+    map.mIsKnown = true;
+    map.mDifferentRows = QBitArray(height, false);
+    foreach (auto range, mDifferentRowRanges) {
+        int first = std::max(range.first, top) - top;
+        int last = std::min(range.second, top + height - 1) - top;
+        if (first > last) {
+            continue;
+        }
+        map.mDifferentRows.fill(true, first, last + 1);
+        map.mDifferentRowRanges.append({ first, last });
+        map.mDifferentRowCount += last - first + 1;
+    }
+    return map;
+}
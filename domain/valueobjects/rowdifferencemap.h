@@ -0,0 +1,54 @@
+#ifndef ROWDIFFERENCEMAP_H
+#define ROWDIFFERENCEMAP_H
+
+#include <QBitArray>
+#include <QImage>
+#include <QList>
+#include <QPair>
+#include <functional>
+
+// Which rows of two images of the same size differ. The scanlines are compared
+// with memcmp (vectorized by the C library), so building the map costs about
+// as much as reading both images once. Comparators use it to skip the rows in
+// which every pixel is equal, and to report identical images immediately.
+//
+// A default-constructed map knows nothing about the images, so every row is
+// treated as different.
+
+class RowDifferenceMap
+{
+public:
+    RowDifferenceMap() = default;
+    ~RowDifferenceMap() = default;
+
+    // If the sizes of the images differ, the returned map is unknown. isCanceled is
+    // polled between the rows; a canceled build returns an unknown map.
+    static RowDifferenceMap build(const QImage &first,
+                                  const QImage &second,
+                                  const std::function<bool()> &isCanceled = {}
+                                  );
+
+    bool isKnown() const;
+
+    // True only if the map is known and no row differs.
+    bool isIdentical() const;
+
+    bool isRowDifferent(int y) const;
+    int getDifferentRowCount() const;
+    int getHeight() const;
+
+    // The ranges [first, last] of consecutive differing rows
+    const QList<QPair<int, int>>& getDifferentRowRanges() const;
+
+    // The map of the rows [top, top + height), e.g. of a tile of the images.
+    // The rows are renumbered from 0; an unknown map stays unknown.
+    RowDifferenceMap mid(int top, int height) const;
+
+private:
+    bool mIsKnown = false;
+    QBitArray mDifferentRows;
+    QList<QPair<int, int>> mDifferentRowRanges;
+    int mDifferentRowCount = 0;
+};
+
+#endif // ROWDIFFERENCEMAP_H
@@ -0,0 +1,97 @@
+#include "rowindex.h"
+
+#include <QHash>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+
+RowIndex::RowIndex(const QImage &image)
+    : mSize(image.size()),
+    mImage(image),
+    mLuma(image.convertToFormat(QImage::Format_Grayscale8)),
+    mRowHashes(hashRows(image))
+{
+    int width = mLuma.width();
+    mRowEnergy.assign(mLuma.height(), 0.0f);
+    for (int y = 1; y < mLuma.height() && width > 0; ++y) {
+        int sum = sumOfAbsoluteDifferences(mLuma.constScanLine(y - 1), mLuma.constScanLine(y), width);
+        mRowEnergy[y] = static_cast<float>(sum) / width;
+    }
+}
+
+int RowIndex::getHeight() const {
+    return mSize.height();
+}
+
+QSize RowIndex::getSize() const {
+    return mSize;
+}
+
+const std::vector<quint64>& RowIndex::getRowHashes() const {
+    return mRowHashes;
+}
+
+const std::vector<float>& RowIndex::getRowEnergy() const {
+    return mRowEnergy;
+}
+
+std::vector<quint64> RowIndex::hashRows(const QImage &image) {
+    std::vector<quint64> hashes;
+    hashes.reserve(image.height());
+
+    // Only the visible part of the scan line is hashed: the padding
+    // at the end of a line may contain garbage.
+    size_t rowBytes = getRowBytes(image);
+    for (int y = 0; y < image.height(); ++y) {
+        hashes.push_back(qHashBits(image.constScanLine(y), rowBytes, y));
+    }
+    return hashes;
+}
+
+size_t RowIndex::getRowBytes(const QImage &image) {
+    return (static_cast<size_t>(image.width()) * image.depth() + 7) / 8;
+}
+
+bool RowIndex::isRowEqual(const RowIndex &first, const RowIndex &second, int y) {
+    if (first.mRowHashes[y] != second.mRowHashes[y]) {
+        return false;
+    }
+    if (first.mImage.format() != second.mImage.format() || first.mSize != second.mSize) {
+        return false;
+    }
+    return memcmp(first.mImage.constScanLine(y), second.mImage.constScanLine(y), getRowBytes(first.mImage)) == 0;
+}
+
+std::vector<float> RowIndex::calculateRowDifferences(const RowIndex &first, const RowIndex &second) {
+    if (first.mSize != second.mSize) {
+        throw std::runtime_error("Error: the images must have the same size.");
+    }
+    int width = first.mLuma.width();
+    std::vector<float> differences(first.getHeight(), 0.0f);
+    for (int y = 0; y < first.getHeight() && width > 0; ++y) {
+        if (isRowEqual(first, second, y)) {
+            continue;
+        }
+        int sum = sumOfAbsoluteDifferences(first.mLuma.constScanLine(y), second.mLuma.constScanLine(y), width);
+        differences[y] = static_cast<float>(sum) / width;
+    }
+    return differences;
+}
+
+int RowIndex::calculateMaxDifference(const uchar *first, const uchar *second, int bytes) {
+    int maxDifference = 0;
+    for (int i = 0; i < bytes; ++i) {
+        maxDifference = std::max(maxDifference, std::abs(static_cast<int>(first[i]) - static_cast<int>(second[i])));
+    }
+    return maxDifference;
+}
+
+int RowIndex::sumOfAbsoluteDifferences(const uchar *first, const uchar *second, int count) {
+    int sum = 0;
+    for (int i = 0; i < count; ++i) {
+        sum += std::abs(static_cast<int>(first[i]) - static_cast<int>(second[i]));
+    }
+    return sum;
+}
@@ -0,0 +1,60 @@
+#ifndef ROWINDEX_H
+#define ROWINDEX_H
+
+#include <QImage>
+#include <vector>
+
+// A per-row description of an image used to find horizontal discontinuities:
+//  - the hash of every row of the original pixels, so most of the differing rows
+//    of two images are recognized without looking at their pixels; rows with equal
+//    hashes are confirmed by comparing their bytes (see isRowEqual);
+//  - the luminance plane, from which the per-row differences are calculated;
+//  - the inter-row difference energy, i.e. the mean absolute luminance difference
+//    between a row and the row above it. A tear line shows up as a spike of it.
+// The inner loops work on contiguous 8-bit rows and accumulate into integers,
+// so the compiler can vectorize them.
+
+class RowIndex
+{
+public:
+    explicit RowIndex(const QImage &image);
+    ~RowIndex() = default;
+
+    int getHeight() const;
+    QSize getSize() const;
+    const std::vector<quint64>& getRowHashes() const;
+    const std::vector<float>& getRowEnergy() const;
+
+    // The hash of the visible part of every row of the image.
+    static std::vector<quint64> hashRows(const QImage &image);
+
+    // The number of bytes of the visible part of a row, without the padding at the
+    // end of the scan line. Rows of images with less than 8 bits per pixel end in a
+    // partially used byte, which is counted.
+    static size_t getRowBytes(const QImage &image);
+
+    // Whether the row y of the original pixels of the two images is the same: the
+    // hashes are compared first and equal hashes are confirmed by the row bytes.
+    // Rows of images of different formats are never equal.
+    static bool isRowEqual(const RowIndex &first, const RowIndex &second, int y);
+
+    // The mean absolute luminance difference of every row of the two images;
+    // identical rows are skipped (see isRowEqual). Throws std::runtime_error
+    // if the sizes of the images differ.
+    static std::vector<float> calculateRowDifferences(const RowIndex &first, const RowIndex &second);
+
+    // The maximum absolute difference of the bytes of two rows, e.g. of the color
+    // channels of two Format_RGB32 rows (their 4th bytes are always 0xFF).
+    static int calculateMaxDifference(const uchar *first, const uchar *second, int bytes);
+
+private:
+    QSize mSize;
+    QImage mImage;
+    QImage mLuma;
+    std::vector<quint64> mRowHashes;
+    std::vector<float> mRowEnergy;
+
+    static int sumOfAbsoluteDifferences(const uchar *first, const uchar *second, int count);
+};
+
+#endif // ROWINDEX_H
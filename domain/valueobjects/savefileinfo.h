@@ -1,6 +1,7 @@
 #ifndef SAVEFILEINFO_H
 #define SAVEFILEINFO_H
 
+#include <qimage.h>
 #include <qpixmap.h>
 
 enum class SaveImageInfoType {
@@ -13,15 +14,21 @@ enum class SaveImageInfoType {
     ComparisonImageArea
 };
 
+// The image is saved as it is, so an image produced by a comparator keeps its
+// format, e.g. a paletted difference image is saved as a paletted PNG.
+
 struct SaveImageInfo {
     SaveImageInfo(SaveImageInfoType saveImageInfoType, const QPixmap &image) :
-        mSaveImageInfoType(saveImageInfoType), mImage(std::move(image)) {}
+        mSaveImageInfoType(saveImageInfoType), mImage(image.toImage()) {}
+
+    SaveImageInfo(SaveImageInfoType saveImageInfoType, const QImage &image) :
+        mSaveImageInfoType(saveImageInfoType), mImage(image) {}
 
     SaveImageInfo() : mSaveImageInfoType(SaveImageInfoType::None) {
     }
 
     const SaveImageInfoType mSaveImageInfoType;
-    const QPixmap mImage;
+    const QImage mImage;
 };
 
 typedef std::shared_ptr<QString> QStringPtr;
@@ -0,0 +1,196 @@
+#include "summedareatable.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+double RegionSums::getMean() const {
+    return pixelCount == 0 ? 0.0 : static_cast<double>(sum) / pixelCount;
+}
+
+double RegionSums::getVariance() const {
+    if (pixelCount == 0) {
+        return 0.0;
+    }
+    double mean = getMean();
+    return std::max(0.0, static_cast<double>(sumOfSquares) / pixelCount - mean * mean);
+}
+
+double RegionSums::getStandardDeviation() const {
+    return std::sqrt(getVariance());
+}
+
+SummedAreaTable SummedAreaTable::build(int width,
+                                       int height,
+                                       const RowProvider &getRow,
+                                       Content content,
+                                       const std::function<bool()> &isCanceled
+                                       )
+{
+    SummedAreaTable table;
+    if (width <= 0 || height <= 0) {
+        return table;
+    }
+    table.mWidth = width;
+    table.mHeight = height;
+    table.mTileColumns = width / mTileSize + 1;
+    table.mTileRows = height / mTileSize + 1;
+
+    const size_t stride = width + 1;
+    table.mTileSums.assign(stride * (height + 1), 0);
+    bool hasSumsOfSquares = (content == Content::SumsAndSquares);
+    if (hasSumsOfSquares) {
+        table.mTileSumsOfSquares.assign(stride * (height + 1), 0);
+    }
+    table.mColumnStrips.assign(static_cast<size_t>(table.mTileRows) * stride, {});
+    table.mRowStrips.assign(static_cast<size_t>(height + 1) * table.mTileColumns, {});
+    table.mCorners.assign(static_cast<size_t>(table.mTileRows) * table.mTileColumns, {});
+
+    std::vector<uchar> values(width);
+    std::vector<quint32> rowTileSums(stride);           // The sums of the row within the tile of x
+    std::vector<quint32> rowTileSumsOfSquares(stride);
+    std::vector<Sums> rowWholeTileSums(table.mTileColumns); // The sums of the row over the whole tiles left of tx
+
+    for (int y = 0; y < height; ++y) {
+        if (isCanceled && isCanceled()) {
+            return {};
+        }
+        getRow(y, values.data());
+
+        quint32 sum = 0;
+        quint32 sumOfSquares = 0;
+        Sums wholeTiles;
+        for (int x = 0; x <= width; ++x) {
+            if (x % mTileSize == 0) {
+                wholeTiles.sum += sum;
+                wholeTiles.sumOfSquares += sumOfSquares;
+                rowWholeTileSums[x / mTileSize] = wholeTiles;
+                sum = 0;
+                sumOfSquares = 0;
+            }
+            rowTileSums[x] = sum;
+            rowTileSumsOfSquares[x] = sumOfSquares;
+            if (x < width) {
+                quint32 value = values[x];
+                sum += value;
+                sumOfSquares += value * value;
+            }
+        }
+
+        // The row y is added to the entries of the row y + 1; when a tile row is
+        // completed, its tile parts are moved to the strips and the corners
+        const quint32 *previousSums = &table.mTileSums[y * stride];
+        const Sums *previousRowStrips = &table.mRowStrips[static_cast<size_t>(y) * table.mTileColumns];
+        quint32 *nextSums = &table.mTileSums[(y + 1) * stride];
+        Sums *nextRowStrips = &table.mRowStrips[static_cast<size_t>(y + 1) * table.mTileColumns];
+        // The strips and the corners are small, so only the tile parts of the
+        // sums of squares are skipped if the table is built without them
+        const quint32 *previousSumsOfSquares = hasSumsOfSquares ? &table.mTileSumsOfSquares[y * stride]
+                                                                : nullptr;
+        quint32 *nextSumsOfSquares = hasSumsOfSquares ? &table.mTileSumsOfSquares[(y + 1) * stride]
+                                                      : nullptr;
+
+        bool isTileRowCompleted = (y + 1) % mTileSize == 0;
+        if (!isTileRowCompleted) {
+            for (size_t x = 0; x < stride; ++x) {
+                nextSums[x] = previousSums[x] + rowTileSums[x];
+            }
+            if (hasSumsOfSquares) {
+                for (size_t x = 0; x < stride; ++x) {
+                    nextSumsOfSquares[x] = previousSumsOfSquares[x] + rowTileSumsOfSquares[x];
+                }
+            }
+            for (int tx = 0; tx < table.mTileColumns; ++tx) {
+                nextRowStrips[tx].sum = previousRowStrips[tx].sum + rowWholeTileSums[tx].sum;
+                nextRowStrips[tx].sumOfSquares = previousRowStrips[tx].sumOfSquares + rowWholeTileSums[tx].sumOfSquares;
+            }
+            continue;
+        }
+
+        int tileRow = (y + 1) / mTileSize;
+        const Sums *previousColumnStrips = &table.mColumnStrips[(tileRow - 1) * stride];
+        Sums *nextColumnStrips = &table.mColumnStrips[tileRow * stride];
+        for (size_t x = 0; x < stride; ++x) {
+            nextColumnStrips[x].sum = previousColumnStrips[x].sum + previousSums[x] + rowTileSums[x];
+            if (hasSumsOfSquares) {
+                nextColumnStrips[x].sumOfSquares = previousColumnStrips[x].sumOfSquares +
+                                                   previousSumsOfSquares[x] +
+                                                   rowTileSumsOfSquares[x];
+            }
+        }
+        const Sums *previousCorners = &table.mCorners[(tileRow - 1) * table.mTileColumns];
+        Sums *nextCorners = &table.mCorners[tileRow * table.mTileColumns];
+        for (int tx = 0; tx < table.mTileColumns; ++tx) {
+            nextCorners[tx].sum = previousCorners[tx].sum + previousRowStrips[tx].sum + rowWholeTileSums[tx].sum;
+            nextCorners[tx].sumOfSquares = previousCorners[tx].sumOfSquares +
+                                           previousRowStrips[tx].sumOfSquares +
+                                           rowWholeTileSums[tx].sumOfSquares;
+        }
+        // The entries of the row y + 1 start a new tile row, so they stay zero
+    }
+    return table;
+}
+
+bool SummedAreaTable::isNull() const {
+    return mWidth == 0;
+}
+
+bool SummedAreaTable::hasSumsOfSquares() const {
+    return !mTileSumsOfSquares.empty();
+}
+
+qint64 SummedAreaTable::getMemoryUsage() const {
+    return static_cast<qint64>(mTileSums.size() + mTileSumsOfSquares.size()) * sizeof(quint32) +
+           static_cast<qint64>(mColumnStrips.size() + mRowStrips.size() + mCorners.size()) * sizeof(Sums);
+}
+
+int SummedAreaTable::width() const {
+    return mWidth;
+}
+
+int SummedAreaTable::height() const {
+    return mHeight;
+}
+
+RegionSums SummedAreaTable::getRegionSums(const QRect &region) const {
+    QRect clippedRegion = region.intersected(QRect(0, 0, mWidth, mHeight));
+    RegionSums result;
+    if (clippedRegion.isEmpty()) {
+        return result;
+    }
+    int left = clippedRegion.left();
+    int top = clippedRegion.top();
+    int right = left + clippedRegion.width();
+    int bottom = top + clippedRegion.height();
+
+    Sums bottomRight = getPrefixSums(right, bottom);
+    Sums bottomLeft = getPrefixSums(left, bottom);
+    Sums topRight = getPrefixSums(right, top);
+    Sums topLeft = getPrefixSums(left, top);
+    result.pixelCount = static_cast<qint64>(clippedRegion.width()) * clippedRegion.height();
+    result.sum = bottomRight.sum - bottomLeft.sum - topRight.sum + topLeft.sum;
+    if (hasSumsOfSquares()) {
+        result.sumOfSquares = bottomRight.sumOfSquares - bottomLeft.sumOfSquares -
+                              topRight.sumOfSquares + topLeft.sumOfSquares;
+    }
+    return result;
+}
+
+// The sums over [0, x) x [0, y)
+SummedAreaTable::Sums SummedAreaTable::getPrefixSums(int x, int y) const {
+    const size_t stride = mWidth + 1;
+    int tileColumn = x / mTileSize;
+    int tileRow = y / mTileSize;
+    const Sums &corner = mCorners[tileRow * mTileColumns + tileColumn];
+    const Sums &columnStrip = mColumnStrips[tileRow * stride + x];
+    const Sums &rowStrip = mRowStrips[static_cast<size_t>(y) * mTileColumns + tileColumn];
+    size_t index = y * stride + x;
+
+    Sums sums;
+    sums.sum = corner.sum + columnStrip.sum + rowStrip.sum + mTileSums[index];
+    if (hasSumsOfSquares()) {
+        sums.sumOfSquares = corner.sumOfSquares + columnStrip.sumOfSquares +
+                            rowStrip.sumOfSquares + mTileSumsOfSquares[index];
+    }
+    return sums;
+}
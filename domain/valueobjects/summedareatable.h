@@ -0,0 +1,86 @@
+#ifndef SUMMEDAREATABLE_H
+#define SUMMEDAREATABLE_H
+
+#include <QRect>
+#include <functional>
+#include <vector>
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct RegionSums {
+    qint64 pixelCount = 0;
+    quint64 sum = 0;
+    quint64 sumOfSquares = 0;
+
+    double getMean() const;
+    double getVariance() const;
+    double getStandardDeviation() const;
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// The sums and the sums of squares of a plane of 8-bit values (e.g. a channel of
+// an image) over any rectangle, in O(1).
+//
+// A plain summed-area table needs 64-bit entries for the sums of squares of large
+// images. Here the plane is split into tiles of mTileSize x mTileSize, and the sum
+// of a rectangle anchored at the origin is composed of four parts: the whole tiles
+// above and to the left of the corner, the strip of the tiles above the corner,
+// the strip of the tiles to the left of it and the part of the corner's own tile.
+// Only the last part is stored per value, and it fits in 32 bits; the strips and
+// the whole tiles are stored with 64 bits per tile row or per tile column, so the
+// table takes about 8 bytes per value and is exact for any size of the plane.
+// Without the sums of squares (e.g. for the means only) it takes about 4 bytes.
+
+class SummedAreaTable
+{
+public:
+    // Writes the width values of the row y to the buffer
+    typedef std::function<void(int y, uchar *values)> RowProvider;
+
+    enum class Content { Sums, SumsAndSquares };
+
+    SummedAreaTable() = default;
+    ~SummedAreaTable() = default;
+
+    // isCanceled is polled between the rows; a canceled build returns a null table
+    static SummedAreaTable build(int width,
+                                 int height,
+                                 const RowProvider &getRow,
+                                 Content content = Content::SumsAndSquares,
+                                 const std::function<bool()> &isCanceled = {}
+                                 );
+
+    bool isNull() const;
+    bool hasSumsOfSquares() const;
+    int width() const;
+    int height() const;
+    qint64 getMemoryUsage() const;
+
+    // The region is clipped to the plane. The sum of squares is zero if the
+    // table is built without them.
+    RegionSums getRegionSums(const QRect &region) const;
+
+private:
+    struct Sums {
+        quint64 sum = 0;
+        quint64 sumOfSquares = 0;
+    };
+
+    static constexpr int mTileSize = 256;
+
+    int mWidth = 0;
+    int mHeight = 0;
+    int mTileColumns = 0;   // The number of tile corners along x: width / mTileSize + 1
+    int mTileRows = 0;      // The number of tile corners along y: height / mTileSize + 1
+
+    std::vector<quint32> mTileSums;              // (height + 1) x (width + 1)
+    std::vector<quint32> mTileSumsOfSquares;     // (height + 1) x (width + 1), or empty
+    std::vector<Sums> mColumnStrips;             // mTileRows x (width + 1)
+    std::vector<Sums> mRowStrips;                // (height + 1) x mTileColumns
+    std::vector<Sums> mCorners;                  // mTileRows x mTileColumns
+
+    Sums getPrefixSums(int x, int y) const;
+};
+
+#endif // SUMMEDAREATABLE_H
@@ -0,0 +1,179 @@
+#include "tiledimagebuffer.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+
+TiledImageBuffer::TiledImageBuffer(const QSize &size, int tileSize)
+    : mSize(size),
+    mTileSize(std::max(1, tileSize)),
+    mPendingTileCount(0),
+    mReadyTileCount(0),
+    mVisibleArea(QPoint(0, 0), size),
+    mIsCanceled(false)
+{
+    mColumnCount = (std::max(0, size.width()) + mTileSize - 1) / mTileSize;
+    mRowCount = (std::max(0, size.height()) + mTileSize - 1) / mTileSize;
+    mPendingTileCount = mColumnCount * mRowCount;
+    mTileStates.assign(mPendingTileCount, TileState::Pending);
+    mTiles.resize(mPendingTileCount);
+}
+
+QSize TiledImageBuffer::getSize() const {
+    return mSize;
+}
+
+int TiledImageBuffer::getTileSize() const {
+    return mTileSize;
+}
+
+int TiledImageBuffer::getColumnCount() const {
+    return mColumnCount;
+}
+
+int TiledImageBuffer::getRowCount() const {
+    return mRowCount;
+}
+
+int TiledImageBuffer::getTileCount() const {
+    return mColumnCount * mRowCount;
+}
+
+QRect TiledImageBuffer::getTileRect(int index) const {
+    if (index < 0 || index >= getTileCount()) {
+        return {};
+    }
+    QRect tile { (index % mColumnCount) * mTileSize, (index / mColumnCount) * mTileSize, mTileSize, mTileSize };
+    return tile.intersected(QRect(QPoint(0, 0), mSize));
+}
+
+int TiledImageBuffer::takeNextTile() {
+    QMutexLocker locker(&mMutex);
+    if (mIsCanceled || mPendingTileCount == 0) {
+        return -1;
+    }
+    // The visible tiles go first, then the closest ones to the center of the viewport
+    QPoint center = mVisibleArea.center();
+    int bestIndex = -1;
+    bool isBestVisible = false;
+    qint64 bestDistance = std::numeric_limits<qint64>::max();
+    for (int index = 0; index < getTileCount(); ++index) {
+        if (mTileStates[index] != TileState::Pending) {
+            continue;
+        }
+        QRect tile = getTileRect(index);
+        bool isVisible = tile.intersects(mVisibleArea);
+        if (isBestVisible && !isVisible) {
+            continue;
+        }
+        qint64 dx = tile.center().x() - center.x();
+        qint64 dy = tile.center().y() - center.y();
+        qint64 distance = dx * dx + dy * dy;
+        if ((isVisible && !isBestVisible) || distance < bestDistance) {
+            bestIndex = index;
+            isBestVisible = isVisible;
+            bestDistance = distance;
+        }
+    }
+    mTileStates[bestIndex] = TileState::Rendering;
+    --mPendingTileCount;
+    return bestIndex;
+}
+
+void TiledImageBuffer::setTile(int index, const QImage &tile) {
+    QMutexLocker locker(&mMutex);
+    if (index < 0 || index >= getTileCount() || mTileStates[index] == TileState::Ready) {
+        return;
+    }
+    mTiles[index] = tile;
+    mTileStates[index] = TileState::Ready;
+    ++mReadyTileCount;
+    mUpdatedAreas.append(getTileRect(index));
+}
+
+void TiledImageBuffer::setError(const QString &error) {
+    QMutexLocker locker(&mMutex);
+    if (mError.isEmpty()) {
+        mError = error;
+    }
+    mIsCanceled = true;
+}
+
+void TiledImageBuffer::setVisibleArea(const QRect &area) {
+    QMutexLocker locker(&mMutex);
+    mVisibleArea = area;
+}
+
+QList<QRect> TiledImageBuffer::takeUpdatedAreas() {
+    QMutexLocker locker(&mMutex);
+    QList<QRect> areas;
+    areas.swap(mUpdatedAreas);
+    return areas;
+}
+
+QImage TiledImageBuffer::getTile(int index) const {
+    QMutexLocker locker(&mMutex);
+    if (index < 0 || index >= getTileCount()) {
+        return {};
+    }
+    return mTiles[index];
+}
+
+bool TiledImageBuffer::isComplete() const {
+    QMutexLocker locker(&mMutex);
+    return mReadyTileCount == getTileCount();
+}
+
+void TiledImageBuffer::cancel() {
+    QMutexLocker locker(&mMutex);
+    mIsCanceled = true;
+}
+
+bool TiledImageBuffer::isCanceled() const {
+    QMutexLocker locker(&mMutex);
+    return mIsCanceled;
+}
+
+QString TiledImageBuffer::getError() const {
+    QMutexLocker locker(&mMutex);
+    return mError;
+}
+
+QImage TiledImageBuffer::toImage() const {
+    QMutexLocker locker(&mMutex);
+    if (mReadyTileCount != getTileCount() || mTiles.empty()) {
+        throw std::runtime_error("Error: the comparison image is not rendered yet.");
+    }
+
+    // Indexed tiles keep the color table of the first one, e.g. the difference images
+    QImage::Format format = mTiles[0].format();
+    QImage image(mSize, format);
+    if (format == QImage::Format_Indexed8) {
+        image.setColorTable(mTiles[0].colorTable());
+    }
+    const int bytesPerPixel = image.depth() / 8;
+    if (bytesPerPixel == 0) {
+        throw std::runtime_error("Error: an unsupported format of the comparison image.");
+    }
+
+    for (int index = 0; index < getTileCount(); ++index) {
+        QRect area = getTileRect(index);
+        QImage tile = mTiles[index];
+        if (tile.format() != format) {
+            tile = tile.convertToFormat(format, image.colorTable());
+        }
+        if (tile.size() != area.size()) {
+            throw std::runtime_error("Error: a tile of the comparison image has a wrong size.");
+        }
+        for (int y = 0; y < area.height(); ++y) {
+            memcpy(image.scanLine(area.top() + y) + area.left() * bytesPerPixel,
+                   tile.constScanLine(y),
+                   area.width() * bytesPerPixel
+                   );
+        }
+    }
+    return image;
+}
@@ -0,0 +1,84 @@
+#ifndef TILEDIMAGEBUFFER_H
+#define TILEDIMAGEBUFFER_H
+
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QRect>
+#include <QString>
+#include <memory>
+#include <vector>
+
+// A comparison image that is rendered tile by tile by several threads and shown
+// while it is being rendered. The renderers take the pending tiles one by one:
+// the tiles in the visible area of the viewer go first, the closest ones to its
+// center first, so the user sees the result where they are looking at once and
+// the rest of the image fills in. The viewer polls the finished tiles.
+//
+// All the methods are thread-safe.
+
+class TiledImageBuffer
+{
+public:
+    explicit TiledImageBuffer(const QSize &size, int tileSize = mDefaultTileSize);
+    ~TiledImageBuffer() = default;
+
+    QSize getSize() const;
+    int getTileSize() const;
+    int getColumnCount() const;
+    int getRowCount() const;
+    int getTileCount() const;
+
+    // The area of the tile in image coordinates, the tiles at the edges are smaller
+    QRect getTileRect(int index) const;
+
+    // The renderers' side
+
+    // Returns the index of the next tile to render, or -1 if there are no pending
+    // tiles left or the rendering was canceled
+    int takeNextTile();
+    // The tile must have the size of getTileRect(index)
+    void setTile(int index, const QImage &tile);
+    // Cancels the rendering; only the first error is kept
+    void setError(const QString &error);
+
+    // The viewer's side
+
+    // The area of the image in the viewport, in image coordinates
+    void setVisibleArea(const QRect &area);
+    // The areas of the tiles that were finished since the previous call
+    QList<QRect> takeUpdatedAreas();
+    // A null image if the tile is not rendered yet
+    QImage getTile(int index) const;
+    bool isComplete() const;
+    void cancel();
+    bool isCanceled() const;
+    QString getError() const;
+
+    // Joins the tiles into one image in the format of the first tile.
+    // Throws std::runtime_error if the buffer is not complete.
+    QImage toImage() const;
+
+    static constexpr int mDefaultTileSize = 256;
+
+private:
+    enum class TileState : quint8 { Pending, Rendering, Ready };
+
+    mutable QMutex mMutex;
+    QSize mSize;
+    int mTileSize;
+    int mColumnCount;
+    int mRowCount;
+    std::vector<TileState> mTileStates;
+    std::vector<QImage> mTiles;
+    int mPendingTileCount;
+    int mReadyTileCount;
+    QRect mVisibleArea;
+    QList<QRect> mUpdatedAreas;
+    bool mIsCanceled;
+    QString mError;
+};
+
+typedef std::shared_ptr<TiledImageBuffer> TiledImageBufferPtr;
+
+#endif // TILEDIMAGEBUFFER_H
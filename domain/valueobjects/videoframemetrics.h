@@ -0,0 +1,32 @@
+#ifndef VIDEOFRAMEMETRICS_H
+#define VIDEOFRAMEMETRICS_H
+
+#include <QMetaType>
+#include <QtGlobal>
+
+// The comparators every frame pair of two videos can be fed through. Only the
+// metrics of the selected comparators are calculated, the others stay zero.
+
+enum class VideoFrameComparator {
+    PixelDifference, // maxDifference and differingPixelsPercent
+    Brightness,      // firstBrightness and secondBrightness
+    Contrast         // firstContrast and secondContrast
+};
+
+// Per-frame result of comparing two videos in lockstep. One entry is produced
+// for each pair of decoded frames, so the whole list forms the metrics timeline.
+
+struct VideoFrameMetrics {
+    int frameIndex = 0;
+    qint64 positionMs = 0;               // Position of the frame pair in the videos
+    int maxDifference = 0;               // Max channel difference over all pixels [0, 255]
+    double differingPixelsPercent = 0.0; // Pixels with a non-zero difference [0, 100]
+    double firstBrightness = 0.0;        // Average qGray() value of the first frame [0, 255]
+    double secondBrightness = 0.0;       // Average qGray() value of the second frame [0, 255]
+    double firstContrast = 0.0;          // Luminance standard deviation of the first frame
+    double secondContrast = 0.0;         // Luminance standard deviation of the second frame
+};
+
+Q_DECLARE_METATYPE(VideoFrameMetrics)
+
+#endif // VIDEOFRAMEMETRICS_H
@@ -0,0 +1,11 @@
+#ifndef VIEWRENDERMODE_H
+#define VIEWRENDERMODE_H
+
+// How the images are shown. It only affects painting: the pixmaps keep the
+// original pixels, so the Color Picker still reports the original values.
+// The pixels of a mode are converted by the per-pixel filter of the mode
+// (see ImageProcessingInteractor::createRenderFilter).
+
+enum class ViewRenderMode { Color, Red, Green, Blue, Grayscale };
+
+#endif // VIEWRENDERMODE_H
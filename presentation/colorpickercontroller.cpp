@@ -1,5 +1,6 @@
 #include "colorpickercontroller.h"
 
+#include <QSettings>
 #include <presentation/dialogs/colorpickerpanel.h>
 #include <presentation/mainwindow.h>
 
@@ -7,6 +8,8 @@ ColorPickerController::ColorPickerController(MainWindow *mainWindow)
     : QDockWidget(nullptr),
     mMainWindow(mainWindow)
 {    
+    QSettings settings("com.WhisperingWind", "TwinPix");
+    mBrushSize = settings.value("colorPicker/brushSize", 1).toInt();
     setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
     QObject::connect(this, &QDockWidget::dockLocationChanged, this, &ColorPickerController::onDockLocationChanged);
 }
@@ -26,6 +29,8 @@ void ColorPickerController::onDockLocationChanged(Qt::DockWidgetArea area) {
         mColorPicker = new ColorPickerPanel(true);
         setWidget(mColorPicker);
     }
+    mColorPicker->setBrushSize(mBrushSize);
+    QObject::connect(mColorPicker, &ColorPickerPanel::brushSizeChanged, this, &ColorPickerController::onBrushSizeChanged);
     if (area == Qt::NoDockWidgetArea) {
         adjustSize();
     } else {
@@ -36,9 +41,17 @@ void ColorPickerController::onDockLocationChanged(Qt::DockWidgetArea area) {
 void ColorPickerController::openColorPickerDialog() {
     mMainWindow->addDockWidget(Qt::RightDockWidgetArea, this);
     show();
+    mMainWindow->onColorPickerBrushSizeChanged(mBrushSize);
     mMainWindow->onColorUnderCursorTrackingStatusChanged(true);
 }
 
+void ColorPickerController::onBrushSizeChanged(int brushSize) {
+    mBrushSize = brushSize;
+    QSettings settings("com.WhisperingWind", "TwinPix");
+    settings.setValue("colorPicker/brushSize", brushSize);
+    mMainWindow->onColorPickerBrushSizeChanged(brushSize);
+}
+
 void ColorPickerController::placeColorPickerToRightSideOfMainWindow() {
     if (isVisible()) {
         mMainWindow->addDockWidget(Qt::RightDockWidgetArea, this);
@@ -16,6 +16,7 @@ class ColorPickerController : public QDockWidget, public IColorPickerController
 
 public slots:
     void onDockLocationChanged(Qt::DockWidgetArea);
+    void onBrushSizeChanged(int brushSize);
 
 public:
     ColorPickerController(MainWindow *mainWindow);
@@ -35,6 +36,7 @@ public:
 private:
     MainWindow *mMainWindow;
     ColorPickerPanel *mColorPicker;
+    int mBrushSize;
 
     void createColorPicker();
 };
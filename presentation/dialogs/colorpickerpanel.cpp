@@ -2,6 +2,7 @@
 
 #include <qboxlayout.h>
 #include <qlineedit.h>
+#include <qspinbox.h>
 
 ColorPickerPanel::ColorPickerPanel(bool isForRightPosition, QWidget *parent, bool isTwoPanelMode)
     : QWidget(parent),
@@ -25,6 +26,18 @@ void ColorPickerPanel::setLayout(bool isForRightPosition) {
     mainLayout->setContentsMargins(12, 10, 10, 10);
     mainLayout->setSpacing(10);
 
+    // The brush of the picker, the statistics are calculated over the pixels under it
+    auto brushLayout = new QHBoxLayout();
+    brushLayout->addWidget(new QLabel("Brush:", this));
+    mBrushSizeSpinBox = new QSpinBox(this);
+    mBrushSizeSpinBox->setRange(1, BrushStatistics::mMaxBrushSize);
+    mBrushSizeSpinBox->setSuffix(" px");
+    mBrushSizeSpinBox->setToolTip("The size of the square brush of the picker");
+    brushLayout->addWidget(mBrushSizeSpinBox);
+    brushLayout->addStretch();
+    mainLayout->addLayout(brushLayout);
+    connect(mBrushSizeSpinBox, &QSpinBox::valueChanged, this, &ColorPickerPanel::brushSizeChanged);
+
     // Create the first panel (visible image panel)
     auto rgbWidgets = createPanel(isForRightPosition);
     mainLayout->addLayout(rgbWidgets.panelLayout);
@@ -33,6 +46,7 @@ void ColorPickerPanel::setLayout(bool isForRightPosition) {
     mFirstRLabel = rgbWidgets.rLabel;
     mFirstGLabel = rgbWidgets.gLabel;
     mFirstBLabel = rgbWidgets.bLabel;
+    mFirstStatisticsLabel = rgbWidgets.statisticsLabel;
 
     // If isTwoPanelMode is true, create a advanced color picker' panel
     if (mIsTwoPanelMode) {
@@ -50,6 +64,7 @@ void ColorPickerPanel::setLayout(bool isForRightPosition) {
         mSecondRLabel = rgbWidgets.rLabel;
         mSecondGLabel = rgbWidgets.gLabel;
         mSecondBLabel = rgbWidgets.bLabel;
+        mSecondStatisticsLabel = rgbWidgets.statisticsLabel;
     }
 
     // Add a spacer to push everything to the top of the panel
@@ -111,7 +126,11 @@ RgbWidgets ColorPickerPanel::createPanel(bool isForRightPosition) {
     // Add the horizontal layout to the panel layout
     panelLayout->addLayout(topLayout);
 
-    return { fileNameLabel, panelLayout, colorSquare, rLabel, gLabel, bLabel };
+    auto statisticsLabel = new QLabel(this);
+    statisticsLabel->setVisible(false);
+    panelLayout->addWidget(statisticsLabel);
+
+    return { fileNameLabel, panelLayout, colorSquare, rLabel, gLabel, bLabel, statisticsLabel };
 }
 
 void ColorPickerPanel::reset() {
@@ -119,7 +138,36 @@ void ColorPickerPanel::reset() {
     update(emptyData, emptyData);
 }
 
+void ColorPickerPanel::setBrushSize(int brushSize) {
+    mBrushSizeSpinBox->setValue(brushSize);
+}
+
+void ColorPickerPanel::updateStatistics(QLabel *statisticsLabel, const ImagePixelColor &color) {
+    const BrushStatistics &statistics = color.getStatistics();
+    // A single pixel has no statistics
+    if (statistics.isNull() || statistics.getChannelSums(0).pixelCount <= 1) {
+        statisticsLabel->setVisible(false);
+        return;
+    }
+    QString means, deviations, differences;
+    for (int channel = 0; channel < 3; ++channel) {
+        const RegionSums &sums = statistics.getChannelSums(channel);
+        QString separator = (channel == 0) ? "" : "  ";
+        means += separator + QString::number(sums.getMean(), 'f', 1);
+        deviations += separator + QString::number(sums.getStandardDeviation(), 'f', 1);
+        differences += separator + QString::number(statistics.getMaxDifference(channel));
+    }
+    QString text = QString("Mean RGB: %1\nσ RGB: %2").arg(means, deviations);
+    if (statistics.getMaxDifference(0) >= 0) {
+        text += QString("\nMax Δ RGB: %1").arg(differences);
+    }
+    statisticsLabel->setText(text);
+    statisticsLabel->setVisible(true);
+}
+
 void ColorPickerPanel::updateTopPanelOnly(const ImagePixelColor &visibleImageColor) {
+    updateStatistics(mFirstStatisticsLabel, visibleImageColor);
+
     // Set the file name in the top panel
     mFirstFileNameLabel->setText(visibleImageColor.getImageName());
 
@@ -167,6 +215,9 @@ void ColorPickerPanel::update(const ImagePixelColor &visibleImageColor,
         return;
     }
 
+    updateStatistics(mFirstStatisticsLabel, visibleImageColor);
+    updateStatistics(mSecondStatisticsLabel, hiddenImageColor.value());
+
     // Update the top panel
     mFirstFileNameLabel->setText(visibleImageColor.getImageName());
     QString topStyle = QString("background-color: rgb(%1, %2, %3);")
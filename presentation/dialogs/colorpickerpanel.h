@@ -9,10 +9,15 @@
 class QLineEdit;
 class QLabel;
 class QFrame;
+class QSpinBox;
 
 // If RGB tracking is active, the dialog displays the RGB values of the pixel
 // under the mouse cursor for both compared images. For this purpose,
 // the dialog has two panels with RGB values.
+//
+// With a brush larger than 1x1 the RGB values are the mean color under the brush,
+// and the panels also show the mean and the standard deviation of the channels
+// and their maximum difference between the images under the brush.
 
 class ColorPickerPanel : public QWidget
 {
@@ -26,6 +31,11 @@ public:
 
     void reset();
 
+    void setBrushSize(int brushSize);
+
+signals:
+    void brushSizeChanged(int brushSize);
+
 private:
     RgbWidgets createPanel(bool isForRightPosition);  // Helper method to create a single panel
 
@@ -35,18 +45,23 @@ private:
     QLabel* mFirstRLabel;            // Label for R value (first panel)
     QLabel* mFirstBLabel;            // Label for G value (first panel)
     QLabel* mFirstGLabel;            // Label for B value (first panel)
+    QLabel* mFirstStatisticsLabel;   // The statistics under the brush (first panel)
 
     QLabel* mSecondFileNameLabel = nullptr;
     QFrame* mSecondColorSquare = nullptr; // The square that shows the color (second panel)
     QLabel* mSecondRLabel = nullptr;      // Label for R value (second panel)
     QLabel* mSecondGLabel = nullptr;      // Label for G value (second panel)
     QLabel* mSecondBLabel = nullptr;      // Label for B value (second panel)
+    QLabel* mSecondStatisticsLabel = nullptr; // The statistics under the brush (second panel)
+
+    QSpinBox* mBrushSizeSpinBox;
 
     bool mIsTwoPanelMode;
 
     QLayout *mPanelMainLayout;
     
     void updateTopPanelOnly(const ImagePixelColor &firstPanelValue);
+    void updateStatistics(QLabel *statisticsLabel, const ImagePixelColor &color);
     void setLayout(bool isForRightPosition);
 
     QString format(const QString &colorComponemt,
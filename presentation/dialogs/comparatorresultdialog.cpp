@@ -14,7 +14,7 @@ ComparatorResultDialog::ComparatorResultDialog(const QString &message,
     mMessage(message),
     mFirstFilePath(firstImageFilePath),
     mSecondFilePath(secondImageFilePath),
-    mComparatorFullName(comparatorFullName){
+    mComparatorFullName(comparatorFullName) {
     setupUI();
 }
 
@@ -23,9 +23,12 @@ void ComparatorResultDialog::setupUI() {
     mCloseButton = new QPushButton("Close", this);
     mSaveButton = new QPushButton("Save", this);
     mMessageLabel->setWordWrap(true);
+    mStatusLabel = new QLabel(this);
+    mStatusLabel->setVisible(false);
 
     QVBoxLayout *vlayout = new QVBoxLayout(this);
     vlayout->addWidget(mMessageLabel);
+    vlayout->addWidget(mStatusLabel);
     QHBoxLayout *hlayout = new QHBoxLayout(this);
     hlayout->addStretch();
     hlayout->addWidget(mSaveButton);
@@ -41,6 +44,42 @@ void ComparatorResultDialog::setupUI() {
     setWindowTitle("Comparison Report");
 }
 
+void ComparatorResultDialog::waitForExactResult(const QFuture<QString> &exactResult) {
+    mSaveButton->setEnabled(false);
+    mStatusLabel->setText("Calculating the exact result...");
+    mStatusLabel->setVisible(true);
+    setWindowTitle("Comparison Report (Estimate)");
+
+    // The signal is emitted at once if the future is already finished
+    connect(&mExactResult, &QFutureWatcher<QString>::finished, this, &ComparatorResultDialog::onExactResultFinished);
+    mExactResult.setFuture(exactResult);
+}
+
+void ComparatorResultDialog::onExactResultFinished() {
+    QString error;
+    try {
+        // A failed future is canceled as well, so its exception is rethrown first
+        mExactResult.waitForFinished();
+        if (mExactResult.future().resultCount() == 0) {
+            error = "The calculation of the exact result was canceled.";
+        } else {
+            mMessage = mExactResult.result();
+            mMessageLabel->setText(mMessage);
+            mStatusLabel->setText("<b><font color=\"green\">Exact result</font></b>");
+            mSaveButton->setEnabled(true);
+            setWindowTitle("Comparison Report");
+        }
+    } catch (std::exception &e) {
+        error = e.what();
+    } catch (...) {
+        error = "An unknown error occurred while the exact result was calculated.";
+    }
+    if (!error.isEmpty()) {
+        mStatusLabel->setText(QString("<font color=\"red\">%1</font>").arg(error.toHtmlEscaped()));
+    }
+    adjustSize();
+}
+
 void ComparatorResultDialog::onSaveClicked() {
     QDir parentDir(QFileInfo(mFirstFilePath).absolutePath());
     QString filePath = parentDir.absolutePath() + QDir::separator() + "report.html";
@@ -6,6 +6,7 @@
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QDir>
+#include <QFutureWatcher>
 
 class ComparatorResultDialog : public QDialog {
     Q_OBJECT
@@ -18,6 +19,10 @@ public:
                            QWidget *parent = nullptr
                            );
 
+    // The message is an estimate; it is replaced in place by the exact result when
+    // the future is finished. The report cannot be saved until then.
+    void waitForExactResult(const QFuture<QString> &exactResult);
+
 private:
     QString mMessage;
     QString mFirstFilePath;
@@ -27,11 +32,14 @@ private:
     QLabel *mMessageLabel;
     QPushButton *mCloseButton;
     QPushButton *mSaveButton;
+    QLabel *mStatusLabel;
+    QFutureWatcher<QString> mExactResult;
 
     void setupUI();
 
 private slots:
     void onSaveClicked();
+    void onExactResultFinished();
 };
 
 #endif // COMPARATORRESULTDIALOG_H
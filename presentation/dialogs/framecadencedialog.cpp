@@ -0,0 +1,194 @@
+#include "framecadencedialog.h"
+
+#include <QApplication>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMap>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTime>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+#include <qevent.h>
+#include <qmessagebox.h>
+#include <business/videoanalysis/framecadenceinteractor.h>
+
+
+FrameCadenceDialog::FrameCadenceDialog(QWidget *parent, const QString &videoPath)
+    : QDialog(parent),
+    mIsRunning(false)
+{
+    setWindowTitle(QString("Dropped And Duplicated Frames: %1").arg(QFileInfo(videoPath).fileName()));
+    resize(800, 500);
+
+    mInteractor = new FrameCadenceInteractor(videoPath, this);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    mSummaryLabel = new QLabel("Analyzing the video. Every frame is decoded separately, "
+                               "so the analysis may take longer than playing the video.", this);
+    mSummaryLabel->setWordWrap(true);
+    mainLayout->addWidget(mSummaryLabel);
+
+    mEventsTable = new QTableWidget(0, 4, this);
+    mEventsTable->setHorizontalHeaderLabels({ "Frame", "Time", "Event", "Details" });
+    mEventsTable->horizontalHeader()->setStretchLastSection(true);
+    mEventsTable->verticalHeader()->setVisible(false);
+    mEventsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mEventsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mEventsTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    mainLayout->addWidget(mEventsTable, 1);
+
+    mainLayout->addWidget(new QLabel("Double-click an event to open the frame and the previous "
+                                     "one in the main window.", this));
+
+    QHBoxLayout *progressLayout = new QHBoxLayout();
+    mProgressBar = new QProgressBar(this);
+    mCancelOrCloseButton = new QPushButton("Cancel", this);
+    progressLayout->addWidget(mProgressBar, 1);
+    progressLayout->addWidget(mCancelOrCloseButton);
+    mainLayout->addLayout(progressLayout);
+
+    connect(mInteractor, &FrameCadenceInteractor::progressChanged,
+            this, &FrameCadenceDialog::onProgressChanged);
+    connect(mInteractor, &FrameCadenceInteractor::analysisFinished,
+            this, &FrameCadenceDialog::onAnalysisFinished);
+    connect(mInteractor, &FrameCadenceInteractor::analysisFailed,
+            this, &FrameCadenceDialog::onAnalysisFailed);
+    connect(mEventsTable, &QTableWidget::cellDoubleClicked, this, [this](int row, int) {
+        onEventActivated(row);
+    });
+    connect(mCancelOrCloseButton, &QPushButton::clicked,
+            this, &FrameCadenceDialog::onCancelOrCloseClicked);
+    connect(&mFramePairWatcher, &QFutureWatcher<QPair<QString, QString>>::finished,
+            this, &FrameCadenceDialog::onFramePairSaved);
+}
+
+FrameCadenceDialog::~FrameCadenceDialog() {
+    // The interactor is a child of the dialog; its destructor stops the worker threads.
+    mInteractor->cancel();
+    // The frame pair is saved by the interactor, so it has to be finished first;
+    // its error is not shown anymore
+    if (mFramePairWatcher.isRunning()) {
+        try {
+            mFramePairWatcher.waitForFinished();
+        } catch (...) {
+        }
+        QApplication::restoreOverrideCursor();
+    }
+}
+
+bool FrameCadenceDialog::startAnalysis() {
+    try {
+        mInteractor->start();
+    } catch (std::runtime_error &e) {
+        showError(e.what());
+        return false;
+    }
+    mIsRunning = true;
+    mProgressBar->setRange(0, mInteractor->getTotalFrames());
+    mProgressBar->setValue(0);
+    return true;
+}
+
+void FrameCadenceDialog::closeEvent(QCloseEvent *event) {
+    mInteractor->cancel();
+    QDialog::closeEvent(event);
+}
+
+void FrameCadenceDialog::onProgressChanged(int processedFrames) {
+    mProgressBar->setValue(processedFrames);
+}
+
+void FrameCadenceDialog::onAnalysisFinished() {
+    mIsRunning = false;
+    mCancelOrCloseButton->setText("Close");
+    mProgressBar->setValue(mProgressBar->maximum());
+
+    auto events = mInteractor->getEvents();
+    QMap<FrameCadenceEventType, int> counts;
+    mEventsTable->setRowCount(events.size());
+    for (int row = 0; row < events.size(); ++row) {
+        const FrameCadenceEvent &event = events[row];
+        counts[event.type]++;
+
+        QTime time = QTime(0, 0).addMSecs(event.positionMs);
+        auto frameItem = new QTableWidgetItem(QString::number(event.frameIndex));
+        frameItem->setData(Qt::UserRole, event.frameIndex);
+        mEventsTable->setItem(row, 0, frameItem);
+        mEventsTable->setItem(row, 1, new QTableWidgetItem(time.toString("hh:mm:ss.zzz")));
+        mEventsTable->setItem(row, 2, new QTableWidgetItem(FrameCadenceAnalyzer::getEventTypeName(event.type)));
+        mEventsTable->setItem(row, 3, new QTableWidgetItem(event.description));
+    }
+    mEventsTable->resizeColumnsToContents();
+
+    mSummaryLabel->setText(QString("%1 frames at %2 fps: %3 duplicated, %4 with dropped frames before them, "
+                                   "%5 timestamp irregularities.")
+                               .arg(mInteractor->getTotalFrames())
+                               .arg(mInteractor->getFrameRate(), 0, 'f', 3)
+                               .arg(counts.value(FrameCadenceEventType::DuplicatedFrame))
+                               .arg(counts.value(FrameCadenceEventType::DroppedFrames))
+                               .arg(counts.value(FrameCadenceEventType::TimestampIrregularity))
+                           );
+}
+
+void FrameCadenceDialog::onAnalysisFailed(const QString &error) {
+    mIsRunning = false;
+    mCancelOrCloseButton->setText("Close");
+    mSummaryLabel->setText("The analysis failed.");
+    showError(error);
+}
+
+void FrameCadenceDialog::onEventActivated(int row) {
+    auto item = mEventsTable->item(row, 0);
+    if (item == nullptr || mFramePairWatcher.isRunning()) {
+        return;
+    }
+    // The frames are decoded in a worker thread: the reader runs its own event loop,
+    // which must not re-enter the event handling of the dialog from this slot
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    auto interactor = mInteractor;
+    int frameIndex = item->data(Qt::UserRole).toInt();
+    auto future = QtConcurrent::run([interactor, frameIndex](QPromise<QPair<QString, QString>> &promise) {
+        try {
+            promise.addResult(interactor->saveFramePairAsTemporary(frameIndex));
+        } catch (...) {
+            promise.setException(std::current_exception());
+        }
+    });
+    mFramePairWatcher.setFuture(future);
+}
+
+void FrameCadenceDialog::onFramePairSaved() {
+    QApplication::restoreOverrideCursor();
+    try {
+        mFramePairWatcher.waitForFinished();
+        auto paths = mFramePairWatcher.result();
+        emit framePairSelected(paths.first, paths.second);
+    } catch (std::exception &e) {
+        showError(e.what());
+    }
+}
+
+void FrameCadenceDialog::onCancelOrCloseClicked() {
+    if (mIsRunning) {
+        mIsRunning = false;
+        mInteractor->cancel();
+        mCancelOrCloseButton->setText("Close");
+        mSummaryLabel->setText("The analysis was canceled.");
+        return;
+    }
+    close();
+}
+
+void FrameCadenceDialog::showError(const QString &errorMessage) {
+    QMessageBox msgBox;
+    msgBox.setIcon(QMessageBox::Critical);
+    msgBox.setText(errorMessage);
+    msgBox.setStandardButtons(QMessageBox::Ok);
+    msgBox.setDefaultButton(QMessageBox::Ok);
+    msgBox.exec();
+}
@@ -0,0 +1,57 @@
+#ifndef FRAMECADENCEDIALOG_H
+#define FRAMECADENCEDIALOG_H
+
+#include <QFutureWatcher>
+#include <QPair>
+#include <qdialog.h>
+
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class QTableWidget;
+class FrameCadenceInteractor;
+
+// Shows the dropped / duplicated frames and the timestamp irregularities of
+// a captured video. Double-clicking an event opens the frame and the previous
+// one in the main window.
+
+class FrameCadenceDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    FrameCadenceDialog(QWidget *parent, const QString &videoPath);
+    ~FrameCadenceDialog();
+
+    // Returns false if the video could not be opened; the error is shown to the user.
+    bool startAnalysis();
+
+signals:
+    void framePairSelected(const QString &firstImagePath, const QString &secondImagePath);
+
+protected:
+    void closeEvent(QCloseEvent *event) override;
+
+private slots:
+    void onProgressChanged(int processedFrames);
+    void onAnalysisFinished();
+    void onAnalysisFailed(const QString &error);
+    void onEventActivated(int row);
+    void onFramePairSaved();
+    void onCancelOrCloseClicked();
+
+private:
+    FrameCadenceInteractor *mInteractor;
+    QLabel *mSummaryLabel;
+    QTableWidget *mEventsTable;
+    QProgressBar *mProgressBar;
+    QPushButton *mCancelOrCloseButton;
+    bool mIsRunning;
+
+    // The frame pair that is being decoded and saved after a double-click on an event;
+    // the double-clicks are ignored until it is finished.
+    QFutureWatcher<QPair<QString, QString>> mFramePairWatcher;
+
+    void showError(const QString &errorMessage);
+};
+
+#endif // FRAMECADENCEDIALOG_H
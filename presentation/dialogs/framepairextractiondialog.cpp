@@ -0,0 +1,141 @@
+#include "framepairextractiondialog.h"
+
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QLineEdit>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+#include <qmessagebox.h>
+#include <business/videoanalysis/framepairextractioninteractor.h>
+#include <data/storage/filedialoghandler.h>
+
+
+FramePairExtractionDialog::FramePairExtractionDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Extract Frame Pairs");
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QFormLayout *formLayout = new QFormLayout();
+
+    mModeComboBox = new QComboBox(this);
+    mModeComboBox->addItem("At a fixed interval");
+    mModeComboBox->addItem("At scene changes");
+    mModeComboBox->addItem("At the timestamps");
+    mModeComboBox->setItemData(1, "Every frame of the first video is decoded separately, so this mode "
+                                  "may take longer than playing the video.", Qt::ToolTipRole);
+    formLayout->addRow("Extract frames:", mModeComboBox);
+
+    mIntervalSpinBox = new QDoubleSpinBox(this);
+    mIntervalSpinBox->setRange(0.01, 3600.0);
+    mIntervalSpinBox->setDecimals(2);
+    mIntervalSpinBox->setValue(mSettings.intervalMs / 1000.0);
+    mIntervalSpinBox->setSuffix(" s");
+    formLayout->addRow("Interval:", mIntervalSpinBox);
+
+    mSceneThresholdSpinBox = new QDoubleSpinBox(this);
+    mSceneThresholdSpinBox->setRange(1.0, 255.0);
+    mSceneThresholdSpinBox->setDecimals(1);
+    mSceneThresholdSpinBox->setValue(mSettings.sceneChangeThreshold);
+    mSceneThresholdSpinBox->setToolTip("The mean luminance difference from the previous frame [0, 255] "
+                                       "at which a new scene starts.");
+    formLayout->addRow("Scene change threshold:", mSceneThresholdSpinBox);
+
+    mTimestampsEdit = new QPlainTextEdit(this);
+    mTimestampsEdit->setPlaceholderText("E.g. 12.5, 1:05, 00:10:00.250");
+    mTimestampsEdit->setMaximumHeight(80);
+    formLayout->addRow("Timestamps:", mTimestampsEdit);
+
+    mMaxPairsSpinBox = new QSpinBox(this);
+    mMaxPairsSpinBox->setRange(0, 1000000);
+    mMaxPairsSpinBox->setValue(mSettings.maxPairs);
+    mMaxPairsSpinBox->setSpecialValueText("Unlimited");
+    formLayout->addRow("Max pairs:", mMaxPairsSpinBox);
+
+    mFormatComboBox = new QComboBox(this);
+    mFormatComboBox->addItem("PNG (lossless, fast compression)", "png");
+    mFormatComboBox->addItem("BMP (uncompressed, the fastest)", "bmp");
+    mFormatComboBox->addItem("PPM (uncompressed)", "ppm");
+    formLayout->addRow("Format:", mFormatComboBox);
+
+    QHBoxLayout *directoryLayout = new QHBoxLayout();
+    mOutputDirectoryEdit = new QLineEdit(this);
+    QPushButton *browseButton = new QPushButton("Browse...", this);
+    directoryLayout->addWidget(mOutputDirectoryEdit, 1);
+    directoryLayout->addWidget(browseButton);
+    formLayout->addRow("Output directory:", directoryLayout);
+
+    mainLayout->addLayout(formLayout);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+    mainLayout->addWidget(buttonBox);
+
+    connect(mModeComboBox, &QComboBox::currentIndexChanged, this, &FramePairExtractionDialog::onModeChanged);
+    connect(browseButton, &QPushButton::clicked, this, &FramePairExtractionDialog::onBrowseClicked);
+    connect(buttonBox, &QDialogButtonBox::accepted, this, &FramePairExtractionDialog::onOkClicked);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    onModeChanged(mModeComboBox->currentIndex());
+}
+
+FramePairExtractionSettings FramePairExtractionDialog::getSettings() const {
+    return mSettings;
+}
+
+void FramePairExtractionDialog::onModeChanged(int index) {
+    auto mode = static_cast<FramePairExtractionMode>(index);
+    mIntervalSpinBox->setEnabled(mode == FramePairExtractionMode::FixedInterval);
+    mSceneThresholdSpinBox->setEnabled(mode == FramePairExtractionMode::SceneChanges);
+    mTimestampsEdit->setEnabled(mode == FramePairExtractionMode::Timestamps);
+}
+
+void FramePairExtractionDialog::onBrowseClicked() {
+    FileDialogHandler handler;
+    auto directory = handler.getUserOutputDirectory(mOutputDirectoryEdit->text());
+    if (directory) {
+        mOutputDirectoryEdit->setText(directory.value());
+    }
+}
+
+void FramePairExtractionDialog::onOkClicked() {
+    FramePairExtractionSettings settings;
+    settings.mode = static_cast<FramePairExtractionMode>(mModeComboBox->currentIndex());
+    settings.intervalMs = static_cast<qint64>(mIntervalSpinBox->value() * 1000.0);
+    settings.sceneChangeThreshold = mSceneThresholdSpinBox->value();
+    settings.maxPairs = mMaxPairsSpinBox->value();
+    settings.imageFormat = mFormatComboBox->currentData().toString();
+    settings.outputDirectory = mOutputDirectoryEdit->text().trimmed();
+
+    if (settings.outputDirectory.isEmpty()) {
+        showError("Please select the output directory.");
+        return;
+    }
+    if (settings.mode == FramePairExtractionMode::Timestamps) {
+        try {
+            settings.timestampsMs = FramePairExtractionInteractor::parseTimestamps(mTimestampsEdit->toPlainText());
+        } catch (std::runtime_error &e) {
+            showError(e.what());
+            return;
+        }
+        if (settings.timestampsMs.isEmpty()) {
+            showError("Please enter at least one timestamp.");
+            return;
+        }
+    }
+    mSettings = settings;
+    accept();
+}
+
+void FramePairExtractionDialog::showError(const QString &errorMessage) {
+    QMessageBox msgBox;
+    msgBox.setIcon(QMessageBox::Critical);
+    msgBox.setText(errorMessage);
+    msgBox.setStandardButtons(QMessageBox::Ok);
+    msgBox.setDefaultButton(QMessageBox::Ok);
+    msgBox.exec();
+}
@@ -0,0 +1,43 @@
+#ifndef FRAMEPAIREXTRACTIONDIALOG_H
+#define FRAMEPAIREXTRACTIONDIALOG_H
+
+#include <qdialog.h>
+#include <domain/valueobjects/framepairextractionsettings.h>
+
+class QComboBox;
+class QDoubleSpinBox;
+class QLineEdit;
+class QPlainTextEdit;
+class QSpinBox;
+
+// Asks the user which frame pairs should be extracted from two videos
+// and where they should be saved.
+
+class FramePairExtractionDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit FramePairExtractionDialog(QWidget *parent = nullptr);
+
+    // Valid after the dialog was accepted.
+    FramePairExtractionSettings getSettings() const;
+
+private slots:
+    void onModeChanged(int index);
+    void onBrowseClicked();
+    void onOkClicked();
+
+private:
+    QComboBox *mModeComboBox;
+    QDoubleSpinBox *mIntervalSpinBox;
+    QDoubleSpinBox *mSceneThresholdSpinBox;
+    QPlainTextEdit *mTimestampsEdit;
+    QSpinBox *mMaxPairsSpinBox;
+    QComboBox *mFormatComboBox;
+    QLineEdit *mOutputDirectoryEdit;
+    FramePairExtractionSettings mSettings;
+
+    void showError(const QString &errorMessage);
+};
+
+#endif // FRAMEPAIREXTRACTIONDIALOG_H
@@ -1,6 +1,10 @@
 #include "getimagesfromvideosdialog.h"
 
+#include <qcheckbox.h>
+#include <qlabel.h>
 #include <qmessagebox.h>
+#include <qpushbutton.h>
+#include <business/videoanalysis/videosyncinteractor.h>
 
 
 GetImagesFromVideosDialog::GetImagesFromVideosDialog(QWidget *parent,
@@ -9,19 +13,36 @@ GetImagesFromVideosDialog::GetImagesFromVideosDialog(QWidget *parent,
     : QDialog(parent),
     mVideoFilePath1(videoFilePath1),
     mVideoFilePath2(videoFilePath2),
+    mSyncInteractor(nullptr),
+    mOffsetMs(0),
     mTotalScreenshotsTaken(0)
 {
     setWindowTitle("Get Images From Videos");
 
     // Main layout for the dialog
-    QHBoxLayout *mainLayout = new QHBoxLayout(this);
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QHBoxLayout *playersLayout = new QHBoxLayout();
 
     // Create two video player widgets
     mPlayer1 = new VideoPlayerWidget(this, 1);
     mPlayer2 = new VideoPlayerWidget(this, 2);
 
-    mainLayout->addWidget(mPlayer1);
-    mainLayout->addWidget(mPlayer2);
+    playersLayout->addWidget(mPlayer1);
+    playersLayout->addWidget(mPlayer2);
+    mainLayout->addLayout(playersLayout);
+
+    // Synchronization controls
+    QHBoxLayout *syncLayout = new QHBoxLayout();
+    mAutoSyncButton = new QPushButton("Auto Sync", this);
+    mLockPlayersCheckBox = new QCheckBox("Lock players", this);
+    mSyncStatusLabel = new QLabel(this);
+
+    syncLayout->addWidget(mAutoSyncButton);
+    syncLayout->addWidget(mLockPlayersCheckBox);
+    syncLayout->addWidget(mSyncStatusLabel, 1);
+    mainLayout->addLayout(syncLayout);
+
+    connect(mAutoSyncButton, &QPushButton::clicked, this, &GetImagesFromVideosDialog::toggleAutoSync);
 
     if (!videoFilePath1.isEmpty() && !videoFilePath2.isEmpty()) {
         mPlayer1->loadVideo(videoFilePath1);
@@ -31,6 +52,16 @@ GetImagesFromVideosDialog::GetImagesFromVideosDialog(QWidget *parent,
     // Connect screenshot signals from both players
     connect(mPlayer1, &VideoPlayerWidget::screenshotTaken, this, &GetImagesFromVideosDialog::handleScreenshotTaken);
     connect(mPlayer2, &VideoPlayerWidget::screenshotTaken, this, &GetImagesFromVideosDialog::handleScreenshotTaken);
+
+    // Mirror the user's actions between the players while they are locked
+    connect(mPlayer1, &VideoPlayerWidget::positionChangedByUser, this, &GetImagesFromVideosDialog::onFirstPlayerPositionChanged);
+    connect(mPlayer2, &VideoPlayerWidget::positionChangedByUser, this, &GetImagesFromVideosDialog::onSecondPlayerPositionChanged);
+    connect(mPlayer1, &VideoPlayerWidget::playingChangedByUser, this, &GetImagesFromVideosDialog::onFirstPlayerPlayingChanged);
+    connect(mPlayer2, &VideoPlayerWidget::playingChangedByUser, this, &GetImagesFromVideosDialog::onSecondPlayerPlayingChanged);
+}
+
+GetImagesFromVideosDialog::~GetImagesFromVideosDialog() {
+    stopSync();
 }
 
 std::optional<QString> GetImagesFromVideosDialog::getFirstScreenshotPath() {
@@ -60,3 +91,93 @@ void GetImagesFromVideosDialog::showError(const QString &errorMessage) {
     msgBox.setDefaultButton(QMessageBox::Ok);
     msgBox.exec();
 }
+
+/* Synchronization { */
+
+void GetImagesFromVideosDialog::toggleAutoSync() {
+    if (mSyncInteractor != nullptr) {
+        stopSync();
+        mSyncStatusLabel->setText("Synchronization canceled.");
+        return;
+    }
+    if (mVideoFilePath1.isEmpty() || mVideoFilePath2.isEmpty()) {
+        return;
+    }
+
+    mSyncInteractor = new VideoSyncInteractor(mVideoFilePath1, mVideoFilePath2);
+    connect(mSyncInteractor, &VideoSyncInteractor::progressChanged, this, &GetImagesFromVideosDialog::onSyncProgressChanged);
+    connect(mSyncInteractor, &VideoSyncInteractor::syncFinished, this, &GetImagesFromVideosDialog::onSyncFinished);
+    connect(mSyncInteractor, &VideoSyncInteractor::syncFailed, this, &GetImagesFromVideosDialog::onSyncFailed);
+
+    try {
+        mSyncInteractor->start();
+    } catch (std::runtime_error &e) {
+        stopSync();
+        showError(e.what());
+        return;
+    }
+    mAutoSyncButton->setText("Cancel Sync");
+    mSyncStatusLabel->setText("Synchronizing... 0%");
+}
+
+void GetImagesFromVideosDialog::onSyncProgressChanged(int percent) {
+    if (mSyncInteractor != nullptr) {
+        mSyncStatusLabel->setText(QString("Synchronizing... %1%").arg(percent));
+    }
+}
+
+void GetImagesFromVideosDialog::onSyncFinished(qint64 offsetMs, double correlation) {
+    stopSync();
+    mOffsetMs = offsetMs;
+    mSyncStatusLabel->setText(QString("Offset: %1 ms (correlation %2)")
+                                  .arg(offsetMs)
+                                  .arg(correlation, 0, 'f', 2)
+                              );
+    mLockPlayersCheckBox->setChecked(true);
+    mPlayer2->setPosition(mPlayer1->getPosition() + mOffsetMs);
+}
+
+void GetImagesFromVideosDialog::onSyncFailed(const QString &error) {
+    stopSync();
+    mSyncStatusLabel->clear();
+    showError(error);
+}
+
+void GetImagesFromVideosDialog::stopSync() {
+    if (mSyncInteractor != nullptr) {
+        // deleteLater() is used because this method can be called from a slot of the interactor
+        mSyncInteractor->cancel();
+        mSyncInteractor->disconnect(this);
+        mSyncInteractor->deleteLater();
+        mSyncInteractor = nullptr;
+    }
+    mAutoSyncButton->setText("Auto Sync");
+}
+
+void GetImagesFromVideosDialog::onFirstPlayerPositionChanged(qint64 position) {
+    if (mLockPlayersCheckBox->isChecked()) {
+        mPlayer2->setPosition(position + mOffsetMs);
+    }
+}
+
+void GetImagesFromVideosDialog::onSecondPlayerPositionChanged(qint64 position) {
+    if (mLockPlayersCheckBox->isChecked()) {
+        mPlayer1->setPosition(position - mOffsetMs);
+    }
+}
+
+void GetImagesFromVideosDialog::onFirstPlayerPlayingChanged(bool isPlaying) {
+    if (mLockPlayersCheckBox->isChecked()) {
+        mPlayer2->setPosition(mPlayer1->getPosition() + mOffsetMs);
+        mPlayer2->setPlaying(isPlaying);
+    }
+}
+
+void GetImagesFromVideosDialog::onSecondPlayerPlayingChanged(bool isPlaying) {
+    if (mLockPlayersCheckBox->isChecked()) {
+        mPlayer1->setPosition(mPlayer2->getPosition() - mOffsetMs);
+        mPlayer1->setPlaying(isPlaying);
+    }
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
@@ -6,6 +6,11 @@
 #include <qdialog.h>
 #include <qevent.h>
 
+class QCheckBox;
+class QLabel;
+class QPushButton;
+class VideoSyncInteractor;
+
 
 class GetImagesFromVideosDialog : public QDialog {
     Q_OBJECT
@@ -15,6 +20,7 @@ public:
                               const QString &videoFilePath1,
                               const QString &videoFilePath2
                               );
+    ~GetImagesFromVideosDialog();
 
     std::optional<QString> getFirstScreenshotPath();
 
@@ -26,12 +32,27 @@ public:
 
 private slots:
     void handleScreenshotTaken();
+    void toggleAutoSync();
+    void onSyncProgressChanged(int percent);
+    void onSyncFinished(qint64 offsetMs, double correlation);
+    void onSyncFailed(const QString &error);
+    void onFirstPlayerPositionChanged(qint64 position);
+    void onSecondPlayerPositionChanged(qint64 position);
+    void onFirstPlayerPlayingChanged(bool isPlaying);
+    void onSecondPlayerPlayingChanged(bool isPlaying);
 
 private:
     QString mVideoFilePath1;
     QString mVideoFilePath2;
     VideoPlayerWidget *mPlayer1;
     VideoPlayerWidget *mPlayer2;
+    QPushButton *mAutoSyncButton;
+    QCheckBox *mLockPlayersCheckBox;
+    QLabel *mSyncStatusLabel;
+    VideoSyncInteractor *mSyncInteractor;
+    qint64 mOffsetMs; // Position in the second video = position in the first video + mOffsetMs
     int mTotalScreenshotsTaken;
+
+    void stopSync();
 };
 #endif // GETIMAGESFROMVIDEOSDIALOG_H
@@ -1,14 +1,16 @@
 #include "propertyeditordialog.h"
 
+#include <QSlider>
 #include <data/storage/filedialoghandler.h>
 
 
 PropertyEditorDialog::PropertyEditorDialog(const QString &processorName,
                                            const QString &processorDescription,
                                            const QList<Property> &properties,
+                                           const PropertiesChangedCallback &onPropertiesChanged,
                                            QWidget *parent)
 
-    : QDialog(parent), mDeafultProperties(properties) {
+    : QDialog(parent), mOnPropertiesChanged(onPropertiesChanged), mDeafultProperties(properties) {
 
     setWindowTitle(processorName);
 
@@ -46,6 +48,16 @@ PropertyEditorDialog::PropertyEditorDialog(const QString &processorName,
             spinBox->setValue(static_cast<int>(property.getValue()));
             spinBox->setReadOnly(false);
             editor = spinBox;
+            if (mOnPropertiesChanged) {
+                QSlider *slider = new QSlider(Qt::Horizontal, this);
+                slider->setRange(minValue, maxValue);
+                slider->setValue(spinBox->value());
+                slider->setMinimumWidth(200);
+                connect(slider, &QSlider::valueChanged, spinBox, &QSpinBox::setValue);
+                connect(spinBox, &QSpinBox::valueChanged, slider, &QSlider::setValue);
+                connect(spinBox, &QSpinBox::valueChanged, this, &PropertyEditorDialog::onPropertyChanged);
+                propertyLayout->addWidget(slider);
+            }
             break;
         }
         case Property::Type::Real: {
@@ -55,6 +67,9 @@ PropertyEditorDialog::PropertyEditorDialog(const QString &processorName,
             doubleSpinBox->setValue(property.getValue());
             doubleSpinBox->setDecimals(2); // Set precision for floating-point numbers
             editor = doubleSpinBox;
+            if (mOnPropertiesChanged) {
+                connect(doubleSpinBox, &QDoubleSpinBox::valueChanged, this, &PropertyEditorDialog::onPropertyChanged);
+            }
             break;
         }
         case Property::Type::Alternatives: {
@@ -62,6 +77,9 @@ PropertyEditorDialog::PropertyEditorDialog(const QString &processorName,
             comboBox->addItems(property.getAlternatives());
             comboBox->setCurrentIndex(static_cast<int>(property.getValue()));
             editor = comboBox;
+            if (mOnPropertiesChanged) {
+                connect(comboBox, &QComboBox::currentIndexChanged, this, &PropertyEditorDialog::onPropertyChanged);
+            }
             break;
         }
 
@@ -111,10 +129,26 @@ PropertyEditorDialog::PropertyEditorDialog(const QString &processorName,
     // Connect signals to slots
     connect(runButton, &QPushButton::clicked, this, &PropertyEditorDialog::onRun);
     connect(cancelButton, &QPushButton::clicked, this, &PropertyEditorDialog::reject);
+
+    // Show the result for the default values at once
+    onPropertyChanged();
 }
 
 void PropertyEditorDialog::onRun() {
-    // Update property values from the editors
+    mUpdatedProperties = collectProperties();
+    accept(); // Close dialog with Accepted result
+}
+
+void PropertyEditorDialog::onPropertyChanged() {
+    if (mOnPropertiesChanged) {
+        mOnPropertiesChanged(collectProperties());
+    }
+}
+
+QList<Property> PropertyEditorDialog::collectProperties() const {
+    QList<Property> properties;
+
+    // Read property values from the editors
     for (int i = 0; i < mDeafultProperties.size(); ++i) {
         auto property = mDeafultProperties[i];
         QWidget *editor = mEditors[i];
@@ -130,7 +164,7 @@ void PropertyEditorDialog::onRun() {
                     static_cast<int>(property.getMinValue()),
                     static_cast<int>(property.getMaxValue())
                     );
-                mUpdatedProperties.append(prop);
+                properties.append(prop);
             }
             break;
         }
@@ -144,7 +178,7 @@ void PropertyEditorDialog::onRun() {
                     property.getMinValue(),
                     property.getMaxValue()
                     );
-                mUpdatedProperties.append(prop);
+                properties.append(prop);
             }
             break;
         }
@@ -157,7 +191,7 @@ void PropertyEditorDialog::onRun() {
                     property.getAlternatives(),
                     comboBox->currentIndex()
                     );
-                mUpdatedProperties.append(prop);
+                properties.append(prop);
             }
             break;
         }
@@ -169,14 +203,13 @@ void PropertyEditorDialog::onRun() {
                     property.getPropertyDescription(),
                     filePathEdit->text()
                     );
-                mUpdatedProperties.append(prop);
+                properties.append(prop);
             }
             break;
         }
         }
     }
-
-    accept(); // Close dialog with Accepted result
+    return properties;
 }
 
 QList<Property> PropertyEditorDialog::getUpdatedProperties() const {
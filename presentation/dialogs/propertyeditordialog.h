@@ -13,6 +13,7 @@
 #include <QPushButton>
 
 #include <domain/valueobjects/property.h>
+#include <domain/interfaces/presentation/iprocessorpropertiesdialogcallback.h>
 
 class PropertyEditorDialog : public QDialog {
     Q_OBJECT
@@ -21,6 +22,7 @@ public:
     explicit PropertyEditorDialog(const QString &processorName,
                                   const QString &processorDescription,
                                   const QList<Property> &properties,
+                                  const PropertiesChangedCallback &onPropertiesChanged = nullptr,
                                   QWidget *parent = nullptr
                                   );
 
@@ -29,13 +31,19 @@ public:
 
 private slots:
     void onRun();
+    void onPropertyChanged();
 
 private:
+    // If it is set, the integer properties also get sliders, so the values
+    // can be changed quickly while the result is previewed
+    PropertiesChangedCallback mOnPropertiesChanged;
     QList<Property> mDeafultProperties; // List of Property objects
     QList<Property> mUpdatedProperties; // List of Property objects
     QList<QWidget*> mEditors;           // List of dynamically created editors for each property
 
     QVBoxLayout *mMainLayout;
+
+    QList<Property> collectProperties() const;
 };
 
 #endif // PROPERTYEDITORDIALOG_H
@@ -0,0 +1,91 @@
+#include "regionstatisticspanel.h"
+
+#include <QHeaderView>
+#include <QLabel>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+namespace {
+
+struct StatisticsRow {
+    QString title;
+    StatisticsChannel channel;
+    bool isStandardDeviation;
+};
+
+const QList<StatisticsRow> statisticsRows = {
+    { "Mean R", StatisticsChannel::Red, false },
+    { "Mean G", StatisticsChannel::Green, false },
+    { "Mean B", StatisticsChannel::Blue, false },
+    { "Mean luminance", StatisticsChannel::Luminance, false },
+    { "Contrast (std. dev.)", StatisticsChannel::Luminance, true },
+    { "Mean brightness", StatisticsChannel::Brightness, false }
+};
+
+} // namespace
+
+RegionStatisticsPanel::RegionStatisticsPanel(QWidget *parent)
+    : QDockWidget("Region Statistics", parent)
+{
+    setObjectName("RegionStatisticsPanel");
+    setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+
+    auto content = new QWidget(this);
+    auto layout = new QVBoxLayout(content);
+    layout->setContentsMargins(10, 10, 10, 10);
+
+    mAreaLabel = new QLabel(content);
+    mAreaLabel->setWordWrap(true);
+    layout->addWidget(mAreaLabel);
+
+    mTable = new QTableWidget(statisticsRows.size(), 0, content);
+    QStringList rowTitles;
+    foreach (auto row, statisticsRows) {
+        rowTitles.append(row.title);
+    }
+    mTable->setVerticalHeaderLabels(rowTitles);
+    mTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mTable->setSelectionMode(QAbstractItemView::NoSelection);
+    mTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    layout->addWidget(mTable);
+
+    setWidget(content);
+    setMinimumWidth(300);
+    reset();
+}
+
+void RegionStatisticsPanel::update(const QRect &area, const QList<RegionStatisticsSource> &images) {
+    mAreaLabel->setText(QString("Area: %1 x %2 at (%3, %4)")
+                            .arg(area.width())
+                            .arg(area.height())
+                            .arg(area.x())
+                            .arg(area.y())
+                        );
+    mTable->setColumnCount(images.size());
+    QStringList columnTitles;
+    for (int column = 0; column < images.size(); ++column) {
+        const auto &image = images[column];
+        columnTitles.append(image.imageName);
+        for (int row = 0; row < statisticsRows.size(); ++row) {
+            QString text = "Not available";
+            if (image.integralImage != nullptr) {
+                auto sums = image.integralImage->getRegionSums(statisticsRows[row].channel, area);
+                double value = statisticsRows[row].isStandardDeviation
+                                   ? sums.getStandardDeviation()
+                                   : sums.getMean();
+                text = format(value);
+            }
+            mTable->setItem(row, column, new QTableWidgetItem(text));
+        }
+    }
+    mTable->setHorizontalHeaderLabels(columnTitles);
+}
+
+void RegionStatisticsPanel::reset() {
+    mAreaLabel->setText("Select an area with the mouse while holding Shift, Control or Alt.");
+    mTable->setColumnCount(0);
+}
+
+QString RegionStatisticsPanel::format(double value) {
+    return QString::number(value, 'f', 2);
+}
@@ -0,0 +1,44 @@
+#ifndef REGIONSTATISTICSPANEL_H
+#define REGIONSTATISTICSPANEL_H
+
+#include <QDockWidget>
+#include <QList>
+#include <memory>
+#include <domain/valueobjects/integralimage.h>
+
+class QLabel;
+class QTableWidget;
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+struct RegionStatisticsSource {
+    QString imageName;
+    std::shared_ptr<const IntegralImage> integralImage; // nullptr if it is not ready (yet)
+};
+
+// =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+// Shows the mean of the channels and the contrast of the selected area of the
+// images while the user drags the selection. The statistics are taken from
+// the summed-area tables of the images, so the cost does not depend on the
+// size of the area.
+
+class RegionStatisticsPanel : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    explicit RegionStatisticsPanel(QWidget *parent = nullptr);
+
+    // The visible image goes first
+    void update(const QRect &area, const QList<RegionStatisticsSource> &images);
+    void reset();
+
+private:
+    QLabel *mAreaLabel;
+    QTableWidget *mTable;
+
+    static QString format(double value);
+};
+
+#endif // REGIONSTATISTICSPANEL_H
@@ -0,0 +1,226 @@
+#include "videocomparisondialog.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+#include <qevent.h>
+#include <qmessagebox.h>
+#include <business/videoanalysis/videocomparisoninteractor.h>
+#include <presentation/views/videometricschartwidget.h>
+
+
+VideoComparisonDialog::VideoComparisonDialog(QWidget *parent,
+                                             const QString &firstVideoPath,
+                                             const QString &secondVideoPath
+                                             )
+    : QDialog(parent),
+    mIsRunning(false)
+{
+    setWindowTitle(QString("Compare Videos: %1 vs %2")
+                       .arg(QFileInfo(firstVideoPath).fileName(),
+                            QFileInfo(secondVideoPath).fileName()));
+
+    mInteractor = new VideoComparisonInteractor(firstVideoPath, secondVideoPath, this);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout *comparatorsLayout = new QHBoxLayout();
+    mPixelDifferenceCheckBox = new QCheckBox("Difference in pixel values", this);
+    mBrightnessCheckBox = new QCheckBox("Brightness", this);
+    mContrastCheckBox = new QCheckBox("Contrast", this);
+    mStartButton = new QPushButton("Start", this);
+    QList<QCheckBox*> checkBoxes = { mPixelDifferenceCheckBox, mBrightnessCheckBox, mContrastCheckBox };
+    comparatorsLayout->addWidget(new QLabel("Comparators:", this));
+    foreach (auto checkBox, checkBoxes) {
+        checkBox->setChecked(true);
+        comparatorsLayout->addWidget(checkBox);
+    }
+    comparatorsLayout->addStretch(1);
+    comparatorsLayout->addWidget(mStartButton);
+    mainLayout->addLayout(comparatorsLayout);
+
+    QHBoxLayout *metricLayout = new QHBoxLayout();
+    mMetricComboBox = new QComboBox(this);
+    mMetricComboBox->setEnabled(false);
+    metricLayout->addWidget(new QLabel("Metric:", this));
+    metricLayout->addWidget(mMetricComboBox, 1);
+    mainLayout->addLayout(metricLayout);
+
+    mChart = new VideoMetricsChartWidget(this);
+    mainLayout->addWidget(mChart, 1);
+
+    mStatusLabel = new QLabel("Select the comparators of the frame pairs and click Start.", this);
+    mainLayout->addWidget(mStatusLabel);
+
+    QHBoxLayout *progressLayout = new QHBoxLayout();
+    mProgressBar = new QProgressBar(this);
+    mCancelOrCloseButton = new QPushButton("Close", this);
+    progressLayout->addWidget(mProgressBar, 1);
+    progressLayout->addWidget(mCancelOrCloseButton);
+    mainLayout->addLayout(progressLayout);
+
+    connect(mStartButton, &QPushButton::clicked,
+            this, &VideoComparisonDialog::onStartClicked);
+    connect(mInteractor, &VideoComparisonInteractor::frameMetricsCalculated,
+            this, &VideoComparisonDialog::onFrameMetricsCalculated);
+    connect(mInteractor, &VideoComparisonInteractor::comparisonFinished,
+            this, &VideoComparisonDialog::onComparisonFinished);
+    connect(mInteractor, &VideoComparisonInteractor::comparisonFailed,
+            this, &VideoComparisonDialog::onComparisonFailed);
+    connect(mMetricComboBox, &QComboBox::currentIndexChanged,
+            this, &VideoComparisonDialog::onMetricTypeChanged);
+    connect(mChart, &VideoMetricsChartWidget::framePointClicked,
+            this, &VideoComparisonDialog::onFramePointClicked);
+    connect(mCancelOrCloseButton, &QPushButton::clicked,
+            this, &VideoComparisonDialog::onCancelOrCloseClicked);
+    connect(&mFramePairWatcher, &QFutureWatcher<QPair<QString, QString>>::finished,
+            this, &VideoComparisonDialog::onFramePairSaved);
+}
+
+VideoComparisonDialog::~VideoComparisonDialog() {
+    // The interactor is a child of the dialog; its destructor stops the worker threads.
+    mInteractor->cancel();
+    // The frame pair is saved by the interactor, so it has to be finished first;
+    // its error is not shown anymore
+    try {
+        mFramePairWatcher.waitForFinished();
+    } catch (...) {
+    }
+}
+
+void VideoComparisonDialog::onStartClicked() {
+    auto comparators = getSelectedComparators();
+    mInteractor->setComparators(comparators);
+    try {
+        mInteractor->start();
+    } catch (std::runtime_error &e) {
+        showError(e.what());
+        return;
+    }
+    mIsRunning = true;
+    mStartButton->setEnabled(false);
+    foreach (auto checkBox, findChildren<QCheckBox*>()) {
+        checkBox->setEnabled(false);
+    }
+    fillMetricComboBox(comparators);
+    mCancelOrCloseButton->setText("Cancel");
+    mStatusLabel->setText("Click a point of the chart to open the frame pair in the main window.");
+    mChart->setTotalFrames(mInteractor->getTotalFrames());
+    mProgressBar->setRange(0, mInteractor->getTotalFrames());
+    mProgressBar->setValue(0);
+}
+
+QList<VideoFrameComparator> VideoComparisonDialog::getSelectedComparators() const {
+    QList<VideoFrameComparator> comparators;
+    if (mPixelDifferenceCheckBox->isChecked()) {
+        comparators.append(VideoFrameComparator::PixelDifference);
+    }
+    if (mBrightnessCheckBox->isChecked()) {
+        comparators.append(VideoFrameComparator::Brightness);
+    }
+    if (mContrastCheckBox->isChecked()) {
+        comparators.append(VideoFrameComparator::Contrast);
+    }
+    return comparators;
+}
+
+// Only the metrics of the selected comparators can be shown
+void VideoComparisonDialog::fillMetricComboBox(const QList<VideoFrameComparator> &comparators) {
+    mMetricComboBox->clear();
+    if (comparators.contains(VideoFrameComparator::PixelDifference)) {
+        mMetricComboBox->addItem("Max difference in pixel values", static_cast<int>(VideoMetricType::MaxDifference));
+        mMetricComboBox->addItem("Differing pixels (%)", static_cast<int>(VideoMetricType::DifferingPixels));
+    }
+    if (comparators.contains(VideoFrameComparator::Brightness)) {
+        mMetricComboBox->addItem("Brightness", static_cast<int>(VideoMetricType::Brightness));
+    }
+    if (comparators.contains(VideoFrameComparator::Contrast)) {
+        mMetricComboBox->addItem("Contrast", static_cast<int>(VideoMetricType::Contrast));
+    }
+    mMetricComboBox->setEnabled(true);
+}
+
+void VideoComparisonDialog::closeEvent(QCloseEvent *event) {
+    mInteractor->cancel();
+    QDialog::closeEvent(event);
+}
+
+void VideoComparisonDialog::onFrameMetricsCalculated(const VideoFrameMetrics &metrics) {
+    mChart->addMetrics(metrics);
+    mProgressBar->setValue(metrics.frameIndex + 1);
+}
+
+void VideoComparisonDialog::onComparisonFinished() {
+    mIsRunning = false;
+    mCancelOrCloseButton->setText("Close");
+    mProgressBar->setValue(mProgressBar->maximum());
+}
+
+void VideoComparisonDialog::onComparisonFailed(const QString &error) {
+    mIsRunning = false;
+    mCancelOrCloseButton->setText("Close");
+    showError(error);
+}
+
+void VideoComparisonDialog::onMetricTypeChanged(int index) {
+    if (index < 0) {
+        return;
+    }
+    mChart->setMetricType(static_cast<VideoMetricType>(mMetricComboBox->itemData(index).toInt()));
+}
+
+// The frame pair is decoded in a worker thread, so the dialog stays responsive
+// and a second click can not start another decoding in the middle of the first one
+void VideoComparisonDialog::onFramePointClicked(int frameIndex) {
+    if (mFramePairWatcher.isRunning()) {
+        return;
+    }
+    mStatusLabel->setText(QString("Decoding the frame pair %1...").arg(frameIndex));
+    auto interactor = mInteractor;
+    auto future = QtConcurrent::run([interactor, frameIndex](QPromise<QPair<QString, QString>> &promise) {
+        try {
+            promise.addResult(interactor->saveFramePairAsTemporary(frameIndex));
+        } catch (...) {
+            promise.setException(std::current_exception());
+        }
+    });
+    mFramePairWatcher.setFuture(future);
+}
+
+void VideoComparisonDialog::onFramePairSaved() {
+    mStatusLabel->setText("Click a point of the chart to open the frame pair in the main window.");
+    try {
+        mFramePairWatcher.waitForFinished();
+        auto paths = mFramePairWatcher.result();
+        emit framePairSelected(paths.first, paths.second);
+    } catch (std::exception &e) {
+        showError(e.what());
+    }
+}
+
+void VideoComparisonDialog::onCancelOrCloseClicked() {
+    if (mIsRunning) {
+        mIsRunning = false;
+        mInteractor->cancel();
+        mCancelOrCloseButton->setText("Close");
+        mStatusLabel->setText("The comparison was canceled. The frames compared so far "
+                              "are still available.");
+        return;
+    }
+    close();
+}
+
+void VideoComparisonDialog::showError(const QString &errorMessage) {
+    QMessageBox msgBox;
+    msgBox.setIcon(QMessageBox::Critical);
+    msgBox.setText(errorMessage);
+    msgBox.setStandardButtons(QMessageBox::Ok);
+    msgBox.setDefaultButton(QMessageBox::Ok);
+    msgBox.exec();
+}
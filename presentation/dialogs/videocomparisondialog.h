@@ -0,0 +1,69 @@
+#ifndef VIDEOCOMPARISONDIALOG_H
+#define VIDEOCOMPARISONDIALOG_H
+
+#include <QFutureWatcher>
+#include <QPair>
+#include <qdialog.h>
+#include <domain/valueobjects/videoframemetrics.h>
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class VideoMetricsChartWidget;
+class VideoComparisonInteractor;
+
+// Lets the user select the comparators of the frame pairs and shows the per-frame
+// metrics timeline of two videos while they are being compared. Clicking a point
+// of the chart opens the corresponding frame pair in the main window.
+
+class VideoComparisonDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    VideoComparisonDialog(QWidget *parent,
+                          const QString &firstVideoPath,
+                          const QString &secondVideoPath
+                          );
+    ~VideoComparisonDialog();
+
+signals:
+    void framePairSelected(const QString &firstImagePath, const QString &secondImagePath);
+
+protected:
+    void closeEvent(QCloseEvent *event) override;
+
+private slots:
+    void onStartClicked();
+    void onFrameMetricsCalculated(const VideoFrameMetrics &metrics);
+    void onComparisonFinished();
+    void onComparisonFailed(const QString &error);
+    void onMetricTypeChanged(int index);
+    void onFramePointClicked(int frameIndex);
+    void onFramePairSaved();
+    void onCancelOrCloseClicked();
+
+private:
+    VideoComparisonInteractor *mInteractor;
+    VideoMetricsChartWidget *mChart;
+    QCheckBox *mPixelDifferenceCheckBox;
+    QCheckBox *mBrightnessCheckBox;
+    QCheckBox *mContrastCheckBox;
+    QPushButton *mStartButton;
+    QComboBox *mMetricComboBox;
+    QLabel *mStatusLabel;
+    QProgressBar *mProgressBar;
+    QPushButton *mCancelOrCloseButton;
+    bool mIsRunning;
+
+    // The frame pair that is being decoded and saved after a click on the chart;
+    // the clicks are ignored until it is finished.
+    QFutureWatcher<QPair<QString, QString>> mFramePairWatcher;
+
+    QList<VideoFrameComparator> getSelectedComparators() const;
+    void fillMetricComboBox(const QList<VideoFrameComparator> &comparators);
+    void showError(const QString &errorMessage);
+};
+
+#endif // VIDEOCOMPARISONDIALOG_H
@@ -17,29 +17,45 @@
 #include <QDockWidget>
 #include <QMimeData>
 #include <qprocess.h>
+#include <QtConcurrent>
 #include <ui_mainwindow.h>
 #include <QThread>
+#include <QTime>
+#include <algorithm>
 #include <QClipboard>
+#include <QActionGroup>
+#include <QStatusBar>
+#include <QTimer>
 #include <presentation/colorpickercontroller.h>
 #include <business/getimagesfromvideosinteractor.h>
 #include <presentation/views/imageviewer.h>
 #include <presentation/dialogs/aboutdialog.h>
 #include <presentation/dialogs/comparatorresultdialog.h>
 #include <presentation/dialogs/externalimageviewerdialog.h>
+#include <presentation/dialogs/framecadencedialog.h>
+#include <presentation/dialogs/framepairextractiondialog.h>
 #include <presentation/dialogs/helpdialog.h>
 #include <presentation/dialogs/imageautoanalysissettingsdialog.h>
 #include <presentation/dialogs/pluginssettingsdialog.h>
 #include <presentation/dialogs/propertyeditordialog.h>
+#include <presentation/dialogs/regionstatisticspanel.h>
+#include <presentation/dialogs/videocomparisondialog.h>
 #include <data/storage/filedialoghandler.h>
+#include <data/storage/imagefileshandler.h>
+#include <domain/valueobjects/compressedimage.h>
 #include <business/imageanalysis/imageprocessinginteractor.h>
-#include <domain/interfaces/presentation/iotherappinstancesinteractorcallback.h>
-#include <business/otherappinstancesinteractor.h>
 #include <business/recentfilesinteractor.h>
+#include <business/videoanalysis/firstdifferentframeinteractor.h>
+#include <business/videoanalysis/framepairextractioninteractor.h>
+#include <business/videoanalysis/tearinginteractor.h>
+#include <business/videoanalysis/temporalditheringinteractor.h>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
     ui(new Ui::MainWindow),
-    mMenuIsInSingleImageMode(false)
+    mMenuIsInSingleImageMode(false),
+    mCurrentDifferenceRegion(-1),
+    mPendingDifferenceRegionStep(0)
 {
     ui->setupUi(this);
 
@@ -52,19 +68,43 @@ MainWindow::MainWindow(QWidget *parent)
     restoreMainWindowPosition();
 
     mColorPickerController = new ColorPickerController(this);
+    mRegionStatisticsPanel = new RegionStatisticsPanel(this);
+    mRegionStatisticsPanel->hide();
     mImageView = new ImageViewer(this, this);
     mImageFilesInteractor = new ImageFilesInteractor();
     mImageProcessorsMenuController = new ImageProcessorsMenuController(this);
     mRecentFilesInteractor = new RecentFilesInteractor();
-    mOtherAppInstanceInteractor = new OtherAppInstancesInteractor(this);
     mImageProcessingInteractor = nullptr;
     mProgressDialog = nullptr;
 
     setCentralWidget(mImageView);
 
+    mMemoryUsageLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(mMemoryUsageLabel);
+    QTimer *memoryUsageTimer = new QTimer(this);
+    connect(memoryUsageTimer, &QTimer::timeout, this, &MainWindow::updateMemoryUsageStatus);
+    memoryUsageTimer->start(mMemoryUsageUpdateIntervalMs);
+    updateMemoryUsageStatus();
+
+    connect(&mDifferenceRegionIndexWatcher,
+            &QFutureWatcher<DifferenceRegionIndex>::finished,
+            this,
+            &MainWindow::onDifferenceRegionIndexFinished
+            );
+    connect(&mRowDifferencesWatcher,
+            &QFutureWatcher<RowDifferenceMap>::finished,
+            this,
+            &MainWindow::onRowDifferencesFinished
+            );
+    connect(&mIntegralImagesWatcher,
+            &QFutureWatcher<DisplayedIntegralImages>::finished,
+            this,
+            &MainWindow::onIntegralImagesFinished
+            );
+
     mImageFilesInteractor->subscribe(this);
 
-    buildImageProcessorsMenu();
+    buildImageProcessorsMenu(false);
     makeConnections();
     enableImageProceesorsMenuItems(false);
 
@@ -72,6 +112,14 @@ MainWindow::MainWindow(QWidget *parent)
 }
 
 MainWindow::~MainWindow() {
+    if (mImageProcessingInteractor != nullptr) {
+        mImageProcessingInteractor->unsubscribe(this);
+        delete mImageProcessingInteractor;
+    }
+    mImageFilesInteractor->unsubscribe(this);
+    delete mImageFilesInteractor;
+    delete mRecentFilesInteractor;
+    delete mImageProcessorsMenuController;
     delete ui;
 }
 
@@ -101,10 +149,27 @@ void MainWindow::mousePressEvent(QMouseEvent *event) {
     contextMenu.exec(event->globalPosition().toPoint());
 }
 
+// Shows how much memory the images take, the inactive ones are kept compressed
+void MainWindow::updateMemoryUsageStatus() {
+    constexpr double megabyte = 1024.0 * 1024.0;
+    qint64 decodedSize = 0;
+    if (mImageProcessingInteractor != nullptr) {
+        decodedSize = mImageProcessingInteractor->getDecodedMemoryUsage();
+    }
+    QString text = QString("Images: %1 MB decoded, %2 MB compressed (%3 MB uncompressed)")
+                       .arg(decodedSize / megabyte, 0, 'f', 1)
+                       .arg(CompressedImage::getTotalCompressedSize() / megabyte, 0, 'f', 1)
+                       .arg(CompressedImage::getTotalUncompressedSize() / megabyte, 0, 'f', 1);
+    mMemoryUsageLabel->setText(text);
+}
+
 /*  Application menu settings { */
 
-void MainWindow::buildImageProcessorsMenu() {
-    auto imageProcessorsInfo = ImageProcessingInteractor::getImageProcessorsInfo();
+// The processors are loaded once per process, so the windows of cropped
+// areas reuse them unless the plugins are rescanned
+void MainWindow::buildImageProcessorsMenu(bool isRescanNeeded) {
+    auto imageProcessorsInfo = isRescanNeeded ? ImageProcessingInteractor::getImageProcessorsInfo()
+                                              : ImageProcessingInteractor::getLoadedImageProcessorsInfo();
     QMenu *comparatorsMenu = ui->menuComparators;
     QMenu *filtersMenu = ui->menuFilters;
     mImageProcessorsMenuController->buildFiltersAndComparatorsMenus(comparatorsMenu,
@@ -121,7 +186,10 @@ void MainWindow::makeConnections() {
     connect(ui->actionSaveVisibleAreaAs, &QAction::triggered, this, &MainWindow::saveVisibleAreaAs);
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::showAboutDialog);
     connect(ui->actionColorPicker, &QAction::triggered, this, &MainWindow::showDockedColorPicker);
+    connect(ui->actionShowRegionStatistics, &QAction::triggered, this, &MainWindow::showRegionStatistics);
     connect(ui->actionShowOriginalImage, &QAction::triggered, this, &MainWindow::reloadImagesFromDisk);
+    connect(ui->actionUndoFilter, &QAction::triggered, this, &MainWindow::undoFilter);
+    connect(ui->actionRedoFilter, &QAction::triggered, this, &MainWindow::redoFilter);
     connect(ui->actionActualSize, &QAction::triggered, this, &MainWindow::imageZoomedToActualSize);
     connect(ui->actionFitInView, &QAction::triggered, this, &MainWindow::imagFitInView);
     connect(ui->actionZoomIn, &QAction::triggered, this, &MainWindow::imageZoomIn);
@@ -130,6 +198,12 @@ void MainWindow::makeConnections() {
     connect(ui->actionPlaceColorPickerOnRight, &QAction::triggered, this, &MainWindow::placeColorPickerOnRight);
     connect(ui->actionPlaceColorPickerOnLeft, &QAction::triggered, this, &MainWindow::placeColorPickerOnLeft);
     connect(ui->actionGetImagesFromVideos, &QAction::triggered, this, &MainWindow::getImagesFromVideos);
+    connect(ui->actionCompareVideos, &QAction::triggered, this, &MainWindow::compareVideos);
+    connect(ui->actionAnalyzeTemporalDithering, &QAction::triggered, this, &MainWindow::analyzeTemporalDithering);
+    connect(ui->actionFindFirstDifferentFrame, &QAction::triggered, this, &MainWindow::findFirstDifferentFrame);
+    connect(ui->actionDetectDroppedFrames, &QAction::triggered, this, &MainWindow::detectDroppedFrames);
+    connect(ui->actionDetectTearing, &QAction::triggered, this, &MainWindow::detectTearing);
+    connect(ui->actionExtractFramePairs, &QAction::triggered, this, &MainWindow::extractFramePairs);
     connect(ui->actionRunAllComparators, &QAction::triggered, this, &MainWindow::runAllComparators);
     connect(ui->actionPluginsSettings, &QAction::triggered, this, &MainWindow::changePluginsSettings);
     connect(ui->actionRescanPluginDir, &QAction::triggered, this, &MainWindow::rescanPluginDir);
@@ -137,8 +211,28 @@ void MainWindow::makeConnections() {
     connect(ui->actionShowFirstImage, &QAction::triggered, this, &MainWindow::showFirstImage);
     connect(ui->actionShowSecondImage, &QAction::triggered, this, &MainWindow::showSecondImage);
     connect(ui->actionShowComparisonImage, &QAction::triggered, this, &MainWindow::showComparisonImage);
+    connect(ui->actionLiveComparisonOverlay, &QAction::toggled, this, &MainWindow::toggleLiveComparisonOverlay);
+    connect(ui->actionShowNextDifference, &QAction::triggered, this, &MainWindow::showNextDifference);
+    connect(ui->actionShowPreviousDifference, &QAction::triggered, this, &MainWindow::showPreviousDifference);
     connect(ui->actionImageAutoAnalysisSettings, &QAction::triggered, this, &MainWindow::showImageAutoAnalysisSettings);
     connect(ui->actionOpenImageFromClipboard, &QAction::triggered, this, &MainWindow::openImageFromClipboard);
+
+    // The render modes are exclusive, the checked one is the mode of the viewer
+    QList<QPair<QAction*, ViewRenderMode>> renderModes = {
+        { ui->actionShowAllChannels, ViewRenderMode::Color },
+        { ui->actionShowRedChannelOnly, ViewRenderMode::Red },
+        { ui->actionShowGreenChannelOnly, ViewRenderMode::Green },
+        { ui->actionShowBlueChannelOnly, ViewRenderMode::Blue },
+        { ui->actionShowLuminanceOnly, ViewRenderMode::Grayscale }
+    };
+    QActionGroup *renderModesGroup = new QActionGroup(this);
+    foreach (auto renderMode, renderModes) {
+        renderModesGroup->addAction(renderMode.first);
+        ViewRenderMode mode = renderMode.second;
+        connect(renderMode.first, &QAction::triggered, this, [this, mode]() {
+            mImageView->setRenderMode(mode, ImageProcessingInteractor::createRenderFilter(mode));
+        });
+    }
 }
 
 void MainWindow::enableImageProceesorsMenuItems(bool isEnabled) {
@@ -152,13 +246,19 @@ void MainWindow::enableImageProceesorsMenuItems(bool isEnabled) {
     ui->actionZoomIn->setDisabled(!isEnabled);
     ui->actionZoomOut->setDisabled(!isEnabled);
     ui->actionShowOriginalImage->setDisabled(!isEnabled);
+    ui->actionUndoFilter->setDisabled(!isEnabled);
+    ui->actionRedoFilter->setDisabled(!isEnabled);
     ui->actionSwitchBetweenImages->setDisabled(!isEnabled);
     ui->actionPlaceColorPickerOnLeft->setDisabled(!isEnabled);
     ui->actionPlaceColorPickerOnRight->setDisabled(!isEnabled);
     ui->actionFitInView->setDisabled(!isEnabled);
     ui->actionColorPicker->setDisabled(!isEnabled);
+    ui->actionShowRegionStatistics->setDisabled(!isEnabled);
     ui->actionShowFirstImage->setDisabled(!isEnabled);
     ui->actionShowSecondImage->setDisabled(!isEnabled);
+    ui->actionShowNextDifference->setDisabled(!isEnabled);
+    ui->actionShowPreviousDifference->setDisabled(!isEnabled);
+    ui->actionLiveComparisonOverlay->setDisabled(!isEnabled);
 
     if (mMenuIsInSingleImageMode) {
         ui->menuComparators->setDisabled(true);
@@ -167,6 +267,9 @@ void MainWindow::enableImageProceesorsMenuItems(bool isEnabled) {
         ui->actionShowFirstImage->setDisabled(true);
         ui->actionShowSecondImage->setDisabled(true);
         ui->actionShowComparisonImage->setDisabled(true);
+        ui->actionLiveComparisonOverlay->setDisabled(true);
+        ui->actionShowNextDifference->setDisabled(true);
+        ui->actionShowPreviousDifference->setDisabled(true);
     }
 }
 
@@ -201,6 +304,284 @@ void MainWindow::getImagesFromVideos() {
     mImageFilesInteractor->openImagesFromVideos();
 }
 
+void MainWindow::compareVideos() {
+    FileDialogHandler handler;
+    auto videoPaths = handler.getUserOpenTwoVideoPaths("");
+    if (!videoPaths) {
+        return; // the operation was canceled by the user
+    }
+    auto dialog = new VideoComparisonDialog(this, videoPaths->first, videoPaths->second);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    connect(dialog, &VideoComparisonDialog::framePairSelected, this, &MainWindow::openVideoFramePair);
+    dialog->show();
+}
+
+void MainWindow::openVideoFramePair(const QString &firstImagePath, const QString &secondImagePath) {
+    mImageFilesInteractor->openTemporaryImages(firstImagePath, secondImagePath);
+    raise();
+    activateWindow();
+}
+
+void MainWindow::analyzeTemporalDithering() {
+    FileDialogHandler handler;
+    auto videoPath = handler.getUserOpenVideoPath("");
+    if (!videoPath) {
+        return; // the operation was canceled by the user
+    }
+
+    auto interactor = new TemporalDitheringInteractor(videoPath.value(), this);
+    try {
+        interactor->start();
+    } catch (std::runtime_error &e) {
+        delete interactor;
+        showError(e.what());
+        return;
+    }
+
+    showProgressDialog("Analyzing temporal dithering...", interactor->getTotalFrames());
+
+    // The interactor is the context of the connections, so no queued
+    // notification can reach the lambdas once it has been deleted.
+
+    connect(interactor, &TemporalDitheringInteractor::progressChanged, interactor, [this, interactor](int value) {
+        if (wasCanceled()) {
+            interactor->cancel();
+            interactor->deleteLater();
+            return;
+        }
+        onUpdateProgressValue(value);
+    });
+    connect(interactor, &TemporalDitheringInteractor::analysisFailed, interactor, [this, interactor](const QString &error) {
+        onUpdateProgressValue(interactor->getTotalFrames());
+        showError(error);
+        interactor->deleteLater();
+    });
+    connect(interactor, &TemporalDitheringInteractor::analysisFinished, interactor, [this, interactor]() {
+        onUpdateProgressValue(interactor->getTotalFrames());
+        try {
+            ImageFilesHandler imageFilesHandler;
+            QString heatmapPath = imageFilesHandler.saveImageAsTemporary(QPixmap::fromImage(interactor->getHeatmap()));
+            mImageFilesInteractor->openTemporaryImage(heatmapPath);
+            ComparatorResultDialog dialog { interactor->getSummaryHtml(),
+                                            "Temporal dithering analysis",
+                                            interactor->getVideoPath(),
+                                            interactor->getVideoPath()
+                                          };
+            dialog.exec();
+        } catch (std::runtime_error &e) {
+            showError(e.what());
+        }
+        interactor->deleteLater();
+    });
+}
+
+void MainWindow::findFirstDifferentFrame() {
+    FileDialogHandler handler;
+    auto videoPaths = handler.getUserOpenTwoVideoPaths("");
+    if (!videoPaths) {
+        return; // the operation was canceled by the user
+    }
+
+    auto answer = QMessageBox::question(this,
+                                        "Find First Different Frame",
+                                        "Check every 64th frame first to skip long identical parts?\n\n"
+                                        "This is much faster, but assumes that the videos stay "
+                                        "different once they have diverged."
+                                        );
+    bool useCoarseSearch = answer == QMessageBox::Yes;
+
+    auto interactor = new FirstDifferentFrameInteractor(videoPaths->first,
+                                                        videoPaths->second,
+                                                        useCoarseSearch,
+                                                        this
+                                                        );
+    try {
+        interactor->start();
+    } catch (std::runtime_error &e) {
+        delete interactor;
+        showError(e.what());
+        return;
+    }
+
+    showProgressDialog("Searching for the first different frame...", interactor->getTotalFrames());
+
+    connect(interactor, &FirstDifferentFrameInteractor::progressChanged, interactor, [this, interactor](int value) {
+        if (wasCanceled()) {
+            interactor->cancel();
+            interactor->deleteLater();
+            return;
+        }
+        onUpdateProgressValue(value);
+    });
+    connect(interactor, &FirstDifferentFrameInteractor::searchFailed, interactor, [this, interactor](const QString &error) {
+        onUpdateProgressValue(interactor->getTotalFrames());
+        showError(error);
+        interactor->deleteLater();
+    });
+    connect(interactor, &FirstDifferentFrameInteractor::searchFinished, interactor, [this, interactor]() {
+        onUpdateProgressValue(interactor->getTotalFrames());
+        auto frame = interactor->getFirstDifferentFrame();
+        if (!frame) {
+            onMessage("No different frames were found.");
+            interactor->deleteLater();
+            return;
+        }
+        try {
+            auto paths = interactor->saveFramePairAsTemporary();
+            openVideoFramePair(paths.first, paths.second);
+            QTime time = QTime(0, 0).addMSecs(interactor->getFramePosition(frame.value()));
+            onMessage(QString("The first different frame is #%1 (%2), the first different row is %3.")
+                          .arg(frame.value())
+                          .arg(time.toString("hh:mm:ss.zzz"))
+                          .arg(interactor->getFirstDifferentRow())
+                      );
+        } catch (std::runtime_error &e) {
+            showError(e.what());
+        }
+        interactor->deleteLater();
+    });
+}
+
+void MainWindow::detectDroppedFrames() {
+    FileDialogHandler handler;
+    auto videoPath = handler.getUserOpenVideoPath("");
+    if (!videoPath) {
+        return; // the operation was canceled by the user
+    }
+    auto dialog = new FrameCadenceDialog(this, videoPath.value());
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    connect(dialog, &FrameCadenceDialog::framePairSelected, this, &MainWindow::openVideoFramePair);
+    dialog->show();
+    if (!dialog->startAnalysis()) {
+        dialog->close();
+    }
+}
+
+void MainWindow::detectTearing() {
+    FileDialogHandler handler;
+    auto videoPath = handler.getUserOpenVideoPath("");
+    if (!videoPath) {
+        return; // the operation was canceled by the user
+    }
+
+    auto interactor = new TearingInteractor(videoPath.value(), this);
+    try {
+        interactor->start();
+    } catch (std::runtime_error &e) {
+        delete interactor;
+        showError(e.what());
+        return;
+    }
+
+    showProgressDialog("Detecting screen tearing...", interactor->getTotalFrames());
+
+    connect(interactor, &TearingInteractor::progressChanged, interactor, [this, interactor](int value) {
+        if (wasCanceled()) {
+            interactor->cancel();
+            interactor->deleteLater();
+            return;
+        }
+        onUpdateProgressValue(value);
+    });
+    connect(interactor, &TearingInteractor::analysisFailed, interactor, [this, interactor](const QString &error) {
+        onUpdateProgressValue(interactor->getTotalFrames());
+        showError(error);
+        interactor->deleteLater();
+    });
+    connect(interactor, &TearingInteractor::analysisFinished, interactor, [this, interactor]() {
+        onUpdateProgressValue(interactor->getTotalFrames());
+        auto showSummary = [this, interactor]() {
+            ComparatorResultDialog dialog { interactor->getSummaryHtml(),
+                                            "Screen tearing analysis",
+                                            interactor->getVideoPath(),
+                                            interactor->getVideoPath()
+                                          };
+            dialog.exec();
+            interactor->deleteLater();
+        };
+        auto tornFrames = interactor->getTornFrames();
+        if (tornFrames.isEmpty()) {
+            showSummary();
+            return;
+        }
+        auto mostConfident = std::max_element(tornFrames.begin(),
+                                              tornFrames.end(),
+                                              [](const auto &a, const auto &b) {
+                                                  return a.tearLine.confidence < b.tearLine.confidence;
+                                              });
+        // The frames are decoded in a worker thread: the reader runs its own event loop,
+        // which must not re-enter the event handling of the main window from this slot
+        int frameIndex = mostConfident->frameIndex;
+        auto watcher = new QFutureWatcher<QPair<QString, QString>>(interactor);
+        connect(watcher, &QFutureWatcher<QPair<QString, QString>>::finished, this, [this, watcher, showSummary]() {
+            try {
+                watcher->waitForFinished();
+                auto paths = watcher->result();
+                openVideoFramePair(paths.first, paths.second);
+            } catch (std::exception &e) {
+                showError(e.what());
+            }
+            showSummary();
+        });
+        watcher->setFuture(QtConcurrent::run([interactor, frameIndex](QPromise<QPair<QString, QString>> &promise) {
+            try {
+                promise.addResult(interactor->saveFramePairAsTemporary(frameIndex));
+            } catch (...) {
+                promise.setException(std::current_exception());
+            }
+        }));
+    });
+}
+
+void MainWindow::extractFramePairs() {
+    FileDialogHandler handler;
+    auto videoPaths = handler.getUserOpenTwoVideoPaths("");
+    if (!videoPaths) {
+        return; // the operation was canceled by the user
+    }
+    FramePairExtractionDialog settingsDialog { this };
+    if (settingsDialog.exec() != QDialog::Accepted) {
+        return;
+    }
+
+    auto interactor = new FramePairExtractionInteractor(videoPaths->first,
+                                                        videoPaths->second,
+                                                        settingsDialog.getSettings(),
+                                                        this
+                                                        );
+    try {
+        interactor->start();
+    } catch (std::runtime_error &e) {
+        delete interactor;
+        showError(e.what());
+        return;
+    }
+
+    showProgressDialog("Extracting frame pairs...", interactor->getTotalSteps());
+
+    connect(interactor, &FramePairExtractionInteractor::progressChanged, interactor, [this, interactor](int value) {
+        if (wasCanceled()) {
+            interactor->cancel();
+            interactor->deleteLater();
+            return;
+        }
+        onUpdateProgressValue(value);
+    });
+    connect(interactor, &FramePairExtractionInteractor::extractionFailed, interactor, [this, interactor](const QString &error) {
+        onUpdateProgressValue(interactor->getTotalSteps());
+        showError(error);
+        interactor->deleteLater();
+    });
+    connect(interactor, &FramePairExtractionInteractor::extractionFinished, interactor, [this, interactor]() {
+        onUpdateProgressValue(interactor->getTotalSteps());
+        onMessage(QString("%1 frame pairs were saved to\n%2\n%3")
+                      .arg(interactor->getExtractedPairs())
+                      .arg(interactor->getFirstOutputDirectory(), interactor->getSecondOutputDirectory())
+                  );
+        interactor->deleteLater();
+    });
+}
+
 void MainWindow::runAllComparators() {
     if (mImageProcessingInteractor != nullptr) {
         mImageProcessingInteractor->runAllComparators();
@@ -214,7 +595,7 @@ void MainWindow::changePluginsSettings() {
 }
 
 void MainWindow::rescanPluginDir() {
-    buildImageProcessorsMenu();
+    buildImageProcessorsMenu(true);
     enableImageProceesorsMenuItems(mImageView->hasActiveSession());
 }
 
@@ -279,6 +660,84 @@ void MainWindow::showComparisonImage() {
     mImageProcessingInteractor->showLastComparisonImage();
 }
 
+// The overlay stays on for the next opened images until the user turns it off
+void MainWindow::toggleLiveComparisonOverlay(bool isEnabled) {
+    if (mImageProcessingInteractor != nullptr) {
+        mImageProcessingInteractor->setLiveComparisonOverlayEnabled(isEnabled);
+    }
+}
+
+void MainWindow::showNextDifference() {
+    showDifferenceRegion(1);
+}
+
+void MainWindow::showPreviousDifference() {
+    showDifferenceRegion(-1);
+}
+
+// The index of the differences is built on the first request; the step is taken when it is ready
+void MainWindow::showDifferenceRegion(int step) {
+    if (mImageProcessingInteractor == nullptr || mMenuIsInSingleImageMode) {
+        return;
+    }
+    QFuture<DifferenceRegionIndex> future = mImageProcessingInteractor->getDifferenceRegionIndex();
+    if (!future.isFinished()) {
+        mPendingDifferenceRegionStep = step;
+        mDifferenceRegionIndexWatcher.setFuture(future);
+        statusBar()->showMessage("Searching for the differences...");
+        return;
+    }
+    try {
+        future.waitForFinished(); // rethrows the error of the build
+        if (future.resultCount() == 0) {
+            return; // the images were closed
+        }
+        DifferenceRegionIndex index = future.result();
+        if (index.isEmpty()) {
+            onMessage("The images are identical.");
+            return;
+        }
+        if (mCurrentDifferenceRegion < 0) {
+            mCurrentDifferenceRegion = step > 0 ? 0 : index.size() - 1;
+        } else {
+            mCurrentDifferenceRegion = (mCurrentDifferenceRegion + step + index.size()) % index.size();
+        }
+        const DifferenceRegion &region = index.at(mCurrentDifferenceRegion);
+        QString caption = QString("Difference %1 of %2: %3 px, max difference %4")
+                              .arg(mCurrentDifferenceRegion + 1)
+                              .arg(index.size())
+                              .arg(region.pixelCount)
+                              .arg(region.maxDifference);
+        mImageView->showDifferenceRegion(region.boundingRect, caption);
+    } catch (std::exception &e) {
+        showError(e.what());
+    }
+}
+
+void MainWindow::onDifferenceRegionIndexFinished() {
+    statusBar()->clearMessage();
+    int step = mPendingDifferenceRegionStep;
+    mPendingDifferenceRegionStep = 0;
+    if (step != 0) { // zero if the images were closed while the index was built
+        showDifferenceRegion(step);
+    }
+}
+
+// The map of the differing rows is built in the background, the margin is drawn when it is ready
+void MainWindow::showRowDifferences() {
+    mImageView->setRowDifferences({});
+    mRowDifferencesWatcher.setFuture(mImageProcessingInteractor->getRowDifferences());
+}
+
+void MainWindow::onRowDifferencesFinished() {
+    QFuture<RowDifferenceMap> future = mRowDifferencesWatcher.future();
+    // The build is canceled if the images were closed or filtered meanwhile
+    if (mImageProcessingInteractor == nullptr || future.resultCount() == 0) {
+        return;
+    }
+    mImageView->setRowDifferences(future.result());
+}
+
 void MainWindow::showImageAutoAnalysisSettings() {
     ImageAutoAnalysisSettingsDialog dialog{};
     dialog.exec();
@@ -311,6 +770,15 @@ void MainWindow::callImageProcessorsHelp() {
 
 void MainWindow::saveImageAs() {
     SaveImageInfo info = mImageView->getImageShowedOnTheScreen();
+    // The pixmap on the screen is in the display format, so the comparison result
+    // is saved from the image of the comparator, e.g. as a paletted PNG
+    if (info.mSaveImageInfoType == SaveImageInfoType::ComparisonImage && mImageProcessingInteractor != nullptr) {
+        auto comparisonImage = mImageProcessingInteractor->getLastComparisonImage();
+        if (comparisonImage && comparisonImage->size() == info.mImage.size()) {
+            mImageFilesInteractor->saveImageAs({ SaveImageInfoType::ComparisonImage, comparisonImage.value() });
+            return;
+        }
+    }
     mImageFilesInteractor->saveImageAs(info);
 }
 
@@ -330,10 +798,31 @@ void MainWindow::reloadImagesFromDisk() {
     }
 }
 
+void MainWindow::undoFilter() {
+    if (mImageProcessingInteractor != nullptr) {
+        mImageProcessingInteractor->undoFilter();
+    }
+}
+
+void MainWindow::redoFilter() {
+    if (mImageProcessingInteractor != nullptr) {
+        mImageProcessingInteractor->redoFilter();
+    }
+}
+
 void MainWindow::showDockedColorPicker() {
     mColorPickerController->openColorPickerDialog();
 }
 
+// The summed-area tables are built only while the panel is used
+void MainWindow::showRegionStatistics() {
+    addDockWidget(Qt::RightDockWidgetArea, mRegionStatisticsPanel);
+    mRegionStatisticsPanel->show();
+    if (mImageProcessingInteractor != nullptr) {
+        mIntegralImagesWatcher.setFuture(mImageProcessingInteractor->getIntegralImages());
+    }
+}
+
 void MainWindow::placeColorPickerOnRight() {
     mColorPickerController->placeColorPickerToRightSideOfMainWindow();
 }
@@ -350,6 +839,10 @@ void MainWindow::onColorUnderCursorTrackingStatusChanged(bool isActive) {
     mImageView->onColorUnderCursorTrackingStatusChanged(isActive);
 }
 
+void MainWindow::onColorPickerBrushSizeChanged(int brushSize) {
+    mImageView->setColorPickerBrushSize(brushSize);
+}
+
 /* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
 
 /* Save and restore the main widow position { */
@@ -403,23 +896,80 @@ void MainWindow::onDrop(QList<QUrl> urls) {
  * a specific area while holding the left mouse button, the comparator will run only for
  * the selected area. {   */
 
-void MainWindow::onSelectedAreaShouldBeAnalyzed(ImageHolderPtr images, std::optional<int> key) {
-    mImageProcessingInteractor->analyzeSelectedArea(images, key);
+void MainWindow::onSelectedAreaShouldBeAnalyzed(ImageHolderPtr images,
+                                                const QRect &area,
+                                                std::optional<int> key
+                                                )
+{
+    mImageProcessingInteractor->analyzeSelectedArea(images, area, key);
+}
+
+// The viewer reports the streamed comparison image when all its tiles are shown
+// or the comparator fails; the interactor loads it as the comparison result then
+void MainWindow::onComparisonImageStreamFinished(const TiledImageBufferPtr &buffer) {
+    if (mImageProcessingInteractor != nullptr) {
+        mImageProcessingInteractor->finishComparisonImageStream(buffer);
+    }
+}
+
+// The statistics are read from the summed-area tables of the displayed images,
+// so they follow the selection while the user drags it
+void MainWindow::onSelectedAreaChanged(ImageHolderPtr images, const QRect &area) {
+    if (!mRegionStatisticsPanel->isVisible() || mImageProcessingInteractor == nullptr || images == nullptr) {
+        return;
+    }
+    mSelectedAreaImages = images;
+    mSelectedArea = area;
+    QFuture<DisplayedIntegralImages> integralImages = mImageProcessingInteractor->getIntegralImages();
+    if (!integralImages.isFinished()) {
+        mIntegralImagesWatcher.setFuture(integralImages);
+        statusBar()->showMessage("Calculating the region statistics...");
+    }
+    QList<RegionStatisticsSource> sources = {
+        { images->getFirstImagePath(), mImageProcessingInteractor->getIntegralImage(images->getFirstImage()) }
+    };
+    if (images->isPairOfImages()) {
+        sources.append({ images->getSecondImagePath(),
+                         mImageProcessingInteractor->getIntegralImage(images->getSecondImage())
+                       });
+    }
+    mRegionStatisticsPanel->update(area, sources);
+}
+
+void MainWindow::onIntegralImagesFinished() {
+    statusBar()->clearMessage();
+    QFuture<DisplayedIntegralImages> future = mIntegralImagesWatcher.future();
+    try {
+        future.waitForFinished(); // rethrows the error of the build
+    } catch (std::bad_alloc &) {
+        showError("Error: there is not enough memory for the region statistics of these images.");
+        return;
+    } catch (std::exception &e) {
+        showError(e.what());
+        return;
+    }
+    // The build is canceled if the displayed images changed meanwhile
+    if (future.resultCount() > 0 && mSelectedAreaImages != nullptr) {
+        onSelectedAreaChanged(mSelectedAreaImages, mSelectedArea);
+    }
 }
 
 /* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
 
-/* If the user selects a part of the image while holding down Option (Alt),
- * we copy the selected part and open it in a new instance of the application
- * for further analysis. Parts from both images are copied.
+/* If the user selects a part of the image while holding down Control,
+ * we copy the selected part and open it in a new window for further analysis.
+ * Parts from both images are copied. The window lives in the same process,
+ * so it shares the loaded image processors and nothing is saved to disk; it
+ * runs its own copies of the processors (see ImageProcessingInteractor).
  *  {   */
 
 void MainWindow::onImagesCropped(ImageHolderPtr images) {
-    mOtherAppInstanceInteractor->openNewAppInstance(images);
-}
-
-void MainWindow::onOtherAppInstanceOpened() {
-    showMinimized();
+    auto window = new MainWindow();
+    window->setAttribute(Qt::WA_DeleteOnClose);
+    window->move(pos() + QPoint(mCroppedImagesWindowOffset, mCroppedImagesWindowOffset));
+    window->mImageFilesInteractor->openCroppedImages(images);
+    window->show();
+    window->activateWindow();
 }
 
 void MainWindow::showError(const QString &errorMessage) {
@@ -461,13 +1011,18 @@ void MainWindow::onImagesOpened(const ImageHolderPtr images) {
 
     }
     mMenuIsInSingleImageMode = images->isSingleImage();
+    mCurrentDifferenceRegion = -1;
+    mPendingDifferenceRegionStep = 0;
+    mSelectedAreaImages = nullptr;
     mImageView->cleanUp();
     mImageProcessingInteractor = new ImageProcessingInteractor(images, this, this);
     mImageProcessingInteractor->subscribe(this);
     mImageView->displayImages(images);
+    showRowDifferences();
+    mImageProcessingInteractor->setLiveComparisonOverlayEnabled(ui->actionLiveComparisonOverlay->isChecked());
     mColorPickerController->onImagesOpened();
     enableImageProceesorsMenuItems(true);
-    if (!images->isMarkedTemporary()) {
+    if (!images->isMarkedTemporary() && !images->isMarkedInMemory()) {
         if (images->isPairOfImages()) {
             mRecentFilesInteractor->addRecentFilesRecord(images->getFirstImagePath(),
                                                         images->getSecondImagePath()
@@ -494,8 +1049,12 @@ void MainWindow::onImagesClosed() {
         mImageProcessingInteractor = nullptr;
     }
     mMenuIsInSingleImageMode = false;
+    mCurrentDifferenceRegion = -1;
+    mPendingDifferenceRegionStep = 0;
+    mSelectedAreaImages = nullptr;
     mImageFilesInteractor->cleanup();
     mColorPickerController->onImagesClosed();
+    mRegionStatisticsPanel->reset();
     mImageView->cleanUp();
     enableImageProceesorsMenuItems(false);
     setWindowTitle("TwinPix");
@@ -531,6 +1090,26 @@ void MainWindow::onComparisonResultLoaded(const QString &html,
     dialog.exec();
 }
 
+void MainWindow::onComparisonResultEstimated(const QString &estimateHtml,
+                                             const QFuture<QString> &exactHtml,
+                                             const QString &comparatorFullName,
+                                             const QString &firstImagePath,
+                                             const QString &secondImagePath
+                                             )
+{
+    ComparatorResultDialog dialog { estimateHtml,
+                                    comparatorFullName,
+                                    firstImagePath,
+                                    secondImagePath
+                                  };
+    dialog.waitForExactResult(exactHtml);
+    dialog.exec();
+}
+
+void MainWindow::onComparisonImageStreamStarted(const TiledImageBufferPtr &buffer) {
+    mImageView->showComparisonImageStream(buffer);
+}
+
 void MainWindow::onShowImageInExternalViewer(const QPixmap &image, const QString &description) {
     if (isMaximized()) {
         showMinimized();
@@ -544,6 +1123,9 @@ void MainWindow::onShowImageInExternalViewer(const QPixmap &image, const QString
 
 void MainWindow::onFilteredResultLoaded(const ImageHolderPtr imageHolder) {
     mImageView->replaceDisplayedImages(imageHolder);
+    if (mImageProcessingInteractor != nullptr) {
+        showRowDifferences();
+    }
 }
 
 void MainWindow::onImageProcessorFailed(const QString &error) {
@@ -565,6 +1147,18 @@ void MainWindow::onFastSwitchingToComparisonImageStatusChanged(bool isSwitchingA
     ui->actionShowComparisonImage->setEnabled(isSwitchingAvailable);
 }
 
+void MainWindow::onComparisonPreviewChanged(const ComparisonPreviewRenderer &renderer) {
+    mImageView->showComparisonPreview(renderer);
+}
+
+void MainWindow::onComparisonPreviewFinished() {
+    mImageView->hideComparisonPreview();
+}
+
+void MainWindow::onLiveComparisonOverlayChanged(const ComparisonPreviewRenderer &renderer) {
+    mImageView->showLiveComparisonOverlay(renderer);
+}
+
 /* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
 
 /* Methods of the abstract class IPropcessorPropertiesDialogCallback { */
@@ -576,10 +1170,16 @@ void MainWindow::onFastSwitchingToComparisonImageStatusChanged(bool isSwitchingA
  */
 QList<Property> MainWindow::showImageProcessorPropertiesDialog(const QString& processorName,
                                                                const QString& processorDescription,
-                                                               const QList<Property>& defaultProperties
+                                                               const QList<Property>& defaultProperties,
+                                                               const PropertiesChangedCallback &onPropertiesChanged
                                                                )
 {
-    PropertyEditorDialog dialog(processorName, processorDescription, defaultProperties, this);
+    PropertyEditorDialog dialog(processorName,
+                                processorDescription,
+                                defaultProperties,
+                                onPropertiesChanged,
+                                this
+                                );
     dialog.setWindowTitle("Properties");
     dialog.setModal(true);
     dialog.exec();
@@ -5,8 +5,8 @@
 #include <QMainWindow>
 #include <QProcess>
 #include <QProgressDialog>
+#include <QFutureWatcher>
 #include <domain/interfaces/presentation/idroptarget.h>
-#include <domain/interfaces/presentation/iotherappinstancesinteractorcallback.h>
 #include <domain/interfaces/presentation/icolorundercursorchangelistener.h>
 #include <domain/interfaces/presentation/iprogressdialog.h>
 #include <domain/interfaces/presentation/ioncropimageslistener.h>
@@ -20,7 +20,8 @@ class ImageViewer;
 class IColorPickerController;
 class RecentFilesInteractor;
 class ImageProcessingInteractor;
-class OtherAppInstancesInteractor;
+class QLabel;
+class RegionStatisticsPanel;
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -35,8 +36,7 @@ class MainWindow : public QMainWindow,
                    public IImageFilesInteractorListener,
                    public IImageProcessingInteractorListener,
                    public IDropListener,
-                   public OnCropImageListener,
-                   public OtherAppInstancesInteractorCallback
+                   public OnCropImageListener
 {
     Q_OBJECT
 
@@ -51,7 +51,10 @@ public slots:
     void saveVisibleAreaAs();
     void showAboutDialog();
     void showDockedColorPicker();
+    void showRegionStatistics();
     void reloadImagesFromDisk();
+    void undoFilter();
+    void redoFilter();
     void imageZoomedToActualSize();
     void imageZoomIn();
     void imageZoomOut();
@@ -60,6 +63,13 @@ public slots:
     void placeColorPickerOnLeft();
     void imagFitInView();
     void getImagesFromVideos();
+    void compareVideos();
+    void openVideoFramePair(const QString &firstImagePath, const QString &secondImagePath);
+    void analyzeTemporalDithering();
+    void findFirstDifferentFrame();
+    void detectDroppedFrames();
+    void detectTearing();
+    void extractFramePairs();
     void runAllComparators();
     void changePluginsSettings();
     void rescanPluginDir();
@@ -67,23 +77,29 @@ public slots:
     void showFirstImage();
     void showSecondImage();
     void showComparisonImage();
+    void toggleLiveComparisonOverlay(bool isEnabled);
+    void showNextDifference();
+    void showPreviousDifference();
     void showImageAutoAnalysisSettings();
     void openImageFromClipboard();
+    void updateMemoryUsageStatus();
 
 public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
-    void openImagesInOtherAppInstance(QString firstFilePath, QString secondFilePath);
     void openImagesFromCommandLine(const QString &firstFilePath, const QString &secondFilePath);
     void openImageFromCommandLine(const QString &filePath);
     void onColorUnderCursorTrackingStatusChanged(bool isActive);
-    void onSelectedAreaShouldBeAnalyzed(ImageHolderPtr images, std::optional<int> key);
+    void onColorPickerBrushSizeChanged(int brushSize);
+    void onSelectedAreaShouldBeAnalyzed(ImageHolderPtr images, const QRect &area, std::optional<int> key);
+    void onSelectedAreaChanged(ImageHolderPtr images, const QRect &area);
 
     void onComparebleImageDisplayed(const QString &imageName);
     void onComparisonImageDisplayed(const QString &image1Name,
                                     const QString &image2Name,
                                     const QString &comparatorName
                                     );
+    void onComparisonImageStreamFinished(const TiledImageBufferPtr &buffer);
 
     // IProgressDialog interface
 
@@ -102,7 +118,9 @@ public:
 
     QList<Property> showImageProcessorPropertiesDialog(const QString &processorName,
                                                        const QString &processorDescription,
-                                                       const QList<Property> &defaultProperties) override;
+                                                       const QList<Property> &defaultProperties,
+                                                       const PropertiesChangedCallback &onPropertiesChanged = nullptr
+                                                       ) override;
 
 
     // IImageFilesInteractorListener interface
@@ -121,10 +139,21 @@ public:
                                   const QString &firstImagePath,
                                   const QString &secondImagePath) override;
 
+    void onComparisonResultEstimated(const QString &estimateHtml,
+                                     const QFuture<QString> &exactHtml,
+                                     const QString &comparatorFullName,
+                                     const QString &firstImagePath,
+                                     const QString &secondImagePath) override;
+
+    void onComparisonImageStreamStarted(const TiledImageBufferPtr &buffer) override;
+
     void onShowImageInExternalViewer(const QPixmap &image, const QString &description) override;
     void onFilteredResultLoaded(const ImageHolderPtr imageHolder) override;
     void onImageProcessorFailed(const QString &error) override;
     void onFastSwitchingToComparisonImageStatusChanged(bool isSwitchingAvailable) override;
+    void onComparisonPreviewChanged(const ComparisonPreviewRenderer &renderer) override;
+    void onComparisonPreviewFinished() override;
+    void onLiveComparisonOverlayChanged(const ComparisonPreviewRenderer &renderer) override;
 
     // IDropListener interface
 
@@ -134,10 +163,7 @@ public:
 
     void onImagesCropped(ImageHolderPtr images) override;
 
-    // OpenImagesInOtherAppInstanceInteractorCallback interface
-
-    void onOtherAppInstanceOpened() override;
-    void showError(const QString &errorMessage) override;
+    void showError(const QString &errorMessage);
 
     void mousePressEvent(QMouseEvent *event) override;
 
@@ -153,19 +179,35 @@ private:
     ImageFilesInteractor *mImageFilesInteractor;
     ImageProcessingInteractor *mImageProcessingInteractor;
     IColorPickerController *mColorPickerController;
+    RegionStatisticsPanel *mRegionStatisticsPanel;
     ImageProcessorsMenuController *mImageProcessorsMenuController;
     RecentFilesInteractor *mRecentFilesInteractor;
-    OtherAppInstancesInteractor *mOtherAppInstanceInteractor;
     QProgressDialog *mProgressDialog;
+    QLabel *mMemoryUsageLabel;
     bool mMenuIsInSingleImageMode;
-
-    void buildImageProcessorsMenu();
+    int mCurrentDifferenceRegion;
+    int mPendingDifferenceRegionStep; // The step to take when the index is built, zero if none
+    QFutureWatcher<DifferenceRegionIndex> mDifferenceRegionIndexWatcher;
+    QFutureWatcher<RowDifferenceMap> mRowDifferencesWatcher;
+    QFutureWatcher<DisplayedIntegralImages> mIntegralImagesWatcher;
+    ImageHolderPtr mSelectedAreaImages; // The statistics are shown again when the tables are built
+    QRect mSelectedArea;
+
+    static constexpr int mMemoryUsageUpdateIntervalMs = 1500;
+    static constexpr int mCroppedImagesWindowOffset = 40;
+
+    void buildImageProcessorsMenu(bool isRescanNeeded);
     void makeConnections();
     void loadTwoImagesBeingCompared();
     void enableImageProceesorsMenuItems(bool isEnabled);
     void saveMainWindowPosition();
     void restoreMainWindowPosition();
     void updateRecentFilesMenu();
+    void showDifferenceRegion(int step);
+    void onDifferenceRegionIndexFinished();
+    void showRowDifferences();
+    void onRowDifferencesFinished();
+    void onIntegralImagesFinished();
 };
 #endif // MAINWINDOW_H
 
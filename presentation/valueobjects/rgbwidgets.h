@@ -11,6 +11,7 @@ struct RgbWidgets {
     QLabel* rLabel;            // Label for R value (first panel)
     QLabel* gLabel;            // Label for G value (first panel)
     QLabel* bLabel;            // Label for B value (first panel)
+    QLabel* statisticsLabel;   // The statistics of the pixels under the brush
 };
 
 #endif // RGBWIDGETS_H
@@ -1,5 +1,7 @@
 #include "graphicspixmapitem.h"
 
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <domain/interfaces/presentation/idroptarget.h>
 
 
@@ -8,15 +10,102 @@ GraphicsPixmapItem::GraphicsPixmapItem(const QPixmap &pixmap,
                                        QGraphicsItem *parent
                                        )
     : QGraphicsPixmapItem(pixmap, parent),
-    mDropListener(dropListener)
+    mDropListener(dropListener),
+    mRenderMode(ViewRenderMode::Color),
+    mTiles(mMaxCachedPixels)
 {
     setAcceptDrops(true);
+    // Gives paint() the exposed rect instead of the whole bounding rect
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
 }
 
 GraphicsPixmapItem::~GraphicsPixmapItem() {
 
 }
 
+/* Render modes { */
+
+// The tiles of the previous mode stay in the cache, they are keyed by the mode
+void GraphicsPixmapItem::setRenderMode(ViewRenderMode mode, const IFilterPtr &renderFilter) {
+    if (mode == mRenderMode) {
+        return;
+    }
+    mRenderMode = mode;
+    mRenderFilter = renderFilter;
+    update();
+}
+
+ViewRenderMode GraphicsPixmapItem::getRenderMode() const {
+    return mRenderMode;
+}
+
+void GraphicsPixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    if (mRenderFilter == nullptr) {
+        QGraphicsPixmapItem::paint(painter, option, widget);
+        return;
+    }
+    QRect imageRect = pixmap().rect();
+    QRect exposedRect = option->exposedRect.toAlignedRect().intersected(imageRect);
+    if (exposedRect.isEmpty()) {
+        return;
+    }
+    int level = getLevel(QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform()));
+    int sourceTileSize = mTileSize << level;
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, transformationMode() == Qt::SmoothTransformation);
+    int firstColumn = exposedRect.left() / sourceTileSize;
+    int lastColumn = exposedRect.right() / sourceTileSize;
+    int firstRow = exposedRect.top() / sourceTileSize;
+    int lastRow = exposedRect.bottom() / sourceTileSize;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            QRect area = QRect(column * sourceTileSize, row * sourceTileSize, sourceTileSize, sourceTileSize)
+                             .intersected(imageRect);
+            painter->drawImage(QRectF(area), getTile(column, row, level, area));
+        }
+    }
+}
+
+QImage GraphicsPixmapItem::getTile(int column, int row, int level, const QRect &area) {
+    quint64 key = (static_cast<quint64>(mRenderMode) << 56) |
+                  (static_cast<quint64>(level) << 48) |
+                  (static_cast<quint64>(row) << 24) |
+                  static_cast<quint64>(column);
+    QImage *cachedTile = mTiles.object(key);
+    if (cachedTile != nullptr) {
+        return *cachedTile;
+    }
+
+    // The tile is drawn from the pixmap at the resolution of the level,
+    // so a zoomed out view never converts more pixels than it shows
+    int scale = 1 << level;
+    QSize tileSize { (area.width() + scale - 1) / scale, (area.height() + scale - 1) / scale };
+    QImage tile { tileSize, QImage::Format_ARGB32 };
+    tile.fill(Qt::transparent);
+    {
+        QPainter painter(&tile);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, level > 0);
+        painter.drawPixmap(QRectF(tile.rect()), pixmap(), QRectF(area));
+    }
+    for (int y = 0; y < tile.height(); ++y) {
+        mRenderFilter->filterRow(reinterpret_cast<QRgb*>(tile.scanLine(y)), tile.width());
+    }
+    mTiles.insert(key, new QImage(tile), tile.width() * tile.height());
+    return tile;
+}
+
+// The level at which a tile has at least as many pixels as it covers on the screen
+int GraphicsPixmapItem::getLevel(qreal levelOfDetail) {
+    int level = 0;
+    while (level < mMaxLevel && levelOfDetail * 2.0 <= 1.0) {
+        levelOfDetail *= 2.0;
+        ++level;
+    }
+    return level;
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
 void GraphicsPixmapItem::dragEnterEvent(QGraphicsSceneDragDropEvent *event) {
     if (event->mimeData()->hasFormat("text/uri-list") && mDropListener) {
         event->acceptProposedAction();
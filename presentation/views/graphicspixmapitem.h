@@ -1,10 +1,13 @@
 #ifndef GRAPHICSPIXMAPITEM_H
 #define GRAPHICSPIXMAPITEM_H
 
+#include <QCache>
 #include <QGraphicsPixmapItem>
 #include <QMimeData>
 #include <QGraphicsSceneDragDropEvent>
 #include <QDebug>
+#include <domain/interfaces/business/ifilter.h>
+#include <domain/valueobjects/viewrendermode.h>
 
 class IDropListener;
 
@@ -18,12 +21,31 @@ public:
                        );
     virtual ~GraphicsPixmapItem();
 
+    // In the modes other than Color the visible tiles are converted at paint time
+    // by the per-pixel filter of the mode (nullptr for Color). The tiles are rendered
+    // at the resolution of the current zoom level and cached per mode, so switching
+    // back to a mode shows the cached tiles at once.
+    void setRenderMode(ViewRenderMode mode, const IFilterPtr &renderFilter);
+    ViewRenderMode getRenderMode() const;
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
 protected:
     void dragEnterEvent(QGraphicsSceneDragDropEvent *event) override;
     void dropEvent(QGraphicsSceneDragDropEvent *event) override;
 
 private:
+    static constexpr int mTileSize = 256;
+    static constexpr int mMaxLevel = 8;          // The tiles are downscaled at most 2^8 times
+    static constexpr int mMaxCachedPixels = 64 * mTileSize * mTileSize;
+
     IDropListener *mDropListener;
+    ViewRenderMode mRenderMode;
+    IFilterPtr mRenderFilter;
+    QCache<quint64, QImage> mTiles;              // Of all the modes, the cost of a tile is its number of pixels
+
+    QImage getTile(int column, int row, int level, const QRect &area);
+    static int getLevel(qreal levelOfDetail);
 };
 
 #endif // GRAPHICSPIXMAPITEM_H
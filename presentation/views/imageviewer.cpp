@@ -13,19 +13,33 @@
 #include <QGraphicsView>
 #include <presentation/mainwindow.h>
 #include <business/utils/imagesinfo.h>
+#include <domain/valueobjects/brushstatistics.h>
 
 
 ImageViewer::ImageViewer(IDropListener *dropListener, MainWindow *parent)
     : QGraphicsView(parent),
     mParent(parent),
     mDropListener(dropListener),
+    mColorPickerBrushSize(1),
     mIsSingleImageMode(false),
-    mInvalidColor({-1, -1, -1})
+    mInvalidColor({-1, -1, -1}),
+    mRenderMode(ViewRenderMode::Color)
 {    
     mCustomScene = nullptr;
     mFirstDisplayedImage = nullptr;
     mSecondDisplayedImage = nullptr;
     mComparatorResultDisplayedImage = nullptr;
+    mComparisonPreview = nullptr;
+    mComparisonImageStream = nullptr;
+    mLiveComparisonOverlay = nullptr;
+
+    mComparisonImageStreamTimer = new QTimer(this);
+    connect(mComparisonImageStreamTimer, &QTimer::timeout, this, &ImageViewer::updateComparisonImageStream);
+    // The tiles are prefetched when the event loop is idle, a few at a time; every
+    // finished tile repaints the view, which requests the next ones
+    mLiveComparisonOverlayPrefetchTimer = new QTimer(this);
+    mLiveComparisonOverlayPrefetchTimer->setSingleShot(true);
+    connect(mLiveComparisonOverlayPrefetchTimer, &QTimer::timeout, this, &ImageViewer::prefetchLiveComparisonOverlay);
 
     QColor backgroundColor = QApplication::palette().color(QPalette::Window);
     setBackgroundBrush(backgroundColor);
@@ -53,6 +67,11 @@ void ImageViewer::onColorUnderCursorTrackingStatusChanged(bool isActivate) {
     }
 }
 
+void ImageViewer::setColorPickerBrushSize(int brushSize) {
+    mColorPickerBrushSize = brushSize;
+    sendPixelColorUnderCursor(mLastCursorPos);
+}
+
 /* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
 
 /* Zoom { */
@@ -107,6 +126,65 @@ void ImageViewer::setToFitImageInView() {
     }
 }
 
+void ImageViewer::showDifferenceRegion(const QRect &region, const QString &caption) {
+    if (!hasActiveSession()) {
+        return;
+    }
+    mDifferenceRegion = region;
+    mDifferenceRegionCaption = caption;
+
+    // A single pixel would be zoomed beyond recognition,
+    // so some context is kept around small regions.
+    const qreal minSide = 48.0;
+    QRectF target = QRectF(region).adjusted(-region.width() * 0.25,
+                                            -region.height() * 0.25,
+                                            region.width() * 0.25,
+                                            region.height() * 0.25
+                                            );
+    if (target.width() < minSide || target.height() < minSide) {
+        QPointF center = target.center();
+        target.setSize(QSizeF(qMax(target.width(), minSide), qMax(target.height(), minSide)));
+        target.moveCenter(center);
+    }
+    fitInView(target, Qt::KeepAspectRatio);
+    viewport()->update();
+    sendPixelColorUnderCursor(mLastCursorPos);
+}
+
+void ImageViewer::setRowDifferences(const RowDifferenceMap &rowDifferences) {
+    mRowDifferences = rowDifferences;
+    viewport()->update();
+}
+
+void ImageViewer::drawRowDifferencesMargin(QPainter &painter) {
+    int imageHeight = mRowDifferences.getHeight();
+    if (mIsSingleImageMode || !mRowDifferences.isKnown() || imageHeight == 0) {
+        return;
+    }
+    const int marginWidth = 6;
+    const int viewHeight = viewport()->height();
+    const int left = viewport()->width() - marginWidth;
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(128, 128, 128, 80));
+    painter.drawRect(left, 0, marginWidth, viewHeight);
+
+    painter.setBrush(QColor(255, 0, 0, 220));
+    foreach (auto range, mRowDifferences.getDifferentRowRanges()) {
+        int top = static_cast<int>(static_cast<qint64>(range.first) * viewHeight / imageHeight);
+        int bottom = static_cast<int>(static_cast<qint64>(range.second + 1) * viewHeight / imageHeight);
+        painter.drawRect(left, top, marginWidth, qMax(1, bottom - top));
+    }
+
+    // The rows that are currently visible
+    QRectF visibleRect = mapToScene(viewport()->rect()).boundingRect();
+    int top = static_cast<int>(qBound(0.0, visibleRect.top() / imageHeight, 1.0) * viewHeight);
+    int bottom = static_cast<int>(qBound(0.0, visibleRect.bottom() / imageHeight, 1.0) * viewHeight);
+    painter.setPen(QPen(QColor(0, 0, 0, 160), 1));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(left, top, marginWidth - 1, qMax(1, bottom - top - 1));
+}
+
 /* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
 
 /* Show images in QGraphicsView { */
@@ -130,6 +208,7 @@ void ImageViewer::displayImages(const ImageHolderPtr images) {
     mFirstImageBaseName = info.getFirstImageBaseName();;
     mFirstImageName = info.getFirstImageName();
     mFirstDisplayedImage = new GraphicsPixmapItem(images->getFirstImage(), mDropListener);
+    mFirstDisplayedImage->setRenderMode(mRenderMode, mRenderFilter);
     mCustomScene->addItem(mFirstDisplayedImage);
     mParent->onComparebleImageDisplayed(mFirstImageName);
 
@@ -138,6 +217,7 @@ void ImageViewer::displayImages(const ImageHolderPtr images) {
         mSecondImageBaseName = info.getSecondImageBaseName();
         mSecondImageName = info.getSecondImageName();
         mSecondDisplayedImage = new GraphicsPixmapItem(images->getSecondImage(), mDropListener);
+        mSecondDisplayedImage->setRenderMode(mRenderMode, mRenderFilter);
         mSecondDisplayedImage->setVisible(false);
         mCustomScene->addItem(mSecondDisplayedImage);
     }
@@ -151,6 +231,7 @@ void ImageViewer::showImageFromComparator(const QPixmap &image, const QString &d
     if (!hasActiveSession() || mIsSingleImageMode) {
         return;
     }
+    hideComparisonImageStream();
     if (mComparatorResultDisplayedImage != nullptr) {
         mCustomScene->removeItem(mComparatorResultDisplayedImage);
         delete mComparatorResultDisplayedImage;
@@ -165,6 +246,108 @@ void ImageViewer::showImageFromComparator(const QPixmap &image, const QString &d
     mParent->onComparisonImageDisplayed(mFirstImageName, mSecondImageName, description);
 }
 
+void ImageViewer::showComparisonPreview(const ComparisonPreviewRenderer &renderer) {
+    if (!hasActiveSession() || mIsSingleImageMode) {
+        return;
+    }
+    if (mComparisonPreview == nullptr) {
+        mComparisonPreview = new TiledPreviewItem(mFirstDisplayedImage->pixmap().size());
+        mComparisonPreview->setZValue(1); // over the images and the comparison result
+        mCustomScene->addItem(mComparisonPreview);
+    }
+    mComparisonPreview->setRenderer(renderer);
+}
+
+void ImageViewer::hideComparisonPreview() {
+    if (mComparisonPreview != nullptr) {
+        mCustomScene->removeItem(mComparisonPreview);
+        delete mComparisonPreview;
+        mComparisonPreview = nullptr;
+    }
+}
+
+void ImageViewer::showComparisonImageStream(const TiledImageBufferPtr &buffer) {
+    if (!hasActiveSession() || mIsSingleImageMode) {
+        buffer->cancel();
+        return;
+    }
+    hideComparisonImageStream();
+    mComparisonImageStream = new StreamedImageItem(buffer);
+    mComparisonImageStream->setZValue(1); // over the images and the previous comparison result
+    mCustomScene->addItem(mComparisonImageStream);
+    updateComparisonImageStream();
+    mComparisonImageStreamTimer->start(mComparisonImageStreamPollingIntervalMs);
+}
+
+void ImageViewer::hideComparisonImageStream() {
+    mComparisonImageStreamTimer->stop();
+    if (mComparisonImageStream != nullptr) {
+        mCustomScene->removeItem(mComparisonImageStream);
+        delete mComparisonImageStream;
+        mComparisonImageStream = nullptr;
+    }
+}
+
+void ImageViewer::updateComparisonImageStream() {
+    if (mComparisonImageStream == nullptr) {
+        return;
+    }
+    TiledImageBufferPtr buffer = mComparisonImageStream->getBuffer();
+    QRect imageRect { QPoint(0, 0), buffer->getSize() };
+    buffer->setVisibleArea(mapToScene(viewport()->rect()).boundingRect().toAlignedRect().intersected(imageRect));
+    mComparisonImageStream->updateFinishedTiles();
+
+    bool isFailed = !buffer->getError().isEmpty();
+    if (buffer->isComplete() || isFailed) {
+        mComparisonImageStreamTimer->stop();
+        mParent->onComparisonImageStreamFinished(buffer); // the whole image replaces the item
+        hideComparisonImageStream();
+    } else if (buffer->isCanceled()) {
+        hideComparisonImageStream(); // e.g. a filter was applied
+    }
+}
+
+void ImageViewer::showLiveComparisonOverlay(const ComparisonPreviewRenderer &renderer) {
+    if (!renderer || !hasActiveSession() || mIsSingleImageMode) {
+        hideLiveComparisonOverlay();
+        return;
+    }
+    if (mLiveComparisonOverlay == nullptr) {
+        mLiveComparisonOverlay = new TiledPreviewItem(mFirstDisplayedImage->pixmap().size());
+        mLiveComparisonOverlay->setZValue(0.5); // over the images, under the preview of the properties
+        mCustomScene->addItem(mLiveComparisonOverlay);
+    }
+    mLiveComparisonOverlay->setRenderer(renderer);
+}
+
+void ImageViewer::hideLiveComparisonOverlay() {
+    mLiveComparisonOverlayPrefetchTimer->stop();
+    if (mLiveComparisonOverlay != nullptr) {
+        mCustomScene->removeItem(mLiveComparisonOverlay);
+        delete mLiveComparisonOverlay;
+        mLiveComparisonOverlay = nullptr;
+    }
+}
+
+void ImageViewer::prefetchLiveComparisonOverlay() {
+    if (mLiveComparisonOverlay == nullptr) {
+        return;
+    }
+    QRect visibleArea = mLiveComparisonOverlay->mapFromScene(mapToScene(viewport()->rect())).boundingRect().toAlignedRect();
+    mLiveComparisonOverlay->prefetch(visibleArea);
+}
+
+void ImageViewer::setRenderMode(ViewRenderMode mode, const IFilterPtr &renderFilter) {
+    mRenderMode = mode;
+    mRenderFilter = renderFilter;
+    if (mFirstDisplayedImage != nullptr) {
+        mFirstDisplayedImage->setRenderMode(mode, renderFilter);
+    }
+    if (mSecondDisplayedImage != nullptr) {
+        mSecondDisplayedImage->setRenderMode(mode, renderFilter);
+    }
+}
+
 void ImageViewer::replaceDisplayedImages(const ImageHolderPtr imageHolder) {
     if (!hasActiveSession() || imageHolder == nullptr) {
         return;
@@ -172,6 +355,7 @@ void ImageViewer::replaceDisplayedImages(const ImageHolderPtr imageHolder) {
 
     QRectF viewRect = mapToScene(viewport()->geometry()).boundingRect();
 
+    hideComparisonImageStream();
     if (mFirstDisplayedImage != nullptr) {
         mCustomScene->removeItem(mFirstDisplayedImage);
         delete mFirstDisplayedImage;
@@ -189,10 +373,12 @@ void ImageViewer::replaceDisplayedImages(const ImageHolderPtr imageHolder) {
     }
 
     mFirstDisplayedImage = new GraphicsPixmapItem(imageHolder->getFirstImage(), mDropListener);
+    mFirstDisplayedImage->setRenderMode(mRenderMode, mRenderFilter);
     mCustomScene->addItem(mFirstDisplayedImage);
 
     if (!mIsSingleImageMode) {
         mSecondDisplayedImage = new GraphicsPixmapItem(imageHolder->getSecondImage(), mDropListener);
+        mSecondDisplayedImage->setRenderMode(mRenderMode, mRenderFilter);
 
         if (mCurrentImageIndex == 0) {
             mSecondDisplayedImage->setVisible(false);
@@ -218,6 +404,9 @@ bool ImageViewer::hasActiveSession() {
 }
 
 void ImageViewer::cleanUp() {
+    hideComparisonPreview();
+    hideComparisonImageStream();
+    hideLiveComparisonOverlay();
     if (mFirstDisplayedImage != nullptr) {
         mCustomScene->removeItem(mFirstDisplayedImage);
         delete mFirstDisplayedImage;
@@ -249,6 +438,9 @@ void ImageViewer::cleanUp() {
     mIsZoomToSelectionEnabled = false;
     mSelectionStart = {};
     mSelectionRect = {};
+    mDifferenceRegion = {};
+    mDifferenceRegionCaption = "";
+    mRowDifferences = {};
 }
 
 /* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
@@ -415,32 +607,45 @@ QPixmap ImageViewer::getVisiblePixmap() {
     return result;
 }
 
-ImageHolderPtr ImageViewer::getCroppedImages(const QRectF &rect) {
-    QRect selectionRect = rect.toAlignedRect();
+// The displayed pixmaps are shared, not copied; the visible image goes first
+ImageHolderPtr ImageViewer::getDisplayedImages() {
     auto firstPixmap = mFirstDisplayedImage->pixmap();
-    QRect boundedRect1 = selectionRect.intersected(firstPixmap.rect());
-    QPixmap croppedPixmap1 = firstPixmap.copy(boundedRect1);
     if (mIsSingleImageMode) {
-        return std::make_shared<ImageHolder>(croppedPixmap1, mFirstImageBaseName);
+        return std::make_shared<ImageHolder>(firstPixmap, mFirstImageBaseName);
     }
     auto secondPixmap = mSecondDisplayedImage->pixmap();
-    QRect boundedRect2 = selectionRect.intersected(secondPixmap.rect());
-    QPixmap croppedPixmap2 = secondPixmap.copy(boundedRect2);
     if (mCurrentImageIndex == 0) {
-        return std::make_shared<ImageHolder>(croppedPixmap1,
+        return std::make_shared<ImageHolder>(firstPixmap,
                                              mFirstImageBaseName,
-                                             croppedPixmap2,
+                                             secondPixmap,
                                              mSecondImageBaseName
                                              );
     } else {
-        return std::make_shared<ImageHolder>(croppedPixmap2,
+        return std::make_shared<ImageHolder>(secondPixmap,
                                              mSecondImageBaseName,
-                                             croppedPixmap1,
+                                             firstPixmap,
                                              mFirstImageBaseName
                                              );
     }
 }
 
+ImageHolderPtr ImageViewer::getCroppedImages(const QRectF &rect) {
+    QRect selectionRect = rect.toAlignedRect();
+    ImageHolderPtr images = getDisplayedImages();
+    QPixmap firstPixmap = images->getFirstImage();
+    QPixmap croppedPixmap1 = firstPixmap.copy(selectionRect.intersected(firstPixmap.rect()));
+    if (images->isSingleImage()) {
+        return std::make_shared<ImageHolder>(croppedPixmap1, images->getFirstImagePath());
+    }
+    QPixmap secondPixmap = images->getSecondImage();
+    QPixmap croppedPixmap2 = secondPixmap.copy(selectionRect.intersected(secondPixmap.rect()));
+    return std::make_shared<ImageHolder>(croppedPixmap1,
+                                         images->getFirstImagePath(),
+                                         croppedPixmap2,
+                                         images->getSecondImagePath()
+                                         );
+}
+
 /* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
 
 /* Events { */
@@ -458,6 +663,11 @@ void ImageViewer::mouseMoveEvent(QMouseEvent* event) {
         QPoint currentPoint = event->pos();
         mSelectionRect = QRect(mSelectionStart, currentPoint).normalized();
         viewport()->update();
+
+        QRect sceneSelectionRect = mapToScene(mSelectionRect).boundingRect().toAlignedRect();
+        if (!sceneSelectionRect.isEmpty()) {
+            mParent->onSelectedAreaChanged(getDisplayedImages(), sceneSelectionRect);
+        }
     }
 
     // Implement RGB values tracking under the mouse cursor. It needs for Color Picker.
@@ -499,67 +709,43 @@ void ImageViewer::sendPixelColorUnderCursor(std::optional<QPoint> cursorPos) {
 void ImageViewer::sendPixelColorValuesForSingleImage(const QImage &visibleImage, int &x, int &y) {
     // Ensure the coordinates are within the image bounds
     if (x >= 0 && x < visibleImage.width() && y >= 0 && y < visibleImage.height()) {
-        // Get the color of the pixel
-        QColor colorOfImage;
-        QString imageName;
-        colorOfImage = mFirstDisplayedImage->pixmap().toImage().pixelColor(x, y);
-        imageName = mFirstImageBaseName;
-        sendPixelColorValues(imageName, colorOfImage, std::nullopt, std::nullopt);
+        // Get the color of the pixels under the brush
+        auto statistics = BrushStatistics::calculate(mFirstDisplayedImage->pixmap().toImage(),
+                                                     QPoint(x, y),
+                                                     mColorPickerBrushSize
+                                                     );
+        mParent->onColorUnderCursorChanged({ mFirstImageBaseName, statistics }, std::nullopt);
     }
 }
 
 void ImageViewer::sendPixelColorValuesForTwoImages(const QImage &visibleImage, int &x, int &y) {
     // Ensure the coordinates are within the image bounds
     if (x >= 0 && x < visibleImage.width() && y >= 0 && y < visibleImage.height()) {
-        // Get the color of the pixel
-        QColor colorOfVisibleImage, colorOfHiddenImage;
+        // Get the color of the pixels under the brush
+        QImage visiblePixels, hiddenPixels;
         QString visibleImageName, hiddenImageName;
         if (mCurrentImageIndex == 0) {
-            colorOfVisibleImage =
-                mFirstDisplayedImage->pixmap().toImage().pixelColor(x, y);
-            colorOfHiddenImage =
-                mSecondDisplayedImage->pixmap().toImage().pixelColor(x, y);
+            visiblePixels = mFirstDisplayedImage->pixmap().toImage();
+            hiddenPixels = mSecondDisplayedImage->pixmap().toImage();
             visibleImageName = mFirstImageBaseName;
             hiddenImageName = mSecondImageBaseName;
         } else {
-            colorOfVisibleImage =
-                mSecondDisplayedImage->pixmap().toImage().pixelColor(x, y);
-            colorOfHiddenImage =
-                mFirstDisplayedImage->pixmap().toImage().pixelColor(x, y);
+            visiblePixels = mSecondDisplayedImage->pixmap().toImage();
+            hiddenPixels = mFirstDisplayedImage->pixmap().toImage();
             visibleImageName = mSecondImageBaseName;
             hiddenImageName = mFirstImageBaseName;
         }
-        sendPixelColorValues(visibleImageName,
-                             colorOfVisibleImage,
-                             hiddenImageName,
-                             colorOfHiddenImage
-                             );
-    }
-}
-
-void ImageViewer::sendPixelColorValues(const QString &visibleImageName,
-                                       const QColor &colorOfVisibleImage,
-                                       const std::optional<QString> &hiddenImageName,
-                                       const std::optional<QColor> &colorOfHiddenImage
-                                       )
-{
-    ImagePixelColor pixelValueOfVisibleImage = {
-        visibleImageName,
-        colorOfVisibleImage.red(),
-        colorOfVisibleImage.green(),
-        colorOfVisibleImage.blue()
-    };
-    std::optional<ImagePixelColor> pixelValueOfHiddenImage;
-    if (hiddenImageName && colorOfHiddenImage) {
-
-        pixelValueOfHiddenImage = {
-                hiddenImageName.value(),
-                colorOfHiddenImage.value().red(),
-                colorOfHiddenImage.value().green(),
-                colorOfHiddenImage.value().blue()
+        QPoint center { x, y };
+        ImagePixelColor visibleImageColor {
+            visibleImageName,
+            BrushStatistics::calculate(visiblePixels, center, mColorPickerBrushSize, hiddenPixels)
         };
+        ImagePixelColor hiddenImageColor {
+            hiddenImageName,
+            BrushStatistics::calculate(hiddenPixels, center, mColorPickerBrushSize, visiblePixels)
+        };
+        mParent->onColorUnderCursorChanged(visibleImageColor, hiddenImageColor);
     }
-    mParent->onColorUnderCursorChanged(pixelValueOfVisibleImage, pixelValueOfHiddenImage);
 }
 
 // Implement zoom to selection
@@ -614,9 +800,11 @@ void ImageViewer::mouseReleaseEvent(QMouseEvent *event) {
         {
             // If the user holds down the Command (Ctrl) key along with the comparator hotkey and selects
             // a specific area while holding the left mouse button, the comparator will run only for
-            // the selected area.
-            ImageHolderPtr images = getCroppedImages(sceneSelectionRect);
-            mParent->onSelectedAreaShouldBeAnalyzed(images, mPressedKey);
+            // the selected area. The area is analyzed in place, the images are not cropped.
+            mParent->onSelectedAreaShouldBeAnalyzed(getDisplayedImages(),
+                                                    sceneSelectionRect.toAlignedRect(),
+                                                    mPressedKey
+                                                    );
         }
         mSelectionRect = QRect(); // Clear the selection rectangle
         viewport()->update();    // Request a repaint of the view
@@ -647,6 +835,15 @@ void ImageViewer::paintEvent(QPaintEvent *event) {
     if (!hasActiveSession()) {
         return;
     }
+    // The view was scrolled or zoomed, so the tiles around the new visible area are prefetched
+    if (mLiveComparisonOverlay != nullptr && !mLiveComparisonOverlayPrefetchTimer->isActive()) {
+        mLiveComparisonOverlayPrefetchTimer->start(0);
+    }
+    // Only one painter can be active on the viewport at a time
+    {
+        QPainter painter(viewport());
+        drawRowDifferencesMargin(painter);
+    }
     // Draw the selection rectangle if it exists
     if (!mSelectionRect.isNull()) {
         QPainter painter(viewport());
@@ -654,6 +851,29 @@ void ImageViewer::paintEvent(QPaintEvent *event) {
         painter.setBrush(QBrush(Qt::transparent));       // Transparent fill
         painter.drawRect(mSelectionRect);
     }
+    // Outline the current difference, one pixel outside of it
+    if (!mDifferenceRegion.isNull()) {
+        QPainter painter(viewport());
+        QRect regionRect = mapFromScene(QRectF(mDifferenceRegion)).boundingRect().adjusted(-1, -1, 1, 1);
+        painter.setPen(QPen(Qt::magenta, 2));
+        painter.setBrush(QBrush(Qt::transparent));
+        painter.drawRect(regionRect);
+
+        QRect captionRect = painter.fontMetrics().boundingRect(mDifferenceRegionCaption).adjusted(-6, -4, 6, 4);
+        captionRect.moveTopLeft(QPoint(8, 8));
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(0, 0, 0, 160));
+        painter.drawRect(captionRect);
+        painter.setPen(Qt::white);
+        painter.drawText(captionRect, Qt::AlignCenter, mDifferenceRegionCaption);
+    }
+}
+
+// The margin and the outline are drawn in view coordinates, so the scrolled
+// pixels cannot be reused.
+void ImageViewer::scrollContentsBy(int dx, int dy) {
+    QGraphicsView::scrollContentsBy(dx, dy);
+    viewport()->update();
 }
 
 void ImageViewer::dragEnterEvent(QDragEnterEvent *event) {
@@ -3,6 +3,9 @@
 
 #include "domain/valueobjects/images.h"
 #include "graphicspixmapitem.h"
+#include "tiledpreviewitem.h"
+#include "streamedimageitem.h"
+#include <domain/valueobjects/rowdifferencemap.h>
 #include <domain/valueobjects/savefileinfo.h>
 
 #include <qgraphicsview.h>
@@ -10,6 +13,8 @@
 class MainWindow;
 class IDropListener;
 class QPixmap;
+class QPainter;
+class QTimer;
 
 class ImageViewer : public QGraphicsView {
     Q_OBJECT
@@ -43,6 +48,10 @@ public:
     // changes under the cursor; if false, we do not.
     void onColorUnderCursorTrackingStatusChanged(bool isActivate);
 
+    // The Color Picker shows the statistics of the pixels under a square brush
+    // of brushSize x brushSize centered at the cursor (see BrushStatistics).
+    void setColorPickerBrushSize(int brushSize);
+
     // Filters can be applied to modify images. This function removes
     // all filters applied to the compared images.
     void replaceDisplayedImages(const ImageHolderPtr imageHolder);
@@ -54,12 +63,42 @@ public:
 
     bool hasActiveSession();
 
+    // Zooms to a region in which the images differ and outlines it.
+    // The caption is drawn in the top left corner of the view.
+    void showDifferenceRegion(const QRect &region, const QString &caption);
+
+    // The rows in which the images differ are marked in a narrow margin
+    // at the right edge of the view, which covers the whole height of the image.
+    void setRowDifferences(const RowDifferenceMap &rowDifferences);
+
+    // Shows a live comparison result over the images, e.g. while the properties
+    // of a comparator are edited. Only the visible tiles of it are rendered.
+    void showComparisonPreview(const ComparisonPreviewRenderer &renderer);
+    void hideComparisonPreview();
+
+    // Shows a comparison image while its tiles are rendered (see TiledImageBuffer).
+    // The visible area is rendered first and follows scrolling and zooming; the
+    // finished or failed buffer is reported to MainWindow.
+    void showComparisonImageStream(const TiledImageBufferPtr &buffer);
+    void hideComparisonImageStream();
+
+    // Shows a comparison result over the images while the user browses them. Only
+    // the visible tiles are rendered, on worker threads, when they are painted; the
+    // tiles around the viewport are prefetched, so panning and zooming stay smooth.
+    void showLiveComparisonOverlay(const ComparisonPreviewRenderer &renderer);
+    void hideLiveComparisonOverlay();
+
+    // Shows only a color channel or the luminance of the compared images without
+    // changing them. The mode is kept when other images are opened or filtered.
+    void setRenderMode(ViewRenderMode mode, const IFilterPtr &renderFilter);
+
 protected:
     void wheelEvent(QWheelEvent *event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void mousePressEvent(QMouseEvent *event) override ;
     void mouseReleaseEvent(QMouseEvent *event) override;
     void paintEvent(QPaintEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
     void dragEnterEvent(QDragEnterEvent *event) override;
     void dropEvent(QDropEvent *event) override;
     void keyReleaseEvent(QKeyEvent *event) override;
@@ -74,15 +113,23 @@ private:
     QString mSecondImageBaseName;
     QString mFirstImageName;
     QString mSecondImageName;
-    QGraphicsPixmapItem *mFirstDisplayedImage;
-    QGraphicsPixmapItem *mSecondDisplayedImage;
+    GraphicsPixmapItem *mFirstDisplayedImage;
+    GraphicsPixmapItem *mSecondDisplayedImage;
     QGraphicsPixmapItem *mComparatorResultDisplayedImage;
+    TiledPreviewItem *mComparisonPreview;
+    StreamedImageItem *mComparisonImageStream;
+    QTimer *mComparisonImageStreamTimer;
+    TiledPreviewItem *mLiveComparisonOverlay;
+    QTimer *mLiveComparisonOverlayPrefetchTimer;
     int mCurrentImageIndex;
     bool mIsColorUnderCursorTrackingActive;
+    int mColorPickerBrushSize;
     std::optional<QPoint> mLastCursorPos;
     std::optional<int> mPressedKey;
     bool mIsSingleImageMode;
     QColor mInvalidColor;
+    ViewRenderMode mRenderMode;
+    IFilterPtr mRenderFilter; // The per-pixel filter of the render mode, nullptr for Color
 
     // Zoom to selection
     bool mIsSelecting;                       // Whether the user is currently selecting an area
@@ -90,20 +137,25 @@ private:
     QPoint mSelectionStart;                  // Start point of the selection (in view coordinates)
     QRect mSelectionRect;                    // Rectangle being selected (in view coordinates)
 
+    // Navigation between the differences
+    QRect mDifferenceRegion;                 // The outlined region (in image coordinates)
+    QString mDifferenceRegionCaption;
+    RowDifferenceMap mRowDifferences;
+
     QPixmap getVisiblePixmap();
 
+    ImageHolderPtr getDisplayedImages();
     ImageHolderPtr getCroppedImages(const QRectF &rect);
 
     void sendPixelColorValuesForTwoImages(const QImage &visibleImage, int &x, int &y);
     void sendPixelColorValuesForSingleImage(const QImage &visibleImage, int &x, int &y);
     void sendPixelColorUnderCursor(std::optional<QPoint> cursorPos);
-
-    void sendPixelColorValues(const QString &visibleImageName,
-                              const QColor &colorOfVisibleImage,
-                              const std::optional<QString> &hiddenImageName,
-                              const std::optional<QColor> &colorOfHiddenImage
-                              );
     void setCenterToViewRectCenter();
+    void drawRowDifferencesMargin(QPainter &painter);
+    void updateComparisonImageStream();
+    void prefetchLiveComparisonOverlay();
+
+    static constexpr int mComparisonImageStreamPollingIntervalMs = 30;
 };
 
 
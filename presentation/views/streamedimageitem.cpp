@@ -0,0 +1,48 @@
+#include "streamedimageitem.h"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+
+StreamedImageItem::StreamedImageItem(const TiledImageBufferPtr &buffer, QGraphicsItem *parent)
+    : QGraphicsItem(parent),
+    mBuffer(buffer)
+{
+    // Gives paint() the exposed rect instead of the whole bounding rect
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+const TiledImageBufferPtr& StreamedImageItem::getBuffer() const {
+    return mBuffer;
+}
+
+void StreamedImageItem::updateFinishedTiles() {
+    foreach (auto area, mBuffer->takeUpdatedAreas()) {
+        update(area);
+    }
+}
+
+QRectF StreamedImageItem::boundingRect() const {
+    return QRectF(QPointF(0, 0), mBuffer->getSize());
+}
+
+void StreamedImageItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    Q_UNUSED(widget);
+    QRect exposedRect = option->exposedRect.toAlignedRect().intersected(QRect(QPoint(0, 0), mBuffer->getSize()));
+    if (exposedRect.isEmpty()) {
+        return;
+    }
+    int tileSize = mBuffer->getTileSize();
+    int firstColumn = exposedRect.left() / tileSize;
+    int lastColumn = exposedRect.right() / tileSize;
+    int firstRow = exposedRect.top() / tileSize;
+    int lastRow = exposedRect.bottom() / tileSize;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            QImage tile = mBuffer->getTile(row * mBuffer->getColumnCount() + column);
+            if (!tile.isNull()) {
+                painter->drawImage(QPoint(column * tileSize, row * tileSize), tile);
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef STREAMEDIMAGEITEM_H
+#define STREAMEDIMAGEITEM_H
+
+#include <QGraphicsItem>
+#include <domain/valueobjects/tiledimagebuffer.h>
+
+// Shows a comparison image while it is being rendered tile by tile in the
+// background (see TiledImageBuffer). Only the finished tiles are painted;
+// the rest of the item is transparent, so the images stay visible there.
+
+class StreamedImageItem : public QGraphicsItem
+{
+public:
+    StreamedImageItem(const TiledImageBufferPtr &buffer, QGraphicsItem *parent = nullptr);
+    virtual ~StreamedImageItem() = default;
+
+    const TiledImageBufferPtr& getBuffer() const;
+
+    // Repaints the tiles that were finished since the previous call
+    void updateFinishedTiles();
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    TiledImageBufferPtr mBuffer;
+};
+
+#endif // STREAMEDIMAGEITEM_H
@@ -0,0 +1,133 @@
+#include "tiledpreviewitem.h"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QtConcurrent>
+
+
+TiledPreviewItem::TiledPreviewItem(const QSize &size, QGraphicsItem *parent)
+    : QGraphicsObject(parent),
+    mSize(size),
+    mIsRendererReplaced(std::make_shared<std::atomic_bool>(false))
+{
+    // Gives paint() the exposed rect instead of the whole bounding rect
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+// The continuations of the pending tiles are canceled with the item
+TiledPreviewItem::~TiledPreviewItem() {
+    *mIsRendererReplaced = true;
+}
+
+void TiledPreviewItem::setRenderer(const ComparisonPreviewRenderer &renderer) {
+    *mIsRendererReplaced = true;
+    mIsRendererReplaced = std::make_shared<std::atomic_bool>(false);
+    mRenderer = renderer;
+    mTiles.clear();
+    mPendingTiles.clear();
+    update();
+}
+
+QRectF TiledPreviewItem::boundingRect() const {
+    return QRectF(QPointF(0, 0), mSize);
+}
+
+void TiledPreviewItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    Q_UNUSED(widget);
+    if (!mRenderer) {
+        return;
+    }
+    QRect exposedRect = option->exposedRect.toAlignedRect().intersected(QRect(QPoint(0, 0), mSize));
+    if (exposedRect.isEmpty()) {
+        return;
+    }
+    int firstColumn = exposedRect.left() / mTileSize;
+    int lastColumn = exposedRect.right() / mTileSize;
+    int firstRow = exposedRect.top() / mTileSize;
+    int lastRow = exposedRect.bottom() / mTileSize;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            auto it = mTiles.constFind(QPoint(column, row));
+            if (it == mTiles.cend()) {
+                requestTile(QPoint(column, row)); // the tile is painted when it is ready
+            } else if (!it.value().isNull()) {
+                painter->drawImage(QPoint(column * mTileSize, row * mTileSize), it.value());
+            }
+        }
+    }
+}
+
+void TiledPreviewItem::prefetch(const QRect &visibleArea) {
+    if (!mRenderer) {
+        return;
+    }
+    QRect tilesArea = getTilesArea(visibleArea, mPrefetchMargin);
+    if (tilesArea.isEmpty()) {
+        return;
+    }
+    if (mTiles.size() > mMaxCachedTiles) {
+        dropTilesOutside(tilesArea);
+    }
+    for (int row = tilesArea.top(); row <= tilesArea.bottom(); ++row) {
+        for (int column = tilesArea.left(); column <= tilesArea.right(); ++column) {
+            QPoint tile { column, row };
+            if (mTiles.contains(tile) || mPendingTiles.contains(tile)) {
+                continue;
+            }
+            if (mPendingTiles.size() >= mMaxPrefetchedTiles) {
+                return;
+            }
+            requestTile(tile);
+        }
+    }
+}
+
+QRect TiledPreviewItem::getTilesArea(const QRect &area, int margin) const {
+    QRect clippedArea = area.intersected(QRect(QPoint(0, 0), mSize));
+    if (clippedArea.isEmpty()) {
+        return {};
+    }
+    int columnCount = (mSize.width() + mTileSize - 1) / mTileSize;
+    int rowCount = (mSize.height() + mTileSize - 1) / mTileSize;
+    return QRect(QPoint(clippedArea.left() / mTileSize - margin, clippedArea.top() / mTileSize - margin),
+                 QPoint(clippedArea.right() / mTileSize + margin, clippedArea.bottom() / mTileSize + margin)
+                 ).intersected(QRect(0, 0, columnCount, rowCount));
+}
+
+void TiledPreviewItem::dropTilesOutside(const QRect &tilesArea) {
+    for (auto it = mTiles.begin(); it != mTiles.end();) {
+        if (tilesArea.contains(it.key())) {
+            ++it;
+        } else {
+            it = mTiles.erase(it);
+        }
+    }
+}
+
+void TiledPreviewItem::requestTile(const QPoint &tile) {
+    if (mPendingTiles.contains(tile)) {
+        return;
+    }
+    mPendingTiles.insert(tile);
+    QRect area = QRect(tile * mTileSize, QSize(mTileSize, mTileSize)).intersected(QRect(QPoint(0, 0), mSize));
+    auto renderer = mRenderer;
+    auto isRendererReplaced = mIsRendererReplaced;
+    QtConcurrent::run([renderer, area, isRendererReplaced]() -> QImage {
+        if (*isRendererReplaced) {
+            return {};
+        }
+        try {
+            return renderer(area);
+        } catch (...) {
+            return {}; // e.g. invalid properties, there is nothing to show
+        }
+    }).then(this, [this, tile, area, isRendererReplaced](const QImage &image) {
+        if (*isRendererReplaced) {
+            return; // the tile of the previous renderer
+        }
+        // A null tile is cached too, so it is not rendered again
+        mPendingTiles.remove(tile);
+        mTiles.insert(tile, image);
+        update(area);
+    });
+}
@@ -0,0 +1,58 @@
+#ifndef TILEDPREVIEWITEM_H
+#define TILEDPREVIEWITEM_H
+
+#include <QGraphicsObject>
+#include <QHash>
+#include <QImage>
+#include <QSet>
+#include <atomic>
+#include <memory>
+#include <domain/interfaces/presentation/imageprocessinginteractorlistener.h>
+
+// Shows a comparison result that is rendered on demand, e.g. a live preview
+// of a comparator while its properties are being edited. Only the tiles that
+// intersect the exposed (visible) part of the item are rendered; they are cached
+// until the renderer changes, so scrolling and zooming do not render them again.
+// The tiles are rendered on the worker threads of the global thread pool, and a
+// missing tile is left transparent until it is ready, so painting never waits for
+// the renderer. The tiles around the visible area can be prefetched in idle time,
+// so panning shows ready tiles; the tiles far from it are dropped if the cache
+// grows too big.
+
+class TiledPreviewItem : public QGraphicsObject
+{
+public:
+    TiledPreviewItem(const QSize &size, QGraphicsItem *parent = nullptr);
+    virtual ~TiledPreviewItem();
+
+    // Drops the rendered tiles and repaints the item with the new renderer.
+    // The renderer is called from several threads at once.
+    void setRenderer(const ComparisonPreviewRenderer &renderer);
+
+    // Requests a few missing tiles within mPrefetchMargin tiles around the visible
+    // area (in item coordinates). A finished tile repaints the item, so the view
+    // prefetches the next ones after the repaint.
+    void prefetch(const QRect &visibleArea);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+private:
+    static constexpr int mTileSize = 256;
+    static constexpr int mPrefetchMargin = 1;
+    static constexpr int mMaxPrefetchedTiles = 8; // Being rendered at a time
+    static constexpr int mMaxCachedTiles = 512;
+
+    QSize mSize;
+    ComparisonPreviewRenderer mRenderer;
+    QHash<QPoint, QImage> mTiles;     // The key is the tile position in tiles
+    QSet<QPoint> mPendingTiles;       // The tiles being rendered on the workers
+    // Set when the renderer is replaced, so the workers skip the tiles that are not started yet
+    std::shared_ptr<std::atomic_bool> mIsRendererReplaced;
+
+    void requestTile(const QPoint &tile);
+    QRect getTilesArea(const QRect &area, int margin) const; // In tiles
+    void dropTilesOutside(const QRect &tilesArea);
+};
+
+#endif // TILEDPREVIEWITEM_H
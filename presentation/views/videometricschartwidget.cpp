@@ -0,0 +1,221 @@
+#include "videometricschartwidget.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <algorithm>
+
+
+VideoMetricsChartWidget::VideoMetricsChartWidget(QWidget *parent)
+    : QWidget(parent),
+    mTotalFrames(0),
+    mMetricType(VideoMetricType::MaxDifference),
+    mHoveredFrameIndex(-1),
+    mMaxContrast(1.0)
+{
+    setMinimumSize(800, 300);
+    setMouseTracking(true);
+    setCursor(Qt::CrossCursor);
+}
+
+void VideoMetricsChartWidget::setTotalFrames(int totalFrames) {
+    mTotalFrames = totalFrames;
+    update();
+}
+
+void VideoMetricsChartWidget::setMetricType(VideoMetricType metricType) {
+    mMetricType = metricType;
+    update();
+}
+
+void VideoMetricsChartWidget::addMetrics(const VideoFrameMetrics &metrics) {
+    mMetrics.append(metrics);
+    mMaxContrast = std::max({ mMaxContrast, metrics.firstContrast, metrics.secondContrast });
+    update();
+}
+
+void VideoMetricsChartWidget::clear() {
+    mMetrics.clear();
+    mMaxContrast = 1.0;
+    mHoveredFrameIndex = -1;
+    update();
+}
+
+/* Geometry of the chart { */
+
+QRectF VideoMetricsChartWidget::getPlotRect() const {
+    return QRectF(50, 30, width() - 70, height() - 60);
+}
+
+double VideoMetricsChartWidget::getMaxValue() const {
+    switch (mMetricType) {
+    case VideoMetricType::MaxDifference:
+    case VideoMetricType::Brightness:
+        return 255.0;
+    case VideoMetricType::DifferingPixels:
+        return 100.0;
+    case VideoMetricType::Contrast:
+        return mMaxContrast;
+    }
+    return 1.0;
+}
+
+double VideoMetricsChartWidget::getValue(const VideoFrameMetrics &metrics, bool isSecondVideo) const {
+    switch (mMetricType) {
+    case VideoMetricType::MaxDifference:
+        return metrics.maxDifference;
+    case VideoMetricType::DifferingPixels:
+        return metrics.differingPixelsPercent;
+    case VideoMetricType::Brightness:
+        return isSecondVideo ? metrics.secondBrightness : metrics.firstBrightness;
+    case VideoMetricType::Contrast:
+        return isSecondVideo ? metrics.secondContrast : metrics.firstContrast;
+    }
+    return 0.0;
+}
+
+bool VideoMetricsChartWidget::hasTwoSeries() const {
+    return mMetricType == VideoMetricType::Brightness ||
+           mMetricType == VideoMetricType::Contrast;
+}
+
+QPointF VideoMetricsChartWidget::mapToPlot(int frameIndex, double value) const {
+    QRectF plotRect = getPlotRect();
+    double lastFrame = std::max(1, mTotalFrames - 1);
+    double x = plotRect.left() + plotRect.width() * frameIndex / lastFrame;
+    double y = plotRect.bottom() - plotRect.height() * value / getMaxValue();
+    return QPointF(x, y);
+}
+
+std::optional<int> VideoMetricsChartWidget::getFrameIndexAt(const QPointF &position) const {
+    QRectF plotRect = getPlotRect();
+    if (mMetrics.isEmpty() || mTotalFrames <= 0 || plotRect.width() <= 0) {
+        return std::nullopt;
+    }
+    double lastFrame = std::max(1, mTotalFrames - 1);
+    double relativeX = (position.x() - plotRect.left()) / plotRect.width();
+    int frameIndex = qRound(std::clamp(relativeX, 0.0, 1.0) * lastFrame);
+
+    // Only frames that have already been compared can be selected
+    return std::min(frameIndex, mMetrics.last().frameIndex);
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+/* Painting { */
+
+QString VideoMetricsChartWidget::getValueDescription(const VideoFrameMetrics &metrics) const {
+    QString result = QString("Frame %1 (%2 ms): ").arg(metrics.frameIndex).arg(metrics.positionMs);
+    switch (mMetricType) {
+    case VideoMetricType::MaxDifference:
+        return result + QString("max difference %1").arg(metrics.maxDifference);
+    case VideoMetricType::DifferingPixels:
+        return result + QString("%1% of pixels differ").arg(metrics.differingPixelsPercent, 0, 'f', 3);
+    case VideoMetricType::Brightness:
+        return result + QString("brightness %1 / %2")
+                            .arg(metrics.firstBrightness, 0, 'f', 2)
+                            .arg(metrics.secondBrightness, 0, 'f', 2);
+    case VideoMetricType::Contrast:
+        return result + QString("contrast %1 / %2")
+                            .arg(metrics.firstContrast, 0, 'f', 2)
+                            .arg(metrics.secondContrast, 0, 'f', 2);
+    }
+    return result;
+}
+
+void VideoMetricsChartWidget::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QRectF plotRect = getPlotRect();
+    QColor textColor = palette().color(QPalette::WindowText);
+
+    // Axes and scale
+    painter.setPen(QPen(textColor, 1));
+    painter.drawRect(plotRect);
+    QFontMetrics fontMetrics = painter.fontMetrics();
+    const int gridLines = 4;
+    for (int i = 0; i <= gridLines; ++i) {
+        double value = getMaxValue() * i / gridLines;
+        double y = plotRect.bottom() - plotRect.height() * i / gridLines;
+        painter.setPen(QPen(textColor, 1, Qt::DotLine));
+        painter.drawLine(QPointF(plotRect.left(), y), QPointF(plotRect.right(), y));
+        painter.setPen(textColor);
+        QString label = QString::number(value, 'f', value < 10 ? 1 : 0);
+        painter.drawText(QPointF(plotRect.left() - fontMetrics.horizontalAdvance(label) - 5,
+                                 y + fontMetrics.ascent() / 2.0),
+                         label);
+    }
+    painter.drawText(QPointF(plotRect.left(), plotRect.bottom() + fontMetrics.height() + 2), "0");
+    QString lastFrameLabel = QString::number(std::max(0, mTotalFrames - 1));
+    painter.drawText(QPointF(plotRect.right() - fontMetrics.horizontalAdvance(lastFrameLabel),
+                             plotRect.bottom() + fontMetrics.height() + 2),
+                     lastFrameLabel);
+
+    // Series
+    QList<QColor> seriesColors = { QColor(0, 114, 189), QColor(217, 83, 25) };
+    int seriesCount = hasTwoSeries() ? 2 : 1;
+    for (int series = 0; series < seriesCount; ++series) {
+        QPainterPath path;
+        for (int i = 0; i < mMetrics.size(); ++i) {
+            QPointF point = mapToPlot(mMetrics[i].frameIndex, getValue(mMetrics[i], series == 1));
+            if (i == 0) {
+                path.moveTo(point);
+            } else {
+                path.lineTo(point);
+            }
+        }
+        painter.setPen(QPen(seriesColors[series], 1.5));
+        painter.drawPath(path);
+    }
+    if (hasTwoSeries()) {
+        painter.setPen(seriesColors[0]);
+        painter.drawText(QPointF(plotRect.left(), plotRect.top() - 8), "First video");
+        painter.setPen(seriesColors[1]);
+        painter.drawText(QPointF(plotRect.left() + 100, plotRect.top() - 8), "Second video");
+    }
+
+    // Hovered frame
+    if (mHoveredFrameIndex >= 0 && mHoveredFrameIndex < mMetrics.size()) {
+        const VideoFrameMetrics &metrics = mMetrics[mHoveredFrameIndex];
+        QPointF top = mapToPlot(metrics.frameIndex, getMaxValue());
+        painter.setPen(QPen(textColor, 1, Qt::DashLine));
+        painter.drawLine(top, QPointF(top.x(), plotRect.bottom()));
+        painter.setPen(textColor);
+        QString description = getValueDescription(metrics);
+        painter.drawText(QPointF(plotRect.right() - fontMetrics.horizontalAdvance(description),
+                                 plotRect.top() - 8),
+                         description);
+    }
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
+
+/* Mouse { */
+
+void VideoMetricsChartWidget::mousePressEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    auto frameIndex = getFrameIndexAt(event->position());
+    if (frameIndex) {
+        emit framePointClicked(frameIndex.value());
+    }
+}
+
+void VideoMetricsChartWidget::mouseMoveEvent(QMouseEvent *event) {
+    auto frameIndex = getFrameIndexAt(event->position());
+    int hoveredFrameIndex = frameIndex.value_or(-1);
+    if (hoveredFrameIndex != mHoveredFrameIndex) {
+        mHoveredFrameIndex = hoveredFrameIndex;
+        update();
+    }
+}
+
+void VideoMetricsChartWidget::leaveEvent(QEvent *) {
+    mHoveredFrameIndex = -1;
+    update();
+}
+
+/* } =-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- */
@@ -0,0 +1,57 @@
+#ifndef VIDEOMETRICSCHARTWIDGET_H
+#define VIDEOMETRICSCHARTWIDGET_H
+
+#include <QList>
+#include <QWidget>
+#include <optional>
+#include <domain/valueobjects/videoframemetrics.h>
+
+
+enum class VideoMetricType {
+    MaxDifference,
+    DifferingPixels,
+    Brightness,
+    Contrast
+};
+
+// Draws the per-frame metrics of the video comparison as a line chart.
+// Clicking the chart selects the frame pair under the cursor.
+
+class VideoMetricsChartWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit VideoMetricsChartWidget(QWidget *parent = nullptr);
+
+    void setTotalFrames(int totalFrames);
+    void setMetricType(VideoMetricType metricType);
+    void addMetrics(const VideoFrameMetrics &metrics);
+    void clear();
+
+signals:
+    void framePointClicked(int frameIndex);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+
+private:
+    QList<VideoFrameMetrics> mMetrics;
+    int mTotalFrames;
+    VideoMetricType mMetricType;
+    int mHoveredFrameIndex;
+    double mMaxContrast;
+
+    QRectF getPlotRect() const;
+    double getMaxValue() const;
+    double getValue(const VideoFrameMetrics &metrics, bool isSecondVideo) const;
+    bool hasTwoSeries() const;
+    QString getValueDescription(const VideoFrameMetrics &metrics) const;
+    std::optional<int> getFrameIndexAt(const QPointF &position) const;
+    QPointF mapToPlot(int frameIndex, double value) const;
+};
+
+#endif // VIDEOMETRICSCHARTWIDGET_H
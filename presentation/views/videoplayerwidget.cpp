@@ -1,5 +1,6 @@
 #include "videoplayerwidget.h"
 
+#include <algorithm>
 #include <qmessagebox.h>
 #include <presentation/views/videodialogslider.h>
 #include <business/validation/imagevalidationrulesfactory.h>
@@ -54,8 +55,8 @@ VideoPlayerWidget::VideoPlayerWidget(QWidget *parent, int videoPlayerNumber)
     connect(mScreenshotButton, &QPushButton::clicked, this, &VideoPlayerWidget::takeScreenshot);
     connect(mMediaPlayer, &QMediaPlayer::durationChanged, this, &VideoPlayerWidget::updateSliderRange);
     connect(mMediaPlayer, &QMediaPlayer::positionChanged, this, &VideoPlayerWidget::updateSliderPosition);
-    connect(mSlider, &QSlider::sliderMoved, mMediaPlayer, &QMediaPlayer::setPosition);
-    connect(mSlider, &VideoDialogSlider::sliderClicked, mMediaPlayer, &QMediaPlayer::setPosition);
+    connect(mSlider, &QSlider::sliderMoved, this, &VideoPlayerWidget::seekByUser);
+    connect(mSlider, &VideoDialogSlider::sliderClicked, this, &VideoPlayerWidget::seekByUser);
 
     connect(mMediaPlayer, &QMediaPlayer::metaDataChanged, this, [&]() {
         if (mMediaPlayer->metaData().keys().contains(QMediaMetaData::VideoFrameRate)) {
@@ -85,12 +86,35 @@ std::optional<QString> VideoPlayerWidget::getCurrentScreenshotPath() const {
 
 void VideoPlayerWidget::togglePlayPause() {
     // Toggle between Play and Pause states
-    if (mMediaPlayer->playbackState() == QMediaPlayer::PlayingState) {
-        mMediaPlayer->pause();
-        mPlayPauseButton->setText("Play");
-    } else {
+    bool shouldPlay = mMediaPlayer->playbackState() != QMediaPlayer::PlayingState;
+    setPlaying(shouldPlay);
+    emit playingChangedByUser(shouldPlay);
+}
+
+void VideoPlayerWidget::seekByUser(int position) {
+    mMediaPlayer->setPosition(position);
+    emit positionChangedByUser(position);
+}
+
+qint64 VideoPlayerWidget::getPosition() const {
+    return mMediaPlayer->position();
+}
+
+void VideoPlayerWidget::setPosition(qint64 position) {
+    qint64 duration = mMediaPlayer->duration();
+    if (duration > 0) {
+        position = std::clamp<qint64>(position, 0, duration);
+    }
+    mMediaPlayer->setPosition(position);
+}
+
+void VideoPlayerWidget::setPlaying(bool isPlaying) {
+    if (isPlaying) {
         mMediaPlayer->play();
         mPlayPauseButton->setText("Pause");
+    } else {
+        mMediaPlayer->pause();
+        mPlayPauseButton->setText("Play");
     }
 }
 
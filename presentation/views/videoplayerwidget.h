@@ -30,9 +30,17 @@ public:
 
     std::optional<QString> getCurrentScreenshotPath() const;
 
+    // Used to drive the player from the outside, e.g. when two players are locked
+    // together; unlike the user's actions, these methods do not emit signals.
+    qint64 getPosition() const;
+    void setPosition(qint64 position);
+    void setPlaying(bool isPlaying);
+
 private slots:
     void togglePlayPause();
 
+    void seekByUser(int position);
+
     void takeScreenshot();
 
     void updateSliderRange(qint64 duration);
@@ -43,6 +51,8 @@ private slots:
 
 signals:
     void screenshotTaken();
+    void positionChangedByUser(qint64 position);
+    void playingChangedByUser(bool isPlaying);
 
 private:
     QMediaPlayer *mMediaPlayer;